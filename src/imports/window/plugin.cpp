@@ -71,8 +71,9 @@ public:
         Q_ASSERT(QLatin1String(uri) == QLatin1String("QtQuick.Window"));
         QQuickWindowModule::defineModule();
 
-        // Auto-increment the import to stay in sync with ALL future QtQuick minor versions from 5.11 onward
-        qmlRegisterModule(uri, 2, QT_VERSION_MINOR);
+        // Auto-increment the import to stay in sync with ALL future QtQuick minor versions from 5.11 onward.
+        // QtQuick.Window 2.13 comes with this module, also when it is built against an older qtbase.
+        qmlRegisterModule(uri, 2, qMax(QT_VERSION_MINOR, 13));
     }
 };
 //![class decl]
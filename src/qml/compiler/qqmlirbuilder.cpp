@@ -1923,6 +1923,11 @@ QVector<int> JSCodeGen::generateJSCodeForFunctionsAndBindings(const QList<Compil
                                  function ? function->formals : nullptr,
                                  body);
         runtimeFunctionIndices[i] = idx;
+
+#ifndef V4_BOOTSTRAP
+        if (!function && !_disableAcceleratedLookups && hasFixedDependencies(node))
+            _module->functions.at(idx)->hasFixedQmlDependencies = true;
+#endif
     }
 
     return runtimeFunctionIndices;
@@ -1954,6 +1959,130 @@ QQmlPropertyData *JSCodeGen::lookupQmlCompliantProperty(QQmlPropertyCache *cache
     return pd;
 }
 
+static bool isPlainValueProperty(const QQmlPropertyData *data)
+{
+    if (!data || data->isFunction())
+        return false;
+    if (data->isEnum() || data->isQObject())
+        return true;
+    if (!data->isFullyResolved())
+        return false;
+    switch (data->propType()) {
+    case QMetaType::Bool:
+    case QMetaType::Int:
+    case QMetaType::UInt:
+    case QMetaType::LongLong:
+    case QMetaType::ULongLong:
+    case QMetaType::Float:
+    case QMetaType::Double:
+    case QMetaType::QString:
+        return true;
+    default:
+        return false;
+    }
+}
+
+/*
+    Returns true if the set of notifiers a binding expression subscribes to can be
+    determined by looking at the expression alone. That is the case when the expression
+    only reads ids, properties of ids, and properties of the scope or context object,
+    and combines them without calls, conditionals or short-circuiting operators. For
+    such expressions the guards captured during the first evaluation stay valid for
+    the lifetime of the binding, so later evaluations can skip the capture.
+
+    Member access is only accepted on ids: they are the only bases that cannot change
+    identity, whereas e.g. parent.width has to be re-captured whenever parent changes.
+*/
+bool JSCodeGen::hasFixedDependencies(AST::Node *node)
+{
+    if (!node)
+        return false;
+
+    switch (node->kind) {
+    case AST::Node::Kind_ExpressionStatement:
+        return hasFixedDependencies(static_cast<AST::ExpressionStatement *>(node)->expression);
+    case AST::Node::Kind_NestedExpression:
+        return hasFixedDependencies(static_cast<AST::NestedExpression *>(node)->expression);
+    case AST::Node::Kind_NumericLiteral:
+    case AST::Node::Kind_StringLiteral:
+    case AST::Node::Kind_TrueLiteral:
+    case AST::Node::Kind_FalseLiteral:
+    case AST::Node::Kind_NullExpression:
+        return true;
+    case AST::Node::Kind_UnaryMinusExpression:
+        return hasFixedDependencies(static_cast<AST::UnaryMinusExpression *>(node)->expression);
+    case AST::Node::Kind_UnaryPlusExpression:
+        return hasFixedDependencies(static_cast<AST::UnaryPlusExpression *>(node)->expression);
+    case AST::Node::Kind_NotExpression:
+        return hasFixedDependencies(static_cast<AST::NotExpression *>(node)->expression);
+    case AST::Node::Kind_TildeExpression:
+        return hasFixedDependencies(static_cast<AST::TildeExpression *>(node)->expression);
+    case AST::Node::Kind_BinaryExpression: {
+        AST::BinaryExpression *binary = static_cast<AST::BinaryExpression *>(node);
+        switch (binary->op) {
+        case QSOperator::Add:
+        case QSOperator::Sub:
+        case QSOperator::Mul:
+        case QSOperator::Div:
+        case QSOperator::Mod:
+        case QSOperator::Exp:
+        case QSOperator::BitAnd:
+        case QSOperator::BitOr:
+        case QSOperator::BitXor:
+        case QSOperator::LShift:
+        case QSOperator::RShift:
+        case QSOperator::URShift:
+        case QSOperator::Equal:
+        case QSOperator::NotEqual:
+        case QSOperator::StrictEqual:
+        case QSOperator::StrictNotEqual:
+        case QSOperator::Lt:
+        case QSOperator::Le:
+        case QSOperator::Gt:
+        case QSOperator::Ge:
+            return hasFixedDependencies(binary->left) && hasFixedDependencies(binary->right);
+        default:
+            return false;
+        }
+    }
+    case AST::Node::Kind_IdentifierExpression: {
+        const QString name = static_cast<AST::IdentifierExpression *>(node)->name.toString();
+        // Mirror the resolution order of fallbackNameLookup()
+        for (const IdMapping &mapping : qAsConst(_idObjects)) {
+            if (name == mapping.name)
+                return true;
+        }
+        if (name.at(0).isUpper() && imports->query(name).isValid())
+            return false;
+        if (_scopeObject) {
+            if (QQmlPropertyData *data = lookupQmlCompliantProperty(_scopeObject, name))
+                return isPlainValueProperty(data);
+        }
+        if (_contextObject) {
+            if (QQmlPropertyData *data = lookupQmlCompliantProperty(_contextObject, name))
+                return isPlainValueProperty(data);
+        }
+        return false;
+    }
+    case AST::Node::Kind_FieldMemberExpression: {
+        AST::FieldMemberExpression *member = static_cast<AST::FieldMemberExpression *>(node);
+        if (member->base->kind != AST::Node::Kind_IdentifierExpression)
+            return false;
+        const QStringRef baseName = static_cast<AST::IdentifierExpression *>(member->base)->name;
+        for (const IdMapping &mapping : qAsConst(_idObjects)) {
+            if (baseName == mapping.name) {
+                if (!mapping.type)
+                    return false;
+                return isPlainValueProperty(lookupQmlCompliantProperty(mapping.type, member->name.toString()));
+            }
+        }
+        return false;
+    }
+    default:
+        return false;
+    }
+}
+
 enum MetaObjectResolverFlags {
     AllPropertiesAreFinal      = 0x1,
     LookupsIncludeEnums        = 0x2,
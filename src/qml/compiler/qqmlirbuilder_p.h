@@ -628,6 +628,7 @@ protected:
 private:
     // returns nullptr if lookup needs to happen by name
     QQmlPropertyData *lookupQmlCompliantProperty(QQmlPropertyCache *cache, const QString &name);
+    bool hasFixedDependencies(AST::Node *node);
 
     QString sourceCode;
     QQmlJS::Engine *jsEngine; // needed for memory pool
@@ -52,6 +52,7 @@
 #include <private/qv4vme_moth_p.h>
 #include <private/qv4module_p.h>
 #include "qv4compilationunitmapper_p.h"
+#include <private/qv4jitcodecache_p.h>
 #include <QQmlPropertyMap>
 #include <QDateTime>
 #include <QFile>
@@ -186,10 +187,14 @@ QV4::Function *CompilationUnit::linkToEngine(ExecutionEngine *engine)
     }
 
     runtimeFunctions.resize(data->functionTableSize);
-    for (int i = 0 ;i < runtimeFunctions.size(); ++i) {
-        const QV4::CompiledData::Function *compiledFunction = data->functionAt(i);
-        runtimeFunctions[i] = new QV4::Function(engine, this, compiledFunction);
-    }
+    for (int i = 0 ;i < runtimeFunctions.size(); ++i)
+        runtimeFunctions[i] = new QV4::Function(engine, this, uint(i));
+
+#ifdef V4_ENABLE_JIT_CODE_CACHE
+    // Functions that were hot in a previous run start out compiled
+    if (jitCodeCache && engine->canJIT() && !engine->debugger())
+        jitCodeCache->instantiate(runtimeFunctions);
+#endif
 
     Scope scope(engine);
     Scoped<InternalClass> ic(scope);
@@ -269,6 +274,7 @@ void CompilationUnit::unlink()
     }
 
     propertyCaches.clear();
+    literalValueSnapshot.clear();
 
     dependentScripts.clear();
 
@@ -287,6 +293,12 @@ void CompilationUnit::unlink()
     runtimeRegularExpressions = nullptr;
     free(runtimeClasses);
     runtimeClasses = nullptr;
+#ifdef V4_ENABLE_JIT_CODE_CACHE
+    if (jitCodeCache && jitCodeCache->isDirty()) {
+        QString error;
+        jitCodeCache->save(&error);
+    }
+#endif
     qDeleteAll(runtimeFunctions);
     runtimeFunctions.clear();
 }
@@ -644,6 +656,15 @@ bool CompilationUnit::loadFromDisk(const QUrl &url, const QDateTime &sourceTimeS
         dataPtrRevert.dismiss();
         free(const_cast<Unit*>(oldDataPtr));
         backingFile.reset(cacheFile.take());
+
+#ifdef V4_ENABLE_JIT_CODE_CACHE
+        if (JIT::CodeCache::isEnabled()) {
+            jitCodeCache.reset(new JIT::CodeCache(data, JIT::CodeCache::filePathForUnitCache(localCacheFilePath(url))));
+            // A missing or outdated file is not an error, the code gets stored again on unlink().
+            QString jitError;
+            jitCodeCache->load(&jitError);
+        }
+#endif
         return true;
     }
 
@@ -700,6 +721,13 @@ bool CompilationUnit::saveToDisk(const QUrl &unitUrl, QString *errorString)
         return false;
     }
 
+#if defined(V4_ENABLE_JIT_CODE_CACHE)
+    // Units compiled from source record their JIT code from now on, so that it is
+    // there when the unit is loaded from the disk cache next time.
+    if (!jitCodeCache && JIT::CodeCache::isEnabled())
+        jitCodeCache.reset(new JIT::CodeCache(data, JIT::CodeCache::filePathForUnitCache(outputFileName)));
+#endif
+
     return true;
 #else
     Q_UNUSED(outputFileName)
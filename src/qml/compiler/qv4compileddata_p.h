@@ -73,7 +73,7 @@
 QT_BEGIN_NAMESPACE
 
 // Bump this whenever the compiler data structures change in an incompatible way.
-#define QV4_DATA_STRUCTURE_VERSION 0x19
+#define QV4_DATA_STRUCTURE_VERSION 0x1a
 
 class QIODevice;
 class QQmlPropertyCache;
@@ -96,6 +96,11 @@ struct Module;
 struct Function;
 class EvalISelFactory;
 class CompilationUnitMapper;
+#ifdef V4_ENABLE_JIT_CODE_CACHE
+namespace JIT {
+class CodeCache;
+}
+#endif
 
 namespace CompiledData {
 
@@ -265,7 +270,8 @@ struct Function
     enum Flags : unsigned int {
         IsStrict            = 0x1,
         IsArrowFunction     = 0x2,
-        IsGenerator         = 0x4
+        IsGenerator         = 0x4,
+        HasFixedQmlDependencies = 0x8 // binding reads the same notifiers on every evaluation
     };
 
     // Absolute offset into file where the code for this function is located.
@@ -1167,6 +1173,13 @@ public:
     QHash<int, IdentifierHash> namedObjectsPerComponentCache;
     inline IdentifierHash namedObjectsPerComponent(int componentObjectIndex);
 
+    // Literal binding values that had to be converted from their string representation
+    // (colors, urls, geometry, dates, custom types) when the component was first
+    // instantiated. Subsequent instantiations restore them from this snapshot instead of
+    // parsing the literal again. The snapshot is tied to the lifetime of this unit, so it
+    // is implicitly dropped when the source changes and the unit is recompiled.
+    QHash<const Binding *, QVariant> literalValueSnapshot;
+
     void finalizeCompositeType(QQmlEnginePrivate *qmlEngine);
 
     int totalBindingsCount = 0; // Number of bindings used in this type
@@ -1184,6 +1197,9 @@ public:
     bool isRegisteredWithEngine = false;
 
     QScopedPointer<CompilationUnitMapper> backingFile;
+#ifdef V4_ENABLE_JIT_CODE_CACHE
+    QScopedPointer<JIT::CodeCache> jitCodeCache;
+#endif
     QStringList dynamicStrings;
 
     // --- interface for QQmlPropertyCacheCreator
@@ -280,6 +280,7 @@ struct Context {
     SmallSet<int> idObjectDependencies;
     PropertyDependencyMap contextObjectPropertyDependencies;
     PropertyDependencyMap scopeObjectPropertyDependencies;
+    bool hasFixedQmlDependencies = false;
 
     Context(Context *parent, ContextType type)
         : parent(parent)
@@ -5,10 +5,12 @@ SOURCES += \
     $$PWD/qv4jithelpers.cpp \
     $$PWD/qv4baselinejit.cpp \
     $$PWD/qv4baselineassembler.cpp \
-    $$PWD/qv4assemblercommon.cpp
+    $$PWD/qv4assemblercommon.cpp \
+    $$PWD/qv4jitcodecache.cpp
 
 HEADERS += \
     $$PWD/qv4jithelpers_p.h \
     $$PWD/qv4baselinejit_p.h \
     $$PWD/qv4baselineassembler_p.h \
-    $$PWD/qv4assemblercommon_p.h
+    $$PWD/qv4assemblercommon_p.h \
+    $$PWD/qv4jitcodecache_p.h
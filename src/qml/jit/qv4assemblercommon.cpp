@@ -42,6 +42,7 @@
 
 #include "qv4engine_p.h"
 #include "qv4assemblercommon_p.h"
+#include "qv4jitcodecache_p.h"
 #include <private/qv4function_p.h>
 #include <private/qv4runtime_p.h>
 
@@ -139,6 +140,32 @@ void PlatformAssemblerCommon::link(Function *function, const char *jitKind)
         linkBuffer.patch(ehTarget.label, linkBuffer.locationOf(targetLabel));
     }
 
+#ifdef V4_ENABLE_JIT_CODE_CACHE
+    CodeCache *codeCache = function->compilationUnit->jitCodeCache.data();
+    std::vector<CodeCache::Relocation> relocations;
+    if (codeCache) {
+        const char *start = static_cast<const char *>(linkBuffer.debugAddress());
+        auto offsetOf = [start](void *address) {
+            return quint32(static_cast<const char *>(address) - start);
+        };
+        for (const auto &target : runtimeCallTargets) {
+            qint64 value;
+            if (!CodeCache::runtimeFunctionOffset(target.function, &value)) {
+                codeCache = nullptr;
+                break;
+            }
+            relocations.push_back({ offsetOf(linkBuffer.locationOf(target.label).executableAddress()),
+                                    CodeCache::RuntimeFunction, value });
+        }
+        for (const auto &ehTarget : ehTargets) {
+            auto targetLabel = labelForOffset.value(ehTarget.offset);
+            relocations.push_back({ offsetOf(linkBuffer.locationOf(ehTarget.label).executableAddress()),
+                                    CodeCache::CodeAddress,
+                                    offsetOf(linkBuffer.locationOf(targetLabel).executableAddress()) });
+        }
+    }
+#endif
+
     JSC::MacroAssemblerCodeRef codeRef;
 
     static const bool showCode = qEnvironmentVariableIsSet("QV4_SHOW_ASM");
@@ -159,6 +186,13 @@ void PlatformAssemblerCommon::link(Function *function, const char *jitKind)
     function->codeRef = new JSC::MacroAssemblerCodeRef(codeRef);
     function->jittedCode = reinterpret_cast<Function::JittedCode>(function->codeRef->code().executableAddress());
 
+#ifdef V4_ENABLE_JIT_CODE_CACHE
+    if (codeCache) {
+        codeCache->store(function->index, codeRef.code().executableAddress(), uint(codeRef.size()),
+                         relocations);
+    }
+#endif
+
     // This implements writing of JIT'd addresses so that perf can find the
     // symbol names.
     //
@@ -332,7 +366,7 @@ void PlatformAssemblerCommon::callRuntime(const char *functionName, const void *
 void PlatformAssemblerCommon::callRuntimeUnchecked(const char *functionName, const void *funcPtr)
 {
     functions.insert(funcPtr, functionName);
-    callAbsolute(funcPtr);
+    runtimeCallTargets.push_back({ callAbsolute(funcPtr), funcPtr });
 }
 
 void PlatformAssemblerCommon::tailCallRuntime(const char *functionName, const void *funcPtr)
@@ -342,7 +376,7 @@ void PlatformAssemblerCommon::tailCallRuntime(const char *functionName, const vo
     setTailCallArg(CppStackFrameRegister, 0);
     freeStackSpace();
     generatePlatformFunctionExit(/*tailCall =*/ true);
-    jumpAbsolute(funcPtr);
+    runtimeCallTargets.push_back({ jumpAbsolute(funcPtr), funcPtr });
 }
 
 void PlatformAssemblerCommon::setTailCallArg(RegisterID src, int arg)
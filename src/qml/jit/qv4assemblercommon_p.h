@@ -127,16 +127,18 @@ public:
             ret();
     }
 
-    void callAbsolute(const void *funcPtr)
+    DataLabelPtr callAbsolute(const void *funcPtr)
     {
-        move(TrustedImmPtr(funcPtr), ScratchRegister);
+        DataLabelPtr target = moveWithPatch(TrustedImmPtr(funcPtr), ScratchRegister);
         call(ScratchRegister);
+        return target;
     }
 
-    void jumpAbsolute(const void *funcPtr)
+    DataLabelPtr jumpAbsolute(const void *funcPtr)
     {
-        move(TrustedImmPtr(funcPtr), ScratchRegister);
+        DataLabelPtr target = moveWithPatch(TrustedImmPtr(funcPtr), ScratchRegister);
         jump(ScratchRegister);
+        return target;
     }
 
     void pushAligned(RegisterID reg)
@@ -213,18 +215,20 @@ public:
             ret();
     }
 
-    void callAbsolute(const void *funcPtr)
+    DataLabelPtr callAbsolute(const void *funcPtr)
     {
-        move(TrustedImmPtr(funcPtr), ScratchRegister);
+        DataLabelPtr target = moveWithPatch(TrustedImmPtr(funcPtr), ScratchRegister);
         subPtr(TrustedImm32(4 * PointerSize), StackPointerRegister);
         call(ScratchRegister);
         addPtr(TrustedImm32(4 * PointerSize), StackPointerRegister);
+        return target;
     }
 
-    void jumpAbsolute(const void *funcPtr)
+    DataLabelPtr jumpAbsolute(const void *funcPtr)
     {
-        move(TrustedImmPtr(funcPtr), ScratchRegister);
+        DataLabelPtr target = moveWithPatch(TrustedImmPtr(funcPtr), ScratchRegister);
         jump(ScratchRegister);
+        return target;
     }
 
     void pushAligned(RegisterID reg)
@@ -306,16 +310,18 @@ public:
             ret();
     }
 
-    void callAbsolute(const void *funcPtr)
+    DataLabelPtr callAbsolute(const void *funcPtr)
     {
-        move(TrustedImmPtr(funcPtr), ScratchRegister);
+        DataLabelPtr target = moveWithPatch(TrustedImmPtr(funcPtr), ScratchRegister);
         call(ScratchRegister);
+        return target;
     }
 
-    void jumpAbsolute(const void *funcPtr)
+    DataLabelPtr jumpAbsolute(const void *funcPtr)
     {
-        move(TrustedImmPtr(funcPtr), ScratchRegister);
+        DataLabelPtr target = moveWithPatch(TrustedImmPtr(funcPtr), ScratchRegister);
         jump(ScratchRegister);
+        return target;
     }
 
     void pushAligned(RegisterID reg)
@@ -407,16 +413,18 @@ public:
             ret();
     }
 
-    void callAbsolute(const void *funcPtr)
+    DataLabelPtr callAbsolute(const void *funcPtr)
     {
-        move(TrustedImmPtr(funcPtr), ScratchRegister);
+        DataLabelPtr target = moveWithPatch(TrustedImmPtr(funcPtr), ScratchRegister);
         call(ScratchRegister);
+        return target;
     }
 
-    void jumpAbsolute(const void *funcPtr)
+    DataLabelPtr jumpAbsolute(const void *funcPtr)
     {
-        move(TrustedImmPtr(funcPtr), ScratchRegister);
+        DataLabelPtr target = moveWithPatch(TrustedImmPtr(funcPtr), ScratchRegister);
         jump(ScratchRegister);
+        return target;
     }
 
     void pushAligned(RegisterID reg)
@@ -511,16 +519,18 @@ public:
             ret();
     }
 
-    void callAbsolute(const void *funcPtr)
+    DataLabelPtr callAbsolute(const void *funcPtr)
     {
-        move(TrustedImmPtr(funcPtr), dataTempRegister);
+        DataLabelPtr target = moveWithPatch(TrustedImmPtr(funcPtr), dataTempRegister);
         call(dataTempRegister);
+        return target;
     }
 
-    void jumpAbsolute(const void *funcPtr)
+    DataLabelPtr jumpAbsolute(const void *funcPtr)
     {
-        move(TrustedImmPtr(funcPtr), dataTempRegister);
+        DataLabelPtr target = moveWithPatch(TrustedImmPtr(funcPtr), dataTempRegister);
         jump(dataTempRegister);
+        return target;
     }
 
     void pushAligned(RegisterID reg)
@@ -716,6 +726,8 @@ private:
     std::vector<JumpTarget> jumpsToLink;
     struct ExceptionHanlderTarget { JSC::MacroAssemblerBase::DataLabelPtr label; int offset; };
     std::vector<ExceptionHanlderTarget> ehTargets;
+    struct RuntimeCallTarget { JSC::MacroAssemblerBase::DataLabelPtr label; const void *function; };
+    std::vector<RuntimeCallTarget> runtimeCallTargets;
     QHash<int, JSC::MacroAssemblerBase::Label> labelForOffset;
     QHash<const void *, const char *> functions;
     std::vector<Jump> catchyJumps;
@@ -0,0 +1,344 @@
+/****************************************************************************
+**
+** Copyright (C) 2019 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtQml module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#include "qv4jitcodecache_p.h"
+
+#ifdef V4_ENABLE_JIT_CODE_CACHE
+
+#include "qv4assemblercommon_p.h"
+#include <private/qv4compileddata_p.h>
+#include <private/qv4engine_p.h>
+#include <private/qv4function_p.h>
+#include <private/qv4runtime_p.h>
+#include <private/qsimd_p.h>
+
+#include <QtCore/qfile.h>
+#include <QtCore/qsavefile.h>
+
+#include <assembler/MacroAssemblerCodeRef.h>
+#include <assembler/LinkBuffer.h>
+#include <WTFStubs.h>
+
+#if defined(Q_OS_WIN)
+#  include <qt_windows.h>
+#else
+#  include <dlfcn.h>
+#endif
+
+QT_BEGIN_NAMESPACE
+
+namespace QV4 {
+namespace JIT {
+
+namespace {
+
+enum { CodeCacheVersion = 1 };
+
+struct FileHeader
+{
+    char magic[8];
+    quint32 version;
+    quint32 entryCount;
+    char libraryVersionHash[CompiledData::QmlCompileHashSpace];
+    char unitChecksum[16];
+    quint64 cpuFeatures;
+    // distances between functions in this library, to tell different builds apart
+    qint64 layout[2];
+};
+
+struct EntryHeader
+{
+    quint32 functionIndex;
+    quint32 codeSize;
+    quint32 relocationCount;
+    quint32 reserved;
+};
+
+const char magicString[8] = "qv4jitc";
+
+// All runtime functions called from JIT code are stored relative to this one.
+inline const char *anchor()
+{
+    return reinterpret_cast<const char *>(&Runtime::method_throwException);
+}
+
+inline qint64 distanceFromAnchor(const void *address)
+{
+    return qint64(reinterpret_cast<const char *>(address) - anchor());
+}
+
+bool isInThisLibrary(const void *address)
+{
+#if defined(Q_OS_WIN)
+    const DWORD flags = GET_MODULE_HANDLE_EX_FLAG_FROM_ADDRESS | GET_MODULE_HANDLE_EX_FLAG_UNCHANGED_REFCOUNT;
+    HMODULE module = nullptr;
+    HMODULE self = nullptr;
+    return GetModuleHandleExW(flags, reinterpret_cast<LPCWSTR>(address), &module)
+            && GetModuleHandleExW(flags, reinterpret_cast<LPCWSTR>(anchor()), &self)
+            && module == self;
+#else
+    Dl_info info;
+    Dl_info self;
+    return dladdr(address, &info) && dladdr(anchor(), &self) && info.dli_fbase == self.dli_fbase;
+#endif
+}
+
+FileHeader headerFor(const char *unitChecksum)
+{
+    FileHeader header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, magicString, sizeof(header.magic));
+    header.version = CodeCacheVersion;
+    memcpy(header.libraryVersionHash, CompiledData::qml_compile_hash, sizeof(header.libraryVersionHash));
+    memcpy(header.unitChecksum, unitChecksum, sizeof(header.unitChecksum));
+    header.cpuFeatures = qCpuFeatures();
+    header.layout[0] = distanceFromAnchor(reinterpret_cast<const void *>(&Runtime::method_equal));
+    header.layout[1] = distanceFromAnchor(reinterpret_cast<const void *>(&Value::toBooleanImpl));
+    return header;
+}
+
+inline uint alignedSize(uint size)
+{
+    return (size + 7) & ~7u;
+}
+
+// Whether the bytes linkPointer() patches for a pointer load at offset are inside the code.
+inline bool isPatchableLocation(quint32 offset, quint32 codeSize)
+{
+#if defined(Q_PROCESSOR_X86_64)
+    // The pointer is the immediate right before the label.
+    return offset >= sizeof(void *) && offset <= codeSize;
+#elif defined(Q_PROCESSOR_ARM_64)
+    // The pointer is loaded with a movz/movk/movk sequence starting at the label.
+    return offset % 4 == 0 && quint64(offset) + 3 * sizeof(quint32) <= codeSize;
+#endif
+}
+
+} // anonymous namespace
+
+CodeCache::CodeCache(const CompiledData::Unit *unit, const QString &filePath)
+    : filePath(filePath)
+{
+    Q_STATIC_ASSERT(sizeof(unitChecksum) == sizeof(unit->md5Checksum));
+    memcpy(unitChecksum, unit->md5Checksum, sizeof(unitChecksum));
+    entries.resize(unit->functionTableSize);
+}
+
+bool CodeCache::isEnabled()
+{
+    return qEnvironmentVariableIntValue("QV4_JIT_DISK_CACHE") > 0
+            && !qEnvironmentVariableIsSet("QV4_FORCE_INTERPRETER");
+}
+
+QString CodeCache::filePathForUnitCache(const QString &unitCacheFilePath)
+{
+    return unitCacheFilePath + QLatin1String(".jit");
+}
+
+bool CodeCache::runtimeFunctionOffset(const void *target, qint64 *offset)
+{
+    if (!isInThisLibrary(target))
+        return false;
+    *offset = distanceFromAnchor(target);
+    return true;
+}
+
+bool CodeCache::load(QString *errorString)
+{
+    QFile file(filePath);
+    if (!file.open(QIODevice::ReadOnly)) {
+        *errorString = file.errorString();
+        return false;
+    }
+    const QByteArray contents = file.readAll();
+    const char *data = contents.constData();
+    const uint size = uint(contents.size());
+
+    FileHeader header;
+    if (size < sizeof(header)) {
+        *errorString = QStringLiteral("JIT code cache file is truncated");
+        return false;
+    }
+    memcpy(&header, data, sizeof(header));
+    FileHeader expected = headerFor(unitChecksum);
+    expected.entryCount = header.entryCount;
+    if (memcmp(&header, &expected, sizeof(header)) != 0) {
+        *errorString = QStringLiteral("JIT code cache was written by a different build, for a different CPU or for a different version of the file");
+        return false;
+    }
+
+    std::vector<Entry> loaded(entries.size());
+    uint pos = sizeof(header);
+    for (uint i = 0; i < header.entryCount; ++i) {
+        EntryHeader entry;
+        if (size - pos < sizeof(entry))
+            break;
+        memcpy(&entry, data + pos, sizeof(entry));
+        pos += sizeof(entry);
+
+        const quint64 relocationsSize = quint64(entry.relocationCount) * sizeof(Relocation);
+        if (entry.functionIndex >= loaded.size() || !entry.codeSize
+                || quint64(size - pos) < alignedSize(entry.codeSize) + relocationsSize)
+            break;
+
+        Entry &e = loaded[entry.functionIndex];
+        e.code = QByteArray(data + pos, int(entry.codeSize));
+        pos += alignedSize(entry.codeSize);
+        e.relocations.resize(entry.relocationCount);
+        memcpy(e.relocations.data(), data + pos, size_t(relocationsSize));
+        pos += uint(relocationsSize);
+
+        for (const Relocation &r : e.relocations) {
+            const bool valid = isPatchableLocation(r.offset, entry.codeSize)
+                    && (r.kind == RuntimeFunction
+                        || (r.kind == CodeAddress && r.value >= 0 && r.value < qint64(entry.codeSize)));
+            if (!valid) {
+                *errorString = QStringLiteral("JIT code cache file contains invalid relocations");
+                return false;
+            }
+        }
+    }
+
+    if (pos != size) {
+        *errorString = QStringLiteral("JIT code cache file is corrupt");
+        return false;
+    }
+
+    entries.swap(loaded);
+    return true;
+}
+
+bool CodeCache::save(QString *errorString)
+{
+#if QT_CONFIG(temporaryfile)
+    QByteArray contents;
+    FileHeader header = headerFor(unitChecksum);
+    for (const Entry &e : entries) {
+        if (!e.code.isEmpty())
+            ++header.entryCount;
+    }
+    contents.append(reinterpret_cast<const char *>(&header), sizeof(header));
+
+    for (uint i = 0; i < entries.size(); ++i) {
+        const Entry &e = entries.at(i);
+        if (e.code.isEmpty())
+            continue;
+        EntryHeader entry;
+        entry.functionIndex = i;
+        entry.codeSize = uint(e.code.size());
+        entry.relocationCount = uint(e.relocations.size());
+        entry.reserved = 0;
+        contents.append(reinterpret_cast<const char *>(&entry), sizeof(entry));
+        contents.append(e.code);
+        contents.append(int(alignedSize(entry.codeSize) - entry.codeSize), '\0');
+        contents.append(reinterpret_cast<const char *>(e.relocations.data()),
+                        int(e.relocations.size() * sizeof(Relocation)));
+    }
+
+    QSaveFile file(filePath);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)
+            || file.write(contents) != contents.size()
+            || !file.commit()) {
+        *errorString = file.errorString();
+        return false;
+    }
+    dirty = false;
+    return true;
+#else
+    *errorString = QStringLiteral("features.temporaryfile is disabled.");
+    return false;
+#endif
+}
+
+void CodeCache::instantiate(const QVector<Function *> &functions)
+{
+    for (int i = 0, end = qMin(functions.size(), int(entries.size())); i < end; ++i) {
+        Entry &e = entries[i];
+        Function *f = functions.at(i);
+        if (e.code.isEmpty() || f->jittedCode || f->isGenerator())
+            continue;
+        if (!instantiate(f, e)) {
+            // out of executable memory; keep the entry for the next run
+            return;
+        }
+    }
+}
+
+bool CodeCache::instantiate(Function *function, const Entry &entry)
+{
+    const size_t size = size_t(entry.code.size());
+    JSC::JSGlobalData globalData(function->internalClass->engine->executableAllocator);
+    RefPtr<JSC::ExecutableMemoryHandle> memory = globalData.executableAllocator.allocate(
+                globalData, size, nullptr, JSC::JITCompilationCanFail);
+    if (!memory || !memory->start())
+        return false;
+
+    char *code = static_cast<char *>(memory->start());
+    JSC::ExecutableAllocator::makeWritable(code, size);
+    memcpy(code, entry.code.constData(), size);
+    for (const Relocation &r : entry.relocations) {
+        const char *target = r.kind == RuntimeFunction ? anchor() + r.value : code + r.value;
+        PlatformAssemblerBase::AssemblerType_T::linkPointer(code, JSC::AssemblerLabel(r.offset),
+                                                            const_cast<char *>(target));
+    }
+    PlatformAssemblerBase::cacheFlush(code, size);
+    JSC::ExecutableAllocator::makeExecutable(code, size);
+
+    function->codeRef = new JSC::MacroAssemblerCodeRef(memory.release());
+    function->jittedCode = reinterpret_cast<Function::JittedCode>(function->codeRef->code().executableAddress());
+    return true;
+}
+
+void CodeCache::store(uint functionIndex, const void *code, uint size, const std::vector<Relocation> &relocations)
+{
+    if (functionIndex >= entries.size())
+        return;
+    Entry &e = entries[functionIndex];
+    e.code = QByteArray(static_cast<const char *>(code), int(size));
+    e.relocations = relocations;
+    dirty = true;
+}
+
+} // JIT namespace
+} // QV4 namespace
+
+QT_END_NAMESPACE
+
+#endif // V4_ENABLE_JIT_CODE_CACHE
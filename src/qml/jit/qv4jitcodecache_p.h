@@ -0,0 +1,138 @@
+/****************************************************************************
+**
+** Copyright (C) 2019 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtQml module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#ifndef QV4JITCODECACHE_P_H
+#define QV4JITCODECACHE_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists purely as an
+// implementation detail.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <private/qv4global_p.h>
+#include <QtCore/qbytearray.h>
+#include <QtCore/qstring.h>
+#include <QtCore/qvector.h>
+
+#include <vector>
+
+QT_BEGIN_NAMESPACE
+
+namespace QV4 {
+
+struct Function;
+
+namespace CompiledData {
+struct Unit;
+}
+
+namespace JIT {
+
+#ifdef V4_ENABLE_JIT_CODE_CACHE
+
+// Keeps the baseline JIT code of the functions of one compilation unit in a file next
+// to its disk cache, so that functions that got hot in a previous run start out
+// compiled. Enabled with QV4_JIT_DISK_CACHE=1.
+//
+// The generated code is position independent, apart from the pointers loaded into
+// registers for calls into the runtime and the code addresses of exception handlers.
+// Those are written out as relocations: runtime functions relative to a symbol in this
+// library, handlers relative to the start of the code. The file is only used when the
+// library, the CPU features and the compilation unit are the same as when it was
+// written. Otherwise it is ignored, and functions get compiled as usual.
+class Q_QML_PRIVATE_EXPORT CodeCache
+{
+public:
+    enum RelocationKind : quint32 {
+        RuntimeFunction,
+        CodeAddress
+    };
+
+    struct Relocation {
+        quint32 offset; // location of the pointer, as returned by LinkBuffer::locationOf()
+        quint32 kind;
+        qint64 value;
+    };
+
+    CodeCache(const CompiledData::Unit *unit, const QString &filePath);
+
+    static bool isEnabled();
+    static QString filePathForUnitCache(const QString &unitCacheFilePath);
+
+    // Returns the value to store for a call into the runtime, or false if the target
+    // can't be expressed relative to this library.
+    static bool runtimeFunctionOffset(const void *target, qint64 *offset);
+
+    bool load(QString *errorString);
+    bool save(QString *errorString);
+    bool isDirty() const { return dirty; }
+
+    // Installs the cached code for all functions that have some.
+    void instantiate(const QVector<Function *> &functions);
+    void store(uint functionIndex, const void *code, uint size, const std::vector<Relocation> &relocations);
+
+private:
+    struct Entry {
+        QByteArray code;
+        std::vector<Relocation> relocations;
+    };
+
+    bool instantiate(Function *function, const Entry &entry);
+
+    char unitChecksum[16];
+    QString filePath;
+    std::vector<Entry> entries; // indexed by function index
+    bool dirty = false;
+};
+
+#endif // V4_ENABLE_JIT_CODE_CACHE
+
+} // JIT namespace
+} // QV4 namespace
+
+QT_END_NAMESPACE
+
+#endif // QV4JITCODECACHE_P_H
@@ -54,6 +54,7 @@
 #include <private/qv4qobjectwrapper_p.h>
 #include <private/qv4stackframe_p.h>
 #include <private/qv4module_p.h>
+#include <private/qv4jsonobject_p.h>
 
 #include <QtCore/qdatetime.h>
 #include <QtCore/qmetaobject.h>
@@ -527,6 +528,7 @@ QJSValue QJSEngine::evaluate(const QString& program, const QString& fileName, in
         result = script.run();
     if (scope.engine->hasException)
         result = v4->catchException();
+    v4->promiseReactionCheckpoint();
 
     QJSValue retval(v4, result->asReturnedValue());
 
@@ -568,6 +570,37 @@ QJSValue QJSEngine::importModule(const QString &fileName)
     return QJSValue(m_v4Engine, moduleNamespace->asReturnedValue());
 }
 
+/*!
+    \since 5.13
+
+    Serializes \a value to JSON, the same way \c{JSON.stringify()} does, and
+    writes the result to \a device encoded in UTF-8. If \a indent is greater
+    than zero, the output is pretty printed with that many spaces per level,
+    up to ten.
+
+    The output is written in chunks while the value is serialized, so large
+    structures can be written without ever holding the complete text in
+    memory.
+
+    Returns \c true on success. Returns \c false if \a value cannot be
+    represented as JSON (for example undefined or a function), if an
+    exception is thrown during serialization (for example for a cyclic
+    structure or from a \c toJSON() method), or if writing to \a device
+    fails. In that case, part of the output may already have been written.
+*/
+bool QJSEngine::toJson(const QJSValue &value, QIODevice *device, int indent)
+{
+    QV4::Scope scope(m_v4Engine);
+    QV4::ScopedValue v(scope, QJSValuePrivate::convertedToValue(m_v4Engine, value));
+    const QString gap(qBound(0, indent, 10), QLatin1Char(' '));
+    const bool ok = QV4::JsonObject::stringify(m_v4Engine, v, gap, device);
+    if (m_v4Engine->hasException) {
+        m_v4Engine->catchException();
+        return false;
+    }
+    return ok;
+}
+
 /*!
   Creates a JavaScript object of class Object.
 
@@ -52,6 +52,8 @@
 QT_BEGIN_NAMESPACE
 
 
+class QIODevice;
+
 template <typename T>
 inline T qjsvalue_cast(const QJSValue &);
 
@@ -71,6 +73,8 @@ public:
 
     QJSValue importModule(const QString &fileName);
 
+    bool toJson(const QJSValue &value, QIODevice *device, int indent = 0);
+
     QJSValue newObject();
     QJSValue newArray(uint length = 0);
 
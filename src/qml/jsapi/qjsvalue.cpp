@@ -770,6 +770,7 @@ QJSValue QJSValue::call(const QJSValueList &args)
     ScopedValue result(scope, f->call(jsCallData));
     if (engine->hasException)
         result = engine->catchException();
+    engine->promiseReactionCheckpoint();
 
     return QJSValue(engine, result->asReturnedValue());
 }
@@ -826,6 +827,7 @@ QJSValue QJSValue::callWithInstance(const QJSValue &instance, const QJSValueList
     ScopedValue result(scope, f->call(jsCallData));
     if (engine->hasException)
         result = engine->catchException();
+    engine->promiseReactionCheckpoint();
 
     return QJSValue(engine, result->asReturnedValue());
 }
@@ -874,6 +876,7 @@ QJSValue QJSValue::callAsConstructor(const QJSValueList &args)
     ScopedValue result(scope, f->callAsConstructor(jsCallData));
     if (engine->hasException)
         result = engine->catchException();
+    engine->promiseReactionCheckpoint();
 
     return QJSValue(engine, result->asReturnedValue());
 }
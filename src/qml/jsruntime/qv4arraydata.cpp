@@ -45,6 +45,11 @@
 #include "qv4string_p.h"
 #include "qv4jscall_p.h"
 
+#include <QtCore/qvarlengtharray.h>
+
+#include <algorithm>
+#include <vector>
+
 using namespace QV4;
 
 DEFINE_MANAGED_VTABLE(ArrayData);
@@ -178,8 +183,7 @@ void ArrayData::realloc(Object *o, Type newType, uint requested, bool enforceAtt
         *lastFree = Encode(0);
         for (uint i = 0; i < toCopy; ++i) {
             if (!sparse->values[i].isEmpty()) {
-                SparseArrayNode *n = sparse->sparse->insert(i);
-                n->value = i;
+                *sparse->sparse->insert(i) = i;
             } else {
                 *lastFree = Encode(i);
                 sparse->values.values[i].setEmpty();
@@ -410,14 +414,14 @@ bool SparseArrayData::put(Object *o, uint index, const Value &value)
         return true;
 
     Heap::SparseArrayData *s = o->d()->arrayData.cast<Heap::SparseArrayData>();
-    SparseArrayNode *n = s->sparse->insert(index);
-    Q_ASSERT(n->value == UINT_MAX || !s->attrs || !s->attrs[n->value].isAccessor());
-    if (n->value == UINT_MAX)
-        n->value = allocate(o);
+    uint *slot = s->sparse->insert(index);
+    Q_ASSERT(*slot == UINT_MAX || !s->attrs || !s->attrs[*slot].isAccessor());
+    if (*slot == UINT_MAX)
+        *slot = allocate(o);
     s = o->d()->arrayData.cast<Heap::SparseArrayData>();
-    s->setArrayData(o->engine(), n->value, value);
+    s->setArrayData(o->engine(), *slot, value);
     if (s->attrs)
-        s->attrs[n->value] = Attr_Data;
+        s->attrs[*slot] = Attr_Data;
     return true;
 }
 
@@ -425,11 +429,11 @@ bool SparseArrayData::del(Object *o, uint index)
 {
     Heap::SparseArrayData *dd = o->d()->arrayData.cast<Heap::SparseArrayData>();
 
-    SparseArrayNode *n = dd->sparse->findNode(index);
-    if (!n)
+    const uint *slot = dd->sparse->find(index);
+    if (!slot)
         return true;
 
-    uint pidx = n->value;
+    uint pidx = *slot;
     Q_ASSERT(!dd->values[pidx].isEmpty());
 
     bool isAccessor = false;
@@ -451,25 +455,25 @@ bool SparseArrayData::del(Object *o, uint index)
     }
 
     dd->sparse->freeList = Encode(pidx);
-    dd->sparse->erase(n);
+    dd->sparse->erase(index);
     return true;
 }
 
 void SparseArrayData::setAttribute(Object *o, uint index, PropertyAttributes attrs)
 {
     Heap::SparseArrayData *d = o->d()->arrayData.cast<Heap::SparseArrayData>();
-    SparseArrayNode *n = d->sparse->insert(index);
-    if (n->value == UINT_MAX) {
-        n->value = allocate(o, attrs.isAccessor());
+    uint *slot = d->sparse->insert(index);
+    if (*slot == UINT_MAX) {
+        *slot = allocate(o, attrs.isAccessor());
         d = o->d()->arrayData.cast<Heap::SparseArrayData>();
     }
-    else if (attrs.isAccessor() != d->attrs[n->value].isAccessor()) {
+    else if (attrs.isAccessor() != d->attrs[*slot].isAccessor()) {
         // need to convert the slot
-        free(o->arrayData(), n->value);
-        n->value = allocate(o, attrs.isAccessor());
+        free(o->arrayData(), *slot);
+        *slot = allocate(o, attrs.isAccessor());
         d = o->d()->arrayData.cast<Heap::SparseArrayData>();
     }
-    d->attrs[n->value] = attrs;
+    d->attrs[*slot] = attrs;
 }
 
 void SparseArrayData::push_front(Object *o, const Value *values, uint n)
@@ -502,24 +506,22 @@ ReturnedValue SparseArrayData::pop_front(Object *o)
 uint SparseArrayData::truncate(Object *o, uint newLen)
 {
     Heap::SparseArrayData *d = o->d()->arrayData.cast<Heap::SparseArrayData>();
-    SparseArrayNode *begin = d->sparse->lowerBound(newLen);
+    SparseArray::ConstIterator begin = d->sparse->lowerBound(newLen);
     if (begin != d->sparse->end()) {
-        SparseArrayNode *it = d->sparse->end()->previousNode();
-        while (1) {
+        // free the slots from the back until we hit a non configurable entry, then
+        // drop all the freed entries in one go
+        SparseArray::ConstIterator it = d->sparse->end();
+        do {
+            --it;
             if (d->attrs) {
-                if (!d->attrs[it->value].isConfigurable()) {
-                    newLen = it->key() + 1;
+                if (!d->attrs[it.value()].isConfigurable()) {
+                    newLen = it.key() + 1;
                     break;
                 }
             }
-            free(o->arrayData(), it->value);
-            bool brk = (it == begin);
-            SparseArrayNode *prev = it->previousNode();
-            d->sparse->erase(it);
-            if (brk)
-                break;
-            it = prev;
-        }
+            free(o->arrayData(), it.value());
+        } while (it != begin);
+        d->sparse->eraseFrom(newLen);
     }
     return newLen;
 }
@@ -527,11 +529,9 @@ uint SparseArrayData::truncate(Object *o, uint newLen)
 uint SparseArrayData::length(const Heap::ArrayData *d)
 {
     const Heap::SparseArrayData *dd = static_cast<const Heap::SparseArrayData *>(d);
-    if (!dd->sparse)
+    if (!dd->sparse || !dd->sparse->nEntries())
         return 0;
-    SparseArrayNode *n = dd->sparse->end();
-    n = n->previousNode();
-    return n ? n->key() + 1 : 0;
+    return dd->sparse->lastKey() + 1;
 }
 
 bool SparseArrayData::putArray(Object *o, uint index, const Value *values, uint n)
@@ -567,15 +567,13 @@ uint ArrayData::append(Object *obj, ArrayObject *otherObj, uint n)
         Heap::SparseArrayData *os = static_cast<Heap::SparseArrayData *>(other->d());
         if (other->hasAttributes()) {
             ScopedValue v(scope);
-            for (const SparseArrayNode *it = os->sparse->begin();
-                 it != os->sparse->end(); it = it->nextNode()) {
-                v = otherObj->getValue(os->values[it->value], other->d()->attrs[it->value]);
-                obj->arraySet(oldSize + it->key(), v);
+            for (SparseArray::ConstIterator it = os->sparse->begin(); it != os->sparse->end(); ++it) {
+                v = otherObj->getValue(os->values[it.value()], other->d()->attrs[it.value()]);
+                obj->arraySet(oldSize + it.key(), v);
             }
         } else {
-            for (const SparseArrayNode *it = other->d()->sparse->begin();
-                 it != os->sparse->end(); it = it->nextNode())
-                obj->arraySet(oldSize + it->key(), os->values[it->value]);
+            for (SparseArray::ConstIterator it = os->sparse->begin(); it != os->sparse->end(); ++it)
+                obj->arraySet(oldSize + it.key(), os->values[it.value()]);
         }
     } else {
         Heap::SimpleArrayData *os = static_cast<Heap::SimpleArrayData *>(other->d());
@@ -614,107 +612,171 @@ void ArrayData::insert(Object *o, uint index, const Value *v, bool isAccessor)
 
     o->initSparseArray();
     Heap::SparseArrayData *s = o->d()->arrayData.cast<Heap::SparseArrayData>();
-    SparseArrayNode *n = s->sparse->insert(index);
-    if (n->value == UINT_MAX)
-        n->value = SparseArrayData::allocate(o, isAccessor);
+    uint *slot = s->sparse->insert(index);
+    if (*slot == UINT_MAX)
+        *slot = SparseArrayData::allocate(o, isAccessor);
     s = o->d()->arrayData.cast<Heap::SparseArrayData>();
-    s->setArrayData(o->engine(), n->value, *v);
+    s->setArrayData(o->engine(), *slot, *v);
     if (isAccessor)
-        s->setArrayData(o->engine(), n->value + Object::SetterOffset, v[Object::SetterOffset]);
+        s->setArrayData(o->engine(), *slot + Object::SetterOffset, v[Object::SetterOffset]);
 }
 
 
+namespace {
+
+// Calls the user supplied comparison function. Once it has thrown, all further
+// comparisons report "not less than", which lets the sort finish without more calls.
 class ArrayElementLessThan
 {
 public:
-    inline ArrayElementLessThan(ExecutionEngine *engine, const Value &comparefn)
+    inline ArrayElementLessThan(ExecutionEngine *engine, const FunctionObject *comparefn)
         : m_engine(engine), m_comparefn(comparefn) {}
 
-    bool operator()(Value v1, Value v2) const;
-
-private:
-    ExecutionEngine *m_engine;
-    const Value &m_comparefn;
-};
-
-
-bool ArrayElementLessThan::operator()(Value v1, Value v2) const
-{
-    Scope scope(m_engine);
+    bool operator()(const Value &v1, const Value &v2) const
+    {
+        if (m_engine->hasException)
+            return false;
 
-    if (v1.isUndefined() || v1.isEmpty())
-        return false;
-    if (v2.isUndefined() || v2.isEmpty())
-        return true;
-    ScopedFunctionObject o(scope, m_comparefn);
-    if (o) {
-        Scope scope(o->engine());
-        ScopedValue result(scope);
+        Scope scope(m_engine);
         JSCallData jsCallData(scope, 2);
         jsCallData->args[0] = v1;
         jsCallData->args[1] = v2;
-        result = o->call(jsCallData);
-
+        ScopedValue result(scope, m_comparefn->call(jsCallData));
         return result->toNumber() < 0;
     }
-    ScopedString p1s(scope, v1.toString(scope.engine));
-    ScopedString p2s(scope, v2.toString(scope.engine));
-    return p1s->toQString() < p2s->toQString();
-}
 
-template <typename RandomAccessIterator, typename T, typename LessThan>
-void sortHelper(RandomAccessIterator start, RandomAccessIterator end, const T &t, LessThan lessThan)
-{
-top:
-    int span = int(end - start);
-    if (span < 2)
-        return;
-
-    --end;
-    RandomAccessIterator low = start, high = end - 1;
-    RandomAccessIterator pivot = start + span / 2;
+private:
+    ExecutionEngine *m_engine;
+    const FunctionObject *m_comparefn;
+};
 
-    if (lessThan(*end, *start))
-        qSwap(*end, *start);
-    if (span == 2)
-        return;
+// Stable sort for arrays of Values, in the spirit of TimSort: natural runs are detected
+// (descending runs are reversed), short runs are extended with a binary insertion sort,
+// and runs are then merged pairwise. Merging two runs that are already in order costs a
+// single comparison, so partially sorted input needs far fewer calls of lessThan than a
+// quicksort. Every loop is bounded by indices only, so an inconsistent comparison
+// function can produce an unspecified order, but never access memory out of bounds.
+//
+// The values and the equally sized buffer must be kept alive by the caller, as
+// lessThan may run JavaScript and thereby trigger garbage collection.
+template <typename LessThan>
+class MergeSorter
+{
+public:
+    MergeSorter(Value *values, Value *buffer, uint length, const LessThan &lessThan)
+        : m_values(values), m_buffer(buffer), m_length(length), m_lessThan(lessThan)
+    {}
+
+    void sort()
+    {
+        const uint MinRun = 32;
+
+        QVarLengthArray<uint, 64> runs;
+        for (uint start = 0; start < m_length;) {
+            uint run = countRun(start);
+            if (run < MinRun) {
+                const uint forced = qMin(MinRun, m_length - start);
+                insertionSort(start, start + forced, start + run);
+                run = forced;
+            }
+            runs.append(start);
+            start += run;
+        }
+        runs.append(m_length);
+
+        while (runs.size() > 2) {
+            QVarLengthArray<uint, 64> merged;
+            int i = 0;
+            for (; i + 2 < runs.size(); i += 2) {
+                merge(runs.at(i), runs.at(i + 1), runs.at(i + 2));
+                merged.append(runs.at(i));
+            }
+            if (i + 1 < runs.size())
+                merged.append(runs.at(i));
+            merged.append(m_length);
+            runs = merged;
+        }
+    }
 
-    if (lessThan(*pivot, *start))
-        qSwap(*pivot, *start);
-    if (lessThan(*end, *pivot))
-        qSwap(*end, *pivot);
-    if (span == 3)
-        return;
+private:
+    uint countRun(uint start)
+    {
+        uint end = start + 1;
+        if (end == m_length)
+            return 1;
+
+        if (m_lessThan(m_values[end], m_values[start])) {
+            // Only strictly descending runs may be reversed without breaking stability.
+            while (end + 1 < m_length && m_lessThan(m_values[end + 1], m_values[end]))
+                ++end;
+            ++end;
+            std::reverse(m_values + start, m_values + end);
+        } else {
+            while (end + 1 < m_length && !m_lessThan(m_values[end + 1], m_values[end]))
+                ++end;
+            ++end;
+        }
+        return end - start;
+    }
 
-    qSwap(*pivot, *end);
+    // Sorts [start, end), of which [start, sorted) is already in order.
+    void insertionSort(uint start, uint end, uint sorted)
+    {
+        for (uint i = qMax(sorted, start + 1); i < end; ++i) {
+            // The value stays in its slot while searching, so it remains reachable.
+            uint low = start;
+            uint high = i;
+            while (low < high) {
+                const uint mid = low + (high - low) / 2;
+                if (m_lessThan(m_values[i], m_values[mid]))
+                    high = mid;
+                else
+                    low = mid + 1;
+            }
+            if (low == i)
+                continue;
+            const Value value = m_values[i];
+            std::copy_backward(m_values + low, m_values + i, m_values + i + 1);
+            m_values[low] = value;
+        }
+    }
 
-    while (low < high) {
-        while (low < high && lessThan(*low, *end))
-            ++low;
+    // Merges the adjacent sorted ranges [start, middle) and [middle, end).
+    void merge(uint start, uint middle, uint end)
+    {
+        if (!m_lessThan(m_values[middle], m_values[middle - 1]))
+            return;
 
-        while (high > low && lessThan(*end, *high))
-            --high;
+        Value *left = m_buffer + start;
+        std::copy(m_values + start, m_values + middle, left);
+        const uint leftLength = middle - start;
 
-        if (low < high) {
-            qSwap(*low, *high);
-            ++low;
-            --high;
-        } else {
-            break;
+        uint l = 0;
+        uint r = middle;
+        uint out = start;
+        while (l < leftLength && r < end) {
+            if (m_lessThan(m_values[r], left[l]))
+                m_values[out++] = m_values[r++];
+            else
+                m_values[out++] = left[l++];
         }
+        while (l < leftLength)
+            m_values[out++] = left[l++];
     }
 
-    if (lessThan(*low, *end))
-        ++low;
-
-    qSwap(*end, *low);
-    sortHelper(start, low, t, lessThan);
+    Value *m_values;
+    Value *m_buffer;
+    uint m_length;
+    const LessThan &m_lessThan;
+};
 
-    start = low + 1;
-    ++end;
-    goto top;
+template <typename LessThan>
+void mergeSort(Value *values, Value *buffer, uint length, const LessThan &lessThan)
+{
+    MergeSorter<LessThan>(values, buffer, length, lessThan).sort();
 }
 
+} // namespace
 
 void ArrayData::sort(ExecutionEngine *engine, Object *thisObject, const Value &comparefn, uint len)
 {
@@ -747,40 +809,41 @@ void ArrayData::sort(ExecutionEngine *engine, Object *thisObject, const Value &c
         ArrayData::realloc(thisObject, Heap::ArrayData::Simple, sparse->sparse()->nEntries(), sparse->attrs() ? true : false);
         Heap::SimpleArrayData *d = thisObject->d()->arrayData.cast<Heap::SimpleArrayData>();
 
-        SparseArrayNode *n = sparse->sparse()->begin();
+        const SparseArray *map = sparse->sparse();
+        SparseArray::ConstIterator n = map->begin();
         uint i = 0;
         if (sparse->attrs()) {
-            while (n != sparse->sparse()->end()) {
-                if (n->value >= len)
+            while (n != map->end()) {
+                if (n.key() >= len)
                     break;
 
-                PropertyAttributes a = sparse->attrs() ? sparse->attrs()[n->value] : Attr_Data;
-                d->setData(engine, i, Value::fromReturnedValue(thisObject->getValue(sparse->arrayData()[n->value], a)));
+                PropertyAttributes a = sparse->attrs() ? sparse->attrs()[n.value()] : Attr_Data;
+                d->setData(engine, i, Value::fromReturnedValue(thisObject->getValue(sparse->arrayData()[n.value()], a)));
                 d->attrs[i] = a.isAccessor() ? Attr_Data : a;
 
-                n = n->nextNode();
+                ++n;
                 ++i;
             }
         } else {
-            while (n != sparse->sparse()->end()) {
-                if (n->value >= len)
+            while (n != map->end()) {
+                if (n.key() >= len)
                     break;
-                d->setData(engine, i, sparse->arrayData()[n->value]);
-                n = n->nextNode();
+                d->setData(engine, i, sparse->arrayData()[n.value()]);
+                ++n;
                 ++i;
             }
         }
         d->values.size = i;
         if (len > i)
             len = i;
-        if (n != sparse->sparse()->end()) {
+        if (n != map->end()) {
             // have some entries outside the sort range that we need to ignore when sorting
             thisObject->initSparseArray();
-            while (n != sparse->sparse()->end()) {
-                PropertyAttributes a = sparse->attrs() ? sparse->attrs()[n->value] : Attr_Data;
-                thisObject->arraySet(n->value, reinterpret_cast<const Property *>(sparse->arrayData() + n->value), a);
+            while (n != map->end()) {
+                PropertyAttributes a = sparse->attrs() ? sparse->attrs()[n.value()] : Attr_Data;
+                thisObject->arraySet(n.key(), reinterpret_cast<const Property *>(sparse->arrayData() + n.value()), a);
 
-                n = n->nextNode();
+                ++n;
             }
 
         }
@@ -806,10 +869,60 @@ void ArrayData::sort(ExecutionEngine *engine, Object *thisObject, const Value &c
     }
 
 
-    ArrayElementLessThan lessThan(engine, static_cast<const FunctionObject &>(comparefn));
+    // Copy the elements into a scratch array, which keeps them alive while the
+    // comparison function runs, and provides the merge buffer in its second half.
+    // Undefined values are not compared, they are moved to the end.
+    Heap::SimpleArrayData *d = thisObject->d()->arrayData.cast<Heap::SimpleArrayData>();
+    ScopedObject scratch(scope, engine->newArrayObject());
+    scratch->arrayReserve(2 * len);
+    Heap::SimpleArrayData *work = scratch->d()->arrayData.cast<Heap::SimpleArrayData>();
+    Value *values = work->values.values;
+    Value *buffer = values + len;
+    uint defined = 0;
+    for (uint i = 0; i < len; ++i) {
+        const Value &v = d->data(i);
+        if (!v.isUndefined())
+            values[defined++] = v;
+    }
+    for (uint i = defined; i < 2 * len; ++i)
+        values[i] = Value::undefinedValue();
+    work->values.size = 2 * len;
+
+    if (comparefn.isUndefined()) {
+        // The default order compares the string values of the elements. Convert every
+        // element once, instead of twice per comparison, and sort natively. For strings
+        // and numbers the conversion does not call back into JavaScript.
+        std::vector<std::pair<QString, uint>> keys;
+        keys.reserve(defined);
+        for (uint i = 0; i < defined; ++i) {
+            keys.emplace_back(values[i].toQString(), i);
+            if (engine->hasException)
+                return;
+        }
 
-    Value *begin = thisObject->arrayData()->values.values;
-    sortHelper(begin, begin + len, *begin, lessThan);
+        std::stable_sort(keys.begin(), keys.end(),
+                         [](const std::pair<QString, uint> &a, const std::pair<QString, uint> &b) {
+            return a.first < b.first;
+        });
+        for (uint i = 0; i < defined; ++i)
+            buffer[i] = values[keys[i].second];
+        std::copy(buffer, buffer + defined, values);
+    } else {
+        ArrayElementLessThan lessThan(engine, static_cast<const FunctionObject *>(&comparefn));
+        mergeSort(values, buffer, defined, lessThan);
+        if (engine->hasException)
+            return;
+    }
+
+    // The comparison function may have modified the array, in which case the
+    // sorted values are written back through the generic path.
+    if (thisObject->d()->arrayData == d && d->values.size >= len) {
+        for (uint i = 0; i < len; ++i)
+            d->setData(engine, i, values[i]);
+    } else {
+        for (uint i = 0; i < len; ++i)
+            thisObject->put(i, values[i]);
+    }
 
 #ifdef CHECK_SPARSE_ARRAYS
     thisObject->initSparseArray();
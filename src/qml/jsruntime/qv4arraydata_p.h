@@ -151,10 +151,10 @@ struct SparseArrayData : public ArrayData {
     }
 
     uint mappedIndex(uint index) const {
-        SparseArrayNode *n = sparse->findNode(index);
+        const uint *n = sparse->find(index);
         if (!n)
             return UINT_MAX;
-        return n->value;
+        return *n;
     }
 
     PropertyAttributes attributes(uint i) const {
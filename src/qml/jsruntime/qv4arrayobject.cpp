@@ -51,6 +51,9 @@
 #include <QtCore/qscopedvaluerollback.h>
 #include "qv4proxy_p.h"
 
+#include <limits>
+#include <vector>
+
 using namespace QV4;
 
 DEFINE_OBJECT_VTABLE(ArrayCtor);
@@ -616,40 +619,82 @@ ReturnedValue ArrayPrototype::method_join(const FunctionObject *b, const Value *
     if (!r2)
         return Encode(scope.engine->newString());
 
+    if (qint64(r4.length()) * (r2 - 1) > std::numeric_limits<int>::max())
+        return scope.engine->throwRangeError(QStringLiteral("Array.prototype.join: Invalid string length"));
+
+    // Densely stored arrays convert all elements first and write the result into
+    // a single preallocated buffer, instead of growing it once per element. Anything
+    // else, in particular sparse arrays with a huge length, is appended to the
+    // result element by element, so no storage per index is needed.
+    ArrayObject *a = instance->as<ArrayObject>();
+    const bool buffered = a && a->arrayData() && a->arrayType() == Heap::ArrayData::Simple
+            && r2 <= a->arrayData()->length();
+    std::vector<QString> elements;
+    if (buffered)
+        elements.reserve(r2);
     QString R;
 
-    // ### FIXME
-    if (ArrayObject *a = instance->as<ArrayObject>()) {
-        ScopedValue e(scope);
-        for (uint i = 0; i < a->getLength(); ++i) {
-            if (i)
-                R += r4;
-
-            e = a->get(i);
+    ScopedValue e(scope);
+    ScopedString name(scope);
+    for (quint32 k = 0; k < r2; ++k) {
+        if (a) {
+            // Converting an element can run arbitrary code, so check for
+            // plain simple storage before reading every element.
+            if (a->arrayData() && a->arrayType() == Heap::ArrayData::Simple
+                && !a->arrayData()->attrs() && !a->protoHasArray()) {
+                Heap::SimpleArrayData *sa = a->d()->arrayData.cast<Heap::SimpleArrayData>();
+                e = k < sa->values.size ? sa->data(k) : Value::undefinedValue();
+                if (e->isEmpty())
+                    e = Encode::undefined();
+            } else {
+                e = a->get(k);
+                CHECK_EXCEPTION();
+            }
+        } else {
+            //
+            // crazy!
+            //
+            name = Value::fromDouble(k).toString(scope.engine);
+            e = instance->get(name);
             CHECK_EXCEPTION();
-            if (!e->isNullOrUndefined())
-                R += e->toQString();
         }
-    } else {
-        //
-        // crazy!
-        //
-        ScopedString name(scope, scope.engine->newString(QStringLiteral("0")));
-        ScopedValue r6(scope, instance->get(name));
-        if (!r6->isNullOrUndefined())
-            R = r6->toQString();
-
-        ScopedValue r12(scope);
-        for (quint32 k = 1; k < r2; ++k) {
-            R += r4;
 
-            name = Value::fromDouble(k).toString(scope.engine);
-            r12 = instance->get(name);
+        QString element;
+        if (!e->isNullOrUndefined()) {
+            element = e->toQString();
             CHECK_EXCEPTION();
+        }
 
-            if (!r12->isNullOrUndefined())
-                R += r12->toQString();
+        if (buffered) {
+            elements.push_back(std::move(element));
+            continue;
         }
+        if (qint64(R.length()) + (k ? r4.length() : 0) + element.length() > std::numeric_limits<int>::max())
+            return scope.engine->throwRangeError(QStringLiteral("Array.prototype.join: Invalid string length"));
+        if (k)
+            R += r4;
+        R += element;
+    }
+
+    if (!buffered)
+        return Encode(scope.engine->newString(R));
+
+    qint64 totalLength = qint64(r4.length()) * qint64(elements.size() - 1);
+    for (const QString &element : elements)
+        totalLength += element.length();
+    if (totalLength > std::numeric_limits<int>::max())
+        return scope.engine->throwRangeError(QStringLiteral("Array.prototype.join: Invalid string length"));
+
+    R = QString(int(totalLength), Qt::Uninitialized);
+    QChar *ch = R.data();
+    for (size_t i = 0; i < elements.size(); ++i) {
+        if (i) {
+            memcpy(static_cast<void *>(ch), r4.constData(), r4.length() * sizeof(QChar));
+            ch += r4.length();
+        }
+        const QString &element = elements[i];
+        memcpy(static_cast<void *>(ch), element.constData(), element.length() * sizeof(QChar));
+        ch += element.length();
     }
 
     return Encode(scope.engine->newString(R));
@@ -1047,6 +1092,24 @@ ReturnedValue ArrayPrototype::method_includes(const FunctionObject *b, const Val
         }
     }
 
+    if (instance->arrayData() && instance->arrayType() == Heap::ArrayData::Simple
+        && !instance->isStringObject() && !ArgumentsObject::isNonStrictArgumentsObject(instance)
+        && !instance->protoHasArray()) {
+        // Read the elements directly. Holes and everything past the stored
+        // elements read as undefined, as nothing in the prototype chain can
+        // provide indexed properties.
+        Heap::SimpleArrayData *sa = instance->d()->arrayData.cast<Heap::SimpleArrayData>();
+        const qint64 size = qMin(len, qint64(sa->values.size));
+        for (; k < size; ++k) {
+            Value value = sa->data(uint(k));
+            if (value.isEmpty())
+                value = Value::undefinedValue();
+            if (value.sameValueZero(argv[0]))
+                return Encode(true);
+        }
+        return Encode(k < len && argv[0].isUndefined());
+    }
+
     while (k < len) {
         ScopedValue val(scope, instance->get(k));
         if (val->sameValueZero(argv[0])) {
@@ -1168,6 +1231,19 @@ ReturnedValue ArrayPrototype::method_lastIndexOf(const FunctionObject *b, const
         fromIndex = (uint) f + 1;
     }
 
+    if (instance->arrayData() && instance->arrayType() == Heap::ArrayData::Simple
+        && !instance->isStringObject() && !ArgumentsObject::isNonStrictArgumentsObject(instance)
+        && !instance->protoHasArray()) {
+        Heap::SimpleArrayData *sa = instance->d()->arrayData.cast<Heap::SimpleArrayData>();
+        for (uint k = qMin(fromIndex, sa->values.size); k > 0;) {
+            --k;
+            const Value &value = sa->data(k);
+            if (!value.isEmpty() && RuntimeHelpers::strictEqual(value, searchValue))
+                return Encode(k);
+        }
+        return Encode(-1);
+    }
+
     ScopedValue v(scope);
     for (uint k = fromIndex; k > 0;) {
         --k;
@@ -1240,6 +1316,24 @@ ReturnedValue ArrayPrototype::method_fill(const FunctionObject *b, const Value *
         fin = std::min(uint(relativeEnd), len);
     }
 
+    if (k < fin && instance->isArrayObject() && instance->arrayType() == Heap::ArrayData::Simple
+        && (!instance->arrayData() || !instance->arrayData()->attrs())
+        && instance->isExtensible() && !instance->protoHasArray()) {
+        // Every index in the range is, or becomes, a plain writable data property,
+        // so the elements can be stored directly. Only extend the storage when that
+        // does not leave holes, so sparse fills keep using sparse storage.
+        const uint size = instance->arrayData() ? instance->arrayData()->length() : 0;
+        if (k <= size) {
+            instance->arrayReserve(fin);
+            Heap::SimpleArrayData *sa = instance->d()->arrayData.cast<Heap::SimpleArrayData>();
+            ScopedValue value(scope, argc ? argv[0] : Value::undefinedValue());
+            for (uint i = k; i < fin; ++i)
+                sa->setData(scope.engine, i, value);
+            sa->values.size = qMax(sa->values.size, fin);
+            return instance.asReturnedValue();
+        }
+    }
+
     while (k < fin) {
         instance->setIndexed(k, argv[0], QV4::Object::DoThrowOnRejection);
         k++;
@@ -650,6 +650,7 @@ ExecutionEngine::~ExecutionEngine()
     delete m_multiplyWrappedQObjects;
     m_multiplyWrappedQObjects = nullptr;
     delete identifierTable;
+    m_reactionHandler.reset();
     delete memoryManager;
 
     while (!compilationUnits.isEmpty())
@@ -923,6 +924,12 @@ Promise::ReactionHandler *ExecutionEngine::getPromiseReactionHandler()
     return m_reactionHandler.data();
 }
 
+void ExecutionEngine::drainPromiseReactions()
+{
+    if (m_reactionHandler)
+        m_reactionHandler->drain();
+}
+
 Heap::Object *ExecutionEngine::newURIErrorObject(const QString &message)
 {
     return ErrorObject::create<URIErrorObject>(this, message);
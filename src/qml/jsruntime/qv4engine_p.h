@@ -537,6 +537,16 @@ public:
     Heap::Object *newPromiseObject(const QV4::FunctionObject *thisObject, const QV4::PromiseCapability *capability);
     Promise::ReactionHandler *getPromiseReactionHandler();
 
+    // Runs all queued promise reactions once no JavaScript is executing anymore.
+    // Called after top-level calls into the engine, bindings and signal handlers.
+    void promiseReactionCheckpoint()
+    {
+        if (Q_UNLIKELY(hasPendingPromiseReactions) && !currentStackFrame)
+            drainPromiseReactions();
+    }
+    void drainPromiseReactions();
+    bool hasPendingPromiseReactions = false;
+
     Heap::Object *newVariantObject(const QVariant &v);
 
     Heap::Object *newForInIteratorObject(Object *o);
@@ -39,6 +39,11 @@
 
 #include "qv4estable_p.h"
 #include "qv4object_p.h"
+#include "qv4string_p.h"
+
+#include <QtCore/qhashfunctions.h>
+
+#include <algorithm>
 
 using namespace QV4;
 
@@ -46,31 +51,56 @@ using namespace QV4;
 // is a little different from most; it requires nonlinear access, and must also
 // preserve the order of insertion of items in a deterministic way.
 //
-// This class implements those requirements, except for fast access: that
-// will be addressed in a followup patch.
+// The entries are kept in insertion order in two arrays, and a separate open
+// addressing hash index maps keys to their entry. Removing an entry only marks
+// it as removed, so removal is O(1). Removed entries are dropped when the entry
+// arrays run out of space. Iterations don't keep an index into the arrays, but
+// the position of the next entry, which does not change when entries move.
+
+static const uint FreeBucket = UINT_MAX;
+
+// Keys that are the same according to SameValueZero must hash the same, so
+// strings hash by content and numbers by their double value.
+static uint hashKey(const Value &key)
+{
+    if (const String *s = key.stringValue())
+        return s->hashValue();
+    if (key.isManaged())
+        return qHash(quintptr(key.m()));
+    if (key.isNumber()) {
+        double d = key.asDouble();
+        if (std::isnan(d))
+            return 0;
+        return qHash(d); // 0 and -0 hash the same
+    }
+    return qHash(key.rawValue());
+}
 
 ESTable::ESTable()
-    : m_capacity(8)
 {
-    m_keys = (Value*)malloc(m_capacity * sizeof(Value));
-    m_values = (Value*)malloc(m_capacity * sizeof(Value));
-    memset(m_keys, 0, m_capacity);
-    memset(m_values, 0, m_capacity);
+    rehash(8);
 }
 
 ESTable::~ESTable()
 {
     free(m_keys);
     free(m_values);
+    free(m_positions);
+    free(m_index);
     m_size = 0;
+    m_used = 0;
     m_capacity = 0;
     m_keys = nullptr;
     m_values = nullptr;
+    m_positions = nullptr;
+    m_index = nullptr;
 }
 
 void ESTable::markObjects(MarkStack *s, bool isWeakMap)
 {
-    for (uint i = 0; i < m_size; ++i) {
+    for (uint i = 0; i < m_used; ++i) {
+        if (m_keys[i].isEmpty())
+            continue;
         if (!isWeakMap)
             m_keys[i].mark(s);
         m_values[i].mark(s);
@@ -78,30 +108,90 @@ void ESTable::markObjects(MarkStack *s, bool isWeakMap)
 }
 
 // Pretends that there's nothing in the table. Doesn't actually free memory, as
-// it will almost certainly be reused again anyway.
+// it will almost certainly be reused again anyway. Positions keep increasing, so
+// iterations that are in progress continue with entries added later.
 void ESTable::clear()
 {
     m_size = 0;
+    m_used = 0;
+    std::fill(m_index, m_index + m_indexMask + 1, FreeBucket);
+}
+
+// Returns the entry position of \a key, or UINT_MAX if it is not in the table.
+uint ESTable::find(const Value &key) const
+{
+    for (uint bucket = hashKey(key) & m_indexMask; ; bucket = (bucket + 1) & m_indexMask) {
+        const uint idx = m_index[bucket];
+        if (idx == FreeBucket)
+            return UINT_MAX;
+        if (!m_keys[idx].isEmpty() && m_keys[idx].sameValueZero(key))
+            return idx;
+    }
+}
+
+// Returns the index of the first entry at or after \a position.
+uint ESTable::indexOf(quint64 position) const
+{
+    if (!m_used || position <= m_positions[0])
+        return 0;
+    // Unless entries were dropped in between, the index follows from the distance
+    // to the first entry.
+    const quint64 guess = position - m_positions[0];
+    if (guess < m_used && m_positions[guess] == position)
+        return uint(guess);
+    return uint(std::lower_bound(m_positions, m_positions + m_used, position) - m_positions);
+}
+
+// Moves the remaining entries to the front of arrays of size \a capacity, and
+// rebuilds the index for them.
+void ESTable::rehash(uint capacity)
+{
+    Q_ASSERT(capacity >= m_size);
+
+    uint toIdx = 0;
+    for (uint idx = 0; idx < m_used; ++idx) {
+        if (m_keys[idx].isEmpty())
+            continue;
+        m_keys[toIdx] = m_keys[idx];
+        m_values[toIdx] = m_values[idx];
+        m_positions[toIdx] = m_positions[idx];
+        ++toIdx;
+    }
+    Q_ASSERT(toIdx == m_size);
+    m_used = m_size;
+
+    if (capacity != m_capacity) {
+        m_capacity = capacity;
+        m_keys = static_cast<Value *>(realloc(m_keys, m_capacity * sizeof(Value)));
+        m_values = static_cast<Value *>(realloc(m_values, m_capacity * sizeof(Value)));
+        m_positions = static_cast<quint64 *>(realloc(m_positions, m_capacity * sizeof(quint64)));
+        m_indexMask = 2 * m_capacity - 1;
+        free(m_index);
+        m_index = static_cast<uint *>(malloc((m_indexMask + 1) * sizeof(uint)));
+    }
+
+    std::fill(m_index, m_index + m_indexMask + 1, FreeBucket);
+    for (uint idx = 0; idx < m_used; ++idx) {
+        uint bucket = hashKey(m_keys[idx]) & m_indexMask;
+        while (m_index[bucket] != FreeBucket)
+            bucket = (bucket + 1) & m_indexMask;
+        m_index[bucket] = idx;
+    }
 }
 
 // Update the table to contain \a value for a given \a key. The key is
 // normalized, as required by the ES spec.
 void ESTable::set(const Value &key, const Value &value)
 {
-    for (uint i = 0; i < m_size; ++i) {
-        if (m_keys[i].sameValueZero(key)) {
-            m_values[i] = value;
-            return;
-        }
+    const uint existing = find(key);
+    if (existing != UINT_MAX) {
+        m_values[existing] = value;
+        return;
     }
 
-    if (m_capacity == m_size) {
-        uint oldCap = m_capacity;
-        m_capacity *= 2;
-        m_keys = (Value*)realloc(m_keys, m_capacity * sizeof(Value));
-        m_values = (Value*)realloc(m_values, m_capacity * sizeof(Value));
-        memset(m_keys + oldCap, 0, m_capacity - oldCap);
-        memset(m_values + oldCap, 0, m_capacity - oldCap);
+    if (m_used == m_capacity) {
+        // Only compact if that frees up a reasonable amount of space.
+        rehash(m_size < m_capacity / 2 ? m_capacity : 2 * m_capacity);
     }
 
     Value nk = key;
@@ -110,58 +200,49 @@ void ESTable::set(const Value &key, const Value &value)
             nk = Value::fromDouble(+0);
     }
 
-    m_keys[m_size] = nk;
-    m_values[m_size] = value;
-
+    const uint idx = m_used++;
+    m_keys[idx] = nk;
+    m_values[idx] = value;
+    m_positions[idx] = m_nextPosition++;
     m_size++;
+
+    // Buckets pointing to removed entries can be reused.
+    uint bucket = hashKey(nk) & m_indexMask;
+    while (m_index[bucket] != FreeBucket && !m_keys[m_index[bucket]].isEmpty())
+        bucket = (bucket + 1) & m_indexMask;
+    m_index[bucket] = idx;
 }
 
 // Returns true if the table contains \a key, false otherwise.
 bool ESTable::has(const Value &key) const
 {
-    for (uint i = 0; i < m_size; ++i) {
-        if (m_keys[i].sameValueZero(key))
-            return true;
-    }
-
-    return false;
+    return find(key) != UINT_MAX;
 }
 
 // Fetches the value for the given \a key, and if \a hasValue is passed in,
 // it is set depending on whether or not the given key was found.
 ReturnedValue ESTable::get(const Value &key, bool *hasValue) const
 {
-    for (uint i = 0; i < m_size; ++i) {
-        if (m_keys[i].sameValueZero(key)) {
-            if (hasValue)
-                *hasValue = true;
-            return m_values[i].asReturnedValue();
-        }
-    }
-
+    const uint idx = find(key);
     if (hasValue)
-        *hasValue = false;
-    return Encode::undefined();
+        *hasValue = idx != UINT_MAX;
+    if (idx == UINT_MAX)
+        return Encode::undefined();
+    return m_values[idx].asReturnedValue();
 }
 
 // Removes the given \a key from the table
 bool ESTable::remove(const Value &key)
 {
-    bool found = false;
-    uint idx = 0;
-    for (; idx < m_size; ++idx) {
-        if (m_keys[idx].sameValueZero(key)) {
-            found = true;
-            break;
-        }
-    }
+    const uint idx = find(key);
+    if (idx == UINT_MAX)
+        return false;
 
-    if (found == true) {
-        memmove(m_keys + idx, m_keys + idx + 1, (m_size - idx)*sizeof(Value));
-        memmove(m_values + idx, m_values + idx + 1, (m_size - idx)*sizeof(Value));
-        m_size--;
-    }
-    return found;
+    // The bucket stays in use, so that lookups keep probing past it.
+    m_keys[idx] = Value::emptyValue();
+    m_values[idx] = Value::undefinedValue();
+    m_size--;
+    return true;
 }
 
 // Returns the size of the table. Note that the size may not match the underlying allocation.
@@ -170,30 +251,37 @@ uint ESTable::size() const
     return m_size;
 }
 
-// Retrieves a key and value for a given \a idx, and places them in \a key and
-// \a value. They must be valid pointers.
-void ESTable::iterate(uint idx, Value *key, Value *value)
+// Retrieves the key and value of the first entry at or after \a position, and
+// places them in \a key and \a value. They must be valid pointers. \a position
+// is advanced past the entry. Returns false if there are no more entries.
+bool ESTable::iterate(quint64 *position, Value *key, Value *value) const
 {
-    Q_ASSERT(idx < m_size);
+    Q_ASSERT(position);
     Q_ASSERT(key);
     Q_ASSERT(value);
-    *key = m_keys[idx];
-    *value = m_values[idx];
+    for (uint idx = indexOf(*position); idx < m_used; ++idx) {
+        if (m_keys[idx].isEmpty())
+            continue;
+        *key = m_keys[idx];
+        *value = m_values[idx];
+        *position = m_positions[idx] + 1;
+        return true;
+    }
+    return false;
 }
 
 void ESTable::removeUnmarkedKeys()
 {
-    uint idx = 0;
-    uint toIdx = 0;
-    for (; idx < m_size; ++idx) {
+    for (uint idx = 0; idx < m_used; ++idx) {
+        if (m_keys[idx].isEmpty())
+            continue;
         Q_ASSERT(m_keys[idx].isObject());
         Object &o = static_cast<Object &>(m_keys[idx]);
-        if (o.d()->isMarked()) {
-            m_keys[toIdx] = m_keys[idx];
-            m_values[toIdx] = m_values[idx];
-            ++toIdx;
+        if (!o.d()->isMarked()) {
+            m_keys[idx] = Value::emptyValue();
+            m_values[idx] = Value::undefinedValue();
+            m_size--;
         }
     }
-    m_size = toIdx;
+    rehash(m_capacity);
 }
-
@@ -71,15 +71,32 @@ public:
     ReturnedValue get(const Value &k, bool *hasValue = nullptr) const;
     bool remove(const Value &k);
     uint size() const;
-    void iterate(uint idx, Value *k, Value *v);
+    uint capacity() const { return m_capacity; }
+    bool iterate(quint64 *position, Value *k, Value *v) const;
 
     void removeUnmarkedKeys();
 
 private:
+    uint find(const Value &k) const;
+    uint indexOf(quint64 position) const;
+    void rehash(uint capacity);
+
+    // Entries in insertion order. Removed entries keep their slot, with an
+    // empty key, until the table is compacted.
     Value *m_keys = nullptr;
     Value *m_values = nullptr;
+    // Iteration position of every entry. It is increasing in insertion order
+    // and never changes, so iterations can resume after a compaction.
+    quint64 *m_positions = nullptr;
+    quint64 m_nextPosition = 0;
     uint m_size = 0;
+    uint m_used = 0;
     uint m_capacity = 0;
+
+    // Open addressing hash index into the entries, with twice as many
+    // buckets as entry slots.
+    uint *m_index = nullptr;
+    uint m_indexMask = 0;
 };
 
 }
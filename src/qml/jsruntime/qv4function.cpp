@@ -72,13 +72,14 @@ ReturnedValue Function::call(const Value *thisObject, const Value *argv, int arg
     return result;
 }
 
-Function::Function(ExecutionEngine *engine, CompiledData::CompilationUnit *unit, const CompiledData::Function *function)
-    : compiledFunction(function)
+Function::Function(ExecutionEngine *engine, CompiledData::CompilationUnit *unit, uint index)
+    : compiledFunction(unit->data->functionAt(int(index)))
     , compilationUnit(unit)
-    , codeData(function->code())
+    , index(index)
+    , codeData(compiledFunction->code())
         , jittedCode(nullptr)
         , codeRef(nullptr)
-        , hasQmlDependencies(function->hasQmlDependencies())
+        , hasQmlDependencies(compiledFunction->hasQmlDependencies())
 {
     Scope scope(engine);
     Scoped<InternalClass> ic(scope, engine->internalClasses(EngineBase::Class_CallContext));
@@ -67,6 +67,8 @@ namespace QV4 {
 struct Q_QML_EXPORT Function {
     const CompiledData::Function *compiledFunction;
     CompiledData::CompilationUnit *compilationUnit;
+    // index in compilationUnit->runtimeFunctions
+    uint index;
 
     ReturnedValue call(const Value *thisObject, const Value *argv, int argc, const ExecutionContext *context);
 
@@ -83,7 +85,7 @@ struct Q_QML_EXPORT Function {
     bool hasQmlDependencies;
     bool isEval = false;
 
-    Function(ExecutionEngine *engine, CompiledData::CompilationUnit *unit, const CompiledData::Function *function);
+    Function(ExecutionEngine *engine, CompiledData::CompilationUnit *unit, uint index);
     ~Function();
 
     // used when dynamically assigning signal handlers (QQmlConnection)
@@ -98,6 +100,7 @@ struct Q_QML_EXPORT Function {
     inline bool isStrict() const { return compiledFunction->flags & CompiledData::Function::IsStrict; }
     inline bool isArrowFunction() const { return compiledFunction->flags & CompiledData::Function::IsArrowFunction; }
     inline bool isGenerator() const { return compiledFunction->flags & CompiledData::Function::IsGenerator; }
+    inline bool hasFixedQmlDependencies() const { return compiledFunction->flags & CompiledData::Function::HasFixedQmlDependencies; }
 
     QQmlSourceLocation sourceLocation() const;
 
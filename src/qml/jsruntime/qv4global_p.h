@@ -137,6 +137,14 @@ inline double trunc(double d) { return d > 0 ? floor(d) : ceil(d); }
 #define ENABLE_JIT 0
 #endif
 
+// JIT code can be stored on disk where the only absolute addresses in it are
+// patchable pointer loads, and where we can tell which module a function lives in.
+#if defined(V4_ENABLE_JIT) && !defined(V4_BOOTSTRAP) \
+    && (defined(Q_PROCESSOR_X86_64) || defined(Q_PROCESSOR_ARM_64)) \
+    && (defined(Q_OS_LINUX) || defined(Q_OS_MAC) || defined(Q_OS_WIN))
+#  define V4_ENABLE_JIT_CODE_CACHE
+#endif
+
 #if defined(Q_OS_QNX) && defined(_CPPLIB_VER)
 #include <math.h>
 #undef isnan
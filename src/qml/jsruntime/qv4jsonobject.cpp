@@ -51,6 +51,11 @@
 
 #include <qstack.h>
 #include <qstringlist.h>
+#include <qiodevice.h>
+#include <qvarlengtharray.h>
+#include <qalgorithms.h>
+#include <private/qsimd_p.h>
+#include "private/qlocale_tools_p.h"
 
 #include <wtf/MathExtras.h>
 
@@ -119,11 +124,34 @@ enum {
     EndObject = 0x7d,
     NameSeparator = 0x3a,
     ValueSeparator = 0x2c,
-    Quote = 0x22
+    Quote = 0x22,
+    Backslash = 0x5c
 };
 
 bool JsonParser::eatSpace()
 {
+    if (json < end && *json > Space)
+        return true;
+
+#ifdef __SSE2__
+    // Skip indentation in pretty printed JSON eight characters at a time.
+    const __m128i space = _mm_set1_epi16(Space);
+    const __m128i tab = _mm_set1_epi16(Tab);
+    const __m128i lineFeed = _mm_set1_epi16(LineFeed);
+    const __m128i carriageReturn = _mm_set1_epi16(Return);
+    while (end - json >= 8) {
+        const __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i *>(json));
+        const __m128i isSpace = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi16(chunk, space), _mm_cmpeq_epi16(chunk, tab)),
+                                             _mm_or_si128(_mm_cmpeq_epi16(chunk, lineFeed), _mm_cmpeq_epi16(chunk, carriageReturn)));
+        const uint mask = uint(_mm_movemask_epi8(isSpace));
+        if (mask != 0xffff) {
+            json += qCountTrailingZeroBits(~mask) / 2;
+            return true;
+        }
+        json += 8;
+    }
+#endif
+
     while (json < end) {
         if (*json > Space)
             break;
@@ -214,10 +242,13 @@ ReturnedValue JsonParser::parseObject()
     Scope scope(engine);
 
     ScopedObject o(scope, engine->newObject());
+    if (shapes.size() <= size_t(nestingLevel))
+        shapes.resize(nestingLevel + 1);
 
     QChar token = nextToken();
+    uint index = 0;
     while (token == Quote) {
-        if (!parseMember(o))
+        if (!parseMember(o, index++))
             return Encode::undefined();
         token = nextToken();
         if (token != ValueSeparator)
@@ -244,13 +275,32 @@ ReturnedValue JsonParser::parseObject()
 /*
     member = string name-separator value
 */
-bool JsonParser::parseMember(Object *o)
+bool JsonParser::parseMember(Object *o, uint index)
 {
     BEGIN << "parseMember";
     Scope scope(engine);
 
+    // If the object so far has the same keys as the last one at this
+    // nesting level, check whether the next key matches as well before
+    // decoding it.
+    Heap::InternalClass *nextClass = nullptr;
+    {
+        const std::vector<ShapeMember> &members = shapes.at(nestingLevel).members;
+        if (index < members.size()) {
+            const ShapeMember &member = members.at(index);
+            Heap::InternalClass *expected = index ? members.at(index - 1).internalClass
+                                                  : engine->classes[EngineBase::Class_Object];
+            const int length = member.name.length();
+            if (o->internalClass() == expected && end - json > length && json[length] == Quote
+                && !memcmp(static_cast<const void *>(json), static_cast<const void *>(member.name.constData()), length * sizeof(QChar))) {
+                json += length + 1;
+                nextClass = member.internalClass;
+            }
+        }
+    }
+
     QString key;
-    if (!parseString(&key))
+    if (!nextClass && !parseString(&key))
         return false;
     QChar token = nextToken();
     if (token != NameSeparator) {
@@ -261,13 +311,33 @@ bool JsonParser::parseMember(Object *o)
     if (!parseValue(val))
         return false;
 
+    if (nextClass) {
+        o->setInternalClass(nextClass);
+        o->setProperty(nextClass->size - 1, val);
+        END;
+        return true;
+    }
+
     ScopedString s(scope, engine->newString(key));
     PropertyKey skey = s->toPropertyKey();
     if (skey.isArrayIndex()) {
         o->put(skey.asArrayIndex(), val);
     } else {
+        Heap::InternalClass *previousClass = o->internalClass();
         // avoid trouble with properties named __proto__
         o->insertMember(s, val);
+
+        // Remember the key for the next object at this nesting level, unless
+        // its escaped form could differ from the decoded one.
+        Shape &shape = shapes.at(nestingLevel);
+        Heap::InternalClass *expected = index ? (index <= shape.members.size() ? shape.members.at(index - 1).internalClass : nullptr)
+                                              : engine->classes[EngineBase::Class_Object];
+        if (previousClass == expected && o->internalClass()->size == index + 1
+            && !key.contains(QLatin1Char(Backslash)) && !key.contains(QLatin1Char(Quote))) {
+            shape.members.resize(index);
+            shape.members.push_back({ key, skey, o->internalClass() });
+            shape.lastClass.set(engine, o->internalClass());
+        }
     }
 
     END;
@@ -441,25 +511,44 @@ bool JsonParser::parseNumber(Value *val)
 
     const QChar *start = json;
     bool isInt = true;
+    bool isNegative = false;
+    // integers with up to 9 digits are accumulated directly
+    int intValue = 0;
+    int intDigits = 0;
 
     // minus
-    if (json < end && *json == '-')
+    if (json < end && *json == '-') {
+        isNegative = true;
         ++json;
+    }
 
     // int = zero / ( digit1-9 *DIGIT )
     if (json < end && *json == '0') {
+        ++intDigits;
         ++json;
     } else {
-        while (json < end && *json >= '0' && *json <= '9')
+        while (json < end && *json >= '0' && *json <= '9') {
+            if (++intDigits <= 9)
+                intValue = intValue * 10 + (json->unicode() - '0');
             ++json;
+        }
+    }
+    if (!intDigits) {
+        lastError = QJsonParseError::IllegalNumber;
+        return false;
     }
 
     // frac = decimal-point 1*DIGIT
     if (json < end && *json == '.') {
         isInt = false;
         ++json;
+        const QChar *digits = json;
         while (json < end && *json >= '0' && *json <= '9')
             ++json;
+        if (json == digits) {
+            lastError = QJsonParseError::IllegalNumber;
+            return false;
+        }
     }
 
     // exp = e [ minus / plus ] 1*DIGIT
@@ -468,28 +557,35 @@ bool JsonParser::parseNumber(Value *val)
         ++json;
         if (json < end && (*json == '-' || *json == '+'))
             ++json;
+        const QChar *digits = json;
         while (json < end && *json >= '0' && *json <= '9')
             ++json;
+        if (json == digits) {
+            lastError = QJsonParseError::IllegalNumber;
+            return false;
+        }
     }
 
-    QString number(start, json - start);
-    DEBUG << "numberstring" << number;
-
-    if (isInt) {
-        bool ok;
-        int n = number.toInt(&ok);
-        if (ok && n < (1<<25) && n > -(1<<25)) {
-            *val = Value::fromInt32(n);
-            END;
-            return true;
-        }
+    // -0 is not an int
+    if (isInt && intDigits <= 9 && (intValue || !isNegative)) {
+        *val = Value::fromInt32(isNegative ? -intValue : intValue);
+        END;
+        return true;
     }
 
+    // The number was validated above, so it consists of ASCII characters only.
+    const int length = int(json - start);
+    QVarLengthArray<char, 64> number(length + 1);
+    for (int i = 0; i < length; ++i)
+        number[i] = char(start[i].unicode());
+    number[length] = '\0';
+    DEBUG << "numberstring" << number.constData();
+
     bool ok;
-    double d;
-    d = number.toDouble(&ok);
+    const char *numberEnd = nullptr;
+    double d = qstrtod(number.constData(), &numberEnd, &ok);
 
-    if (!ok) {
+    if (numberEnd != number.constData() + length) {
         lastError = QJsonParseError::IllegalNumber;
         return false;
     }
@@ -580,11 +676,48 @@ static inline bool scanEscapeSequence(const QChar *&json, const QChar *end, uint
 }
 
 
+// Returns the end of the run of characters starting at json that need no
+// decoding, i.e. the next quote, backslash or control character.
+static inline const QChar *scanUnescaped(const QChar *json, const QChar *end)
+{
+#ifdef __SSE2__
+    const __m128i quote = _mm_set1_epi16(Quote);
+    const __m128i backslash = _mm_set1_epi16(Backslash);
+    const __m128i space = _mm_set1_epi16(Space);
+    const __m128i zero = _mm_setzero_si128();
+    while (end - json >= 8) {
+        const __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i *>(json));
+        const __m128i special = _mm_or_si128(_mm_cmpeq_epi16(chunk, quote), _mm_cmpeq_epi16(chunk, backslash));
+        // the saturated difference is zero for everything but control characters
+        const __m128i printable = _mm_cmpeq_epi16(_mm_subs_epu16(space, chunk), zero);
+        const uint mask = uint(_mm_movemask_epi8(special)) | (~uint(_mm_movemask_epi8(printable)) & 0xffff);
+        if (mask)
+            return json + qCountTrailingZeroBits(mask) / 2;
+        json += 8;
+    }
+#endif
+    while (json < end) {
+        const ushort c = json->unicode();
+        if (c == Quote || c == Backslash || c < Space)
+            break;
+        ++json;
+    }
+    return json;
+}
+
 bool JsonParser::parseString(QString *string)
 {
     BEGIN << "parse string stringPos=" << json;
 
     while (json < end) {
+        const QChar *run = scanUnescaped(json, end);
+        if (run != json) {
+            string->append(json, int(run - json));
+            json = run;
+            if (json == end)
+                break;
+        }
+
         if (*json == '"')
             break;
         else if (*json == '\\') {
@@ -599,12 +732,9 @@ bool JsonParser::parseString(QString *string)
                 *string += QChar(ch);
             }
         } else {
-            if (json->unicode() <= 0x1f) {
-                lastError = QJsonParseError::IllegalEscapeSequence;
-                return false;
-            }
-            *string += *json;
-            ++json;
+            // control character
+            lastError = QJsonParseError::IllegalEscapeSequence;
+            return false;
         }
     }
     ++json;
@@ -629,6 +759,14 @@ struct Stringify
     QString indent;
     QStack<Object *> stack;
 
+    // Everything is appended to result. With a device, the result is written
+    // out in chunks between members, so it never holds the complete text.
+    QString result;
+    QIODevice *device;
+    bool writeFailed;
+
+    enum { ChunkSize = 64 * 1024 };
+
     bool stackContains(Object *o) {
         for (int i = 0; i < stack.size(); ++i)
             if (stack.at(i)->d() == o->d())
@@ -636,60 +774,89 @@ struct Stringify
         return false;
     }
 
-    Stringify(ExecutionEngine *e) : v4(e), replacerFunction(nullptr), propertyList(nullptr), propertyListSize(0) {}
+    Stringify(ExecutionEngine *e, QIODevice *device = nullptr)
+        : v4(e), replacerFunction(nullptr), propertyList(nullptr), propertyListSize(0)
+        , device(device), writeFailed(false)
+    {
+        if (device)
+            result.reserve(2 * ChunkSize);
+    }
 
-    QString Str(const QString &key, const Value &v);
-    QString JA(Object *a);
-    QString JO(Object *o);
+    bool Str(const QString &key, const Value &v);
+    void JA(Object *a);
+    void JO(Object *o);
 
-    QString makeMember(const QString &key, const Value &v);
+    ReturnedValue prepare(const QString &key, const Value &v);
+    static bool isSerializable(const Value &value);
+    void write(const Value &value);
+    void quote(const QString &str);
+    void newLine(const QString &indentation);
+    void flush(bool force = false);
 };
 
-static QString quote(const QString &str)
+void Stringify::quote(const QString &str)
 {
-    QString product;
     const int length = str.length();
-    product.reserve(length + 2);
-    product += QLatin1Char('"');
+    result.reserve(result.length() + length + 2);
+    result += QLatin1Char('"');
+    const QChar *begin = str.constData();
+    const QChar *plain = begin;
     for (int i = 0; i < length; ++i) {
-        QChar c = str.at(i);
-        switch (c.unicode()) {
+        const ushort c = begin[i].unicode();
+        if (c > 0x1f && c != '"' && c != '\\')
+            continue;
+        result.append(plain, int(begin + i - plain));
+        plain = begin + i + 1;
+        switch (c) {
         case '"':
-            product += QLatin1String("\\\"");
+            result += QLatin1String("\\\"");
             break;
         case '\\':
-            product += QLatin1String("\\\\");
+            result += QLatin1String("\\\\");
             break;
         case '\b':
-            product += QLatin1String("\\b");
+            result += QLatin1String("\\b");
             break;
         case '\f':
-            product += QLatin1String("\\f");
+            result += QLatin1String("\\f");
             break;
         case '\n':
-            product += QLatin1String("\\n");
+            result += QLatin1String("\\n");
             break;
         case '\r':
-            product += QLatin1String("\\r");
+            result += QLatin1String("\\r");
             break;
         case '\t':
-            product += QLatin1String("\\t");
+            result += QLatin1String("\\t");
             break;
         default:
-            if (c.unicode() <= 0x1f) {
-                product += QLatin1String("\\u00");
-                product += (c.unicode() > 0xf ? QLatin1Char('1') : QLatin1Char('0')) +
-                        QLatin1Char("0123456789abcdef"[c.unicode() & 0xf]);
-            } else {
-                product += c;
-            }
+            result += QLatin1String("\\u00");
+            result += (c > 0xf ? QLatin1Char('1') : QLatin1Char('0'));
+            result += QLatin1Char("0123456789abcdef"[c & 0xf]);
         }
     }
-    product += QLatin1Char('"');
-    return product;
+    result.append(plain, int(begin + length - plain));
+    result += QLatin1Char('"');
+}
+
+void Stringify::newLine(const QString &indentation)
+{
+    result += QLatin1Char('\n');
+    result += indentation;
+}
+
+void Stringify::flush(bool force)
+{
+    if (!device || writeFailed || (!force && result.length() < ChunkSize))
+        return;
+    // Chunks end between members, so they never split a surrogate pair.
+    const QByteArray utf8 = result.toUtf8();
+    if (device->write(utf8) != utf8.size())
+        writeFailed = true;
+    result.resize(0);
 }
 
-QString Stringify::Str(const QString &key, const Value &v)
+ReturnedValue Stringify::prepare(const QString &key, const Value &v)
 {
     Scope scope(v4);
 
@@ -726,152 +893,156 @@ QString Stringify::Str(const QString &key, const Value &v)
             value = Encode(b->value());
     }
 
-    if (value->isNull())
-        return QStringLiteral("null");
-    if (value->isBoolean())
-        return value->booleanValue() ? QStringLiteral("true") : QStringLiteral("false");
-    if (value->isString())
-        return quote(value->stringValue()->toQString());
-
-    if (value->isNumber()) {
-        double d = value->toNumber();
-        return std::isfinite(d) ? value->toQString() : QStringLiteral("null");
-    }
+    return value->asReturnedValue();
+}
 
-    if (const QV4::VariantObject *v = value->as<QV4::VariantObject>()) {
-        return quote(v->d()->data().toString());
-    }
+bool Stringify::isSerializable(const Value &value)
+{
+    if (value.isNull() || value.isBoolean() || value.isString() || value.isNumber())
+        return true;
+    if (const Object *o = value.as<Object>())
+        return !o->as<FunctionObject>();
+    return false;
+}
 
-    o = value->asReturnedValue();
-    if (o) {
-        if (!o->as<FunctionObject>()) {
-            if (o->isArrayLike()) {
-                return JA(o.getPointer());
-            } else {
-                return JO(o);
-            }
-        }
+void Stringify::write(const Value &value)
+{
+    Q_ASSERT(isSerializable(value));
+
+    if (value.isNull()) {
+        result += QLatin1String("null");
+    } else if (value.isBoolean()) {
+        result += value.booleanValue() ? QLatin1String("true") : QLatin1String("false");
+    } else if (value.isString()) {
+        quote(value.stringValue()->toQString());
+    } else if (value.isNumber()) {
+        double d = value.toNumber();
+        if (std::isfinite(d))
+            result += value.toQString();
+        else
+            result += QLatin1String("null");
+    } else if (const QV4::VariantObject *v = value.as<QV4::VariantObject>()) {
+        quote(v->d()->data().toString());
+    } else {
+        Scope scope(v4);
+        ScopedObject o(scope, value);
+        if (o->isArrayLike())
+            JA(o);
+        else
+            JO(o);
     }
-
-    return QString();
 }
 
-QString Stringify::makeMember(const QString &key, const Value &v)
+bool Stringify::Str(const QString &key, const Value &v)
 {
-    QString strP = Str(key, v);
-    if (!strP.isEmpty()) {
-        QString member = quote(key) + QLatin1Char(':');
-        if (!gap.isEmpty())
-            member += QLatin1Char(' ');
-        member += strP;
-        return member;
-    }
-    return QString();
+    Scope scope(v4);
+    ScopedValue value(scope, prepare(key, v));
+    if (v4->hasException || !isSerializable(value))
+        return false;
+    write(value);
+    return true;
 }
 
-QString Stringify::JO(Object *o)
+void Stringify::JO(Object *o)
 {
     if (stackContains(o)) {
         v4->throwTypeError();
-        return QString();
+        return;
     }
 
     Scope scope(v4);
 
-    QString result;
     stack.push(o);
     QString stepback = indent;
     indent += gap;
 
-    QStringList partial;
+    result += QLatin1Char('{');
+    bool empty = true;
+    auto writeMember = [&](const QString &key, const Value &v) {
+        Scope memberScope(v4);
+        ScopedValue value(memberScope, prepare(key, v));
+        if (v4->hasException || !isSerializable(value))
+            return;
+        if (!empty)
+            result += QLatin1Char(',');
+        empty = false;
+        if (!gap.isEmpty())
+            newLine(indent);
+        quote(key);
+        result += QLatin1Char(':');
+        if (!gap.isEmpty())
+            result += QLatin1Char(' ');
+        write(value);
+        flush();
+    };
+
     if (!propertyListSize) {
         ObjectIterator it(scope, o, ObjectIterator::EnumerableOnly);
         ScopedValue name(scope);
 
         ScopedValue val(scope);
-        while (1) {
+        while (!v4->hasException) {
             name = it.nextPropertyNameAsString(val);
             if (name->isNull())
                 break;
-            QString key = name->toQString();
-            QString member = makeMember(key, val);
-            if (!member.isEmpty())
-                partial += member;
+            writeMember(name->toQString(), val);
         }
     } else {
         ScopedValue v(scope);
-        for (int i = 0; i < propertyListSize; ++i) {
+        for (int i = 0; i < propertyListSize && !v4->hasException; ++i) {
             bool exists;
             String *s = propertyList + i;
-            if (!s)
+            if (!s->m())
                 continue;
             v = o->get(s, &exists);
             if (!exists)
                 continue;
-            QString member = makeMember(s->toQString(), v);
-            if (!member.isEmpty())
-                partial += member;
+            writeMember(s->toQString(), v);
         }
     }
 
-    if (partial.isEmpty()) {
-        result = QStringLiteral("{}");
-    } else if (gap.isEmpty()) {
-        result = QLatin1Char('{') + partial.join(QLatin1Char(',')) + QLatin1Char('}');
-    } else {
-        QString separator = QLatin1String(",\n") + indent;
-        result = QLatin1String("{\n") + indent + partial.join(separator) + QLatin1Char('\n')
-                 + stepback + QLatin1Char('}');
-    }
+    if (!empty && !gap.isEmpty())
+        newLine(stepback);
+    result += QLatin1Char('}');
 
     indent = stepback;
     stack.pop();
-    return result;
 }
 
-QString Stringify::JA(Object *a)
+void Stringify::JA(Object *a)
 {
     if (stackContains(a)) {
         v4->throwTypeError();
-        return QString();
+        return;
     }
 
     Scope scope(a->engine());
 
-    QString result;
     stack.push(a);
     QString stepback = indent;
     indent += gap;
 
-    QStringList partial;
+    result += QLatin1Char('[');
     uint len = a->getLength();
     ScopedValue v(scope);
-    for (uint i = 0; i < len; ++i) {
+    for (uint i = 0; i < len && !v4->hasException; ++i) {
+        if (i)
+            result += QLatin1Char(',');
+        if (!gap.isEmpty())
+            newLine(indent);
         bool exists;
         v = a->get(i, &exists);
-        if (!exists) {
-            partial += QStringLiteral("null");
-            continue;
-        }
-        QString strP = Str(QString::number(i), v);
-        if (!strP.isEmpty())
-            partial += strP;
-        else
-            partial += QStringLiteral("null");
+        if (!exists || !Str(QString::number(i), v))
+            result += QLatin1String("null");
+        flush();
     }
 
-    if (partial.isEmpty()) {
-        result = QStringLiteral("[]");
-    } else if (gap.isEmpty()) {
-        result = QLatin1Char('[') + partial.join(QLatin1Char(',')) + QLatin1Char(']');
-    } else {
-        QString separator = QLatin1String(",\n") + indent;
-        result = QLatin1String("[\n") + indent + partial.join(separator) + QLatin1Char('\n') + stepback + QLatin1Char(']');
-    }
+    if (len && !gap.isEmpty())
+        newLine(stepback);
+    result += QLatin1Char(']');
 
     indent = stepback;
     stack.pop();
-    return result;
 }
 
 
@@ -918,6 +1089,7 @@ ReturnedValue JsonObject::method_stringify(const FunctionObject *b, const Value
         if (o->isArrayObject()) {
             uint arrayLen = o->getLength();
             stringify.propertyList = static_cast<QV4::String *>(scope.alloc(arrayLen));
+            stringify.propertyListSize = int(arrayLen);
             for (uint i = 0; i < arrayLen; ++i) {
                 Value *v = stringify.propertyList + i;
                 *v = o->get(i);
@@ -926,8 +1098,9 @@ ReturnedValue JsonObject::method_stringify(const FunctionObject *b, const Value
                 if (!v->isString()) {
                     v->setM(nullptr);
                 } else {
+                    // Keys converted from numbers are new strings, so compare the contents.
                     for (uint j = 0; j <i; ++j) {
-                        if (stringify.propertyList[j].m() == v->m()) {
+                        if (stringify.propertyList[j].m() && stringify.propertyList[j].isEqualTo(v->stringValue())) {
                             v->setM(nullptr);
                             break;
                         }
@@ -951,10 +1124,19 @@ ReturnedValue JsonObject::method_stringify(const FunctionObject *b, const Value
 
 
     ScopedValue arg0(scope, argc ? argv[0] : Value::undefinedValue());
-    QString result = stringify.Str(QString(), arg0);
-    if (result.isEmpty() || scope.engine->hasException)
+    if (!stringify.Str(QString(), arg0) || scope.engine->hasException)
         RETURN_UNDEFINED();
-    return Encode(scope.engine->newString(result));
+    return Encode(scope.engine->newString(stringify.result));
+}
+
+bool JsonObject::stringify(ExecutionEngine *engine, const Value &value, const QString &gap, QIODevice *device)
+{
+    Stringify stringify(engine, device);
+    stringify.gap = gap.left(10);
+    if (!stringify.Str(QString(), value) || engine->hasException)
+        return false;
+    stringify.flush(true);
+    return !stringify.writeFailed;
 }
 
 
@@ -51,14 +51,19 @@
 //
 
 #include "qv4object_p.h"
+#include "qv4persistent_p.h"
 #include <qjsonarray.h>
 #include <qjsonobject.h>
 #include <qjsonvalue.h>
 #include <qjsondocument.h>
 #include <qhash.h>
 
+#include <vector>
+
 QT_BEGIN_NAMESPACE
 
+class QIODevice;
+
 namespace QV4 {
 
 namespace Heap {
@@ -95,6 +100,8 @@ public:
     static ReturnedValue fromJsonObject(ExecutionEngine *engine, const QJsonObject &object);
     static ReturnedValue fromJsonArray(ExecutionEngine *engine, const QJsonArray &array);
 
+    static bool stringify(ExecutionEngine *engine, const Value &value, const QString &gap, QIODevice *device);
+
     static inline QJsonValue toJsonValue(const QV4::Value &value)
     { V4ObjectSet visitedObjects; return toJsonValue(value, visitedObjects); }
     static inline QJsonObject toJsonObject(const QV4::Object *o)
@@ -122,11 +129,25 @@ private:
 
     ReturnedValue parseObject();
     ReturnedValue parseArray();
-    bool parseMember(Object *o);
+    bool parseMember(Object *o, uint index);
     bool parseString(QString *string);
     bool parseValue(Value *val);
     bool parseNumber(Value *val);
 
+    struct ShapeMember {
+        QString name;
+        PropertyKey key;
+        Heap::InternalClass *internalClass;
+    };
+
+    // The keys of the last object parsed at a nesting level, and the
+    // internal class after each of them. Objects in arrays usually have
+    // the same keys, so the next object can skip the transitions.
+    struct Shape {
+        std::vector<ShapeMember> members;
+        PersistentValue lastClass; // keeps the classes of all members alive
+    };
+
     ExecutionEngine *engine;
     const QChar *head;
     const QChar *json;
@@ -134,6 +155,7 @@ private:
 
     int nestingLevel;
     QJsonParseError::ParseError lastError;
+    std::vector<Shape> shapes;
 };
 
 }
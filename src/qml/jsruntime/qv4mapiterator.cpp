@@ -64,7 +64,7 @@ ReturnedValue MapIteratorPrototype::method_next(const FunctionObject *b, const V
         return scope.engine->throwTypeError(QLatin1String("Not a Map Iterator instance"));
 
     Scoped<MapObject> s(scope, thisObject->d()->iteratedMap);
-    uint index = thisObject->d()->mapNextIndex;
+    quint64 position = thisObject->d()->mapNextPosition;
     IteratorKind itemKind = thisObject->d()->iterationKind;
 
     if (!s) {
@@ -74,9 +74,8 @@ ReturnedValue MapIteratorPrototype::method_next(const FunctionObject *b, const V
 
     Value *arguments = scope.alloc(2);
 
-    while (index < s->d()->esTable->size()) {
-        s->d()->esTable->iterate(index, &arguments[0], &arguments[1]);
-        thisObject->d()->mapNextIndex = index + 1;
+    while (s->d()->esTable->iterate(&position, &arguments[0], &arguments[1])) {
+        thisObject->d()->mapNextPosition = position;
 
         ScopedValue result(scope);
 
@@ -307,9 +307,8 @@ ReturnedValue MapPrototype::method_forEach(const FunctionObject *b, const Value
 
     Value *arguments = scope.alloc(3);
     arguments[2] = that;
-    for (uint i = 0; i < that->d()->esTable->size(); ++i) {
-        that->d()->esTable->iterate(i, &arguments[1], &arguments[0]); // fill in key (0), value (1)
-
+    quint64 position = 0;
+    while (that->d()->esTable->iterate(&position, &arguments[1], &arguments[0])) { // fill in key (0), value (1)
         callbackfn->call(thisArg, arguments, 3);
         CHECK_EXCEPTION();
     }
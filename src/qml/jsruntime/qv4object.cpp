@@ -320,17 +320,16 @@ bool Object::virtualDeleteProperty(Managed *m, PropertyKey id)
 PropertyKey ObjectOwnPropertyKeyIterator::next(const Object *o, Property *pd, PropertyAttributes *attrs)
 {
     if (arrayIndex != UINT_MAX && o->arrayData()) {
-        if (!arrayIndex)
-            arrayNode = o->sparseBegin();
-
         // sparse arrays
-        if (arrayNode) {
-            while (arrayNode != o->sparseEnd()) {
-                uint k = arrayNode->key();
-                uint pidx = arrayNode->value;
-                Heap::SparseArrayData *sa = o->d()->arrayData.cast<Heap::SparseArrayData>();
+        if (o->arrayType() == Heap::ArrayData::Sparse) {
+            // look the position up again on every step, so that modifications of the
+            // array during the iteration can't leave us with a dangling position
+            Heap::SparseArrayData *sa = o->d()->arrayData.cast<Heap::SparseArrayData>();
+            SparseArray::ConstIterator it = sa->sparse->lowerBound(arrayIndex);
+            if (it != sa->sparse->end()) {
+                uint k = it.key();
+                uint pidx = it.value();
                 const Property *p = reinterpret_cast<const Property *>(sa->values.data() + pidx);
-                arrayNode = arrayNode->nextNode();
                 PropertyAttributes a = sa->attrs ? sa->attrs[pidx] : Attr_Data;
                 arrayIndex = k + 1;
                 if (pd)
@@ -339,7 +338,6 @@ PropertyKey ObjectOwnPropertyKeyIterator::next(const Object *o, Property *pd, Pr
                     *attrs = a;
                 return PropertyKey::fromArrayIndex(k);
             }
-            arrayNode = nullptr;
             arrayIndex = UINT_MAX;
         }
         // dense arrays
@@ -87,18 +87,6 @@ namespace Promise {
 
 const int PROMISE_REACTION_EVENT = QEvent::registerEventType();
 
-struct ReactionEvent : public QEvent
-{
-    ReactionEvent(ExecutionEngine *e, const Value *reaction_, const Value *resolution_)
-            : QEvent(QEvent::Type(PROMISE_REACTION_EVENT)),
-              reaction{e, *reaction_},
-              resolution{e, *resolution_}
-    {}
-
-    QV4::PersistentValue reaction;
-    QV4::PersistentValue resolution;
-};
-
 } // namespace Promise
 } // namespace QV4
 QT_END_NAMESPACE
@@ -112,7 +100,36 @@ ReactionHandler::~ReactionHandler()
 
 void ReactionHandler::addReaction(ExecutionEngine *e, const Value *reaction, const Value *value)
 {
-    QCoreApplication::postEvent(this, new ReactionEvent(e, reaction, value));
+    m_queue.append(Reaction(e, *reaction, *value));
+    e->hasPendingPromiseReactions = true;
+
+    if (!m_drainEventPosted) {
+        m_drainEventPosted = true;
+        QCoreApplication::postEvent(this, new QEvent(QEvent::Type(PROMISE_REACTION_EVENT)));
+    }
+}
+
+void ReactionHandler::drain()
+{
+    if (m_draining)
+        return;
+    m_draining = true;
+
+    // Reactions queued while draining are run in the same pass, so a chain of
+    // .then() calls completes without going back to the event loop.
+    ExecutionEngine *engine = nullptr;
+    QVector<Reaction> queue;
+    while (!m_queue.isEmpty()) {
+        queue.swap(m_queue);
+        engine = queue.constFirst().reaction.engine();
+        for (const Reaction &reaction : qAsConst(queue))
+            executeReaction(reaction);
+        queue.clear();
+    }
+    if (engine)
+        engine->hasPendingPromiseReactions = false;
+
+    m_draining = false;
 }
 
 void ReactionHandler::customEvent(QEvent *event)
@@ -120,19 +137,21 @@ void ReactionHandler::customEvent(QEvent *event)
     if (event)
     {
         const int type = event->type();
-        if (type == PROMISE_REACTION_EVENT)
-            executeReaction(static_cast<ReactionEvent*>(event));
+        if (type == PROMISE_REACTION_EVENT) {
+            m_drainEventPosted = false;
+            drain();
+        }
     }
 }
 
-void ReactionHandler::executeReaction(ReactionEvent *event)
+void ReactionHandler::executeReaction(const Reaction &reaction)
 {
-    Scope scope(event->reaction.engine());
+    Scope scope(reaction.reaction.engine());
 
-    Scoped<QV4::PromiseReaction> ro(scope, event->reaction.as<QV4::PromiseReaction>());
+    Scoped<QV4::PromiseReaction> ro(scope, reaction.reaction.as<QV4::PromiseReaction>());
     Scoped<QV4::PromiseCapability> capability(scope, ro->d()->capability);
 
-    ScopedValue resolution(scope, event->resolution.value());
+    ScopedValue resolution(scope, reaction.resolution.value());
     ScopedValue promise(scope, capability->d()->promise);
 
     if (ro->d()->type == Heap::PromiseReaction::Function) {
@@ -141,6 +160,7 @@ void ReactionHandler::executeReaction(ReactionEvent *event)
 
         ScopedFunctionObject reaction(scope);
         if (scope.hasException()) {
+            result = scope.engine->catchException();
             reaction = capability->d()->reject.as<QV4::FunctionObject>();
         } else {
             reaction = capability->d()->resolve.as<QV4::FunctionObject>();
@@ -157,6 +177,9 @@ void ReactionHandler::executeReaction(ReactionEvent *event)
 
         reaction->call(promise, resolution, 1);
     }
+
+    if (scope.hasException())
+        dropException(scope.engine);
 }
 
 namespace {
@@ -52,6 +52,9 @@
 
 #include "qv4object_p.h"
 #include "qv4functionobject_p.h"
+#include "qv4persistent_p.h"
+
+#include <QtCore/qvector.h>
 
 QT_BEGIN_NAMESPACE
 
@@ -61,8 +64,10 @@ struct PromiseCapability;
 
 namespace Promise {
 
-struct ReactionEvent;
-
+// Queue of pending promise reactions (the "microtask" queue). Reactions are run
+// in FIFO order whenever the engine reaches a checkpoint, see
+// ExecutionEngine::drainPromiseReactions(). A single posted event makes sure the
+// queue is also drained when no checkpoint is reached before the event loop runs.
 class ReactionHandler : public QObject
 {
     Q_OBJECT
@@ -72,10 +77,28 @@ public:
     virtual ~ReactionHandler();
 
     void addReaction(ExecutionEngine *e, const Value *reaction, const Value *value);
+    void drain();
+    bool isEmpty() const { return m_queue.isEmpty(); }
 
 protected:
+    struct Reaction
+    {
+        Reaction() = default;
+        Reaction(ExecutionEngine *e, const Value &reaction, const Value &resolution)
+            : reaction(e, reaction), resolution(e, resolution)
+        {}
+
+        QV4::PersistentValue reaction;
+        QV4::PersistentValue resolution;
+    };
+
     void customEvent(QEvent *event);
-    void executeReaction(ReactionEvent *event);
+    void executeReaction(const Reaction &reaction);
+
+private:
+    QVector<Reaction> m_queue;
+    bool m_drainEventPosted = false;
+    bool m_draining = false;
 };
 
 } // Promise
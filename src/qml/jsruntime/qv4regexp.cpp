@@ -43,6 +43,8 @@
 #include <private/qv4mm_p.h>
 #include <runtime/VM.h>
 
+#include <QtCore/qthreadstorage.h>
+
 using namespace QV4;
 
 static JSC::RegExpFlags jscFlags(uint flags)
@@ -69,6 +71,53 @@ RegExpCache::~RegExpCache()
     }
 }
 
+Q_GLOBAL_STATIC(QThreadStorage<RegExpByteCodeCache *>, regExpByteCodeCaches)
+
+RegExpByteCodeCache *RegExpByteCodeCache::instance()
+{
+    QThreadStorage<RegExpByteCodeCache *> *caches = regExpByteCodeCaches();
+    if (!caches->hasLocalData())
+        caches->setLocalData(new RegExpByteCodeCache);
+    return caches->localData();
+}
+
+// Returns the cached bytecode for key, or nullptr. The caller owns a reference.
+RegExpByteCode *RegExpByteCodeCache::acquire(const RegExpCacheKey &key)
+{
+    Entry *entry = m_entries.object(key);
+    if (!entry)
+        return nullptr;
+    entry->byteCode->ref.ref();
+    return entry->byteCode;
+}
+
+// Returns the bytecode for key, compiling yarrPattern if it isn't cached yet.
+// The caller owns a reference.
+RegExpByteCode *RegExpByteCodeCache::acquire(const RegExpCacheKey &key, JSC::Yarr::YarrPattern &yarrPattern)
+{
+    if (RegExpByteCode *cached = acquire(key))
+        return cached;
+
+    RegExpByteCode *byteCode = new RegExpByteCode;
+    byteCode->subPatternCount = yarrPattern.m_numSubpatterns;
+    byteCode->containsBackreferences = yarrPattern.m_containsBackreferences;
+    byteCode->pattern = JSC::Yarr::byteCompile(yarrPattern, &byteCode->allocator);
+    if (!byteCode->pattern) {
+        delete byteCode;
+        return nullptr;
+    }
+
+    byteCode->ref.ref();
+    m_entries.insert(key, new Entry(byteCode));
+    return byteCode;
+}
+
+void RegExpByteCodeCache::release(RegExpByteCode *byteCode)
+{
+    if (byteCode && !byteCode->ref.deref())
+        delete byteCode;
+}
+
 DEFINE_MANAGED_VTABLE(RegExp);
 
 uint RegExp::match(const QString &string, int start, uint *matchOffsets)
@@ -97,16 +146,19 @@ uint RegExp::match(const QString &string, int start, uint *matchOffsets)
 
         // JIT failed. We need byteCode to run the interpreter.
         if (!priv->byteCode) {
-            JSC::Yarr::ErrorCode error = JSC::Yarr::ErrorCode::NoError;
-            JSC::Yarr::YarrPattern yarrPattern(WTF::String(*priv->pattern), jscFlags(priv->flags),
-                                               error);
+            const RegExpCacheKey key(priv);
+            RegExpByteCodeCache *byteCodeCache = RegExpByteCodeCache::instance();
+            priv->byteCode = byteCodeCache->acquire(key);
+            if (!priv->byteCode) {
+                JSC::Yarr::ErrorCode error = JSC::Yarr::ErrorCode::NoError;
+                JSC::Yarr::YarrPattern yarrPattern(WTF::String(*priv->pattern), jscFlags(priv->flags),
+                                                   error);
 
-            // As we successfully parsed the pattern before, we should still be able to.
-            Q_ASSERT(error == JSC::Yarr::ErrorCode::NoError);
+                // As we successfully parsed the pattern before, we should still be able to.
+                Q_ASSERT(error == JSC::Yarr::ErrorCode::NoError);
 
-            priv->byteCode = JSC::Yarr::byteCompile(
-                                     yarrPattern,
-                                     priv->internalClass->engine->bumperPointerAllocator).release();
+                priv->byteCode = byteCodeCache->acquire(key, yarrPattern);
+            }
         }
     }
 #endif // ENABLE(YARR_JIT)
@@ -213,6 +265,25 @@ void Heap::RegExp::init(ExecutionEngine *engine, const QString &pattern, uint fl
 
     valid = false;
 
+    const RegExpCacheKey key(pattern, flags);
+    RegExpByteCodeCache *byteCodeCache = RegExpByteCodeCache::instance();
+
+    // If the pattern is going to be interpreted anyway, reuse the bytecode compiled
+    // for it before, without parsing the pattern again.
+    if (RegExpByteCode *cached = byteCodeCache->acquire(key)) {
+#if ENABLE(YARR_JIT)
+        if (cached->containsBackreferences || !engine->canJIT()) {
+#else
+        {
+#endif
+            byteCode = cached;
+            subPatternCount = cached->subPatternCount;
+            valid = true;
+            return;
+        }
+        RegExpByteCodeCache::release(cached);
+    }
+
     JSC::Yarr::ErrorCode error = JSC::Yarr::ErrorCode::NoError;
     JSC::Yarr::YarrPattern yarrPattern(WTF::String(pattern), jscFlags(flags), error);
     if (error != JSC::Yarr::ErrorCode::NoError)
@@ -231,7 +302,7 @@ void Heap::RegExp::init(ExecutionEngine *engine, const QString &pattern, uint fl
         valid = true;
         return;
     }
-    byteCode = JSC::Yarr::byteCompile(yarrPattern, internalClass->engine->bumperPointerAllocator).release();
+    byteCode = byteCodeCache->acquire(key, yarrPattern);
     if (byteCode)
         valid = true;
 }
@@ -245,7 +316,7 @@ void Heap::RegExp::destroy()
 #if ENABLE(YARR_JIT)
     delete jitCode;
 #endif
-    delete byteCode;
+    RegExpByteCodeCache::release(byteCode);
     delete pattern;
     Base::destroy();
 }
@@ -52,6 +52,8 @@
 
 #include <QString>
 #include <QVector>
+#include <QCache>
+#include <QAtomicInt>
 
 #include <wtf/RefPtr.h>
 #include <wtf/FastAllocBase.h>
@@ -72,6 +74,7 @@ namespace QV4 {
 
 struct ExecutionEngine;
 struct RegExpCacheKey;
+struct RegExpByteCode;
 
 namespace Heap {
 
@@ -80,7 +83,7 @@ struct RegExp : Base {
     void destroy();
 
     QString *pattern;
-    JSC::Yarr::BytecodePattern *byteCode;
+    RegExpByteCode *byteCode;
 #if ENABLE(YARR_JIT)
     JSC::Yarr::YarrCodeBlock *jitCode;
 #endif
@@ -118,7 +121,7 @@ struct RegExp : public Managed
     V4_INTERNALCLASS(RegExp)
 
     QString pattern() const { return *d()->pattern; }
-    JSC::Yarr::BytecodePattern *byteCode() { return d()->byteCode; }
+    inline JSC::Yarr::BytecodePattern *byteCode();
 #if ENABLE(YARR_JIT)
     JSC::Yarr::YarrCodeBlock *jitCode() const { return d()->jitCode; }
 #endif
@@ -173,6 +176,50 @@ public:
     ~RegExpCache();
 };
 
+// Yarr bytecode for one pattern and set of flags. It is shared by all RegExp objects
+// with that key on the same thread, across engines, and is reference counted. Matching
+// allocates from the allocator, so the bytecode must only be used on the thread that
+// compiled it. The reference count is atomic nevertheless, as a RegExp may be released
+// by an engine that was moved to another thread.
+struct RegExpByteCode
+{
+    QAtomicInt ref;
+    int subPatternCount = 0;
+    bool containsBackreferences = false;
+    WTF::BumpPointerAllocator allocator;
+    std::unique_ptr<JSC::Yarr::BytecodePattern> pattern;
+};
+
+// Per-thread cache of compiled bytecode. It keeps the most recently compiled patterns
+// alive even when no RegExp object uses them anymore, so that other engines on the
+// same thread, e.g. multiple QQmlEngines, or a pattern that was garbage collected and
+// is created again, do not need to compile the pattern again. JIT code can't be shared
+// this way, as it refers to the engine it was generated for.
+class RegExpByteCodeCache
+{
+public:
+    static RegExpByteCodeCache *instance();
+
+    RegExpByteCode *acquire(const RegExpCacheKey &key);
+    RegExpByteCode *acquire(const RegExpCacheKey &key, JSC::Yarr::YarrPattern &yarrPattern);
+    static void release(RegExpByteCode *byteCode);
+
+private:
+    struct Entry
+    {
+        explicit Entry(RegExpByteCode *byteCode) : byteCode(byteCode) { byteCode->ref.ref(); }
+        ~Entry() { release(byteCode); }
+        RegExpByteCode *byteCode;
+    };
+
+    QCache<RegExpCacheKey, Entry> m_entries { 256 };
+};
+
+inline JSC::Yarr::BytecodePattern *RegExp::byteCode()
+{
+    return d()->byteCode ? d()->byteCode->pattern.get() : nullptr;
+}
+
 
 
 }
@@ -737,6 +737,27 @@ static Q_NEVER_INLINE bool setElementFallback(ExecutionEngine *engine, const Val
     return o->put(name, value);
 }
 
+// Appending right behind the last element of a plain array, as done when filling
+// an array in a loop, can skip the generic put() as long as nothing but the array's
+// own storage and length can observe the write.
+static inline bool tryAppendToSimpleArray(ExecutionEngine *engine, Heap::Object *o, Heap::SimpleArrayData *s, uint idx, const Value &value)
+{
+    if (idx != s->values.size || idx >= s->values.alloc || s->attrs)
+        return false;
+    if (o->internalClass != engine->classes[EngineBase::Class_ArrayObject])
+        return false;
+    for (Heap::Object *p = o->prototype(); p; p = p->prototype()) {
+        if (p->arrayData)
+            return false;
+    }
+
+    s->values.size = idx + 1;
+    s->setData(engine, idx, value);
+    if (idx >= o->propertyData(Heap::ArrayObject::LengthPropertyIndex)->toUInt32())
+        o->setProperty(engine, Heap::ArrayObject::LengthPropertyIndex, Value::fromUInt32(idx + 1));
+    return true;
+}
+
 void Runtime::method_storeElement(ExecutionEngine *engine, const Value &object, const Value &index, const Value &value)
 {
     if (index.isPositiveInt()) {
@@ -750,6 +771,8 @@ void Runtime::method_storeElement(ExecutionEngine *engine, const Value &object,
                         s->setData(engine, idx, value);
                         return;
                     }
+                    if (tryAppendToSimpleArray(engine, o, s, idx, value))
+                        return;
                 }
             }
         }
@@ -64,7 +64,7 @@ ReturnedValue SetIteratorPrototype::method_next(const FunctionObject *b, const V
         return scope.engine->throwTypeError(QLatin1String("Not a Set Iterator instance"));
 
     Scoped<SetObject> s(scope, thisObject->d()->iteratedSet);
-    uint index = thisObject->d()->setNextIndex;
+    quint64 position = thisObject->d()->setNextPosition;
     IteratorKind itemKind = thisObject->d()->iterationKind;
 
     if (!s) {
@@ -74,9 +74,8 @@ ReturnedValue SetIteratorPrototype::method_next(const FunctionObject *b, const V
 
     Value *arguments = scope.alloc(2);
 
-    while (index < s->d()->esTable->size()) {
-        s->d()->esTable->iterate(index, &arguments[0], &arguments[1]);
-        thisObject->d()->setNextIndex = index + 1;
+    while (s->d()->esTable->iterate(&position, &arguments[0], &arguments[1])) {
+        thisObject->d()->setNextPosition = position;
 
         if (itemKind == KeyValueIteratorKind) {
             ScopedArrayObject resultArray(scope, scope.engine->newArrayObject());
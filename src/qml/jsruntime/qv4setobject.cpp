@@ -282,8 +282,8 @@ ReturnedValue SetPrototype::method_forEach(const FunctionObject *b, const Value
         thisArg = ScopedValue(scope, argv[1]);
 
     Value *arguments = scope.alloc(3);
-    for (uint i = 0; i < that->d()->esTable->size(); ++i) {
-        that->d()->esTable->iterate(i, &arguments[0], &arguments[1]); // fill in key (0), value (1)
+    quint64 position = 0;
+    while (that->d()->esTable->iterate(&position, &arguments[0], &arguments[1])) { // fill in key (0), value (1)
         arguments[1] = arguments[0]; // but for set, we want to return the key twice; value is always undefined.
 
         arguments[2] = that;
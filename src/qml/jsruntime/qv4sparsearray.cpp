@@ -38,401 +38,211 @@
 ****************************************************************************/
 
 #include "qv4sparsearray_p.h"
-#include "qv4runtime_p.h"
-#include "qv4object_p.h"
-#include "qv4functionobject_p.h"
-#include "qv4scopedvalue_p.h"
 #include <stdlib.h>
-
-#ifdef QT_QMAP_DEBUG
-# include <qstring.h>
-# include <qvector.h>
-#endif
+#include <string.h>
 
 using namespace QV4;
 
-const SparseArrayNode *SparseArrayNode::nextNode() const
+SparseArray::Leaf *SparseArray::Leaf::allocate(uint capacity)
 {
-    const SparseArrayNode *n = this;
-    if (n->right) {
-        n = n->right;
-        while (n->left)
-            n = n->left;
-    } else {
-        const SparseArrayNode *y = n->parent();
-        while (y && n == y->right) {
-            n = y;
-            y = n->parent();
-        }
-        n = y;
-    }
-    return n;
-}
-
-const SparseArrayNode *SparseArrayNode::previousNode() const
-{
-    const SparseArrayNode *n = this;
-    if (n->left) {
-        n = n->left;
-        while (n->right)
-            n = n->right;
-    } else {
-        const SparseArrayNode *y = n->parent();
-        while (y && n == y->left) {
-            n = y;
-            y = n->parent();
-        }
-        n = y;
-    }
-    return n;
+    Leaf *l = static_cast<Leaf *>(::malloc(sizeof(Leaf) + (capacity - 1)*sizeof(Entry)));
+    Q_CHECK_PTR(l);
+    l->size = 0;
+    l->capacity = capacity;
+    return l;
 }
 
-SparseArrayNode *SparseArrayNode::copy(SparseArray *d) const
+SparseArray::Leaf *SparseArray::Leaf::reallocate(Leaf *leaf, uint capacity)
 {
-    SparseArrayNode *n = d->createNode(size_left, nullptr, false);
-    n->value = value;
-    n->setColor(color());
-    if (left) {
-        n->left = left->copy(d);
-        n->left->setParent(n);
-    } else {
-        n->left = nullptr;
-    }
-    if (right) {
-        n->right = right->copy(d);
-        n->right->setParent(n);
-    } else {
-        n->right = nullptr;
-    }
-    return n;
+    Q_ASSERT(capacity >= leaf->size);
+    Leaf *l = static_cast<Leaf *>(::realloc(leaf, sizeof(Leaf) + (capacity - 1)*sizeof(Entry)));
+    Q_CHECK_PTR(l);
+    l->capacity = capacity;
+    return l;
 }
 
-/*
-     x              y
-      \            / \
-       y    -->   x   b
-      / \          \
-     a   b          a
-*/
-void SparseArray::rotateLeft(SparseArrayNode *x)
+SparseArray::SparseArray()
+    : numEntries(0)
 {
-    SparseArrayNode *&root = header.left;
-    SparseArrayNode *y = x->right;
-    x->right = y->left;
-    if (y->left != nullptr)
-        y->left->setParent(x);
-    y->setParent(x->parent());
-    if (x == root)
-        root = y;
-    else if (x == x->parent()->left)
-        x->parent()->left = y;
-    else
-        x->parent()->right = y;
-    y->left = x;
-    x->setParent(y);
-    y->size_left += x->size_left;
+    freeList = Encode(-1);
 }
 
-
-/*
-         x          y
-        /          / \
-       y    -->   a   x
-      / \            /
-     a   b          b
-*/
-void SparseArray::rotateRight(SparseArrayNode *x)
+SparseArray::~SparseArray()
 {
-    SparseArrayNode *&root = header.left;
-    SparseArrayNode *y = x->left;
-    x->left = y->right;
-    if (y->right != nullptr)
-        y->right->setParent(x);
-    y->setParent(x->parent());
-    if (x == root)
-        root = y;
-    else if (x == x->parent()->right)
-        x->parent()->right = y;
-    else
-        x->parent()->left = y;
-    y->right = x;
-    x->setParent(y);
-    x->size_left -= y->size_left;
+    for (Leaf *l : leaves)
+        ::free(l);
 }
 
-
-void SparseArray::rebalance(SparseArrayNode *x)
-{
-    SparseArrayNode *&root = header.left;
-    x->setColor(SparseArrayNode::Red);
-    while (x != root && x->parent()->color() == SparseArrayNode::Red) {
-        if (x->parent() == x->parent()->parent()->left) {
-            SparseArrayNode *y = x->parent()->parent()->right;
-            if (y && y->color() == SparseArrayNode::Red) {
-                x->parent()->setColor(SparseArrayNode::Black);
-                y->setColor(SparseArrayNode::Black);
-                x->parent()->parent()->setColor(SparseArrayNode::Red);
-                x = x->parent()->parent();
-            } else {
-                if (x == x->parent()->right) {
-                    x = x->parent();
-                    rotateLeft(x);
-                }
-                x->parent()->setColor(SparseArrayNode::Black);
-                x->parent()->parent()->setColor(SparseArrayNode::Red);
-                rotateRight (x->parent()->parent());
-            }
-        } else {
-            SparseArrayNode *y = x->parent()->parent()->left;
-            if (y && y->color() == SparseArrayNode::Red) {
-                x->parent()->setColor(SparseArrayNode::Black);
-                y->setColor(SparseArrayNode::Black);
-                x->parent()->parent()->setColor(SparseArrayNode::Red);
-                x = x->parent()->parent();
-            } else {
-                if (x == x->parent()->left) {
-                    x = x->parent();
-                    rotateRight(x);
-                }
-                x->parent()->setColor(SparseArrayNode::Black);
-                x->parent()->parent()->setColor(SparseArrayNode::Red);
-                rotateLeft(x->parent()->parent());
-            }
-        }
+SparseArray::SparseArray(const SparseArray &other)
+    : freeList(other.freeList)
+    , numEntries(other.numEntries)
+    , firstKeys(other.firstKeys)
+{
+    leaves.reserve(other.leaves.size());
+    for (const Leaf *l : other.leaves) {
+        Leaf *copy = Leaf::allocate(l->size);
+        copy->size = l->size;
+        memcpy(copy->entries, l->entries, l->size*sizeof(Entry));
+        leaves.push_back(copy);
     }
-    root->setColor(SparseArrayNode::Black);
 }
 
-void SparseArray::deleteNode(SparseArrayNode *z)
+uint *SparseArray::insert(uint key)
 {
-    SparseArrayNode *&root = header.left;
-    SparseArrayNode *y = z;
-    SparseArrayNode *x;
-    SparseArrayNode *x_parent;
-    if (y->left == nullptr) {
-        x = y->right;
-        if (y == mostLeftNode) {
-            if (x)
-                mostLeftNode = x; // It cannot have (left) children due the red black invariant.
-            else
-                mostLeftNode = y->parent();
-        }
-    } else if (y->right == nullptr) {
-            x = y->left;
-    } else {
-        y = y->right;
-        while (y->left != nullptr)
-            y = y->left;
-        x = y->right;
+    if (leaves.empty()) {
+        leaves.push_back(Leaf::allocate(InitialLeafCapacity));
+        firstKeys.push_back(key);
+        return insertAt(0, 0, key);
     }
-    if (y != z) {
-        // move y into the position of z
-        // adjust size_left so the keys are ok.
-        z->size_left += y->size_left;
-        SparseArrayNode *n = y->parent();
-        while (n != z) {
-            n->size_left -= y->size_left;
-            n = n->parent();
-        }
-        y->size_left = 0;
-        z->value = y->value;
 
-        if (y != z->right) {
-            x_parent = y->parent();
-            y->parent()->left = x;
+    uint l = leafFor(key);
+    Leaf *leaf = leaves[l];
+    uint pos = leaf->lowerBound(key);
+    if (pos < leaf->size && leaf->entries[pos].key == key)
+        return &leaf->entries[pos].value;
+    return insertAt(l, pos, key);
+}
+
+uint *SparseArray::insertAt(uint l, uint pos, uint key)
+{
+    Leaf *leaf = leaves[l];
+    if (leaf->size == leaf->capacity) {
+        if (leaf->capacity < LeafCapacity) {
+            leaf = Leaf::reallocate(leaf, qMin<uint>(2*leaf->capacity, LeafCapacity));
+            leaves[l] = leaf;
+        } else if (l == leaves.size() - 1 && pos == leaf->size) {
+            // Appending at the end (the common case when filling an array in order):
+            // start a new leaf instead of splitting, so that the old one stays full.
+            leaf = Leaf::allocate(InitialLeafCapacity);
+            leaves.push_back(leaf);
+            firstKeys.push_back(key);
+            ++l;
+            pos = 0;
         } else {
-            x_parent = z;
-            z->right = x;
-        }
-        if (x)
-            x->setParent(x_parent);
-    } else {
-        x_parent = y->parent();
-        if (x)
-            x->setParent(y->parent());
-        if (root == y)
-            root = x;
-        else if (y->parent()->left == y)
-            y->parent()->left = x;
-        else
-            y->parent()->right = x;
-        if (x && x == y->right)
-            x->size_left += y->size_left;
-        y->size_left = 0;
-    }
-    if (y->color() != SparseArrayNode::Red) {
-        while (x != root && (x == nullptr || x->color() == SparseArrayNode::Black)) {
-            if (x == x_parent->left) {
-                SparseArrayNode *w = x_parent->right;
-                if (w->color() == SparseArrayNode::Red) {
-                    w->setColor(SparseArrayNode::Black);
-                    x_parent->setColor(SparseArrayNode::Red);
-                    rotateLeft(x_parent);
-                    w = x_parent->right;
-                }
-                if ((w->left == nullptr || w->left->color() == SparseArrayNode::Black) &&
-                    (w->right == nullptr || w->right->color() == SparseArrayNode::Black)) {
-                    w->setColor(SparseArrayNode::Red);
-                    x = x_parent;
-                    x_parent = x_parent->parent();
-                } else {
-                    if (w->right == nullptr || w->right->color() == SparseArrayNode::Black) {
-                        if (w->left)
-                            w->left->setColor(SparseArrayNode::Black);
-                        w->setColor(SparseArrayNode::Red);
-                        rotateRight(w);
-                        w = x_parent->right;
-                    }
-                    w->setColor(x_parent->color());
-                    x_parent->setColor(SparseArrayNode::Black);
-                    if (w->right)
-                        w->right->setColor(SparseArrayNode::Black);
-                    rotateLeft(x_parent);
-                    break;
-                }
-            } else {
-            SparseArrayNode *w = x_parent->left;
-            if (w->color() == SparseArrayNode::Red) {
-                w->setColor(SparseArrayNode::Black);
-                x_parent->setColor(SparseArrayNode::Red);
-                rotateRight(x_parent);
-                w = x_parent->left;
-            }
-            if ((w->right == nullptr || w->right->color() == SparseArrayNode::Black) &&
-                (w->left == nullptr || w->left->color() == SparseArrayNode::Black)) {
-                w->setColor(SparseArrayNode::Red);
-                x = x_parent;
-                x_parent = x_parent->parent();
-            } else {
-                if (w->left == nullptr || w->left->color() == SparseArrayNode::Black) {
-                    if (w->right)
-                        w->right->setColor(SparseArrayNode::Black);
-                    w->setColor(SparseArrayNode::Red);
-                    rotateLeft(w);
-                    w = x_parent->left;
-                }
-                w->setColor(x_parent->color());
-                x_parent->setColor(SparseArrayNode::Black);
-                if (w->left)
-                    w->left->setColor(SparseArrayNode::Black);
-                rotateRight(x_parent);
-                break;
+            const uint half = leaf->size/2;
+            Leaf *right = Leaf::allocate(LeafCapacity);
+            right->size = leaf->size - half;
+            memcpy(right->entries, leaf->entries + half, right->size*sizeof(Entry));
+            leaf->size = half;
+            leaves.insert(leaves.begin() + l + 1, right);
+            firstKeys.insert(firstKeys.begin() + l + 1, right->entries[0].key);
+            if (pos > half) {
+                ++l;
+                pos -= half;
+                leaf = right;
             }
         }
     }
-    if (x)
-        x->setColor(SparseArrayNode::Black);
-    }
-    free(y);
-    --numEntries;
-}
 
-void SparseArray::recalcMostLeftNode()
-{
-    mostLeftNode = &header;
-    while (mostLeftNode->left)
-        mostLeftNode = mostLeftNode->left;
-}
-
-static inline int qMapAlignmentThreshold()
-{
-    // malloc on 32-bit platforms should return pointers that are 8-byte
-    // aligned or more while on 64-bit platforms they should be 16-byte aligned
-    // or more
-    return 2 * sizeof(void*);
-}
-
-static inline void *qMapAllocate(int alloc, int alignment)
-{
-    return alignment > qMapAlignmentThreshold()
-        ? qMallocAligned(alloc, alignment)
-        : ::malloc(alloc);
+    Entry *e = leaf->entries + pos;
+    memmove(e + 1, e, (leaf->size - pos)*sizeof(Entry));
+    e->key = key;
+    e->value = UINT_MAX;
+    ++leaf->size;
+    if (!pos)
+        firstKeys[l] = key;
+    ++numEntries;
+    return &e->value;
 }
 
-static inline void qMapDeallocate(SparseArrayNode *node, int alignment)
+bool SparseArray::erase(uint key)
 {
-    if (alignment > qMapAlignmentThreshold())
-        qFreeAligned(node);
-    else
-        ::free(node);
+    if (leaves.empty())
+        return false;
+    uint l = leafFor(key);
+    uint pos = leaves[l]->lowerBound(key);
+    if (pos == leaves[l]->size || leaves[l]->entries[pos].key != key)
+        return false;
+    eraseAt(l, pos);
+    return true;
 }
 
-SparseArrayNode *SparseArray::createNode(uint sl, SparseArrayNode *parent, bool left)
+void SparseArray::eraseAt(uint l, uint pos)
 {
-    SparseArrayNode *node = static_cast<SparseArrayNode *>(qMapAllocate(sizeof(SparseArrayNode), Q_ALIGNOF(SparseArrayNode)));
-    Q_CHECK_PTR(node);
-
-    node->p = (quintptr)parent;
-    node->left = nullptr;
-    node->right = nullptr;
-    node->size_left = sl;
-    node->value = UINT_MAX;
-    ++numEntries;
+    Leaf *leaf = leaves[l];
+    Q_ASSERT(pos < leaf->size);
+    Entry *e = leaf->entries + pos;
+    memmove(e, e + 1, (leaf->size - pos - 1)*sizeof(Entry));
+    --leaf->size;
+    --numEntries;
 
-    if (parent) {
-        if (left) {
-            parent->left = node;
-            if (parent == mostLeftNode)
-                mostLeftNode = node;
-        } else {
-            parent->right = node;
+    if (!leaf->size) {
+        removeLeaf(l);
+        return;
+    }
+    if (!pos)
+        firstKeys[l] = leaf->entries[0].key;
+
+    // merge mostly empty neighbours, so that deleting from an array doesn't leave
+    // lots of tiny leaves behind
+    if (l + 1 < leaves.size() && leaf->size + leaves[l + 1]->size <= LeafCapacity/2) {
+        Leaf *next = leaves[l + 1];
+        if (leaf->capacity < leaf->size + next->size) {
+            leaf = Leaf::reallocate(leaf, LeafCapacity);
+            leaves[l] = leaf;
         }
-        node->setParent(parent);
-        rebalance(node);
+        memcpy(leaf->entries + leaf->size, next->entries, next->size*sizeof(Entry));
+        leaf->size += next->size;
+        next->size = 0;
+        removeLeaf(l + 1);
     }
-    return node;
 }
 
-void SparseArray::freeTree(SparseArrayNode *root, int alignment)
+void SparseArray::removeLeaf(uint l)
 {
-    if (root->left)
-        freeTree(root->left, alignment);
-    if (root->right)
-        freeTree(root->right, alignment);
-    qMapDeallocate(root, alignment);
+    numEntries -= leaves[l]->size;
+    ::free(leaves[l]);
+    leaves.erase(leaves.begin() + l);
+    firstKeys.erase(firstKeys.begin() + l);
 }
 
-SparseArray::SparseArray()
-    : numEntries(0)
+void SparseArray::eraseFrom(uint key)
 {
-    freeList = Encode(-1);
-    header.p = 0;
-    header.left = nullptr;
-    header.right = nullptr;
-    mostLeftNode = &header;
+    if (leaves.empty())
+        return;
+    uint l = leafFor(key);
+    uint pos = leaves[l]->lowerBound(key);
+    uint keep = pos ? l + 1 : l;
+    for (uint i = keep; i < leaves.size(); ++i) {
+        numEntries -= leaves[i]->size;
+        ::free(leaves[i]);
+    }
+    if (pos) {
+        numEntries -= leaves[l]->size - pos;
+        leaves[l]->size = pos;
+    }
+    leaves.resize(keep);
+    firstKeys.resize(keep);
 }
 
-SparseArray::SparseArray(const SparseArray &other)
+uint SparseArray::pop_front()
 {
-    header.p = 0;
-    header.right = nullptr;
-    if (other.header.left) {
-        header.left = other.header.left->copy(this);
-        header.left->setParent(&header);
-        recalcMostLeftNode();
+    uint idx = UINT_MAX;
+    if (leaves.empty())
+        return idx;
+
+    if (!firstKeys[0]) {
+        idx = leaves[0]->entries[0].value;
+        eraseAt(0, 0);
+    }
+    // shift all remaining entries down by one, also if there was a hole at 0
+    for (uint l = 0; l < leaves.size(); ++l) {
+        Leaf *leaf = leaves[l];
+        for (uint i = 0; i < leaf->size; ++i)
+            --leaf->entries[i].key;
+        --firstKeys[l];
     }
-    freeList = other.freeList;
+    return idx;
 }
 
-SparseArrayNode *SparseArray::insert(uint akey)
+void SparseArray::push_front(uint value)
 {
-    SparseArrayNode *n = root();
-    SparseArrayNode *y = end();
-    bool  left = true;
-    uint s = akey;
-    while (n) {
-        y = n;
-        if (s == n->size_left) {
-            return n;
-        } else if (s < n->size_left) {
-            left = true;
-            n = n->left;
-        } else {
-            left = false;
-            s -= n->size_left;
-            n = n->right;
-        }
+    // shift all entries up by one
+    for (uint l = 0; l < leaves.size(); ++l) {
+        Leaf *leaf = leaves[l];
+        for (uint i = 0; i < leaf->size; ++i)
+            ++leaf->entries[i].key;
+        ++firstKeys[l];
     }
-
-    return createNode(s, y, left);
+    *insert(0) = value;
 }
@@ -55,100 +55,87 @@
 #include "qv4value_p.h"
 #include <QtCore/qlist.h>
 
-//#define Q_MAP_DEBUG
-#ifdef Q_MAP_DEBUG
-#include <QtCore/qdebug.h>
-#endif
-
-#include <new>
+#include <algorithm>
+#include <vector>
 
 QT_BEGIN_NAMESPACE
 
 namespace QV4 {
 
-struct SparseArray;
-
-struct SparseArrayNode
+// An ordered map from array indices to slots in the values of a SparseArrayData.
+//
+// The entries are kept sorted by key in a list of leaves holding up to LeafCapacity
+// entries each. Lookups do a binary search over the first keys of the leaves (kept in
+// their own vector, so that the search touches a single contiguous block of memory),
+// followed by one inside the leaf. Compared to a tree with one node per element, this
+// needs a lot fewer allocations, and iterating in order is a linear walk over memory.
+struct Q_QML_EXPORT SparseArray
 {
-    quintptr p;
-    SparseArrayNode *left;
-    SparseArrayNode *right;
-    uint size_left;
-    uint value;
-
-    enum Color { Red = 0, Black = 1 };
-    enum { Mask = 3 }; // reserve the second bit as well
-
-    const SparseArrayNode *nextNode() const;
-    SparseArrayNode *nextNode() { return const_cast<SparseArrayNode *>(const_cast<const SparseArrayNode *>(this)->nextNode()); }
-    const SparseArrayNode *previousNode() const;
-    SparseArrayNode *previousNode() { return const_cast<SparseArrayNode *>(const_cast<const SparseArrayNode *>(this)->previousNode()); }
-
-    Color color() const { return Color(p & 1); }
-    void setColor(Color c) { if (c == Black) p |= Black; else p &= ~Black; }
-    SparseArrayNode *parent() const { return reinterpret_cast<SparseArrayNode *>(p & ~Mask); }
-    void setParent(SparseArrayNode *pp) { p = (p & Mask) | quintptr(pp); }
-
-    uint key() const {
-        uint k = size_left;
-        const SparseArrayNode *n = this;
-        while (SparseArrayNode *p = n->parent()) {
-            if (p && p->right == n)
-                k += p->size_left;
-            n = p;
-        }
-        return k;
-    }
+    struct Entry {
+        uint key;
+        uint value;
+    };
 
-    SparseArrayNode *copy(SparseArray *d) const;
+    enum {
+        LeafCapacity = 128,
+        InitialLeafCapacity = 4
+    };
 
-    SparseArrayNode *lowerBound(uint key);
-    SparseArrayNode *upperBound(uint key);
-};
+    struct Leaf {
+        uint size;
+        uint capacity;
+        Entry entries[1];
 
+        static Leaf *allocate(uint capacity);
+        static Leaf *reallocate(Leaf *leaf, uint capacity);
 
-inline SparseArrayNode *SparseArrayNode::lowerBound(uint akey)
-{
-    SparseArrayNode *n = this;
-    SparseArrayNode *last = nullptr;
-    while (n) {
-        if (akey <= n->size_left) {
-            last = n;
-            n = n->left;
-        } else {
-            akey -= n->size_left;
-            n = n->right;
+        const Entry *begin() const { return entries; }
+        const Entry *end() const { return entries + size; }
+        uint lowerBound(uint key) const {
+            return uint(std::lower_bound(begin(), end(), key, [](const Entry &e, uint k) { return e.key < k; }) - begin());
+        }
+    };
+
+    class ConstIterator
+    {
+    public:
+        uint key() const { return entry().key; }
+        uint value() const { return entry().value; }
+
+        ConstIterator &operator++() {
+            if (++pos == array->leaves[leaf]->size) {
+                ++leaf;
+                pos = 0;
+            }
+            return *this;
+        }
+        ConstIterator &operator--() {
+            if (pos) {
+                --pos;
+            } else {
+                --leaf;
+                pos = array->leaves[leaf]->size - 1;
+            }
+            return *this;
         }
-    }
-    return last;
-}
 
+        bool operator==(const ConstIterator &other) const { return leaf == other.leaf && pos == other.pos; }
+        bool operator!=(const ConstIterator &other) const { return !(*this == other); }
 
-inline SparseArrayNode *SparseArrayNode::upperBound(uint akey)
-{
-    SparseArrayNode *n = this;
-    SparseArrayNode *last = nullptr;
-    while (n) {
-        if (akey < n->size_left) {
-            last = n;
-            n = n->left;
-        } else {
-            akey -= n->size_left;
-            n = n->right;
-        }
-    }
-    return last;
-}
+    private:
+        friend struct SparseArray;
+        ConstIterator(const SparseArray *array, uint leaf, uint pos)
+            : array(array), leaf(leaf), pos(pos) {}
 
+        const Entry &entry() const { return array->leaves[leaf]->entries[pos]; }
 
+        const SparseArray *array;
+        uint leaf;
+        uint pos;
+    };
 
-struct Q_QML_EXPORT SparseArray
-{
     SparseArray();
-    ~SparseArray() {
-        if (root())
-            freeTree(header.left, Q_ALIGNOF(SparseArrayNode));
-    }
+    ~SparseArray();
 
     SparseArray(const SparseArray &other);
 
@@ -156,105 +143,79 @@ struct Q_QML_EXPORT SparseArray
 private:
     SparseArray &operator=(const SparseArray &other);
 
-    int numEntries;
-    SparseArrayNode header;
-    SparseArrayNode *mostLeftNode;
-
-    void rotateLeft(SparseArrayNode *x);
-    void rotateRight(SparseArrayNode *x);
-    void rebalance(SparseArrayNode *x);
-    void recalcMostLeftNode();
-
-    SparseArrayNode *root() const { return header.left; }
+    uint numEntries;
+    std::vector<Leaf *> leaves;
+    // firstKeys[i] == leaves[i]->entries[0].key
+    std::vector<uint> firstKeys;
 
-    void deleteNode(SparseArrayNode *z);
+    // the leaf that contains key, or into which it would be inserted
+    uint leafFor(uint key) const {
+        Q_ASSERT(!leaves.empty());
+        uint l = uint(std::upper_bound(firstKeys.begin(), firstKeys.end(), key) - firstKeys.begin());
+        return l ? l - 1 : 0;
+    }
 
+    uint *insertAt(uint leaf, uint pos, uint key);
+    void eraseAt(uint leaf, uint pos);
+    void removeLeaf(uint leaf);
 
 public:
-    SparseArrayNode *createNode(uint sl, SparseArrayNode *parent, bool left);
-    void freeTree(SparseArrayNode *root, int alignment);
+    uint nEntries() const { return numEntries; }
 
-    SparseArrayNode *findNode(uint akey) const;
+    const uint *find(uint key) const;
+    uint *find(uint key) { return const_cast<uint *>(const_cast<const SparseArray *>(this)->find(key)); }
 
-    uint nEntries() const { return numEntries; }
+    // Returns the value slot for key. Newly inserted entries have a value of UINT_MAX.
+    uint *insert(uint key);
+    bool erase(uint key);
+    // Removes all entries with a key >= key
+    void eraseFrom(uint key);
 
     uint pop_front();
     void push_front(uint at);
     uint pop_back(uint len);
     void push_back(uint at, uint len);
 
-    QList<int> keys() const;
-
-    const SparseArrayNode *end() const { return &header; }
-    SparseArrayNode *end() { return &header; }
-    const SparseArrayNode *begin() const { if (root()) return mostLeftNode; return end(); }
-    SparseArrayNode *begin() { if (root()) return mostLeftNode; return end(); }
+    uint lastKey() const {
+        Q_ASSERT(numEntries);
+        const Leaf *l = leaves.back();
+        return l->entries[l->size - 1].key;
+    }
 
-    SparseArrayNode *erase(SparseArrayNode *n);
+    QList<int> keys() const;
 
-    SparseArrayNode *lowerBound(uint key);
-    const SparseArrayNode *lowerBound(uint key) const;
-    SparseArrayNode *upperBound(uint key);
-    const SparseArrayNode *upperBound(uint key) const;
-    SparseArrayNode *insert(uint akey);
+    ConstIterator begin() const { return ConstIterator(this, 0, 0); }
+    ConstIterator end() const { return ConstIterator(this, uint(leaves.size()), 0); }
+    // Returns the first entry with a key >= key
+    ConstIterator lowerBound(uint key) const;
 
     // STL compatibility
     typedef uint key_type;
     typedef int mapped_type;
     typedef qptrdiff difference_type;
     typedef int size_type;
-
-#ifdef Q_MAP_DEBUG
-    void dump() const;
-#endif
 };
 
-inline SparseArrayNode *SparseArray::findNode(uint akey) const
+inline const uint *SparseArray::find(uint key) const
 {
-    SparseArrayNode *n = root();
-
-    while (n) {
-        if (akey == n->size_left) {
-            return n;
-        } else if (akey < n->size_left) {
-            n = n->left;
-        } else {
-            akey -= n->size_left;
-            n = n->right;
-        }
-    }
-
+    if (leaves.empty())
+        return nullptr;
+    Leaf *l = leaves[leafFor(key)];
+    uint pos = l->lowerBound(key);
+    if (pos < l->size && l->entries[pos].key == key)
+        return &l->entries[pos].value;
     return nullptr;
 }
 
-inline uint SparseArray::pop_front()
+inline SparseArray::ConstIterator SparseArray::lowerBound(uint key) const
 {
-    uint idx = UINT_MAX ;
-
-    SparseArrayNode *n = findNode(0);
-    if (n) {
-        idx = n->value;
-        deleteNode(n);
-        // adjust all size_left indices on the path to leftmost item by 1
-        SparseArrayNode *n = root();
-        while (n) {
-            n->size_left -= 1;
-            n = n->left;
-        }
-    }
-    return idx;
-}
-
-inline void SparseArray::push_front(uint value)
-{
-    // adjust all size_left indices on the path to leftmost item by 1
-    SparseArrayNode *n = root();
-    while (n) {
-        n->size_left += 1;
-        n = n->left;
-    }
-    n = insert(0);
-    n->value = value;
+    if (leaves.empty())
+        return end();
+    uint l = leafFor(key);
+    uint pos = leaves[l]->lowerBound(key);
+    if (pos == leaves[l]->size)
+        return ConstIterator(this, l + 1, 0);
+    return ConstIterator(this, l, pos);
 }
 
 inline uint SparseArray::pop_back(uint len)
@@ -263,99 +224,27 @@ inline uint SparseArray::pop_back(uint len)
     if (!len)
         return idx;
 
-    SparseArrayNode *n = findNode(len - 1);
-    if (n) {
-        idx = n->value;
-        deleteNode(n);
+    if (const uint *v = find(len - 1)) {
+        idx = *v;
+        erase(len - 1);
     }
     return idx;
 }
 
 inline void SparseArray::push_back(uint index, uint len)
 {
-    SparseArrayNode *n = insert(len);
-    n->value = index;
-}
-
-#ifdef Q_MAP_DEBUG
-inline void SparseArray::dump() const
-{
-    const SparseArrayNode *it = begin();
-    qDebug() << "map dump:";
-    while (it != end()) {
-        const SparseArrayNode *n = it;
-        int depth = 0;
-        while (n && n != root()) {
-            ++depth;
-            n = n->parent();
-        }
-        QByteArray space(4*depth, ' ');
-        qDebug() << space << (it->color() == SparseArrayNode::Red ? "Red  " : "Black") << it << it->size_left << it->left << it->right
-                 << it->key() << it->value;
-        it = it->nextNode();
-    }
-    qDebug() << "---------";
-}
-#endif
-
-
-inline SparseArrayNode *SparseArray::erase(SparseArrayNode *n)
-{
-    if (n == end())
-        return n;
-
-    SparseArrayNode *next = n->nextNode();
-    deleteNode(n);
-    return next;
+    *insert(len) = index;
 }
 
 inline QList<int> SparseArray::keys() const
 {
     QList<int> res;
     res.reserve(numEntries);
-    SparseArrayNode *n = mostLeftNode;
-    while (n != end()) {
-        res.append(n->key());
-        n = n->nextNode();
-    }
+    for (ConstIterator it = begin(); it != end(); ++it)
+        res.append(it.key());
     return res;
 }
 
-inline const SparseArrayNode *SparseArray::lowerBound(uint akey) const
-{
-    const SparseArrayNode *lb = root()->lowerBound(akey);
-    if (!lb)
-        lb = end();
-    return lb;
-}
-
-
-inline SparseArrayNode *SparseArray::lowerBound(uint akey)
-{
-    SparseArrayNode *lb = root()->lowerBound(akey);
-    if (!lb)
-        lb = end();
-    return lb;
-}
-
-
-inline const SparseArrayNode *SparseArray::upperBound(uint akey) const
-{
-    const SparseArrayNode *ub = root()->upperBound(akey);
-    if (!ub)
-        ub = end();
-    return ub;
-}
-
-
-inline SparseArrayNode *SparseArray::upperBound(uint akey)
-{
-    SparseArrayNode *ub = root()->upperBound(akey);
-    if (!ub)
-        ub = end();
-    return ub;
-}
-
 }
 
 QT_END_NAMESPACE
@@ -112,11 +112,13 @@ void Heap::ComplexString::init(String *l, String *r)
     left = l;
     right = r;
     len = left->length() + right->length();
-    if (left->subtype >= StringType_Complex)
+    // Substrings are leaves of the tree, their from field shares storage
+    // with largestSubLength.
+    if (left->subtype == StringType_AddedString)
         largestSubLength = static_cast<ComplexString *>(left)->largestSubLength;
     else
         largestSubLength = left->length();
-    if (right->subtype >= StringType_Complex)
+    if (right->subtype == StringType_AddedString)
         largestSubLength = qMax(largestSubLength, static_cast<ComplexString *>(right)->largestSubLength);
     else
         largestSubLength = qMax(largestSubLength, right->length());
@@ -133,6 +135,13 @@ void Heap::ComplexString::init(Heap::String *ref, int from, int len)
 
     subtype = String::StringType_SubString;
 
+    // Slice the underlying string directly instead of chaining substrings.
+    if (ref->subtype == StringType_SubString) {
+        const ComplexString *cs = static_cast<const ComplexString *>(ref);
+        from += cs->from;
+        ref = cs->left;
+    }
+
     left = ref;
     this->from = from;
     this->len = len;
@@ -194,22 +203,26 @@ void Heap::String::simplifyString() const
 
 bool Heap::String::startsWithUpper() const
 {
-    if (subtype == StringType_AddedString)
-        return static_cast<const Heap::ComplexString *>(this)->left->startsWithUpper();
-
+    // Walk down to the leaf holding the first character, without flattening.
     const Heap::String *str = this;
     int offset = 0;
-    if (subtype == StringType_SubString) {
-        const ComplexString *cs = static_cast<const Heap::ComplexString *>(this);
-        if (!cs->len)
-            return false;
-        // simplification here is not ideal, but hopefully not a common case.
-        if (cs->left->subtype >= Heap::String::StringType_Complex)
-            cs->left->simplifyString();
-        str = cs->left;
-        offset = cs->from;
+    while (str->subtype >= StringType_Complex) {
+        const ComplexString *cs = static_cast<const Heap::ComplexString *>(str);
+        if (str->subtype == StringType_AddedString) {
+            const int leftLength = cs->left->length();
+            if (offset < leftLength) {
+                str = cs->left;
+            } else {
+                offset -= leftLength;
+                str = cs->right;
+            }
+        } else {
+            if (offset >= cs->len)
+                return false;
+            offset += cs->from;
+            str = cs->left;
+        }
     }
-    Q_ASSERT(str->subtype < Heap::String::StringType_Complex);
     return str->text->size > offset && QChar::isUpper(str->text->data()[offset]);
 }
 
@@ -229,7 +242,11 @@ void Heap::String::append(const String *data, QChar *ch)
             worklist.push_back(cs->left);
         } else if (item->subtype == StringType_SubString) {
             const ComplexString *cs = static_cast<const ComplexString *>(item);
-            memcpy(ch, cs->left->toQString().constData() + cs->from, cs->len*sizeof(QChar));
+            // Flattening the underlying string is cached in place, so other
+            // slices of it can copy from the same buffer.
+            if (cs->left->subtype >= StringType_Complex)
+                cs->left->simplifyString();
+            memcpy(static_cast<void *>(ch), static_cast<const void *>(cs->left->text->data() + cs->from), cs->len * sizeof(QChar));
             ch += cs->len;
         } else {
             memcpy(static_cast<void *>(ch), static_cast<const void *>(item->text->data()), item->text->size * sizeof(QChar));
@@ -128,15 +128,9 @@ PropertyKey StringObjectOwnPropertyKeyIterator::next(const QV4::Object *o, Prope
         if (pd)
             pd->value = s->getIndex(index);
         return PropertyKey::fromArrayIndex(index);
-    } else if (arrayIndex == slen) {
-        if (s->arrayData()) {
-            arrayNode = s->sparseBegin();
-            // iterate until we're past the end of the string
-            while (arrayNode && arrayNode->key() < slen)
-                arrayNode = arrayNode->nextNode();
-        }
     }
 
+    // array entries past the end of the string
     return ObjectOwnPropertyKeyIterator::next(o, pd, attrs);
 }
 
@@ -338,6 +332,16 @@ static Heap::String *thisAsString(ExecutionEngine *v4, const QV4::Value *thisObj
     return thisObject->toString(v4);
 }
 
+// Substrings share the storage of the string they are taken from.
+static ReturnedValue substringOf(ExecutionEngine *v4, String *s, int from, int len)
+{
+    if (len <= 0)
+        return v4->id_empty()->asReturnedValue();
+    if (from == 0 && len == s->d()->length())
+        return s->asReturnedValue();
+    return Encode(v4->memoryManager->alloc<ComplexString>(s->d(), from, len));
+}
+
 static QString getThisString(ExecutionEngine *v4, const QV4::Value *thisObject)
 {
     if (String *s = thisObject->stringValue())
@@ -1058,9 +1062,13 @@ ReturnedValue StringPrototype::method_startsWith(const FunctionObject *b, const
 ReturnedValue StringPrototype::method_substr(const FunctionObject *b, const Value *thisObject, const Value *argv, int argc)
 {
     ExecutionEngine *v4 = b->engine();
-    const QString value = getThisString(v4, thisObject);
+    if (thisObject->isNullOrUndefined())
+        return v4->throwTypeError();
+    Scope scope(v4);
+    ScopedString s(scope, thisAsString(v4, thisObject));
     if (v4->hasException)
         return QV4::Encode::undefined();
+    Q_ASSERT(s);
 
     double start = 0;
     if (argc > 0)
@@ -1070,25 +1078,31 @@ ReturnedValue StringPrototype::method_substr(const FunctionObject *b, const Valu
     if (argc > 1)
         length = argv[1].toInteger();
 
-    double count = value.length();
+    double count = s->d()->length();
     if (start < 0)
         start = qMax(count + start, 0.0);
+    else
+        start = qMin(start, count);
 
     length = qMin(qMax(length, 0.0), count - start);
 
     qint32 x = Value::toInt32(start);
     qint32 y = Value::toInt32(length);
-    return Encode(v4->newString(value.mid(x, y)));
+    return substringOf(v4, s, x, y);
 }
 
 ReturnedValue StringPrototype::method_substring(const FunctionObject *b, const Value *thisObject, const Value *argv, int argc)
 {
     ExecutionEngine *v4 = b->engine();
-    const QString value = getThisString(v4, thisObject);
+    if (thisObject->isNullOrUndefined())
+        return v4->throwTypeError();
+    Scope scope(v4);
+    ScopedString s(scope, thisAsString(v4, thisObject));
     if (v4->hasException)
         return QV4::Encode::undefined();
+    Q_ASSERT(s);
 
-    int length = value.length();
+    int length = s->d()->length();
 
     double start = 0;
     double end = length;
@@ -1119,7 +1133,7 @@ ReturnedValue StringPrototype::method_substring(const FunctionObject *b, const V
 
     qint32 x = (int)start;
     qint32 y = (int)(end - start);
-    return Encode(v4->newString(value.mid(x, y)));
+    return substringOf(v4, s, x, y);
 }
 
 ReturnedValue StringPrototype::method_toLowerCase(const FunctionObject *b, const Value *thisObject, const Value *, int)
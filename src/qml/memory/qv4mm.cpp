@@ -1087,6 +1087,9 @@ void MemoryManager::runGC()
     QScopedValueRollback<bool> gcBlocker(gcBlocked, true);
 //    qDebug() << "runGC";
 
+    QElapsedTimer gcTimer;
+    gcTimer.start();
+
     if (gcStats) {
         statistics.maxReservedMem = qMax(statistics.maxReservedMem, getAllocatedMem());
         statistics.maxAllocatedMem = qMax(statistics.maxAllocatedMem, getUsedMem() + getLargeItemsMem());
@@ -1184,6 +1187,8 @@ void MemoryManager::runGC()
     blockAllocator.resetBlackBits();
     hugeItemAllocator.resetBlackBits();
     icAllocator.resetBlackBits();
+
+    totalGCTime += gcTimer.nsecsElapsed();
 }
 
 size_t MemoryManager::getUsedMem() const
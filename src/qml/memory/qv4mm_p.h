@@ -313,6 +313,7 @@ public:
 
     int allocationCount = 0;
     size_t lastAllocRequestedSlots = 0;
+    qint64 totalGCTime = 0; // nanoseconds spent in runGC()
 
     struct {
         size_t maxReservedMem = 0;
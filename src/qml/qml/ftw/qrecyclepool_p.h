@@ -109,6 +109,8 @@ public:
 
     static inline void Delete(T *);
 
+    int outstandingItems() const { return d->outstandingItems; }
+
 private:
     QRecyclePoolPrivate<T, Step> *d;
 };
@@ -37,6 +37,7 @@ SOURCES += \
     $$PWD/qqmlfile.cpp \
     $$PWD/qqmlplatform.cpp \
     $$PWD/qqmlbinding.cpp \
+    $$PWD/qqmlbindingscheduler.cpp \
     $$PWD/qqmlabstracturlinterceptor.cpp \
     $$PWD/qqmlapplicationengine.cpp \
     $$PWD/qqmllistwrapper.cpp \
@@ -103,6 +104,7 @@ HEADERS += \
     $$PWD/qqmlfile.h \
     $$PWD/qqmlplatform_p.h \
     $$PWD/qqmlbinding_p.h \
+    $$PWD/qqmlbindingscheduler_p.h \
     $$PWD/qqmlextensionplugin_p.h \
     $$PWD/qqmlabstracturlinterceptor.h \
     $$PWD/qqmlapplicationengine_p.h \
@@ -43,6 +43,7 @@
 #include "qqmlcontext.h"
 #include "qqmlinfo.h"
 #include "qqmldata_p.h"
+#include "qqmlbindingscheduler_p.h"
 #include <private/qqmlprofiler_p.h>
 #include <private/qqmlexpression_p.h>
 #include <private/qqmlscriptstring_p.h>
@@ -147,6 +148,47 @@ QQmlBinding::~QQmlBinding()
     delete m_sourceLocation;
 }
 
+/*!
+    \internal
+
+    Bindings are allocated from the slab pool of the \a engine that creates them. Creating
+    a component instance usually creates many bindings at once, and allocating them from
+    the pool avoids a heap allocation per binding, keeps the bindings of one instantiation
+    close together in memory and recycles the memory of destroyed bindings for the next
+    instantiation.
+*/
+void *QQmlBinding::operator new(size_t size, QQmlEnginePrivate *engine)
+{
+    QQmlBindingStorage *storage = nullptr;
+    if (engine && size <= sizeof(storage->data)) {
+        storage = engine->bindingPool.New();
+        storage->pooled = true;
+    } else {
+        storage = static_cast<QQmlBindingStorage *>(malloc(offsetof(QQmlBindingStorage, data) + size));
+        Q_CHECK_PTR(storage);
+        storage->pooled = false;
+    }
+    return storage->data;
+}
+
+void QQmlBinding::operator delete(void *ptr, QQmlEnginePrivate *)
+{
+    QQmlBinding::operator delete(ptr);
+}
+
+void QQmlBinding::operator delete(void *ptr)
+{
+    if (!ptr)
+        return;
+
+    QQmlBindingStorage *storage = reinterpret_cast<QQmlBindingStorage *>(
+                static_cast<char *>(ptr) - offsetof(QQmlBindingStorage, data));
+    if (storage->pooled)
+        QQmlBindingPool::Delete(storage);
+    else
+        free(storage);
+}
+
 void QQmlBinding::setNotifyOnValueChanged(bool v)
 {
     QQmlJavaScriptExpression::setNotifyOnValueChanged(v);
@@ -186,6 +228,8 @@ void QQmlBinding::update(QQmlPropertyData::WriteFlags flags)
 
     if (!watcher.wasDeleted())
         setUpdatingFlag(false);
+
+    scope.engine->promiseReactionCheckpoint();
 }
 
 QV4::ReturnedValue QQmlBinding::evaluate(bool *isUndefined)
@@ -382,7 +426,7 @@ private:
 
 QQmlBinding *QQmlBinding::createTranslationBinding(const QQmlRefPointer<QV4::CompiledData::CompilationUnit> &unit, const QV4::CompiledData::Binding *binding, QObject *obj, QQmlContextData *ctxt)
 {
-    QQmlTranslationBinding *b = new QQmlTranslationBinding(unit, binding);
+    QQmlTranslationBinding *b = new (QQmlEnginePrivate::get(ctxt)) QQmlTranslationBinding(unit, binding);
 
     b->setNotifyOnValueChanged(true);
     b->QQmlJavaScriptExpression::setContext(ctxt);
@@ -529,6 +573,21 @@ QString QQmlBinding::expressionIdentifier() const
 
 void QQmlBinding::expressionChanged()
 {
+    if (!m_targetIndex.hasValueTypeIndex() && targetObject()) {
+        QQmlData *data = QQmlData::get(targetObject());
+        if (data && data->bindingUpdatesSuspended) {
+            // Defer the evaluation until the property is read or the updates are resumed.
+            setEnabled(false);
+            data->setPendingBindingBit(targetObject(), m_targetIndex.coreIndex());
+            return;
+        }
+    }
+
+    if (QQmlBindingScheduler::isEnabled()) {
+        QQmlBindingScheduler::instance()->schedule(this);
+        return;
+    }
+
     update();
 }
 
@@ -735,27 +794,27 @@ protected:
 QQmlBinding *QQmlBinding::newBinding(QQmlEnginePrivate *engine, const QQmlPropertyData *property)
 {
     if (property && property->isQObject())
-        return new QObjectPointerBinding(engine, property->propType());
+        return new (engine) QObjectPointerBinding(engine, property->propType());
 
     const int type = (property && property->isFullyResolved()) ? property->propType() : QMetaType::UnknownType;
 
     if (type == qMetaTypeId<QQmlBinding *>()) {
-        return new QQmlBindingBinding;
+        return new (engine) QQmlBindingBinding;
     }
 
     switch (type) {
     case QMetaType::Bool:
-        return new GenericBinding<QMetaType::Bool>;
+        return new (engine) GenericBinding<QMetaType::Bool>;
     case QMetaType::Int:
-        return new GenericBinding<QMetaType::Int>;
+        return new (engine) GenericBinding<QMetaType::Int>;
     case QMetaType::Double:
-        return new GenericBinding<QMetaType::Double>;
+        return new (engine) GenericBinding<QMetaType::Double>;
     case QMetaType::Float:
-        return new GenericBinding<QMetaType::Float>;
+        return new (engine) GenericBinding<QMetaType::Float>;
     case QMetaType::QString:
-        return new GenericBinding<QMetaType::QString>;
+        return new (engine) GenericBinding<QMetaType::QString>;
     default:
-        return new GenericBinding<QMetaType::UnknownType>;
+        return new (engine) GenericBinding<QMetaType::UnknownType>;
     }
 }
 
@@ -83,6 +83,10 @@ public:
                                                  QObject *obj, QQmlContextData *ctxt);
     ~QQmlBinding() override;
 
+    void *operator new(size_t size, QQmlEnginePrivate *engine);
+    void operator delete(void *ptr, QQmlEnginePrivate *engine);
+    void operator delete(void *ptr);
+
     void setTarget(const QQmlProperty &);
     bool setTarget(QObject *, const QQmlPropertyData &, const QQmlPropertyData *valueType);
 
@@ -0,0 +1,195 @@
+/****************************************************************************
+**
+** Copyright (C) 2019 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtQml module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include "qqmlbindingscheduler_p.h"
+
+#include <private/qqmlglobal_p.h>
+#include <QtQml/qqmlinfo.h>
+
+#include <QtCore/qset.h>
+#include <QtCore/qthreadstorage.h>
+#include <QtCore/qtimer.h>
+
+#include <algorithm>
+#include <functional>
+
+QT_BEGIN_NAMESPACE
+
+DEFINE_BOOL_CONFIG_OPTION(qmlBatchedBindingUpdates, QML_BATCHED_BINDING_UPDATES)
+
+#ifndef QT_NO_THREAD
+Q_GLOBAL_STATIC(QThreadStorage<QQmlBindingScheduler *>, bindingScheduler)
+#endif
+
+bool QQmlBindingScheduler::isEnabled()
+{
+    return qmlBatchedBindingUpdates();
+}
+
+QQmlBindingScheduler *QQmlBindingScheduler::instance(bool create)
+{
+#ifndef QT_NO_THREAD
+    QQmlBindingScheduler *inst;
+    if (create && !bindingScheduler()->hasLocalData()) {
+        inst = new QQmlBindingScheduler;
+        bindingScheduler()->setLocalData(inst);
+    } else {
+        inst = bindingScheduler() ? bindingScheduler()->localData() : nullptr;
+    }
+    return inst;
+#else
+    static QQmlBindingScheduler scheduler;
+    Q_UNUSED(create);
+    return &scheduler;
+#endif
+}
+
+void QQmlBindingScheduler::flushCurrentThread()
+{
+    if (QQmlBindingScheduler *scheduler = instance(false))
+        scheduler->flush();
+}
+
+void QQmlBindingScheduler::objectDestroyed(QObject *object)
+{
+    if (!isEnabled())
+        return;
+    QQmlBindingScheduler *scheduler = instance(false);
+    if (!scheduler || scheduler->m_entries.isEmpty())
+        return;
+
+    // The entries keep the bindings alive, but not their target. Stale queue items are
+    // skipped in flush(), as they no longer have an entry.
+    for (auto it = scheduler->m_targets.find(object);
+         it != scheduler->m_targets.end() && it.key() == object;
+         it = scheduler->m_targets.erase(it)) {
+        scheduler->m_entries.remove(it.value());
+    }
+}
+
+/*
+    Bindings are ordered by rank: a binding scheduled outside of a flush has rank 0, and a
+    binding scheduled while another one is evaluated has the rank of that binding plus one.
+    When a binding that is still queued is notified again by a binding of the same or a
+    higher rank, it is moved behind that binding instead of being queued twice. This way
+    bindings depending on several changed properties are evaluated once, after all of their
+    dependencies are up to date.
+
+    In an acyclic dependency graph a rank can never exceed the number of bindings involved,
+    so a higher rank means that the bindings depend on each other in a loop.
+*/
+void QQmlBindingScheduler::schedule(QQmlBinding *binding)
+{
+    const int rank = m_evaluating ? m_entries.value(m_evaluating).rank + 1 : 0;
+
+    Entry &entry = m_entries[binding];
+    if (!entry.binding) {
+        entry.binding = binding;
+        m_targets.insert(binding->targetObject(), binding);
+    }
+
+    if (entry.queued && entry.rank >= rank)
+        return;
+
+    entry.cause = m_evaluating;
+    if (rank > m_entries.count()) {
+        reportLoop(binding);
+        return;
+    }
+
+    entry.rank = rank;
+    entry.queued = true;
+    m_queue.push_back({rank, m_sequence++, binding});
+    std::push_heap(m_queue.begin(), m_queue.end(), std::greater<QueueItem>());
+
+    if (!m_flushPosted) {
+        m_flushPosted = true;
+        QTimer::singleShot(0, &QQmlBindingScheduler::flushCurrentThread);
+    }
+}
+
+void QQmlBindingScheduler::flush()
+{
+    if (m_flushing)
+        return;
+    m_flushing = true;
+
+    while (!m_queue.empty()) {
+        std::pop_heap(m_queue.begin(), m_queue.end(), std::greater<QueueItem>());
+        const QueueItem item = m_queue.back();
+        m_queue.pop_back();
+
+        auto it = m_entries.find(item.binding);
+        if (it == m_entries.end() || !it->queued || it->rank != item.rank)
+            continue;
+        it->queued = false;
+
+        // Evaluating the binding can schedule others, which may invalidate the iterator.
+        QQmlBinding::Ptr binding = it->binding;
+        m_evaluating = binding.data();
+        binding->update();
+        m_evaluating = nullptr;
+    }
+
+    m_entries.clear();
+    m_targets.clear();
+    m_sequence = 0;
+    m_flushing = false;
+    m_flushPosted = false;
+}
+
+void QQmlBindingScheduler::reportLoop(QQmlBinding *binding) const
+{
+    // Walk back along the bindings that caused each other to be scheduled.
+    QStringList chain;
+    QSet<QQmlBinding *> visited;
+    QQmlBinding *b = binding;
+    while (b && !visited.contains(b)) {
+        visited.insert(b);
+        chain.prepend(b->expressionIdentifier());
+        b = m_entries.value(b).cause;
+    }
+    if (b)
+        chain.prepend(b->expressionIdentifier());
+
+    qmlWarning(binding->targetObject())
+            << QString(QLatin1String("Binding loop detected: %1")).arg(chain.join(QLatin1String(" -> ")));
+}
+
+QT_END_NAMESPACE
@@ -0,0 +1,117 @@
+/****************************************************************************
+**
+** Copyright (C) 2019 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtQml module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#ifndef QQMLBINDINGSCHEDULER_P_H
+#define QQMLBINDINGSCHEDULER_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists purely as an
+// implementation detail.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <private/qqmlbinding_p.h>
+
+#include <QtCore/qhash.h>
+
+#include <vector>
+
+QT_BEGIN_NAMESPACE
+
+// Collects the bindings whose dependencies changed and evaluates each of them once,
+// in dependency order, instead of once per change notification. Enabled with the
+// QML_BATCHED_BINDING_UPDATES environment variable. There is one scheduler per thread.
+class Q_QML_PRIVATE_EXPORT QQmlBindingScheduler
+{
+public:
+    static bool isEnabled();
+    static QQmlBindingScheduler *instance(bool create = true);
+
+    // Evaluates the bindings scheduled in the current thread, if any.
+    static void flushCurrentThread();
+
+    // Drops the scheduled bindings of an object that is being destroyed.
+    static void objectDestroyed(QObject *object);
+
+    void schedule(QQmlBinding *binding);
+    void flush();
+
+private:
+    struct Entry
+    {
+        QQmlBinding::Ptr binding;
+        QQmlBinding *cause = nullptr;
+        int rank = 0;
+        bool queued = false;
+    };
+
+    struct QueueItem
+    {
+        int rank;
+        quint64 sequence;
+        QQmlBinding *binding;
+
+        bool operator>(const QueueItem &other) const
+        {
+            return rank > other.rank || (rank == other.rank && sequence > other.sequence);
+        }
+    };
+
+    void reportLoop(QQmlBinding *binding) const;
+
+    // State of all bindings scheduled since the last flush completed.
+    QHash<QQmlBinding *, Entry> m_entries;
+    // The bindings in m_entries by target object, so that destroying objects stays linear.
+    QMultiHash<QObject *, QQmlBinding *> m_targets;
+    // Min-heap ordered by rank. Items that no longer match their entry are skipped.
+    std::vector<QueueItem> m_queue;
+    QQmlBinding *m_evaluating = nullptr;
+    quint64 m_sequence = 0;
+    bool m_flushing = false;
+    bool m_flushPosted = false;
+};
+
+QT_END_NAMESPACE
+
+#endif // QQMLBINDINGSCHEDULER_P_H
@@ -225,6 +225,7 @@ void QQmlBoundSignalExpression::evaluate(void **a)
     QQmlJavaScriptExpression::evaluate(jsCall.callData(), nullptr);
 
     ep->dereferenceScarceResources(); // "release" scarce resources if top-level expression evaluation is complete.
+    scope.engine->promiseReactionCheckpoint();
 }
 
 void QQmlBoundSignalExpression::evaluate(const QList<QVariant> &args)
@@ -248,6 +249,7 @@ void QQmlBoundSignalExpression::evaluate(const QList<QVariant> &args)
     QQmlJavaScriptExpression::evaluate(jsCall.callData(), nullptr);
 
     ep->dereferenceScarceResources(); // "release" scarce resources if top-level expression evaluation is complete.
+    scope.engine->promiseReactionCheckpoint();
 }
 
 ////////////////////////////////////////////////////////////////////////
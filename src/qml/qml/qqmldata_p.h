@@ -158,7 +158,8 @@ public:
     quint32 hasInterceptorMetaObject:1;
     quint32 hasVMEMetaObject:1;
     quint32 parentFrozen:1;
-    quint32 dummy:6;
+    quint32 bindingUpdatesSuspended:1;
+    quint32 dummy:5;
 
     // When bindingBitsSize < sizeof(ptr), we store the binding bit flags inside
     // bindingBitsValue. When we need more than sizeof(ptr) bits, we allocated
@@ -273,6 +274,7 @@ public:
     static void setQueuedForDeletion(QObject *);
 
     static inline void flushPendingBinding(QObject *, QQmlPropertyIndex propertyIndex);
+    static void setBindingUpdatesSuspended(QObject *, bool suspended);
 
     static QQmlPropertyCache *ensurePropertyCache(QJSEngine *engine, QObject *object)
     {
@@ -59,6 +59,7 @@
 #include "qqmlincubator.h"
 #include "qqmlabstracturlinterceptor.h"
 #include <private/qqmlboundsignal_p.h>
+#include <private/qqmlbindingscheduler_p.h>
 #include <QtCore/qstandardpaths.h>
 #include <QtCore/qsettings.h>
 #include <QtCore/qmetaobject.h>
@@ -68,6 +69,7 @@
 #include <QtCore/qdir.h>
 #include <QtCore/qmutex.h>
 #include <QtCore/qthread.h>
+#include <QtCore/qvarlengtharray.h>
 #include <private/qthread_p.h>
 
 #if QT_CONFIG(qml_network)
@@ -773,7 +775,7 @@ QQmlData::QQmlData()
     : ownedByQml1(false), ownMemory(true), indestructible(true), explicitIndestructibleSet(false),
       hasTaintedV4Object(false), isQueuedForDeletion(false), rootObjectInCreation(false),
       hasInterceptorMetaObject(false), hasVMEMetaObject(false), parentFrozen(false),
-      bindingBitsArraySize(InlineBindingArraySize), notifyList(nullptr),
+      bindingUpdatesSuspended(false), bindingBitsArraySize(InlineBindingArraySize), notifyList(nullptr),
       bindings(nullptr), signalHandlers(nullptr), nextContextObject(nullptr), prevContextObject(nullptr),
       lineNumber(0), columnNumber(0), jsEngineId(0),
       propertyCache(nullptr), guards(nullptr), extendedData(nullptr)
@@ -957,6 +959,33 @@ void QQmlData::flushPendingBindingImpl(QQmlPropertyIndex index)
                             QQmlPropertyData::DontRemoveBinding);
 }
 
+/*
+    While binding updates are suspended, bindings on the object are not evaluated when their
+    dependencies change. They are disabled and marked as pending instead, and evaluated when
+    their property is read from JavaScript or when the updates are resumed.
+*/
+void QQmlData::setBindingUpdatesSuspended(QObject *object, bool suspended)
+{
+    QQmlData *data = QQmlData::get(object);
+    if (!data || data->bindingUpdatesSuspended == suspended)
+        return;
+
+    data->bindingUpdatesSuspended = suspended;
+    if (suspended)
+        return;
+
+    // Evaluating a binding may add or remove other bindings, so collect the pending ones first.
+    QVarLengthArray<int, 16> pendingBindings;
+    for (QQmlAbstractBinding *b = data->bindings; b; b = b->nextBinding()) {
+        const QQmlPropertyIndex index = b->targetPropertyIndex();
+        if (!index.hasValueTypeIndex() && data->hasPendingBindingBit(index.coreIndex()))
+            pendingBindings.append(index.coreIndex());
+    }
+
+    for (int coreIndex : qAsConst(pendingBindings))
+        flushPendingBinding(object, QQmlPropertyIndex(coreIndex));
+}
+
 QQmlData::DeferredData::DeferredData()
 {
 }
@@ -1885,6 +1914,8 @@ void QQmlData::destroyed(QObject *object)
     else if (outerContext && outerContext->contextObjects == this)
         outerContext->contextObjects = nextContextObject;
 
+    QQmlBindingScheduler::objectDestroyed(object);
+
     QQmlAbstractBinding *binding = bindings;
     while (binding) {
         binding->setAddedToObject(false);
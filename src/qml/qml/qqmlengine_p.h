@@ -117,6 +117,20 @@ public:
     QQmlJavaScriptExpressionGuard *next;
 };
 
+// Bindings created by an engine are allocated from fixed size slabs owned by the engine,
+// rather than one heap allocation each. See QQmlBinding::operator new().
+struct QQmlBindingStorage
+{
+    quintptr pooled;
+    // Bindings hold 64-bit members, which must stay aligned on 32-bit targets as well
+    union {
+        char data[24 * sizeof(void *)];
+        qint64 q_for_alignment_1;
+        double q_for_alignment_2;
+    };
+};
+typedef QRecyclePool<QQmlBindingStorage, 128> QQmlBindingPool;
+
 class Q_QML_PRIVATE_EXPORT QQmlEnginePrivate : public QJSEnginePrivate
 {
     Q_DECLARE_PUBLIC(QQmlEngine)
@@ -132,6 +146,7 @@ public:
     QQmlPropertyCapture *propertyCapture;
 
     QRecyclePool<QQmlJavaScriptExpressionGuard> jsExpressionGuardPool;
+    QQmlBindingPool bindingPool;
 
     QQmlContext *rootContext;
 
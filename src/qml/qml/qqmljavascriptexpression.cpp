@@ -197,11 +197,15 @@ QV4::ReturnedValue QQmlJavaScriptExpression::evaluate(QV4::CallData *callData, b
     Q_ASSERT(notifyOnValueChanged() || activeGuards.isEmpty());
     QQmlPropertyCapture capture(m_context->engine, this, &watcher);
 
+    // Expressions whose dependencies are known to be the same on every evaluation
+    // keep the guards from their first successful evaluation.
+    const bool captureProperties = notifyOnValueChanged() && !m_fixedDependenciesCaptured;
+
     QQmlPropertyCapture *lastPropertyCapture = ep->propertyCapture;
-    ep->propertyCapture = notifyOnValueChanged() ? &capture : nullptr;
+    ep->propertyCapture = captureProperties ? &capture : nullptr;
 
 
-    if (notifyOnValueChanged())
+    if (captureProperties)
         capture.guards.copyAndClearPrepend(activeGuards);
 
     QV4::ExecutionEngine *v4 = m_context->engine->handle();
@@ -232,8 +236,12 @@ QV4::ReturnedValue QQmlJavaScriptExpression::evaluate(QV4::CallData *callData, b
         if (isUndefined)
             *isUndefined = result->isUndefined();
 
-        if (!watcher.wasDeleted() && hasDelayedError())
-            delayedError()->clearError();
+        if (!watcher.wasDeleted()) {
+            if (hasDelayedError())
+                delayedError()->clearError();
+            if (captureProperties && v4Function->hasFixedQmlDependencies())
+                m_fixedDependenciesCaptured = true;
+        }
     }
 
     if (capture.errorString) {
@@ -246,7 +254,7 @@ QV4::ReturnedValue QQmlJavaScriptExpression::evaluate(QV4::CallData *callData, b
     while (QQmlJavaScriptExpressionGuard *g = capture.guards.takeFirst())
         g->Delete();
 
-    if (!watcher.wasDeleted())
+    if (captureProperties && !watcher.wasDeleted())
         setTranslationsCaptured(capture.translationCaptured);
 
     ep->propertyCapture = lastPropertyCapture;
@@ -457,6 +465,7 @@ void QQmlJavaScriptExpression::setupFunction(QV4::ExecutionContext *qmlContext,
         return;
     m_qmlScope.set(qmlContext->engine(), *qmlContext);
     m_v4Function = f;
+    m_fixedDependenciesCaptured = false;
     setCompilationUnit(m_v4Function->compilationUnit);
 }
 
@@ -467,6 +476,7 @@ void QQmlJavaScriptExpression::setCompilationUnit(const QQmlRefPointer<QV4::Comp
 
 void QQmlJavaScriptExpression::clearActiveGuards()
 {
+    m_fixedDependenciesCaptured = false;
     while (QQmlJavaScriptExpressionGuard *g = activeGuards.takeFirst())
         g->Delete();
 }
@@ -187,6 +187,7 @@ private:
     QQmlJavaScriptExpression **m_prevExpression;
     QQmlJavaScriptExpression  *m_nextExpression;
     bool m_permanentDependenciesRegistered = false;
+    bool m_fixedDependenciesCaptured = false;
 
     QV4::PersistentValue m_qmlScope;
     QQmlRefPointer<QV4::CompiledData::CompilationUnit> m_compilationUnit;
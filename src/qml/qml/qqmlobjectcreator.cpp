@@ -412,7 +412,7 @@ void QQmlObjectCreator::setPropertyValue(const QQmlPropertyData *property, const
                 QV4::ScopedString s(scope, v4->newString(stringValue));
                 _vmeMetaObject->setVMEProperty(property->coreIndex(), s);
             } else {
-                QVariant value = QQmlStringConverters::variantFromString(stringValue);
+                QVariant value = literalValue(binding, QMetaType::QVariant);
                 property->writeProperty(_qobject, &value, propertyWriteFlags);
             }
         }
@@ -438,10 +438,7 @@ void QQmlObjectCreator::setPropertyValue(const QQmlPropertyData *property, const
     break;
     case QVariant::Url: {
         Q_ASSERT(binding->type == QV4::CompiledData::Binding::Type_String);
-        QString string = binding->valueAsString(compilationUnit.data());
-        // Encoded dir-separators defeat QUrl processing - decode them first
-        string.replace(QLatin1String("%2f"), QLatin1String("/"), Qt::CaseInsensitive);
-        QUrl value = string.isEmpty() ? QUrl() : compilationUnit->finalUrl().resolved(QUrl(string));
+        QUrl value = literalValue(binding, QVariant::Url).toUrl();
         // Apply URL interceptor
         if (engine->urlInterceptor())
             value = engine->urlInterceptor()->intercept(value, QQmlAbstractUrlInterceptor::UrlString);
@@ -477,9 +474,7 @@ void QQmlObjectCreator::setPropertyValue(const QQmlPropertyData *property, const
     }
     break;
     case QVariant::Color: {
-        bool ok = false;
-        uint colorValue = QQmlStringConverters::rgbaFromString(binding->valueAsString(compilationUnit.data()), &ok);
-        Q_ASSERT(ok);
+        uint colorValue = literalValue(binding, QVariant::Color).toUInt();
         struct { void *data[4]; } buffer;
         if (QQml_valueTypeProvider()->storeValueType(property->propType(), &colorValue, &buffer, sizeof(buffer))) {
             property->writeProperty(_qobject, &buffer, propertyWriteFlags);
@@ -488,72 +483,48 @@ void QQmlObjectCreator::setPropertyValue(const QQmlPropertyData *property, const
     break;
 #if QT_CONFIG(datestring)
     case QVariant::Date: {
-        bool ok = false;
-        QDate value = QQmlStringConverters::dateFromString(binding->valueAsString(compilationUnit.data()), &ok);
-        Q_ASSERT(ok);
+        QDate value = literalValue(binding, QVariant::Date).toDate();
         property->writeProperty(_qobject, &value, propertyWriteFlags);
     }
     break;
     case QVariant::Time: {
-        bool ok = false;
-        QTime value = QQmlStringConverters::timeFromString(binding->valueAsString(compilationUnit.data()), &ok);
-        Q_ASSERT(ok);
+        QTime value = literalValue(binding, QVariant::Time).toTime();
         property->writeProperty(_qobject, &value, propertyWriteFlags);
     }
     break;
     case QVariant::DateTime: {
-        bool ok = false;
-        QDateTime value = QQmlStringConverters::dateTimeFromString(binding->valueAsString(compilationUnit.data()), &ok);
-        // ### VME compatibility :(
-        {
-            const qint64 date = value.date().toJulianDay();
-            const int msecsSinceStartOfDay = value.time().msecsSinceStartOfDay();
-            value = QDateTime(QDate::fromJulianDay(date), QTime::fromMSecsSinceStartOfDay(msecsSinceStartOfDay));
-        }
-        Q_ASSERT(ok);
+        QDateTime value = literalValue(binding, QVariant::DateTime).toDateTime();
         property->writeProperty(_qobject, &value, propertyWriteFlags);
     }
     break;
 #endif // datestring
     case QVariant::Point: {
-        bool ok = false;
-        QPoint value = QQmlStringConverters::pointFFromString(binding->valueAsString(compilationUnit.data()), &ok).toPoint();
-        Q_ASSERT(ok);
+        QPoint value = literalValue(binding, QVariant::Point).toPoint();
         property->writeProperty(_qobject, &value, propertyWriteFlags);
     }
     break;
     case QVariant::PointF: {
-        bool ok = false;
-        QPointF value = QQmlStringConverters::pointFFromString(binding->valueAsString(compilationUnit.data()), &ok);
-        Q_ASSERT(ok);
+        QPointF value = literalValue(binding, QVariant::PointF).toPointF();
         property->writeProperty(_qobject, &value, propertyWriteFlags);
     }
     break;
     case QVariant::Size: {
-        bool ok = false;
-        QSize value = QQmlStringConverters::sizeFFromString(binding->valueAsString(compilationUnit.data()), &ok).toSize();
-        Q_ASSERT(ok);
+        QSize value = literalValue(binding, QVariant::Size).toSize();
         property->writeProperty(_qobject, &value, propertyWriteFlags);
     }
     break;
     case QVariant::SizeF: {
-        bool ok = false;
-        QSizeF value = QQmlStringConverters::sizeFFromString(binding->valueAsString(compilationUnit.data()), &ok);
-        Q_ASSERT(ok);
+        QSizeF value = literalValue(binding, QVariant::SizeF).toSizeF();
         property->writeProperty(_qobject, &value, propertyWriteFlags);
     }
     break;
     case QVariant::Rect: {
-        bool ok = false;
-        QRect value = QQmlStringConverters::rectFFromString(binding->valueAsString(compilationUnit.data()), &ok).toRect();
-        Q_ASSERT(ok);
+        QRect value = literalValue(binding, QVariant::Rect).toRect();
         property->writeProperty(_qobject, &value, propertyWriteFlags);
     }
     break;
     case QVariant::RectF: {
-        bool ok = false;
-        QRectF value = QQmlStringConverters::rectFFromString(binding->valueAsString(compilationUnit.data()), &ok);
-        Q_ASSERT(ok);
+        QRectF value = literalValue(binding, QVariant::RectF).toRectF();
         property->writeProperty(_qobject, &value, propertyWriteFlags);
     }
     break;
@@ -669,14 +640,11 @@ void QQmlObjectCreator::setPropertyValue(const QQmlPropertyData *property, const
         }
 
         // otherwise, try a custom type assignment
-        QString stringValue = binding->valueAsString(compilationUnit.data());
-        QQmlMetaType::StringConverter converter = QQmlMetaType::customStringConverter(property->propType());
-        Q_ASSERT(converter);
-        QVariant value = (*converter)(stringValue);
+        QVariant value = literalValue(binding, property->propType());
 
         QMetaProperty metaProperty = _qobject->metaObject()->property(property->coreIndex());
         if (value.isNull() || ((int)metaProperty.type() != property->propType() && metaProperty.userType() != property->propType())) {
-            recordError(binding->location, tr("Cannot assign value %1 to property %2").arg(stringValue).arg(QString::fromUtf8(metaProperty.name())));
+            recordError(binding->location, tr("Cannot assign value %1 to property %2").arg(binding->valueAsString(compilationUnit.data())).arg(QString::fromUtf8(metaProperty.name())));
             break;
         }
 
@@ -686,6 +654,81 @@ void QQmlObjectCreator::setPropertyValue(const QQmlPropertyData *property, const
     }
 }
 
+QVariant QQmlObjectCreator::literalValue(const QV4::CompiledData::Binding *binding, int propertyType)
+{
+    auto it = compilationUnit->literalValueSnapshot.constFind(binding);
+    if (it != compilationUnit->literalValueSnapshot.constEnd())
+        return *it;
+
+    QString string = binding->valueAsString(compilationUnit.data());
+    QVariant value;
+    bool ok = true;
+
+    switch (propertyType) {
+    case QMetaType::QVariant:
+        value = QQmlStringConverters::variantFromString(string);
+        break;
+    case QVariant::Url:
+        // Encoded dir-separators defeat QUrl processing - decode them first
+        string.replace(QLatin1String("%2f"), QLatin1String("/"), Qt::CaseInsensitive);
+        value = string.isEmpty() ? QUrl() : compilationUnit->finalUrl().resolved(QUrl(string));
+        break;
+    case QVariant::Color:
+        value = QQmlStringConverters::rgbaFromString(string, &ok);
+        break;
+#if QT_CONFIG(datestring)
+    case QVariant::Date:
+        value = QQmlStringConverters::dateFromString(string, &ok);
+        break;
+    case QVariant::Time:
+        value = QQmlStringConverters::timeFromString(string, &ok);
+        break;
+    case QVariant::DateTime: {
+        QDateTime dateTime = QQmlStringConverters::dateTimeFromString(string, &ok);
+        // ### VME compatibility :(
+        {
+            const qint64 date = dateTime.date().toJulianDay();
+            const int msecsSinceStartOfDay = dateTime.time().msecsSinceStartOfDay();
+            dateTime = QDateTime(QDate::fromJulianDay(date), QTime::fromMSecsSinceStartOfDay(msecsSinceStartOfDay));
+        }
+        value = dateTime;
+        break;
+    }
+#endif // datestring
+    case QVariant::Point:
+        value = QQmlStringConverters::pointFFromString(string, &ok).toPoint();
+        break;
+    case QVariant::PointF:
+        value = QQmlStringConverters::pointFFromString(string, &ok);
+        break;
+    case QVariant::Size:
+        value = QQmlStringConverters::sizeFFromString(string, &ok).toSize();
+        break;
+    case QVariant::SizeF:
+        value = QQmlStringConverters::sizeFFromString(string, &ok);
+        break;
+    case QVariant::Rect:
+        value = QQmlStringConverters::rectFFromString(string, &ok).toRect();
+        break;
+    case QVariant::RectF:
+        value = QQmlStringConverters::rectFFromString(string, &ok);
+        break;
+    default: {
+        QQmlMetaType::StringConverter converter = QQmlMetaType::customStringConverter(propertyType);
+        Q_ASSERT(converter);
+        value = (*converter)(string);
+        ok = !value.isNull();
+        break;
+    }
+    }
+
+    // Custom converters report failure through a null value. Don't remember those, so
+    // that the error is recorded again for every instantiation.
+    if (ok)
+        compilationUnit->literalValueSnapshot.insert(binding, value);
+    return value;
+}
+
 static QQmlType qmlTypeForObject(QObject *object)
 {
     QQmlType type;
@@ -1342,7 +1385,13 @@ QQmlContextData *QQmlObjectCreator::finalize(QQmlInstantiationInterrupt &interru
             continue;
         QQmlData *data = QQmlData::get(b->targetObject());
         Q_ASSERT(data);
-        data->clearPendingBindingBit(b->targetPropertyIndex().coreIndex());
+        const int coreIndex = b->targetPropertyIndex().coreIndex();
+        if (data->bindingUpdatesSuspended && !b->targetPropertyIndex().hasValueTypeIndex()
+                && data->hasPendingBindingBit(coreIndex)) {
+            // Leave the binding pending, it is evaluated once the updates are resumed.
+            continue;
+        }
+        data->clearPendingBindingBit(coreIndex);
         b->setEnabled(true, QQmlPropertyData::BypassInterceptor |
                       QQmlPropertyData::DontRemoveBinding);
         if (!b->isValueTypeProxy()) {
@@ -116,6 +116,7 @@ private:
     void setupBindings(bool applyDeferredBindings = false);
     bool setPropertyBinding(const QQmlPropertyData *property, const QV4::CompiledData::Binding *binding);
     void setPropertyValue(const QQmlPropertyData *property, const QV4::CompiledData::Binding *binding);
+    QVariant literalValue(const QV4::CompiledData::Binding *binding, int propertyType);
     void setupFunctions();
 
     QString stringAt(int idx) const { return compilationUnit->stringAt(idx); }
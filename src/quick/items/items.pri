@@ -6,6 +6,8 @@ HEADERS += \
     $$PWD/qquickitem.h \
     $$PWD/qquickitem_p.h \
     $$PWD/qquickitemchangelistener_p.h \
+    $$PWD/qquickframetimings_p.h \
+    $$PWD/qquickhittestindex_p.h \
     $$PWD/qquickrectangle_p.h \
     $$PWD/qquickrectangle_p_p.h \
     $$PWD/qquickwindow.h \
@@ -69,6 +71,8 @@ SOURCES += \
     $$PWD/qquickitem.cpp \
     $$PWD/qquickrectangle.cpp \
     $$PWD/qquickwindow.cpp \
+    $$PWD/qquickframetimings.cpp \
+    $$PWD/qquickhittestindex.cpp \
     $$PWD/qquickfocusscope.cpp \
     $$PWD/qquickitemsmodule.cpp \
     $$PWD/qquickpainteditem.cpp \
@@ -0,0 +1,332 @@
+/****************************************************************************
+**
+** Copyright (C) 2019 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtQuick module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#include "qquickframetimings_p.h"
+#include "qquickwindow.h"
+#include "qquickitem.h"
+
+#include <QtCore/qfile.h>
+#include <QtCore/qmath.h>
+#include <QtCore/qtextstream.h>
+#include <QtQml/qqml.h>
+#include <QtQml/qqmlengine.h>
+#include <private/qv4engine_p.h>
+#include <private/qv4mm_p.h>
+
+#include <algorithm>
+
+QT_BEGIN_NAMESPACE
+
+static const int DefaultCapacity = 1000;
+
+static const char *phaseNames[] = {
+    "polish",
+    "animations",
+    "sync",
+    "updatePaintNode",
+    "render",
+    "swap",
+    "garbageCollection",
+    "total"
+};
+
+static qint64 phaseTime(const QQuickFrameTiming &frame, QQuickFrameTimings::Phase phase)
+{
+    switch (phase) {
+    case QQuickFrameTimings::Polish: return frame.polish;
+    case QQuickFrameTimings::Animations: return frame.animations;
+    case QQuickFrameTimings::Sync: return frame.sync;
+    case QQuickFrameTimings::UpdatePaintNode: return frame.updatePaintNode;
+    case QQuickFrameTimings::Render: return frame.render;
+    case QQuickFrameTimings::Swap: return frame.swap;
+    case QQuickFrameTimings::GarbageCollection: return frame.garbageCollection;
+    case QQuickFrameTimings::Total: return frame.total();
+    }
+    return 0;
+}
+
+static inline qreal toMilliseconds(qint64 nsecs)
+{
+    return nsecs / qreal(1000000);
+}
+
+// Nearest rank percentile of \a values, which must be sorted
+static qint64 percentileOf(const QVector<qint64> &values, qreal percent)
+{
+    if (values.isEmpty())
+        return 0;
+    const int rank = qCeil(qBound<qreal>(0, percent, 100) / 100 * values.size());
+    return values.at(qBound(0, rank - 1, values.size() - 1));
+}
+
+static QVector<qint64> sortedPhaseTimes(const QVector<QQuickFrameTiming> &frames, QQuickFrameTimings::Phase phase)
+{
+    QVector<qint64> values;
+    values.reserve(frames.size());
+    for (const QQuickFrameTiming &frame : frames)
+        values.append(phaseTime(frame, phase));
+    std::sort(values.begin(), values.end());
+    return values;
+}
+
+QQuickFrameTimings::QQuickFrameTimings(QQuickWindow *window)
+    : QObject(window)
+    , m_window(window)
+    , m_garbageCollectionTime(0)
+    , m_enabled(false)
+    , m_frames(DefaultCapacity)
+    , m_next(0)
+    , m_count(0)
+{
+    const int capacity = qEnvironmentVariableIntValue("QSG_FRAME_TIMINGS");
+    if (capacity > 1)
+        m_frames.resize(capacity);
+    m_clock.start();
+}
+
+QQuickFrameTimings::~QQuickFrameTimings()
+{
+    const QString fileName = qEnvironmentVariable("QSG_FRAME_TIMINGS_FILE");
+    if (fileName.isEmpty() || !m_count)
+        return;
+
+    QFile file(fileName);
+    if (file.open(QIODevice::WriteOnly | QIODevice::Append | QIODevice::Text))
+        writePercentiles(&file, frames());
+    else
+        qWarning("QQuickFrameTimings: cannot write to %s", qPrintable(fileName));
+}
+
+/*
+    QSG_FRAME_TIMINGS=1 records the timings of every window; larger values
+    also set the number of frames kept. QSG_FRAME_TIMINGS_FILE=<file> records
+    them as well, and appends the percentiles of each window to the file when
+    the window is destroyed.
+ */
+bool QQuickFrameTimings::isEnabledByDefault()
+{
+    static const bool enabled = qEnvironmentVariableIntValue("QSG_FRAME_TIMINGS") > 0
+            || !qEnvironmentVariableIsEmpty("QSG_FRAME_TIMINGS_FILE");
+    return enabled;
+}
+
+void QQuickFrameTimings::setEnabled(bool enabled)
+{
+    if (m_enabled == enabled)
+        return;
+
+    {
+        QMutexLocker locker(&m_mutex);
+        m_enabled = enabled;
+        // Start over from the next frame, and don't count what the garbage
+        // collector did while not recording.
+        m_guiThreadFrame = QQuickFrameTiming();
+        m_engine = nullptr;
+    }
+    emit enabledChanged();
+}
+
+int QQuickFrameTimings::capacity() const
+{
+    QMutexLocker locker(&m_mutex);
+    return m_frames.size();
+}
+
+void QQuickFrameTimings::setCapacity(int capacity)
+{
+    capacity = qMax(1, capacity);
+    {
+        QMutexLocker locker(&m_mutex);
+        if (capacity == m_frames.size())
+            return;
+
+        // Keep the most recent frames
+        QVector<QQuickFrameTiming> frames;
+        frames.reserve(capacity);
+        const int keep = qMin(m_count, capacity);
+        for (int i = m_count - keep; i < m_count; ++i)
+            frames.append(m_frames.at((m_next - m_count + i + m_frames.size()) % m_frames.size()));
+        m_count = keep;
+        m_next = keep % capacity;
+        frames.resize(capacity);
+        m_frames = frames;
+    }
+    emit capacityChanged();
+}
+
+QVector<QQuickFrameTiming> QQuickFrameTimings::frames() const
+{
+    QMutexLocker locker(&m_mutex);
+    QVector<QQuickFrameTiming> frames;
+    frames.reserve(m_count);
+    const int first = m_next - m_count + m_frames.size();
+    for (int i = 0; i < m_count; ++i)
+        frames.append(m_frames.at((first + i) % m_frames.size()));
+    return frames;
+}
+
+int QQuickFrameTimings::frameCount() const
+{
+    QMutexLocker locker(&m_mutex);
+    return m_count;
+}
+
+/*
+    The recorded frames, oldest first, as objects holding the phase times in
+    milliseconds.
+ */
+QVariantList QQuickFrameTimings::frameList() const
+{
+    QVariantList list;
+    const QVector<QQuickFrameTiming> recorded = frames();
+    list.reserve(recorded.size());
+    for (const QQuickFrameTiming &frame : recorded) {
+        QVariantMap map;
+        map.insert(QStringLiteral("timestamp"), toMilliseconds(frame.timestamp));
+        for (int phase = Polish; phase <= Total; ++phase)
+            map.insert(QLatin1String(phaseNames[phase]), toMilliseconds(phaseTime(frame, Phase(phase))));
+        list.append(map);
+    }
+    return list;
+}
+
+/*
+    The time in milliseconds that \a percent percent of the recorded frames
+    spent at most in \a phase.
+ */
+qreal QQuickFrameTimings::percentile(Phase phase, qreal percent) const
+{
+    return toMilliseconds(percentileOf(sortedPhaseTimes(frames(), phase), percent));
+}
+
+void QQuickFrameTimings::clear()
+{
+    QMutexLocker locker(&m_mutex);
+    m_next = 0;
+    m_count = 0;
+}
+
+bool QQuickFrameTimings::dump(const QString &fileName) const
+{
+    QFile file(fileName);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate | QIODevice::Text))
+        return false;
+    writePercentiles(&file, frames());
+    return true;
+}
+
+QQuickFrameTiming QQuickFrameTimings::takeGuiThreadFrame()
+{
+    QMutexLocker locker(&m_mutex);
+    QQuickFrameTiming frame = m_guiThreadFrame;
+    m_guiThreadFrame = QQuickFrameTiming();
+
+    const qint64 garbageCollectionTime = totalGarbageCollectionTime();
+    frame.garbageCollection = garbageCollectionTime - m_garbageCollectionTime;
+    m_garbageCollectionTime = garbageCollectionTime;
+    return frame;
+}
+
+/*
+    The threaded render loop only picks up the timings object during the sync,
+    and keeps adding frames that only advanced the animators until the next
+    one, so recording may have been disabled since.
+ */
+void QQuickFrameTimings::addFrame(const QQuickFrameTiming &frame)
+{
+    QMutexLocker locker(&m_mutex);
+    if (!m_enabled)
+        return;
+    QQuickFrameTiming &slot = m_frames[m_next];
+    slot = frame;
+    slot.timestamp = m_clock.nsecsElapsed();
+    m_next = (m_next + 1) % m_frames.size();
+    m_count = qMin(m_count + 1, m_frames.size());
+}
+
+/*
+    The time the engine of the window's items spent in the garbage collector
+    so far. Called on the GUI thread or while it is blocked for the sync.
+ */
+qint64 QQuickFrameTimings::totalGarbageCollectionTime()
+{
+    if (!m_engine) {
+        QQmlEngine *engine = qmlEngine(m_window);
+        const QList<QQuickItem *> items = m_window->contentItem()->childItems();
+        for (int i = 0; !engine && i < items.size(); ++i)
+            engine = qmlEngine(items.at(i));
+        if (!engine)
+            return m_garbageCollectionTime;
+
+        // Only count what is collected from now on
+        m_engine = engine;
+        m_garbageCollectionTime = engine->handle()->memoryManager->totalGCTime;
+    }
+    return m_engine->handle()->memoryManager->totalGCTime;
+}
+
+void QQuickFrameTimings::writePercentiles(QIODevice *device, const QVector<QQuickFrameTiming> &frames) const
+{
+    static const qreal percents[] = { 50, 90, 95, 99, 100 };
+
+    QString name = m_window->title();
+    if (name.isEmpty())
+        name = m_window->objectName();
+    if (name.isEmpty())
+        name = QString::fromLatin1(m_window->metaObject()->className());
+
+    QTextStream stream(device);
+    stream.setRealNumberNotation(QTextStream::FixedNotation);
+    stream.setRealNumberPrecision(3);
+    stream << "# " << name << ": " << frames.size() << " frames, milliseconds\n";
+    stream << qSetFieldWidth(18) << left << "phase" << right << qSetFieldWidth(10)
+           << "p50" << "p90" << "p95" << "p99" << "max" << qSetFieldWidth(0) << '\n';
+    for (int phase = Polish; phase <= Total; ++phase) {
+        const QVector<qint64> values = sortedPhaseTimes(frames, Phase(phase));
+        stream << qSetFieldWidth(18) << left << phaseNames[phase] << right << qSetFieldWidth(10);
+        for (qreal percent : percents)
+            stream << toMilliseconds(percentileOf(values, percent));
+        stream << qSetFieldWidth(0) << '\n';
+    }
+}
+
+QT_END_NAMESPACE
+
+#include "moc_qquickframetimings_p.cpp"
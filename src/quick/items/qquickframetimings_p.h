@@ -0,0 +1,159 @@
+/****************************************************************************
+**
+** Copyright (C) 2019 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtQuick module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#ifndef QQUICKFRAMETIMINGS_P_H
+#define QQUICKFRAMETIMINGS_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists purely as an
+// implementation detail.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <QtQuick/private/qtquickglobal_p.h>
+#include <QtCore/qelapsedtimer.h>
+#include <QtCore/qmutex.h>
+#include <QtCore/qobject.h>
+#include <QtCore/qpointer.h>
+#include <QtCore/qvariant.h>
+#include <QtCore/qvector.h>
+
+QT_BEGIN_NAMESPACE
+
+class QIODevice;
+class QQmlEngine;
+class QQuickWindow;
+
+// The time spent in the phases of one frame, in nanoseconds. Sync includes
+// updatePaintNode. Animations holds the time spent advancing the animations
+// whose values are shown in this frame, and is only known for render loops
+// that drive the animations themselves. Garbage collection is the time the
+// JavaScript engine spent collecting since the previous frame.
+struct QQuickFrameTiming
+{
+    qint64 timestamp = 0; // when the frame was done, since recording started
+    qint64 polish = 0;
+    qint64 animations = 0;
+    qint64 sync = 0;
+    qint64 updatePaintNode = 0;
+    qint64 render = 0;
+    qint64 swap = 0;
+    qint64 garbageCollection = 0;
+
+    qint64 total() const { return polish + animations + sync + render + swap; }
+};
+
+// A ring buffer of the timings of the last frames of a window. The render
+// loops record into it when enabled: the GUI thread part of a frame is kept
+// in guiThreadFrame() until the loop takes it during the sync, while the GUI
+// thread is blocked, and completes it with the render thread part.
+class Q_QUICK_PRIVATE_EXPORT QQuickFrameTimings : public QObject
+{
+    Q_OBJECT
+    Q_PROPERTY(bool enabled READ isEnabled WRITE setEnabled NOTIFY enabledChanged)
+    Q_PROPERTY(int capacity READ capacity WRITE setCapacity NOTIFY capacityChanged)
+
+public:
+    enum Phase {
+        Polish,
+        Animations,
+        Sync,
+        UpdatePaintNode,
+        Render,
+        Swap,
+        GarbageCollection,
+        Total
+    };
+    Q_ENUM(Phase)
+
+    explicit QQuickFrameTimings(QQuickWindow *window);
+    ~QQuickFrameTimings() override;
+
+    static bool isEnabledByDefault();
+
+    bool isEnabled() const { return m_enabled; }
+    void setEnabled(bool enabled);
+
+    int capacity() const;
+    void setCapacity(int capacity);
+
+    // Oldest first
+    QVector<QQuickFrameTiming> frames() const;
+
+    Q_INVOKABLE int frameCount() const;
+    Q_INVOKABLE QVariantList frameList() const;
+    Q_INVOKABLE qreal percentile(Phase phase, qreal percent) const;
+    Q_INVOKABLE void clear();
+    Q_INVOKABLE bool dump(const QString &fileName) const;
+
+    // Recording, driven by the render loops
+    QQuickFrameTiming *guiThreadFrame() { return &m_guiThreadFrame; }
+    QQuickFrameTiming takeGuiThreadFrame();
+    void addFrame(const QQuickFrameTiming &frame);
+
+Q_SIGNALS:
+    void enabledChanged();
+    void capacityChanged();
+
+private:
+    qint64 totalGarbageCollectionTime();
+    void writePercentiles(QIODevice *device, const QVector<QQuickFrameTiming> &frames) const;
+
+    QQuickWindow *m_window;
+    QPointer<QQmlEngine> m_engine;
+    QQuickFrameTiming m_guiThreadFrame;
+    qint64 m_garbageCollectionTime;
+    bool m_enabled;
+
+    mutable QMutex m_mutex;
+    QElapsedTimer m_clock;
+    QVector<QQuickFrameTiming> m_frames;
+    int m_next;
+    int m_count;
+};
+
+QT_END_NAMESPACE
+
+#endif // QQUICKFRAMETIMINGS_P_H
@@ -0,0 +1,263 @@
+/****************************************************************************
+**
+** Copyright (C) 2019 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtQuick module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include "qquickhittestindex_p.h"
+#include "qquickitem_p.h"
+
+#include <QtCore/qmath.h>
+#include <QtCore/qnumeric.h>
+#include <QtGui/qtransform.h>
+
+#include <limits>
+
+QT_BEGIN_NAMESPACE
+
+// Items with at least this many children get a grid over their children
+static const int GridThreshold = 16;
+static const int MaxGridDimension = 64;
+// Mapping a rect and mapping a point through the same transform may round
+// differently; grow the mapped rects a little so that edges still hit.
+static const qreal Slack = 0.001;
+
+static int gridCell(qreal v, qreal origin, qreal extent, int count)
+{
+    if (extent <= 0)
+        return 0;
+    return qBound(0, int((v - origin) * count / extent), count - 1);
+}
+
+void QQuickHitTestIndex::Box::unite(const Box &other)
+{
+    if (other.isEmpty())
+        return;
+    if (isEmpty()) {
+        *this = other;
+        return;
+    }
+    x1 = qMin(x1, other.x1);
+    y1 = qMin(y1, other.y1);
+    x2 = qMax(x2, other.x2);
+    y2 = qMax(y2, other.y2);
+}
+
+QQuickHitTestIndex::QQuickHitTestIndex()
+{
+}
+
+QQuickHitTestIndex::~QQuickHitTestIndex()
+{
+    clear();
+}
+
+bool QQuickHitTestIndex::isEnabledByDefault()
+{
+    static const bool enabled = qEnvironmentVariableIntValue("QML_HIT_TEST_INDEX") > 0;
+    return enabled;
+}
+
+QList<QQuickItem *> QQuickHitTestIndex::childItemsAt(QQuickItem *item, const QPointF &itemPos)
+{
+    const Node *node = validate(item);
+    QList<QQuickItem *> result;
+
+    if (node->cells.isEmpty()) {
+        for (int i = 0; i < node->children.count(); ++i) {
+            if (node->childBounds.at(i).contains(itemPos))
+                result.append(node->children.at(i));
+        }
+        return result;
+    }
+
+    static const QVector<int> noCell;
+    const QVector<int> *cell = &noCell;
+    const Box &grid = node->gridBounds;
+    if (grid.contains(itemPos)) {
+        const int column = gridCell(itemPos.x(), grid.x1, grid.x2 - grid.x1, node->columns);
+        const int row = gridCell(itemPos.y(), grid.y1, grid.y2 - grid.y1, node->rows);
+        cell = &node->cells.at(row * node->columns + column);
+    }
+
+    // Both lists are sorted by paint order; merge them.
+    const QVector<int> &unbounded = node->unboundedChildren;
+    int i = 0;
+    int j = 0;
+    while (i < cell->count() || j < unbounded.count()) {
+        int index;
+        if (j == unbounded.count() || (i < cell->count() && cell->at(i) < unbounded.at(j)))
+            index = cell->at(i++);
+        else
+            index = unbounded.at(j++);
+        if (node->childBounds.at(index).contains(itemPos))
+            result.append(node->children.at(index));
+    }
+    return result;
+}
+
+void QQuickHitTestIndex::invalidate(QQuickItem *item)
+{
+    // A valid node implies a valid subtree, so once we reach an item that has
+    // no valid node, all of its ancestors have been invalidated already.
+    for (; item; item = item->parentItem()) {
+        Node *node = m_nodes.value(item);
+        if (!node || !node->valid)
+            break;
+        node->valid = false;
+    }
+}
+
+void QQuickHitTestIndex::remove(QQuickItem *item)
+{
+    delete m_nodes.take(item);
+}
+
+void QQuickHitTestIndex::clear()
+{
+    qDeleteAll(m_nodes);
+    m_nodes.clear();
+}
+
+QQuickHitTestIndex::Node *QQuickHitTestIndex::validate(QQuickItem *item)
+{
+    Node *&slot = m_nodes[item];
+    if (!slot)
+        slot = new Node;
+    // Validating the children below may rehash m_nodes, so don't keep slot.
+    Node *node = slot;
+    if (node->valid)
+        return node;
+
+    QQuickItemPrivate *d = QQuickItemPrivate::get(item);
+    node->children = d->paintOrderChildItems();
+    node->childBounds.resize(node->children.count());
+    node->unboundedChildren.clear();
+    node->cells.clear();
+
+    // QQuickItem::contains() is inclusive on all four edges. A containment
+    // mask, a custom contains() or a pointer handler's margin may accept
+    // points outside of it.
+    Box bounds;
+    bounds.x1 = 0;
+    bounds.y1 = 0;
+    bounds.x2 = d->width;
+    bounds.y2 = d->height;
+    bool unbounded = d->mask || d->customContainment || d->hasPointerHandlers()
+            || !qIsFinite(d->width) || !qIsFinite(d->height);
+
+    const qreal inf = std::numeric_limits<qreal>::infinity();
+    Box childrenBounds;
+    for (int i = 0; i < node->children.count(); ++i) {
+        QQuickItem *child = node->children.at(i);
+        const Node *childNode = validate(child);
+        Box &box = node->childBounds[i];
+        if (!childNode->unbounded) {
+            const Box &b = childNode->bounds;
+            if (b.isEmpty()) {
+                box = Box();
+                continue;
+            }
+            QTransform t;
+            QQuickItemPrivate::get(child)->itemToParentTransform(t);
+            const QRectF r = t.mapRect(QRectF(QPointF(b.x1, b.y1), QPointF(b.x2, b.y2)));
+            box.x1 = r.left() - Slack;
+            box.y1 = r.top() - Slack;
+            box.x2 = r.right() + Slack;
+            box.y2 = r.bottom() + Slack;
+            if (qIsFinite(box.x1) && qIsFinite(box.y1) && qIsFinite(box.x2) && qIsFinite(box.y2)) {
+                childrenBounds.unite(box);
+                continue;
+            }
+        }
+        box.x1 = box.y1 = -inf;
+        box.x2 = box.y2 = inf;
+        node->unboundedChildren.append(i);
+    }
+
+    // Delivery never looks at the children of a clipping item unless the
+    // item itself contains the point.
+    if (!(d->flags & QQuickItem::ItemClipsChildrenToShape)) {
+        bounds.unite(childrenBounds);
+        unbounded = unbounded || !node->unboundedChildren.isEmpty();
+    }
+    node->bounds = bounds;
+    node->unbounded = unbounded;
+
+    node->gridBounds = childrenBounds;
+    if (node->children.count() >= GridThreshold)
+        buildGrid(node);
+
+    node->valid = true;
+    return node;
+}
+
+void QQuickHitTestIndex::buildGrid(Node *node)
+{
+    const Box &grid = node->gridBounds;
+    if (grid.isEmpty())
+        return;
+
+    const int count = node->children.count();
+    const qreal width = grid.x2 - grid.x1;
+    const qreal height = grid.y2 - grid.y1;
+    const int columns = qBound(1, qCeil(qSqrt(count * (width + 1) / (height + 1))), MaxGridDimension);
+    const int rows = qBound(1, qCeil(qreal(count) / columns), MaxGridDimension);
+    node->columns = columns;
+    node->rows = rows;
+    node->cells.resize(columns * rows);
+
+    int nextUnbounded = 0;
+    for (int i = 0; i < count; ++i) {
+        if (nextUnbounded < node->unboundedChildren.count() && node->unboundedChildren.at(nextUnbounded) == i) {
+            ++nextUnbounded;
+            continue;
+        }
+        const Box &box = node->childBounds.at(i);
+        if (box.isEmpty())
+            continue;
+        const int c1 = gridCell(box.x1, grid.x1, width, columns);
+        const int c2 = gridCell(box.x2, grid.x1, width, columns);
+        const int r1 = gridCell(box.y1, grid.y1, height, rows);
+        const int r2 = gridCell(box.y2, grid.y1, height, rows);
+        for (int r = r1; r <= r2; ++r) {
+            for (int c = c1; c <= c2; ++c)
+                node->cells[r * columns + c].append(i);
+        }
+    }
+}
+
+QT_END_NAMESPACE
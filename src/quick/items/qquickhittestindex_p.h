@@ -0,0 +1,131 @@
+/****************************************************************************
+**
+** Copyright (C) 2019 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtQuick module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#ifndef QQUICKHITTESTINDEX_P_H
+#define QQUICKHITTESTINDEX_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists purely as an
+// implementation detail.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <QtQuick/private/qtquickglobal_p.h>
+#include <QtCore/qhash.h>
+#include <QtCore/qlist.h>
+#include <QtCore/qpoint.h>
+#include <QtCore/qvector.h>
+
+QT_BEGIN_NAMESPACE
+
+class QQuickItem;
+
+// Shortlists the children of an item that can possibly be hit at a given
+// point, so that pointer and hover delivery don't need to descend into every
+// subtree of the scene. Every indexed item caches the bounds of its whole
+// subtree in its own coordinate system; items with many children also get a
+// uniform grid over their children's bounds. Entries are invalidated from
+// QQuickItemPrivate::dirty() up to the first ancestor that is already
+// invalid, and rebuilt lazily on the next query.
+//
+// The index assumes that an item only accepts points inside of its bounding
+// rect, as QQuickItem::contains() does. There is no way to tell from the
+// outside whether a subclass overrides contains(), so every item whose
+// override may accept points outside of its bounds must call
+// QQuickItemPrivate::setCustomContainment(); otherwise it is pruned from
+// delivery as soon as the index is enabled. QQuickShape is the only such item
+// in Qt Quick itself. Containment masks and pointer handlers are detected
+// automatically.
+class Q_QUICK_PRIVATE_EXPORT QQuickHitTestIndex
+{
+public:
+    QQuickHitTestIndex();
+    ~QQuickHitTestIndex();
+
+    static bool isEnabledByDefault();
+
+    // The paint-ordered children of \a item whose subtree may contain
+    // \a itemPos, which is given in \a item's coordinate system.
+    QList<QQuickItem *> childItemsAt(QQuickItem *item, const QPointF &itemPos);
+
+    void invalidate(QQuickItem *item);
+    void remove(QQuickItem *item);
+    void clear();
+
+private:
+    struct Box {
+        qreal x1 = 1;
+        qreal y1 = 1;
+        qreal x2 = 0;
+        qreal y2 = 0;
+
+        bool isEmpty() const { return x1 > x2 || y1 > y2; }
+        bool contains(const QPointF &p) const
+        { return p.x() >= x1 && p.x() <= x2 && p.y() >= y1 && p.y() <= y2; }
+        void unite(const Box &other);
+    };
+
+    struct Node {
+        QList<QQuickItem *> children;   // paint order
+        QVector<Box> childBounds;       // in this item's coordinates
+        QVector<int> unboundedChildren; // indices into children
+        // Grid over childBounds, only built for items with many children
+        QVector<QVector<int>> cells;
+        Box gridBounds;
+        int columns = 0;
+        int rows = 0;
+        Box bounds;                     // whole subtree, in this item's coordinates
+        bool unbounded = false;         // some point outside bounds may still hit
+        bool valid = false;
+    };
+
+    Node *validate(QQuickItem *item);
+    void buildGrid(Node *node);
+
+    QHash<QQuickItem *, Node *> m_nodes;
+};
+
+QT_END_NAMESPACE
+
+#endif // QQUICKHITTESTINDEX_P_H
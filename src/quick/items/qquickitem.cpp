@@ -45,6 +45,7 @@
 #include "qquickwindow_p.h"
 
 #include "qquickevents_p_p.h"
+#include "qquickhittestindex_p.h"
 #include "qquickscreen_p.h"
 
 #include <QtQml/qqmlengine.h>
@@ -91,6 +92,8 @@ Q_DECLARE_LOGGING_CATEGORY(DBG_HOVER_TRACE)
 Q_DECLARE_LOGGING_CATEGORY(lcTransient)
 Q_LOGGING_CATEGORY(lcHandlerParent, "qt.quick.handler.parent")
 
+DEFINE_BOOL_CONFIG_OPTION(qmlLazyHiddenBindings, QML_LAZY_HIDDEN_BINDINGS)
+
 void debugFocusTree(QQuickItem *item, QQuickItem *scope = nullptr, int depth = 1)
 {
     if (DBG_FOCUS().isEnabled(QtDebugMsg)) {
@@ -2808,6 +2811,8 @@ void QQuickItem::setParentItem(QQuickItem *parentItem)
     emit parentChanged(d->parentItem);
     if (isVisible() && d->parentItem)
         emit d->parentItem->visibleChildrenChanged();
+
+    d->updateBindingUpdatesSuspendedRecur();
 }
 
 /*!
@@ -3070,6 +3075,8 @@ void QQuickItemPrivate::derefWindow()
     }
 #endif
     c->hoverItems.removeAll(q);
+    if (c->hitTestIndex)
+        c->hitTestIndex->remove(q);
     if (itemNodeInstance)
         c->cleanup(itemNodeInstance);
     if (!parentItem)
@@ -3229,6 +3236,8 @@ QQuickItemPrivate::QQuickItemPrivate()
 #else
     , touchEnabled(false)
 #endif
+    , concurrentPaintNodeUpdate(false)
+    , customContainment(false)
     , dirtyAttributes(0)
     , nextDirtyItem(nullptr)
     , prevDirtyItem(nullptr)
@@ -5919,6 +5928,8 @@ void QQuickItemPrivate::setVisible(bool visible)
     const bool childVisibilityChanged = setEffectiveVisibleRecur(calcEffectiveVisible());
     if (childVisibilityChanged && parentItem)
         emit parentItem->visibleChildrenChanged();   // signal the parent, not this!
+
+    updateBindingUpdatesSuspendedRecur();
 }
 
 void QQuickItem::setVisible(bool v)
@@ -6003,6 +6014,10 @@ bool QQuickItemPrivate::setEffectiveVisibleRecur(bool newEffectiveVisible)
     }
 
     effectiveVisible = newEffectiveVisible;
+    // Suspend right away, so that the change handlers below don't update hidden bindings.
+    // Resuming waits until the whole subtree is updated, see updateBindingUpdatesSuspendedRecur().
+    if (!effectiveVisible && explicitVisible)
+        updateBindingUpdatesSuspended();
     dirty(Visible);
     if (parentItem) QQuickItemPrivate::get(parentItem)->dirty(ChildrenStackingChanged);
 
@@ -6029,6 +6044,65 @@ bool QQuickItemPrivate::setEffectiveVisibleRecur(bool newEffectiveVisible)
     return true;    // effective visibility DID change
 }
 
+/*!
+    \internal
+
+    When the QML_LAZY_HIDDEN_BINDINGS environment variable is set, bindings on items that are
+    hidden because one of their ancestors is invisible are not evaluated when their dependencies
+    change. They are evaluated when the item becomes visible again, or when the bound property
+    is read from JavaScript. Items that are hidden through their own visible property keep
+    their bindings live, so that visible can still be bound.
+*/
+/*!
+    \internal
+
+    Returns false if the state was already up to date. The children that inherit the
+    visibility of the item are then up to date as well.
+*/
+bool QQuickItemPrivate::updateBindingUpdatesSuspended()
+{
+    if (!qmlLazyHiddenBindings())
+        return false;
+
+    Q_Q(QQuickItem);
+    const bool suspended = !effectiveVisible && explicitVisible;
+    // Without QQmlData there is no state to compare, the children may still have one
+    QQmlData *data = QQmlData::get(q);
+    if (data && data->bindingUpdatesSuspended == suspended)
+        return false;
+
+    QQmlData::setBindingUpdatesSuspended(q, suspended);
+    return true;
+}
+
+/*!
+    \internal
+
+    Updates whether binding updates are suspended for this item and the children that
+    inherit its visibility. This is done after the effective visibility of the whole subtree
+    has changed and the change signals have been emitted, so that the pending bindings
+    are evaluated against the final state.
+
+    Unless \a force is set, the children are skipped if the state of the item did not change.
+    The item the change started at always checks its children, it may be hidden through its
+    own visible property.
+*/
+void QQuickItemPrivate::updateBindingUpdatesSuspendedRecur(bool force)
+{
+    if (!qmlLazyHiddenBindings())
+        return;
+
+    if (!updateBindingUpdatesSuspended() && !force)
+        return;
+    // Pending bindings may add or remove children, so don't hold on to the list.
+    for (int ii = 0; ii < childItems.count(); ++ii) {
+        QQuickItemPrivate *childPrivate = QQuickItemPrivate::get(childItems.at(ii));
+        // Items hidden through their own visible property don't depend on the parent.
+        if (childPrivate->explicitVisible)
+            childPrivate->updateBindingUpdatesSuspendedRecur(false);
+    }
+}
+
 bool QQuickItemPrivate::calcEffectiveEnable() const
 {
     // XXX todo - Should the effective enable of an element with no parent just be the current
@@ -6126,6 +6200,20 @@ void QQuickItemPrivate::dirty(DirtyType type)
     if (type & (TransformOrigin | Transform | BasicTransform | Position | Size))
         transformChanged();
 
+    // Position and size changes are reported as geometry changes
+    if ((type & (TransformOrigin | Transform | BasicTransform)) && changeListeners.size()) {
+        const auto listeners = changeListeners; // NOTE: intentional copy (QTBUG-54732)
+        for (const QQuickItemPrivate::ChangeListener &change : listeners) {
+            if (change.types & QQuickItemPrivate::Matrix)
+                change.listener->itemTransformChanged(q);
+        }
+    }
+
+    if (window && (type & HitTestUpdateMask)) {
+        if (QQuickHitTestIndex *index = QQuickWindowPrivate::get(window)->hitTestIndex)
+            index->invalidate(q);
+    }
+
     if (!(dirtyAttributes & type) || (window && !prevDirtyItem)) {
         dirtyAttributes |= type;
         if (window && componentComplete) {
@@ -7756,6 +7844,10 @@ void QQuickItem::setContainmentMask(QObject *mask)
         d->extra.value().maskContains = mask->metaObject()->method(methodIndex);
     }
     d->mask = mask;
+    if (d->window) {
+        if (QQuickHitTestIndex *index = QQuickWindowPrivate::get(d->window)->hitTestIndex)
+            index->invalidate(this);
+    }
     quickMask = qobject_cast<QQuickItem *>(mask);
     if (quickMask) {
         QQuickItemPrivate *maskPrivate = QQuickItemPrivate::get(quickMask);
@@ -8207,6 +8299,25 @@ bool QQuickItemPrivate::hasHoverHandlers() const
     return false;
 }
 
+/*!
+    \internal
+
+    Items whose contains() override may accept points outside of their bounding
+    rect must set this, so that they are not skipped by the hit test index.
+*/
+void QQuickItemPrivate::setCustomContainment(bool custom)
+{
+    Q_Q(QQuickItem);
+    if (customContainment == custom)
+        return;
+
+    customContainment = custom;
+    if (window) {
+        if (QQuickHitTestIndex *index = QQuickWindowPrivate::get(window)->hitTestIndex)
+            index->invalidate(q);
+    }
+}
+
 void QQuickItemPrivate::addPointerHandler(QQuickPointerHandler *h)
 {
     Q_Q(QQuickItem);
@@ -8216,6 +8327,11 @@ void QQuickItemPrivate::addPointerHandler(QQuickPointerHandler *h)
     auto &handlers = extra.value().pointerHandlers;
     if (!handlers.contains(h))
         handlers.prepend(h);
+    // handlers may want points outside of the item's bounds
+    if (window) {
+        if (QQuickHitTestIndex *index = QQuickWindowPrivate::get(window)->hitTestIndex)
+            index->invalidate(q);
+    }
 }
 
 #if QT_CONFIG(quick_shadereffect)
@@ -327,6 +327,7 @@ public:
         ImplicitWidth = 0x100,
         ImplicitHeight = 0x200,
         Enabled = 0x400,
+        Matrix = 0x800,
     };
 
     Q_DECLARE_FLAGS(ChangeTypes, ChangeType)
@@ -469,6 +470,13 @@ public:
     bool isTabFence:1;
     bool replayingPressEvent:1;
     bool touchEnabled:1;
+    // concurrentPaintNodeUpdate: updatePaintNode() only reads plain item state
+    // and only modifies the nodes it owns, so the window may call it from a
+    // worker thread while the scene graph is being synchronized.
+    bool concurrentPaintNodeUpdate:1;
+    // customContainment: contains() is overridden and may accept points outside of
+    // the item's bounding rect, so hit testing must not skip the item by its geometry.
+    bool customContainment:1;
 
     enum DirtyType {
         TransformOrigin         = 0x00000001,
@@ -499,7 +507,9 @@ public:
                                   Window,
         ComplexTransformUpdateMask     = Transform | Window,
         ContentUpdateMask       = Size | Content | Smooth | Window | Antialiasing,
-        ChildrenUpdateMask      = ChildrenChanged | ChildrenStackingChanged | EffectReference | Window
+        ChildrenUpdateMask      = ChildrenChanged | ChildrenStackingChanged | EffectReference | Window,
+        HitTestUpdateMask       = TransformOrigin | Transform | BasicTransform | Position | Size |
+                                  ZValue | ChildrenChanged | ChildrenStackingChanged | Clip
     };
 
     quint32 dirtyAttributes;
@@ -608,6 +618,9 @@ public:
 
     bool calcEffectiveVisible() const;
     bool setEffectiveVisibleRecur(bool);
+    bool updateBindingUpdatesSuspended();
+    void updateBindingUpdatesSuspendedRecur(bool force = true);
+    void setCustomContainment(bool custom);
     bool calcEffectiveEnable() const;
     void setEffectiveEnableRecur(QQuickItem *scope, bool);
 
@@ -136,6 +136,9 @@ public:
     virtual void itemImplicitHeightChanged(QQuickItem *) {}
 
     virtual QQuickAnchorsPrivate *anchorPrivate() { return nullptr; }
+
+    // Appended, so that the vtable layout of the existing functions is kept
+    virtual void itemTransformChanged(QQuickItem *) {}
 };
 
 QT_END_NAMESPACE
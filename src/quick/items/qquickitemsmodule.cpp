@@ -179,7 +179,8 @@ static void qt_quickitems_defineModule(const char *uri, int major, int minor)
     QQmlPrivate::qmlregister(QQmlPrivate::AutoParentRegistration, &autoparent);
 
     // Register the latest version, even if there are no new types or new revisions for existing types yet.
-    qmlRegisterModule(uri, 2, QT_VERSION_MINOR);
+    // QtQuick 2.13 comes with this module, also when it is built against an older qtbase.
+    qmlRegisterModule(uri, 2, qMax(QT_VERSION_MINOR, 13));
 
 #if !QT_CONFIG(quick_animatedimage)
     qmlRegisterTypeNotAvailable(uri,major,minor,"AnimatedImage", QCoreApplication::translate("QQuickAnimatedImage","Qt was built without support for QMovie"));
@@ -472,6 +473,8 @@ static void qt_quickitems_defineModule(const char *uri, int major, int minor)
 #if QT_CONFIG(quick_tableview)
     qmlRegisterType<QQuickTableView>(uri, 2, 12, "TableView");
 #endif
+
+    qmlRegisterType<QQuickText, 13>(uri, 2, 13, "Text");
 }
 
 static void initResources()
@@ -362,6 +362,42 @@ void QQuickRectangle::doUpdate()
     update();
 }
 
+/*
+    Only our own updatePaintNode() is known to be safe to call concurrently, so
+    concurrent updates are enabled for plain Rectangles only. The metaobjects that
+    QML adds for the properties and functions declared in a Rectangle {} block
+    have no static metacall; any other metaobject between the item's and ours
+    belongs to a C++ subclass, which may override updatePaintNode().
+
+    This is checked when the item enters a window rather than in the constructor,
+    where neither the subclass nor the QML metaobject is known yet.
+*/
+void QQuickRectanglePrivate::updateConcurrentPaintNodeUpdate()
+{
+    Q_Q(QQuickRectangle);
+    bool plainRectangle = true;
+    for (const QMetaObject *mo = q->metaObject(); mo && mo != &QQuickRectangle::staticMetaObject;
+         mo = mo->superClass()) {
+        if (mo->d.static_metacall) {
+            plainRectangle = false;
+            break;
+        }
+    }
+
+    // Resolving gradient objects and presets may go through the JS engine,
+    // which is not safe while other threads update paint nodes.
+    concurrentPaintNodeUpdate = plainRectangle && !gradient.isQObject() && !gradient.isNumber()
+            && !gradient.isString();
+}
+
+void QQuickRectangle::itemChange(ItemChange change, const ItemChangeData &value)
+{
+    Q_D(QQuickRectangle);
+    if (change == ItemSceneChange)
+        d->updateConcurrentPaintNodeUpdate();
+    QQuickItem::itemChange(change, value);
+}
+
 /*!
     \qmlproperty bool QtQuick::Rectangle::antialiasing
 
@@ -465,6 +501,7 @@ void QQuickRectangle::setGradient(const QJSValue &gradient)
         d->gradient = QJSValue();
     }
 
+    d->updateConcurrentPaintNodeUpdate();
     update();
 }
 
@@ -72,6 +72,8 @@ public:
     {
     }
 
+    void updateConcurrentPaintNodeUpdate();
+
     QColor color;
     QJSValue gradient;
     QQuickPen *pen;
@@ -59,6 +59,13 @@
 #include <QtGui/qtextcursor.h>
 #include <QtGui/qguiapplication.h>
 #include <QtGui/qinputmethod.h>
+#include <QtCore/qcache.h>
+#include <QtCore/qcoreapplication.h>
+#include <QtCore/qmutex.h>
+#include <QtCore/qrunnable.h>
+#include <QtCore/qthread.h>
+#include <QtCore/qthreadpool.h>
+#include <QtCore/qthreadstorage.h>
 
 #include <private/qtextengine_p.h>
 #include <private/qquickstyledtext_p.h>
@@ -73,8 +80,254 @@ Q_DECLARE_LOGGING_CATEGORY(DBG_HOVER_TRACE)
 
 const QChar QQuickTextPrivate::elideChar = QChar(0x2026);
 
+// Labels with longer texts are unlikely to be repeated
+static const int maximumCachedTextLength = 256;
+static const int textLayoutCacheSize = 1000;
+
+static inline bool operator==(const QQuickTextLayoutCacheKey &k1, const QQuickTextLayoutCacheKey &k2)
+{
+    return k1.text == k2.text && k1.font == k2.font && k1.width == k2.width
+            && k1.topPadding == k2.topPadding && k1.leftPadding == k2.leftPadding
+            && k1.rightPadding == k2.rightPadding && k1.bottomPadding == k2.bottomPadding
+            && k1.lineHeight == k2.lineHeight && k1.lineHeightMode == k2.lineHeightMode
+            && k1.hAlign == k2.hAlign && k1.wrapMode == k2.wrapMode
+            && k1.useDesignMetrics == k2.useDesignMetrics && k1.widthValid == k2.widthValid
+            && k1.implicitWidthValid == k2.implicitWidthValid;
+}
+
+static inline uint qHash(const QQuickTextLayoutCacheKey &key, uint seed = 0)
+{
+    seed = qHash(key.text, seed);
+    seed = qHash(key.font, seed);
+    seed = qHash(key.width, seed);
+    return qHash(key.hAlign | key.wrapMode << 8, seed);
+}
+
+// The laid out text and everything setupTextLayout() derives from it
+struct QQuickTextLayoutCacheEntry
+{
+    QQuickTextLayoutCacheEntry(const QFontInfo &fontInfo) : fontInfo(fontInfo) {}
+
+    QSharedPointer<QTextLayout> layout;
+    QFontInfo fontInfo;
+    QString assignedFont;
+    QRectF boundingRect;
+    QSizeF advance;
+    QSizeF implicitSize;
+    qreal baseline = 0;
+    qreal lineWidth = 0;
+    qreal width = 0;
+    int lineCount = 0;
+    bool truncated = false;
+    bool widthExceeded = false;
+};
+
+// Shared by the Text items of a thread, so that items showing the same string
+// in the same way only shape and lay it out once. A QTextLayout is not thread
+// safe, so the items of other threads, and their render threads, never see it.
+struct QQuickTextLayoutCache
+{
+    QQuickTextLayoutCache() : entries(textLayoutCacheSize) {}
+
+    QCache<QQuickTextLayoutCacheKey, QQuickTextLayoutCacheEntry> entries;
+};
+
+Q_GLOBAL_STATIC(QThreadStorage<QQuickTextLayoutCache *>, textLayoutCaches)
+
+// The cached layouts reference font engines, which must not outlive the font
+// database. The caches of other threads go when their thread finishes, but the
+// one of the GUI thread would only go with the global static, after the
+// application has been destroyed.
+static void cleanupGuiThreadTextLayoutCache()
+{
+    if (textLayoutCaches.exists())
+        textLayoutCaches()->setLocalData(nullptr);
+}
+
+static QQuickTextLayoutCache *textLayoutCache()
+{
+    QThreadStorage<QQuickTextLayoutCache *> *caches = textLayoutCaches();
+    if (!caches->hasLocalData()) {
+        caches->setLocalData(new QQuickTextLayoutCache);
+        QCoreApplication *application = QCoreApplication::instance();
+        if (application && application->thread() == QThread::currentThread())
+            qAddPostRoutine(cleanupGuiThreadTextLayoutCache);
+    }
+    return caches->localData();
+}
+
+int QQuickTextPrivate::textLayoutCacheCount()
+{
+    if (!textLayoutCaches.exists() || !textLayoutCaches()->hasLocalData())
+        return 0;
+    return textLayoutCaches()->localData()->entries.count();
+}
+
+/*
+    Lays out a text that QQuickTextPrivate::isLayoutCacheable() accepts, in the
+    passes that setupTextLayout() makes for any text, and returns what the item
+    takes from the layout. Only depends on the key and the font, so that it also
+    runs on a worker thread for a Text item with asynchronous set. Without
+    eliding, font size fitting and maximumLineCount there are at most two
+    passes: one at the width of the item, and one at the width the lines end up
+    with once the natural width of the text is known.
+*/
+static QQuickTextLayoutCacheEntry *layoutCacheableText(QTextLayout *layout, const QQuickTextLayoutCacheKey &key,
+                                                       const QFont &font)
+{
+    layout->setCacheEnabled(true);
+    QTextOption textOption = layout->textOption();
+    if (textOption.alignment() != Qt::Alignment(key.hAlign)
+            || textOption.wrapMode() != QTextOption::WrapMode(key.wrapMode)
+            || textOption.useDesignMetrics() != key.useDesignMetrics) {
+        textOption.setAlignment(Qt::Alignment(key.hAlign));
+        textOption.setWrapMode(QTextOption::WrapMode(key.wrapMode));
+        textOption.setUseDesignMetrics(key.useDesignMetrics);
+        layout->setTextOption(textOption);
+    }
+    if (layout->font() != font)
+        layout->setFont(font);
+
+    const QString text = layout->text();
+    bool wrapped = false;
+    qreal height = 0;
+    QRectF rect;
+    // The lines of a text without images, positioned the way setLineGeometry() does
+    auto layoutLines = [&](qreal lineWidth) {
+        wrapped = false;
+        height = 0;
+        rect = QRectF();
+        layout->beginLayout();
+        for (QTextLine line = layout->createLine(); line.isValid(); line = layout->createLine()) {
+            if (line.textStart() > 0 && text.at(line.textStart() - 1) != QChar::LineSeparator)
+                wrapped = true;
+            line.setLineWidth(lineWidth);
+            line.setPosition(QPointF(line.position().x(), height));
+            height += key.lineHeightMode == QQuickText::FixedHeight ? key.lineHeight : line.height() * key.lineHeight;
+            rect = rect.united(line.naturalTextRect());
+        }
+        layout->endLayout();
+        rect.moveTop(0);
+        rect.setHeight(height);
+    };
+
+    const qreal availableWidth = key.width - key.leftPadding - key.rightPadding;
+    const bool canWrap = key.wrapMode != QQuickText::NoWrap && key.widthValid;
+    const qreal initialLineWidth = (key.widthValid || key.implicitWidthValid) && key.width > 0
+            ? key.width
+            : FLT_MAX;
+    layoutLines(initialLineWidth);
+    const qreal naturalWidth = layout->maximumWidth();
+
+    // Lay out again if the width the item ends up with changes the wrapping or alignment
+    bool widthExceeded = (availableWidth <= 0 && canWrap) || wrapped;
+    const qreal lineWidth = key.widthValid && availableWidth > 0 ? availableWidth : naturalWidth;
+    if ((!qFuzzyCompare(lineWidth, initialLineWidth) || (widthExceeded && lineWidth > initialLineWidth))
+            && (canWrap || key.hAlign != QQuickText::AlignLeft)) {
+        widthExceeded = lineWidth >= qMin(initialLineWidth, naturalWidth);
+        layoutLines(lineWidth);
+        widthExceeded |= wrapped;
+    }
+
+    const QTextLine firstLine = layout->lineAt(0);
+    const QTextLine lastLine = layout->lineAt(layout->lineCount() - 1);
+    const QFontInfo fontInfo(font);
+
+    QQuickTextLayoutCacheEntry *entry = new QQuickTextLayoutCacheEntry(fontInfo);
+    entry->assignedFont = fontInfo.family();
+    entry->boundingRect = rect;
+    entry->advance = QSizeF(lastLine.horizontalAdvance(), lastLine.y() - firstLine.y());
+    entry->implicitSize = QSizeF(naturalWidth + key.leftPadding + key.rightPadding,
+                                 height + key.topPadding + key.bottomPadding);
+    entry->baseline = firstLine.y() + firstLine.ascent();
+    entry->lineWidth = lineWidth;
+    entry->width = key.widthValid ? key.width : entry->implicitSize.width();
+    entry->lineCount = layout->lineCount();
+    entry->widthExceeded = widthExceeded;
+    return entry;
+}
+
+/*
+    Lays out a text on a worker thread for a Text item with asynchronous set,
+    with layoutCacheableText() like QQuickTextPrivate::setupTextLayout() does.
+*/
+class QQuickTextLayoutJob
+{
+public:
+    QQuickTextLayoutJob(QQuickText *item, const QQuickTextLayoutCacheKey &key);
+
+    void run(const QSharedPointer<QQuickTextLayoutJob> &self);
+    void cancel();
+
+    const QQuickTextLayoutCacheKey key;
+    QSharedPointer<QQuickTextLayoutCacheEntry> entry;
+
+private:
+    QMutex mutex;
+    QQuickText *item;
+    QFont font;
+};
+
+class QQuickTextLayoutRunnable : public QRunnable
+{
+public:
+    QQuickTextLayoutRunnable(const QSharedPointer<QQuickTextLayoutJob> &job) : job(job) {}
+    void run() override { job->run(job); }
+
+private:
+    QSharedPointer<QQuickTextLayoutJob> job;
+};
+
+Q_GLOBAL_STATIC(QThreadPool, textLayoutThreadPool)
+
+QQuickTextLayoutJob::QQuickTextLayoutJob(QQuickText *item, const QQuickTextLayoutCacheKey &key)
+    : key(key), item(item)
+{
+    // The font private caches the font engines of the thread that used it last,
+    // so the worker thread gets a font that doesn't share it with the item.
+    font.fromString(key.font.toString());
+    font.setStyleName(key.font.styleName());
+    font.setCapitalization(key.font.capitalization());
+    font.setLetterSpacing(key.font.letterSpacingType(), key.font.letterSpacing());
+    font.setWordSpacing(key.font.wordSpacing());
+    font.setKerning(key.font.kerning());
+    font.setHintingPreference(key.font.hintingPreference());
+    font.setStyleStrategy(key.font.styleStrategy());
+}
+
+void QQuickTextLayoutJob::cancel()
+{
+    QMutexLocker locker(&mutex);
+    item = nullptr;
+}
+
+void QQuickTextLayoutJob::run(const QSharedPointer<QQuickTextLayoutJob> &self)
+{
+    {
+        QMutexLocker locker(&mutex);
+        if (!item)
+            return;
+    }
+
+    QSharedPointer<QTextLayout> layout(new QTextLayout(key.text, font));
+    QSharedPointer<QQuickTextLayoutCacheEntry> result(layoutCacheableText(layout.data(), key, font));
+    result->layout = layout;
+
+    // Don't keep the font engines of this thread around in the layout
+    layout->engine()->resetFontEngineCache();
+
+    QMutexLocker locker(&mutex);
+    if (!item)
+        return;
+    entry = result;
+    QQuickText *text = item;
+    QMetaObject::invokeMethod(item, [text, self]() {
+        QQuickTextPrivate::get(text)->layoutJobFinished(self);
+    }, Qt::QueuedConnection);
+}
+
 QQuickTextPrivate::QQuickTextPrivate()
-    : fontInfo(font), elideLayout(nullptr), textLine(nullptr), lineWidth(0)
+    : fontInfo(font), layout(new QTextLayout), elideLayout(nullptr), textLine(nullptr), lineWidth(0)
     , color(0xFF000000), linkColor(0xFF0000FF), styleColor(0xFF000000)
     , lineCount(1), multilengthEos(-1)
     , elideMode(QQuickText::ElideNone), hAlign(QQuickText::AlignLeft), vAlign(QQuickText::AlignTop)
@@ -89,6 +342,8 @@ QQuickTextPrivate::QQuickTextPrivate()
     , layoutTextElided(false), textHasChanged(true), needToUpdateLayout(false), formatModifiesFontSize(false)
     , polishSize(false)
     , updateSizeRecursionGuard(false)
+    , layoutShared(false)
+    , asynchronous(false)
 {
     implicitAntialiasing = true;
 }
@@ -255,12 +510,13 @@ void QQuickTextPrivate::updateLayout()
     // Setup instance of QTextLayout for all cases other than richtext
     if (!richText) {
         if (textHasChanged) {
+            detachLayout();
             if (styledText && !text.isEmpty()) {
-                layout.setFont(font);
+                layout->setFont(font);
                 // needs temporary bool because formatModifiesFontSize is in a bit-field
                 bool fontSizeModified = false;
                 QList<QQuickStyledTextImgTag*> someImgTags = extra.isAllocated() ? extra->imgTags : QList<QQuickStyledTextImgTag*>();
-                QQuickStyledText::parse(text, layout, someImgTags, q->baseUrl(), qmlContext(q), !maximumLineCountValid, &fontSizeModified);
+                QQuickStyledText::parse(text, *layout, someImgTags, q->baseUrl(), qmlContext(q), !maximumLineCountValid, &fontSizeModified);
                 if (someImgTags.size() || extra.isAllocated())
                     extra.value().imgTags = someImgTags;
                 formatModifiesFontSize = fontSizeModified;
@@ -271,7 +527,7 @@ void QQuickTextPrivate::updateLayout()
                 if (multilengthEos != -1)
                     tmp = tmp.mid(0, multilengthEos);
                 tmp.replace(QLatin1Char('\n'), QChar::LineSeparator);
-                layout.setText(tmp);
+                layout->setText(tmp);
             }
             textHasChanged = false;
         }
@@ -614,7 +870,7 @@ void QQuickTextPrivate::elideFormats(
         const int start, const int length, int offset, QVector<QTextLayout::FormatRange> *elidedFormats)
 {
     const int end = start + length;
-    const QVector<QTextLayout::FormatRange> formats = layout.formats();
+    const QVector<QTextLayout::FormatRange> formats = layout->formats();
     for (int i = 0; i < formats.count(); ++i) {
         QTextLayout::FormatRange format = formats.at(i);
         const int formatLength = qMin(format.start + format.length, end) - qMax(format.start, start);
@@ -629,20 +885,20 @@ void QQuickTextPrivate::elideFormats(
 QString QQuickTextPrivate::elidedText(qreal lineWidth, const QTextLine &line, QTextLine *nextLine) const
 {
     if (nextLine) {
-        return layout.engine()->elidedText(
+        return layout->engine()->elidedText(
                 Qt::TextElideMode(elideMode),
                 QFixed::fromReal(lineWidth),
                 0,
                 line.textStart(),
                 line.textLength() + nextLine->textLength());
     } else {
-        QString elideText = layout.text().mid(line.textStart(), line.textLength());
+        QString elideText = layout->text().mid(line.textStart(), line.textLength());
         if (!styledText) {
             // QFontMetrics won't help eliding styled text.
             elideText[elideText.length() - 1] = elideChar;
             // Appending the elide character may push the line over the maximum width
             // in which case the elided text will need to be elided.
-            QFontMetricsF metrics(layout.font());
+            QFontMetricsF metrics(layout->font());
             if (metrics.width(elideChar) + line.naturalTextWidth() >= lineWidth)
                 elideText = metrics.elidedText(elideText, Qt::TextElideMode(elideMode), lineWidth);
         }
@@ -652,7 +908,8 @@ QString QQuickTextPrivate::elidedText(qreal lineWidth, const QTextLine &line, QT
 
 void QQuickTextPrivate::clearFormats()
 {
-    layout.clearFormats();
+    detachLayout();
+    layout->clearFormats();
     if (elideLayout)
         elideLayout->clearFormats();
 }
@@ -668,6 +925,27 @@ QRectF QQuickTextPrivate::setupTextLayout(qreal *const baseline)
 {
     Q_Q(QQuickText);
 
+    if (isLayoutCacheable()) {
+        const QQuickTextLayoutCacheKey cacheKey = layoutCacheKey();
+        QRectF rect;
+        if (setupCachedTextLayout(cacheKey, baseline, &rect))
+            return rect;
+        if (asynchronous)
+            return setupPendingTextLayout(cacheKey, baseline);
+
+        cancelLayoutJob();
+        detachLayout();
+        QScopedPointer<QQuickTextLayoutCacheEntry> entry(layoutCacheableText(layout.data(), cacheKey, font));
+        entry->layout = layout;
+        if (setupTextLayoutFromEntry(*entry, false, baseline, &rect)) {
+            cacheTextLayout(cacheKey, *entry);
+            return rect;
+        }
+        // A binding to the implicit size resized the item, lay it out for its new size below
+    }
+    cancelLayoutJob();
+    detachLayout();
+
     bool singlelineElide = elideMode != QQuickText::ElideNone && q->widthValid();
     bool multilineElide = elideMode == QQuickText::ElideRight
             && q->widthValid()
@@ -690,7 +968,7 @@ QRectF QQuickTextPrivate::setupTextLayout(qreal *const baseline)
         }
 
         if (qFuzzyIsNull(q->width())) {
-            layout.setText(QString());
+            layout->setText(QString());
             textHasChanged = true;
         }
 
@@ -703,18 +981,18 @@ QRectF QQuickTextPrivate::setupTextLayout(qreal *const baseline)
     bool shouldUseDesignMetrics = renderType != QQuickText::NativeRendering;
     if (extra.isAllocated())
         extra->visibleImgTags.clear();
-    layout.setCacheEnabled(true);
-    QTextOption textOption = layout.textOption();
+    layout->setCacheEnabled(true);
+    QTextOption textOption = layout->textOption();
     if (textOption.alignment() != q->effectiveHAlign()
             || textOption.wrapMode() != QTextOption::WrapMode(wrapMode)
             || textOption.useDesignMetrics() != shouldUseDesignMetrics) {
         textOption.setAlignment(Qt::Alignment(q->effectiveHAlign()));
         textOption.setWrapMode(QTextOption::WrapMode(wrapMode));
         textOption.setUseDesignMetrics(shouldUseDesignMetrics);
-        layout.setTextOption(textOption);
+        layout->setTextOption(textOption);
     }
-    if (layout.font() != font)
-        layout.setFont(font);
+    if (layout->font() != font)
+        layout->setFont(font);
 
     lineWidth = (q->widthValid() || implicitWidthValid) && q->width() > 0
             ? q->width()
@@ -731,7 +1009,7 @@ QRectF QQuickTextPrivate::setupTextLayout(qreal *const baseline)
             && (q->heightValid() || (maximumLineCountValid && canWrap));
 
     const bool pixelSize = font.pixelSize() != -1;
-    QString layoutText = layout.text();
+    QString layoutText = layout->text();
 
     int largeFont = pixelSize ? font.pixelSize() : font.pointSize();
     int smallFont = fontSizeMode() != QQuickText::FixedSize
@@ -766,11 +1044,11 @@ QRectF QQuickTextPrivate::setupTextLayout(qreal *const baseline)
                 scaledFont.setPixelSize(scaledFontSize);
             else
                 scaledFont.setPointSize(scaledFontSize);
-            if (layout.font() != scaledFont)
-                layout.setFont(scaledFont);
+            if (layout->font() != scaledFont)
+                layout->setFont(scaledFont);
         }
 
-        layout.beginLayout();
+        layout->beginLayout();
 
         bool wrapped = false;
         bool truncateHeight = false;
@@ -784,7 +1062,7 @@ QRectF QQuickTextPrivate::setupTextLayout(qreal *const baseline)
         br = QRectF();
 
         QRectF unelidedRect;
-        QTextLine line = layout.createLine();
+        QTextLine line = layout->createLine();
         for (visibleCount = 1; ; ++visibleCount) {
             if (customLayout) {
                 setupCustomLineGeometry(line, naturalHeight);
@@ -807,7 +1085,7 @@ QRectF QQuickTextPrivate::setupTextLayout(qreal *const baseline)
 
                 visibleCount -= 1;
 
-                QTextLine previousLine = layout.lineAt(visibleCount - 1);
+                QTextLine previousLine = layout->lineAt(visibleCount - 1);
                 elideText = layoutText.at(line.textStart() - 1) != QChar::LineSeparator
                         ? elidedText(line.width(), previousLine, &line)
                         : elidedText(line.width(), previousLine);
@@ -819,7 +1097,7 @@ QRectF QQuickTextPrivate::setupTextLayout(qreal *const baseline)
             }
 
             const QTextLine previousLine = line;
-            line = layout.createLine();
+            line = layout->createLine();
             if (!line.isValid()) {
                 if (singlelineElide && visibleCount == 1 && previousLine.naturalTextWidth() > previousLine.width()) {
                     // Elide a single previousLine of  text if its width exceeds the element width.
@@ -829,7 +1107,7 @@ QRectF QQuickTextPrivate::setupTextLayout(qreal *const baseline)
                         break;
 
                     truncated = true;
-                    elideText = layout.engine()->elidedText(
+                    elideText = layout->engine()->elidedText(
                             Qt::TextElideMode(elideMode),
                             QFixed::fromReal(previousLine.width()),
                             0,
@@ -886,8 +1164,8 @@ QRectF QQuickTextPrivate::setupTextLayout(qreal *const baseline)
             if ((requireImplicitSize) && line.isValid() && unwrappedLineCount < maxLineCount) {
                 // Layout the remainder of the wrapped lines up to maxLineCount to get the implicit
                 // height.
-                for (int lineCount = layout.lineCount(); lineCount < maxLineCount; ++lineCount) {
-                    line = layout.createLine();
+                for (int lineCount = layout->lineCount(); lineCount < maxLineCount; ++lineCount) {
+                    line = layout->createLine();
                     if (!line.isValid())
                         break;
                     if (layoutText.at(line.textStart() - 1) == QChar::LineSeparator)
@@ -901,13 +1179,13 @@ QRectF QQuickTextPrivate::setupTextLayout(qreal *const baseline)
                         ? line.textStart() + line.textLength()
                         : layoutText.length();
                 if (eol < layoutText.length() && layoutText.at(eol) != QChar::LineSeparator)
-                    line = layout.createLine();
+                    line = layout->createLine();
                 for (; line.isValid() && unwrappedLineCount <= maxLineCount; ++unwrappedLineCount)
-                    line = layout.createLine();
+                    line = layout->createLine();
             }
-            layout.endLayout();
+            layout->endLayout();
 
-            const qreal naturalWidth = layout.maximumWidth();
+            const qreal naturalWidth = layout->maximumWidth();
 
             bool wasInLayout = internalWidthUpdate;
             internalWidthUpdate = true;
@@ -964,14 +1242,14 @@ QRectF QQuickTextPrivate::setupTextLayout(qreal *const baseline)
         } else if (widthChanged) {
             widthChanged = false;
             if (line.isValid()) {
-                for (int lineCount = layout.lineCount(); lineCount < maxLineCount; ++lineCount) {
-                    line = layout.createLine();
+                for (int lineCount = layout->lineCount(); lineCount < maxLineCount; ++lineCount) {
+                    line = layout->createLine();
                     if (!line.isValid())
                         break;
                     setLineGeometry(line, lineWidth, naturalHeight);
                 }
             }
-            layout.endLayout();
+            layout->endLayout();
 
             bool wasInLayout = internalWidthUpdate;
             internalWidthUpdate = true;
@@ -995,7 +1273,7 @@ QRectF QQuickTextPrivate::setupTextLayout(qreal *const baseline)
                 continue;
             }
         } else {
-            layout.endLayout();
+            layout->endLayout();
         }
 
         // If the next needs to be elided and there's an abbreviated string available
@@ -1005,7 +1283,7 @@ QRectF QQuickTextPrivate::setupTextLayout(qreal *const baseline)
             eos = text.indexOf(QLatin1Char('\x9c'),  start);
             layoutText = text.mid(start, eos != -1 ? eos - start : -1);
             layoutText.replace(QLatin1Char('\n'), QChar::LineSeparator);
-            layout.setText(layoutText);
+            layout->setText(layoutText);
             textHasChanged = true;
             continue;
         }
@@ -1013,9 +1291,9 @@ QRectF QQuickTextPrivate::setupTextLayout(qreal *const baseline)
         br.moveTop(0);
 
         // Find the advance of the text layout
-        if (layout.lineCount() > 0) {
-            QTextLine firstLine = layout.lineAt(0);
-            QTextLine lastLine = layout.lineAt(layout.lineCount() - 1);
+        if (layout->lineCount() > 0) {
+            QTextLine firstLine = layout->lineAt(0);
+            QTextLine lastLine = layout->lineAt(layout->lineCount() - 1);
             advance = QSizeF(lastLine.horizontalAdvance(),
                              lastLine.y() - firstLine.y());
         } else {
@@ -1066,16 +1344,7 @@ QRectF QQuickTextPrivate::setupTextLayout(qreal *const baseline)
     implicitWidthValid = true;
     implicitHeightValid = true;
 
-    QFontInfo scaledFontInfo(scaledFont);
-    if (fontInfo.weight() != scaledFontInfo.weight()
-            || fontInfo.pixelSize() != scaledFontInfo.pixelSize()
-            || fontInfo.italic() != scaledFontInfo.italic()
-            || !qFuzzyCompare(fontInfo.pointSizeF(), scaledFontInfo.pointSizeF())
-            || fontInfo.family() != scaledFontInfo.family()
-            || fontInfo.styleName() != scaledFontInfo.styleName()) {
-        fontInfo = scaledFontInfo;
-        emit q->fontInfoChanged();
-    }
+    setFontInfo(QFontInfo(scaledFont));
 
     if (eos != multilengthEos)
         truncated = true;
@@ -1087,7 +1356,7 @@ QRectF QQuickTextPrivate::setupTextLayout(qreal *const baseline)
             elideLayout = new QTextLayout;
             elideLayout->setCacheEnabled(true);
         }
-        QTextEngine *engine = layout.engine();
+        QTextEngine *engine = layout->engine();
         if (engine && engine->hasFormats()) {
             QVector<QTextLayout::FormatRange> formats;
             switch (elideMode) {
@@ -1115,8 +1384,8 @@ QRectF QQuickTextPrivate::setupTextLayout(qreal *const baseline)
             elideLayout->setFormats(formats);
         }
 
-        elideLayout->setFont(layout.font());
-        elideLayout->setTextOption(layout.textOption());
+        elideLayout->setFont(layout->font());
+        elideLayout->setTextOption(layout->textOption());
         elideLayout->setText(elideText);
         elideLayout->beginLayout();
 
@@ -1132,7 +1401,7 @@ QRectF QQuickTextPrivate::setupTextLayout(qreal *const baseline)
         br = br.united(elidedLine.naturalTextRect());
 
         if (visibleCount == 1)
-            layout.clearLayout();
+            layout->clearLayout();
     } else {
         delete elideLayout;
         elideLayout = nullptr;
@@ -1140,7 +1409,7 @@ QRectF QQuickTextPrivate::setupTextLayout(qreal *const baseline)
 
     QTextLine firstLine = visibleCount == 1 && elideLayout
             ? elideLayout->lineAt(0)
-            : layout.lineAt(0);
+            : layout->lineAt(0);
     Q_ASSERT(firstLine.isValid());
     *baseline = firstLine.y() + firstLine.ascent();
 
@@ -1159,6 +1428,204 @@ QRectF QQuickTextPrivate::setupTextLayout(qreal *const baseline)
     return br;
 }
 
+/*!
+    Returns true if the layout of the text only depends on the inputs in a
+    QQuickTextLayoutCacheKey, so that it can be shared with other items.
+*/
+bool QQuickTextPrivate::isLayoutCacheable()
+{
+    return !richText && !styledText && multilengthEos == -1 && !internalWidthUpdate
+            && elideMode == QQuickText::ElideNone
+            && fontSizeMode() == QQuickText::FixedSize
+            && !maximumLineCountValid
+            && layout->formats().isEmpty()
+            && !isLineLaidOutConnected();
+}
+
+QQuickTextLayoutCacheKey QQuickTextPrivate::layoutCacheKey() const
+{
+    Q_Q(const QQuickText);
+    QQuickTextLayoutCacheKey key;
+    key.text = layout->text();
+    key.font = font;
+    key.width = q->width();
+    key.topPadding = q->topPadding();
+    key.leftPadding = q->leftPadding();
+    key.rightPadding = q->rightPadding();
+    key.bottomPadding = q->bottomPadding();
+    key.lineHeight = lineHeight();
+    key.lineHeightMode = lineHeightMode();
+    key.hAlign = q->effectiveHAlign();
+    key.wrapMode = wrapMode;
+    key.useDesignMetrics = renderType != QQuickText::NativeRendering;
+    key.widthValid = q->widthValid();
+    key.implicitWidthValid = implicitWidthValid;
+    return key;
+}
+
+/*!
+    Takes the layout from the layout cache if another item has laid out the
+    same text in the same way, or the result of a finished asynchronous layout.
+    Returns false if it has to be laid out.
+*/
+bool QQuickTextPrivate::setupCachedTextLayout(const QQuickTextLayoutCacheKey &key, qreal *const baseline, QRectF *rect)
+{
+    if (finishedLayoutJob && finishedLayoutJob->key == key) {
+        // The worker thread made the same passes as setupTextLayout() would have
+        const QSharedPointer<QQuickTextLayoutCacheEntry> entry = finishedLayoutJob->entry;
+        if (!setupTextLayoutFromEntry(*entry, false, baseline, rect))
+            return false;
+        cacheTextLayout(key, *entry);
+        return true;
+    }
+
+    if (key.text.length() > maximumCachedTextLength)
+        return false;
+    const QQuickTextLayoutCacheEntry *cachedEntry = textLayoutCache()->entries.object(key);
+    if (!cachedEntry)
+        return false;
+    // Setting the implicit size runs bindings, which may lay out other items
+    const QQuickTextLayoutCacheEntry entry(*cachedEntry);
+    return setupTextLayoutFromEntry(entry, true, baseline, rect);
+}
+
+/*!
+    Takes the layout and everything derived from it from \a entry, which
+    layoutCacheableText() returned. Returns false if the item has to be laid
+    out after all, because setting its implicit size resized it differently.
+*/
+bool QQuickTextPrivate::setupTextLayoutFromEntry(const QQuickTextLayoutCacheEntry &entry, bool shared,
+                                                 qreal *const baseline, QRectF *rect)
+{
+    Q_Q(QQuickText);
+    const bool wasInLayout = internalWidthUpdate;
+    internalWidthUpdate = true;
+    q->setImplicitSize(entry.implicitSize.width(), entry.implicitSize.height());
+    internalWidthUpdate = wasInLayout;
+
+    if (q->width() != entry.width)
+        return false;
+
+    layout = entry.layout;
+    layoutShared = shared;
+    delete elideLayout;
+    elideLayout = nullptr;
+
+    lineWidth = entry.lineWidth;
+    advance = entry.advance;
+    widthExceeded = entry.widthExceeded;
+    // Only eliding, fitting and maximumLineCount depend on the height, none of them is cacheable
+    heightExceeded = false;
+    implicitWidthValid = true;
+    implicitHeightValid = true;
+    setFontInfo(entry.fontInfo);
+    assignedFont = entry.assignedFont;
+    *baseline = entry.baseline;
+    *rect = entry.boundingRect;
+
+    if (lineCount != entry.lineCount) {
+        lineCount = entry.lineCount;
+        emit q->lineCountChanged();
+    }
+    if (truncated != entry.truncated) {
+        truncated = entry.truncated;
+        emit q->truncatedChanged();
+    }
+    cancelLayoutJob();
+    return true;
+}
+
+void QQuickTextPrivate::cacheTextLayout(const QQuickTextLayoutCacheKey &key, const QQuickTextLayoutCacheEntry &entry)
+{
+    if (key.text.length() > maximumCachedTextLength)
+        return;
+    textLayoutCache()->entries.insert(key, new QQuickTextLayoutCacheEntry(entry));
+    layoutShared = true;
+}
+
+/*!
+    Gives the item a layout of its own before it is changed, if it is shared
+    with other items through the layout cache.
+*/
+void QQuickTextPrivate::detachLayout()
+{
+    if (!layoutShared)
+        return;
+    layout.reset(new QTextLayout(layout->text()));
+    layoutShared = false;
+}
+
+/*!
+    Starts laying out the text on a worker thread, unless that is already in
+    progress. Nothing is shown until it finishes.
+*/
+QRectF QQuickTextPrivate::setupPendingTextLayout(const QQuickTextLayoutCacheKey &key, qreal *const baseline)
+{
+    Q_Q(QQuickText);
+    if (!layoutJob || !(layoutJob->key == key)) {
+        const bool wasPending = !layoutJob.isNull();
+        if (wasPending)
+            layoutJob->cancel();
+        layoutJob.reset(new QQuickTextLayoutJob(q, key));
+        textLayoutThreadPool()->start(new QQuickTextLayoutRunnable(layoutJob));
+        if (!wasPending)
+            emit q->layoutPendingChanged();
+    }
+
+    detachLayout();
+    layout->clearLayout();
+    delete elideLayout;
+    elideLayout = nullptr;
+    advance = QSizeF();
+    if (lineCount) {
+        lineCount = 0;
+        emit q->lineCountChanged();
+    }
+
+    QFontMetricsF fm(font);
+    *baseline = fm.ascent();
+    return QRectF();
+}
+
+void QQuickTextPrivate::cancelLayoutJob()
+{
+    Q_Q(QQuickText);
+    if (!layoutJob)
+        return;
+    layoutJob->cancel();
+    layoutJob.reset();
+    emit q->layoutPendingChanged();
+}
+
+void QQuickTextPrivate::layoutJobFinished(const QSharedPointer<QQuickTextLayoutJob> &job)
+{
+    Q_Q(QQuickText);
+    if (job != layoutJob)
+        return;
+
+    layoutJob.reset();
+    // setupTextLayout() takes the result, unless the item has changed meanwhile
+    finishedLayoutJob = job;
+    updateSize();
+    finishedLayoutJob.reset();
+    if (!layoutJob)
+        emit q->layoutPendingChanged();
+}
+
+void QQuickTextPrivate::setFontInfo(const QFontInfo &info)
+{
+    Q_Q(QQuickText);
+    if (fontInfo.weight() != info.weight()
+            || fontInfo.pixelSize() != info.pixelSize()
+            || fontInfo.italic() != info.italic()
+            || !qFuzzyCompare(fontInfo.pointSizeF(), info.pointSizeF())
+            || fontInfo.family() != info.family()
+            || fontInfo.styleName() != info.styleName()) {
+        fontInfo = info;
+        emit q->fontInfoChanged();
+    }
+}
+
 void QQuickTextPrivate::setLineGeometry(QTextLine &line, qreal lineWidth, qreal &height)
 {
     Q_Q(QQuickText);
@@ -1315,6 +1782,9 @@ QQuickText::QQuickText(QQuickTextPrivate &dd, QQuickItem *parent)
 
 QQuickText::~QQuickText()
 {
+    Q_D(QQuickText);
+    if (d->layoutJob)
+        d->layoutJob->cancel();
 }
 
 /*!
@@ -2431,7 +2901,7 @@ QSGNode *QQuickText::updatePaintNode(QSGNode *oldNode, UpdatePaintNodeData *data
         if (unelidedLineCount > 0) {
             node->addTextLayout(
                         QPointF(dx, dy),
-                        &d->layout,
+                        d->layout.data(),
                         color, d->style, styleColor, linkColor,
                         QColor(), QColor(), -1, -1,
                         0, unelidedLineCount);
@@ -2721,7 +3191,7 @@ QString QQuickTextPrivate::anchorAt(const QPointF &mousePos) const
     translatedMousePos.rx() -= q->leftPadding();
     translatedMousePos.ry() -= q->topPadding() + QQuickTextUtil::alignedY(layedOutTextRect.height() + lineHeightOffset(), availableHeight(), vAlign);
     if (styledText) {
-        QString link = anchorAt(&layout, translatedMousePos);
+        QString link = anchorAt(layout.data(), translatedMousePos);
         if (link.isEmpty() && elideLayout)
             link = anchorAt(elideLayout, translatedMousePos);
         return link;
@@ -2953,9 +3423,10 @@ void QQuickText::invalidateFontCaches()
             if (block.layout() != nullptr && block.layout()->engine() != nullptr)
                 block.layout()->engine()->resetFontEngineCache();
         }
-    } else {
-        if (d->layout.engine() != nullptr)
-            d->layout.engine()->resetFontEngineCache();
+    } else if (!d->layoutShared) {
+        // A shared layout is still used by other items, it keeps its font engines
+        if (d->layout->engine() != nullptr)
+            d->layout->engine()->resetFontEngineCache();
     }
 }
 
@@ -3174,6 +3645,75 @@ QSizeF QQuickText::advance() const
     return d->advance;
 }
 
+/*!
+    \qmlproperty bool QtQuick::Text::asynchronous
+    \since 5.13
+
+    Specifies that plain text should be laid out on a separate thread.
+    The default value is false, causing the user interface thread to block
+    while the text is shaped and broken into lines.
+
+    Setting asynchronous to true is useful when keeping a responsive user
+    interface while creating many delegates with long texts. Until the layout
+    finishes, the text is not shown, \l implicitWidth and \l implicitHeight
+    keep their previous values and \l layoutPending is true.
+
+    Rich and styled text, elided text, \l fontSizeMode other than
+    Text.FixedSize, \l maximumLineCount and \l lineLaidOut handlers
+    are always laid out synchronously.
+
+    \sa layoutPending
+*/
+bool QQuickText::asynchronous() const
+{
+    Q_D(const QQuickText);
+    return d->asynchronous;
+}
+
+void QQuickText::setAsynchronous(bool asynchronous)
+{
+    Q_D(QQuickText);
+    if (d->asynchronous == asynchronous)
+        return;
+
+    d->asynchronous = asynchronous;
+    if (!asynchronous && d->layoutJob)
+        d->updateLayout();
+    emit asynchronousChanged();
+}
+
+/*!
+    \qmlproperty bool QtQuick::Text::layoutPending
+    \readonly
+    \since 5.13
+
+    This property holds whether the text is being laid out asynchronously.
+    It can be used to show a placeholder meanwhile.
+
+    \code
+    Text {
+        id: label
+        asynchronous: true
+        text: longDescription
+        width: parent.width
+        wrapMode: Text.Wrap
+
+        Rectangle {
+            anchors.fill: parent
+            color: "lightgray"
+            visible: label.layoutPending
+        }
+    }
+    \endcode
+
+    \sa asynchronous
+*/
+bool QQuickText::isLayoutPending() const
+{
+    Q_D(const QQuickText);
+    return !d->layoutJob.isNull();
+}
+
 QT_END_NAMESPACE
 
 #include "moc_qquicktext_p.cpp"
@@ -101,6 +101,9 @@ class Q_QUICK_PRIVATE_EXPORT QQuickText : public QQuickImplicitSizeItem
     Q_PROPERTY(QJSValue fontInfo READ fontInfo NOTIFY fontInfoChanged REVISION 9)
     Q_PROPERTY(QSizeF advance READ advance NOTIFY contentSizeChanged REVISION 10)
 
+    Q_PROPERTY(bool asynchronous READ asynchronous WRITE setAsynchronous NOTIFY asynchronousChanged REVISION 13)
+    Q_PROPERTY(bool layoutPending READ isLayoutPending NOTIFY layoutPendingChanged REVISION 13)
+
 public:
     QQuickText(QQuickItem *parent=nullptr);
     ~QQuickText() override;
@@ -254,6 +257,10 @@ public:
     QJSValue fontInfo() const;
     QSizeF advance() const;
 
+    bool asynchronous() const;
+    void setAsynchronous(bool asynchronous);
+    bool isLayoutPending() const;
+
 Q_SIGNALS:
     void textChanged(const QString &text);
     void linkActivated(const QString &link);
@@ -291,6 +298,8 @@ Q_SIGNALS:
     Q_REVISION(6) void rightPaddingChanged();
     Q_REVISION(6) void bottomPaddingChanged();
     Q_REVISION(9) void fontInfoChanged();
+    Q_REVISION(13) void asynchronousChanged();
+    Q_REVISION(13) void layoutPendingChanged();
 
 protected:
     QQuickText(QQuickTextPrivate &dd, QQuickItem *parent = nullptr);
@@ -57,6 +57,7 @@
 #include <QtQml/qqml.h>
 #include <QtGui/qabstracttextdocumentlayout.h>
 #include <QtGui/qtextlayout.h>
+#include <QtCore/qsharedpointer.h>
 #include <private/qquickstyledtext_p.h>
 #include <private/qlazilyallocated_p.h>
 
@@ -64,6 +65,27 @@ QT_BEGIN_NAMESPACE
 
 class QTextLayout;
 class QQuickTextDocumentWithImageResources;
+class QQuickTextLayoutJob;
+struct QQuickTextLayoutCacheEntry;
+
+// The inputs of a plain text layout, see QQuickTextPrivate::isLayoutCacheable()
+struct QQuickTextLayoutCacheKey
+{
+    QString text;
+    QFont font;
+    qreal width = 0;
+    qreal topPadding = 0;
+    qreal leftPadding = 0;
+    qreal rightPadding = 0;
+    qreal bottomPadding = 0;
+    qreal lineHeight = 1;
+    int lineHeightMode = 0;
+    int hAlign = 0;
+    int wrapMode = 0;
+    bool useDesignMetrics = false;
+    bool widthValid = false;
+    bool implicitWidthValid = false;
+};
 
 class Q_QUICK_PRIVATE_EXPORT QQuickTextPrivate : public QQuickImplicitSizeItemPrivate
 {
@@ -127,9 +149,13 @@ public:
     QFont sourceFont;
     QFontInfo fontInfo;
 
-    QTextLayout layout;
+    // Shared with other items through the layout cache while layoutShared is set
+    QSharedPointer<QTextLayout> layout;
     QTextLayout *elideLayout;
     QQuickTextLine *textLine;
+    // The asynchronous layout in progress, and the one being applied
+    QSharedPointer<QQuickTextLayoutJob> layoutJob;
+    QSharedPointer<QQuickTextLayoutJob> finishedLayoutJob;
 
     qreal lineWidth;
 
@@ -176,6 +202,8 @@ public:
     bool formatModifiesFontSize:1;
     bool polishSize:1; // Workaround for problem with polish called after updateSize (QTBUG-42636)
     bool updateSizeRecursionGuard:1;
+    bool layoutShared:1;
+    bool asynchronous:1;
 
     static const QChar elideChar;
 
@@ -194,10 +222,23 @@ public:
     void ensureDoc();
 
     QRectF setupTextLayout(qreal * const baseline);
+    bool isLayoutCacheable();
+    QQuickTextLayoutCacheKey layoutCacheKey() const;
+    bool setupCachedTextLayout(const QQuickTextLayoutCacheKey &key, qreal *const baseline, QRectF *rect);
+    bool setupTextLayoutFromEntry(const QQuickTextLayoutCacheEntry &entry, bool shared,
+                                  qreal *const baseline, QRectF *rect);
+    void cacheTextLayout(const QQuickTextLayoutCacheKey &key, const QQuickTextLayoutCacheEntry &entry);
+    void detachLayout();
+    QRectF setupPendingTextLayout(const QQuickTextLayoutCacheKey &key, qreal *const baseline);
+    void cancelLayoutJob();
+    void layoutJobFinished(const QSharedPointer<QQuickTextLayoutJob> &job);
+    void setFontInfo(const QFontInfo &info);
     void setupCustomLineGeometry(QTextLine &line, qreal &height, int lineOffset = 0);
     bool isLinkActivatedConnected();
     bool isLinkHoveredConnected();
     static QString anchorAt(const QTextLayout *layout, const QPointF &mousePos);
+    // The number of layouts in the calling thread's layout cache
+    static int textLayoutCacheCount();
     QString anchorAt(const QPointF &pos) const;
 
     inline qreal lineHeight() const { return extra.isAllocated() ? extra->lineHeight : 1.0; }
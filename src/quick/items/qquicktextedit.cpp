@@ -126,6 +126,14 @@ TextEdit {
 // into text nodes corresponding to a text block each so that the glyph node grouping doesn't become pointless.
 static const int nodeBreakingSize = 300;
 
+// Documents with more characters than this only get text nodes for the blocks in and
+// around the visible part of the item. This only limits the nodes: the document is
+// still laid out in full, by updateSize() asking for its size and by firstBlockBelow()
+// asking for block positions, which QTextDocumentLayout lays out up to.
+static const int largeTextSizeThreshold = 10000;
+// The least amount of the document that gets nodes above and below the visible part.
+static const qreal viewportMargin = 256;
+
 namespace {
     class ProtectedLayoutAccessor: public QAbstractTextDocumentLayout
     {
@@ -1982,6 +1990,24 @@ static inline void updateNodeTransform(QQuickTextNode* node, const QPointF &topL
     node->setMatrix(transformMatrix);
 }
 
+// Returns the first block from \a block on whose bottom is below \a y.
+static QTextBlock firstBlockBelow(QTextDocument *document, const QTextBlock &block, qreal y)
+{
+    QAbstractTextDocumentLayout *layout = document->documentLayout();
+    if (!block.isValid() || layout->blockBoundingRect(block).bottom() >= y)
+        return block;
+    int low = block.blockNumber() + 1;
+    int high = document->blockCount();
+    while (low < high) {
+        const int middle = low + (high - low) / 2;
+        if (layout->blockBoundingRect(document->findBlockByNumber(middle)).bottom() < y)
+            low = middle + 1;
+        else
+            high = middle;
+    }
+    return document->findBlockByNumber(low);
+}
+
 /*!
  * \internal
  *
@@ -2029,6 +2055,29 @@ QSGNode *QQuickTextEdit::updatePaintNode(QSGNode *oldNode, UpdatePaintNodeData *
     }
 
     RootNode *rootNode = static_cast<RootNode *>(oldNode);
+
+    // Large documents without child frames only get nodes for the blocks in and
+    // around the visible part of the item; they are renoded when that leaves the
+    // rendered range.
+    const bool restrictToViewport = d->observesViewport
+            && d->document->rootFrame()->childFrames().isEmpty();
+    if (restrictToViewport) {
+        const QRectF visibleRect = d->visibleDocumentRect();
+        if (!oldNode || !d->restrictedToViewport
+                || visibleRect.top() < d->renderedTop || visibleRect.bottom() > d->renderedBottom) {
+            const qreal margin = qMax(visibleRect.height() / 2, viewportMargin);
+            d->renderedTop = visibleRect.top() - margin;
+            d->renderedBottom = visibleRect.bottom() + margin;
+            d->restrictedToViewport = true;
+            for (TextNode &node : d->textNodeMap)
+                node.setDirty();
+        }
+    } else if (d->restrictedToViewport) {
+        d->restrictedToViewport = false;
+        for (TextNode &node : d->textNodeMap)
+            node.setDirty();
+    }
+
     TextNodeIterator nodeIterator = d->textNodeMap.begin();
     while (nodeIterator != d->textNodeMap.end() && !nodeIterator->dirty())
         ++nodeIterator;
@@ -2041,130 +2090,161 @@ QSGNode *QQuickTextEdit::updatePaintNode(QSGNode *oldNode, UpdatePaintNodeData *
         if (!oldNode)
             rootNode = new RootNode;
 
-        int firstDirtyPos = 0;
-        if (nodeIterator != d->textNodeMap.end()) {
-            firstDirtyPos = nodeIterator->startPos();
-            // ### this could be optimized if the first and last dirty nodes are not connected
-            // as the intermediate text nodes would usually only need to be transformed differently.
-            int lastDirtyPos = firstDirtyPos;
-            auto it = d->textNodeMap.constEnd();
-            while (it != nodeIterator) {
-                --it;
-                if (it->dirty()) {
-                    lastDirtyPos = it->startPos();
-                    break;
-                }
-            }
-            do {
-                rootNode->removeChildNode(nodeIterator->textNode());
-                delete nodeIterator->textNode();
-                nodeIterator = d->textNodeMap.erase(nodeIterator);
-            } while (nodeIterator != d->textNodeMap.constEnd() && nodeIterator->startPos() <= lastDirtyPos);
-        }
-
         // FIXME: the text decorations could probably be handled separately (only updated for affected textFrames)
         rootNode->resetFrameDecorations(d->createTextNode());
         resetEngine(&frameDecorationsEngine, d->color, d->selectedTextColor, d->selectionColor);
 
-        QQuickTextNode *node = nullptr;
-
-        int currentNodeSize = 0;
-        int nodeStart = firstDirtyPos;
         QPointF basePosition(d->xoff, d->yoff);
         QMatrix4x4 basePositionMatrix;
         basePositionMatrix.translate(basePosition.x(), basePosition.y());
         rootNode->setMatrix(basePositionMatrix);
 
-        QPointF nodeOffset;
-        const TextNode firstCleanNode = (nodeIterator != d->textNodeMap.end()) ? *nodeIterator
-                                                                               : TextNode();
-
-        QList<QTextFrame *> frames;
-        frames.append(d->document->rootFrame());
-
-        while (!frames.isEmpty()) {
-            QTextFrame *textFrame = frames.takeFirst();
-            frames.append(textFrame->childFrames());
-            frameDecorationsEngine.addFrameDecorations(d->document, textFrame);
-
-            if (textFrame->lastPosition() < firstDirtyPos
-                    || textFrame->firstPosition() >= firstCleanNode.startPos())
-                continue;
-            node = d->createTextNode();
-            resetEngine(&engine, d->color, d->selectedTextColor, d->selectionColor);
-
-            if (textFrame->firstPosition() > textFrame->lastPosition()
-                    && textFrame->frameFormat().position() != QTextFrameFormat::InFlow) {
-                updateNodeTransform(node, d->document->documentLayout()->frameBoundingRect(textFrame).topLeft());
-                const int pos = textFrame->firstPosition() - 1;
-                ProtectedLayoutAccessor *a = static_cast<ProtectedLayoutAccessor *>(d->document->documentLayout());
-                QTextCharFormat format = a->formatAccessor(pos);
-                QTextBlock block = textFrame->firstCursorPosition().block();
-                engine.setCurrentLine(block.layout()->lineForTextPosition(pos - block.position()));
-                engine.addTextObject(block, QPointF(0, 0), format, QQuickTextNodeEngine::Unselected, d->document,
-                                              pos, textFrame->frameFormat().position());
-                nodeStart = pos;
-            } else {
-                // Having nodes spanning across frame boundaries will break the current bookkeeping mechanism. We need to prevent that.
-                QList<int> frameBoundaries;
-                frameBoundaries.reserve(frames.size());
-                for (QTextFrame *frame : qAsConst(frames))
-                    frameBoundaries.append(frame->firstPosition());
-                std::sort(frameBoundaries.begin(), frameBoundaries.end());
-
-                QTextFrame::iterator it = textFrame->begin();
-                while (!it.atEnd()) {
-                    QTextBlock block = it.currentBlock();
-                    ++it;
-                    if (block.position() < firstDirtyPos)
-                        continue;
+        QList<QTextFrame *> allFrames;
+        allFrames.append(d->document->rootFrame());
+        for (int i = 0; i < allFrames.size(); ++i) {
+            allFrames.append(allFrames.at(i)->childFrames());
+            frameDecorationsEngine.addFrameDecorations(d->document, allFrames.at(i));
+        }
 
-                    if (!engine.hasContents()) {
-                        nodeOffset = d->document->documentLayout()->blockBoundingRect(block).topLeft();
-                        updateNodeTransform(node, nodeOffset);
-                        nodeStart = block.position();
-                    }
+        for (;;) {
+            bool layoutShifted = false;
 
-                    engine.addTextBlock(d->document, block, -nodeOffset, d->color, QColor(), selectionStart(), selectionEnd() - 1);
-                    currentNodeSize += block.length();
+            // Every run of consecutive dirty nodes is replaced separately, the clean
+            // nodes in between only need to be transformed differently.
+            do {
+                int firstDirtyPos = 0;
+                if (nodeIterator != d->textNodeMap.end()) {
+                    firstDirtyPos = nodeIterator->startPos();
+                    do {
+                        rootNode->removeChildNode(nodeIterator->textNode());
+                        delete nodeIterator->textNode();
+                        nodeIterator = d->textNodeMap.erase(nodeIterator);
+                    } while (nodeIterator != d->textNodeMap.end() && nodeIterator->dirty());
+                }
+
+                QQuickTextNode *node = nullptr;
+
+                int currentNodeSize = 0;
+                int nodeStart = firstDirtyPos;
+
+                QPointF nodeOffset;
+                const TextNode firstCleanNode = (nodeIterator != d->textNodeMap.end()) ? *nodeIterator
+                                                                                       : TextNode();
+
+                QList<QTextFrame *> frames;
+                frames.append(d->document->rootFrame());
 
-                    if ((it.atEnd()) || block.next().position() >= firstCleanNode.startPos())
-                        break; // last node that needed replacing or last block of the frame
+                while (!frames.isEmpty()) {
+                    QTextFrame *textFrame = frames.takeFirst();
+                    frames.append(textFrame->childFrames());
 
-                    QList<int>::const_iterator lowerBound = std::lower_bound(frameBoundaries.constBegin(), frameBoundaries.constEnd(), block.next().position());
-                    if (currentNodeSize > nodeBreakingSize || lowerBound == frameBoundaries.constEnd() || *lowerBound > nodeStart) {
-                        currentNodeSize = 0;
-                        d->addCurrentTextNodeToRoot(&engine, rootNode, node, nodeIterator, nodeStart);
-                        node = d->createTextNode();
-                        resetEngine(&engine, d->color, d->selectedTextColor, d->selectionColor);
-                        nodeStart = block.next().position();
+                    if (textFrame->lastPosition() < firstDirtyPos
+                            || textFrame->firstPosition() >= firstCleanNode.startPos())
+                        continue;
+                    node = d->createTextNode();
+                    resetEngine(&engine, d->color, d->selectedTextColor, d->selectionColor);
+
+                    if (textFrame->firstPosition() > textFrame->lastPosition()
+                            && textFrame->frameFormat().position() != QTextFrameFormat::InFlow) {
+                        updateNodeTransform(node, d->document->documentLayout()->frameBoundingRect(textFrame).topLeft());
+                        const int pos = textFrame->firstPosition() - 1;
+                        ProtectedLayoutAccessor *a = static_cast<ProtectedLayoutAccessor *>(d->document->documentLayout());
+                        QTextCharFormat format = a->formatAccessor(pos);
+                        QTextBlock block = textFrame->firstCursorPosition().block();
+                        engine.setCurrentLine(block.layout()->lineForTextPosition(pos - block.position()));
+                        engine.addTextObject(block, QPointF(0, 0), format, QQuickTextNodeEngine::Unselected, d->document,
+                                                      pos, textFrame->frameFormat().position());
+                        nodeStart = pos;
+                    } else if (restrictToViewport) {
+                        // There are no frame boundaries, so every block gets a node of its
+                        // own as below, but only the blocks in the rendered range are visited.
+                        QAbstractTextDocumentLayout *layout = d->document->documentLayout();
+                        QTextBlock block = firstBlockBelow(d->document, d->document->findBlock(firstDirtyPos), d->renderedTop);
+                        for (; block.isValid() && block.position() < firstCleanNode.startPos(); block = block.next()) {
+                            nodeOffset = layout->blockBoundingRect(block).topLeft();
+                            if (nodeOffset.y() > d->renderedBottom)
+                                break;
+                            updateNodeTransform(node, nodeOffset);
+                            engine.addTextBlock(d->document, block, -nodeOffset, d->color, QColor(), selectionStart(), selectionEnd() - 1);
+                            d->addCurrentTextNodeToRoot(&engine, rootNode, node, nodeIterator, block.position());
+                            node = d->createTextNode();
+                            resetEngine(&engine, d->color, d->selectedTextColor, d->selectionColor);
+                        }
+                        delete node;
+                        continue;
+                    } else {
+                        // Having nodes spanning across frame boundaries will break the current bookkeeping mechanism. We need to prevent that.
+                        QList<int> frameBoundaries;
+                        frameBoundaries.reserve(frames.size());
+                        for (QTextFrame *frame : qAsConst(frames))
+                            frameBoundaries.append(frame->firstPosition());
+                        std::sort(frameBoundaries.begin(), frameBoundaries.end());
+
+                        QTextFrame::iterator it = textFrame->begin();
+                        while (!it.atEnd()) {
+                            QTextBlock block = it.currentBlock();
+                            ++it;
+                            if (block.position() < firstDirtyPos)
+                                continue;
+
+                            if (!engine.hasContents()) {
+                                nodeOffset = d->document->documentLayout()->blockBoundingRect(block).topLeft();
+                                updateNodeTransform(node, nodeOffset);
+                                nodeStart = block.position();
+                            }
+
+                            engine.addTextBlock(d->document, block, -nodeOffset, d->color, QColor(), selectionStart(), selectionEnd() - 1);
+                            currentNodeSize += block.length();
+
+                            if ((it.atEnd()) || block.next().position() >= firstCleanNode.startPos())
+                                break; // last node that needed replacing or last block of the frame
+
+                            QList<int>::const_iterator lowerBound = std::lower_bound(frameBoundaries.constBegin(), frameBoundaries.constEnd(), block.next().position());
+                            if (currentNodeSize > nodeBreakingSize || lowerBound == frameBoundaries.constEnd() || *lowerBound > nodeStart) {
+                                currentNodeSize = 0;
+                                d->addCurrentTextNodeToRoot(&engine, rootNode, node, nodeIterator, nodeStart);
+                                node = d->createTextNode();
+                                resetEngine(&engine, d->color, d->selectedTextColor, d->selectionColor);
+                                nodeStart = block.next().position();
+                            }
+                        }
                     }
+                    d->addCurrentTextNodeToRoot(&engine, rootNode, node, nodeIterator, nodeStart);
                 }
-            }
-            d->addCurrentTextNodeToRoot(&engine, rootNode, node, nodeIterator, nodeStart);
+
+                Q_ASSERT(nodeIterator == d->textNodeMap.end()
+                         || (nodeIterator->textNode() == firstCleanNode.textNode()
+                             && nodeIterator->startPos() == firstCleanNode.startPos()));
+                // Update the position of the subsequent text blocks, up to the next dirty node.
+                if (firstCleanNode.textNode() != nullptr) {
+                    QPointF oldOffset = firstCleanNode.textNode()->matrix().map(QPointF(0,0));
+                    QPointF currentOffset = d->document->documentLayout()->blockBoundingRect(
+                                d->document->findBlock(firstCleanNode.startPos())).topLeft();
+                    QPointF delta = currentOffset - oldOffset;
+                    if (!delta.isNull())
+                        layoutShifted = true;
+                    while (nodeIterator != d->textNodeMap.end() && !nodeIterator->dirty()) {
+                        QMatrix4x4 transformMatrix = nodeIterator->textNode()->matrix();
+                        transformMatrix.translate(delta.x(), delta.y());
+                        nodeIterator->textNode()->setMatrix(transformMatrix);
+                        ++nodeIterator;
+                    }
+                }
+            } while (nodeIterator != d->textNodeMap.end());
+
+            if (!restrictToViewport || !layoutShifted)
+                break;
+
+            // Blocks have moved in or out of the rendered range, so renode all of it.
+            for (TextNode &node : d->textNodeMap)
+                node.setDirty();
+            nodeIterator = d->textNodeMap.begin();
         }
+
         frameDecorationsEngine.addToSceneGraph(rootNode->frameDecorationsNode, QQuickText::Normal, QColor());
         // Now prepend the frame decorations since we want them rendered first, with the text nodes and cursor in front.
         rootNode->prependChildNode(rootNode->frameDecorationsNode);
 
-        Q_ASSERT(nodeIterator == d->textNodeMap.end()
-                 || (nodeIterator->textNode() == firstCleanNode.textNode()
-                     && nodeIterator->startPos() == firstCleanNode.startPos()));
-        // Update the position of the subsequent text blocks.
-        if (firstCleanNode.textNode() != nullptr) {
-            QPointF oldOffset = firstCleanNode.textNode()->matrix().map(QPointF(0,0));
-            QPointF currentOffset = d->document->documentLayout()->blockBoundingRect(
-                        d->document->findBlock(firstCleanNode.startPos())).topLeft();
-            QPointF delta = currentOffset - oldOffset;
-            while (nodeIterator != d->textNodeMap.end()) {
-                QMatrix4x4 transformMatrix = nodeIterator->textNode()->matrix();
-                transformMatrix.translate(delta.x(), delta.y());
-                nodeIterator->textNode()->setMatrix(transformMatrix);
-                ++nodeIterator;
-            }
-
-        }
-
         // Since we iterate over blocks from different text frames that are potentially not sorted
         // we need to ensure that our list of nodes is sorted again:
         std::sort(d->textNodeMap.begin(), d->textNodeMap.end());
@@ -2184,6 +2264,8 @@ QSGNode *QQuickTextEdit::updatePaintNode(QSGNode *oldNode, UpdatePaintNodeData *
 
 void QQuickTextEdit::updatePolish()
 {
+    Q_D(QQuickTextEdit);
+    d->setObservesViewport(d->document->characterCount() > largeTextSizeThreshold);
     invalidateFontCaches();
 }
 
@@ -2708,6 +2790,102 @@ QQuickTextNode *QQuickTextEditPrivate::createTextNode()
     return node;
 }
 
+void QQuickTextEditPrivate::setObservesViewport(bool observe)
+{
+    Q_Q(QQuickTextEdit);
+    if (observe == observesViewport)
+        return;
+    observesViewport = observe;
+    clearViewportListeners();
+    if (observe)
+        addViewportListeners();
+    q->updateWholeDocument();
+}
+
+void QQuickTextEditPrivate::addViewportListeners()
+{
+    Q_Q(QQuickTextEdit);
+    // The visible part changes when the item or any of its ancestors moves, is resized or transformed
+    for (QQuickItem *item = q; item; item = item->parentItem()) {
+        QQuickItemPrivate::get(item)->addItemChangeListener(this, QQuickItemPrivate::Geometry
+                                                            | QQuickItemPrivate::Matrix
+                                                            | QQuickItemPrivate::Parent
+                                                            | QQuickItemPrivate::Destroyed);
+        viewportItems.append(item);
+    }
+}
+
+void QQuickTextEditPrivate::clearViewportListeners()
+{
+    for (QQuickItem *item : qAsConst(viewportItems)) {
+        QQuickItemPrivate::get(item)->removeItemChangeListener(this, QQuickItemPrivate::Geometry
+                                                               | QQuickItemPrivate::Matrix
+                                                               | QQuickItemPrivate::Parent
+                                                               | QQuickItemPrivate::Destroyed);
+    }
+    viewportItems.clear();
+}
+
+/*!
+    \internal
+
+    Returns the part of the document that is not clipped away by the window or
+    by any clipping ancestor, in document coordinates.
+*/
+QRectF QQuickTextEditPrivate::visibleDocumentRect() const
+{
+    Q_Q(const QQuickTextEdit);
+    QRectF rect(QPointF(0, 0), QSizeF(q->width(), q->height()));
+    if (QQuickWindow *w = q->window())
+        rect = q->mapRectFromScene(QRectF(0, 0, w->width(), w->height()));
+    if (q->clip())
+        rect &= q->clipRect();
+    for (QQuickItem *item = q->parentItem(); item; item = item->parentItem()) {
+        if (item->clip())
+            rect &= item->mapRectToItem(q, item->clipRect());
+    }
+    return rect.translated(-xoff, -yoff);
+}
+
+void QQuickTextEditPrivate::checkVisibleRect()
+{
+    Q_Q(QQuickTextEdit);
+    if (!restrictedToViewport || !q->window())
+        return;
+    const QRectF rect = visibleDocumentRect();
+    if (rect.top() < renderedTop || rect.bottom() > renderedBottom)
+        q->updateWholeDocument();
+}
+
+void QQuickTextEditPrivate::itemGeometryChanged(QQuickItem *, QQuickGeometryChange, const QRectF &)
+{
+    checkVisibleRect();
+}
+
+void QQuickTextEditPrivate::itemTransformChanged(QQuickItem *)
+{
+    checkVisibleRect();
+}
+
+void QQuickTextEditPrivate::itemParentChanged(QQuickItem *, QQuickItem *)
+{
+    // Observe the new ancestors instead
+    clearViewportListeners();
+    addViewportListeners();
+    checkVisibleRect();
+}
+
+void QQuickTextEditPrivate::itemDestroyed(QQuickItem *item)
+{
+    Q_Q(QQuickTextEdit);
+    if (item == q) {
+        clearViewportListeners();
+        observesViewport = false;
+    } else {
+        viewportItems.removeOne(item);
+    }
+}
+
 void QQuickTextEdit::q_canPasteChanged()
 {
     Q_D(QQuickTextEdit);
@@ -53,10 +53,12 @@
 
 #include "qquicktextedit_p.h"
 #include "qquickimplicitsizeitem_p_p.h"
+#include "qquickitemchangelistener_p.h"
 #include "qquicktextutil_p.h"
 
 #include <QtQml/qqml.h>
 #include <QtCore/qlist.h>
+#include <QtCore/qvector.h>
 #include <private/qlazilyallocated_p.h>
 
 #include <limits>
@@ -68,7 +70,7 @@ class QQuickTextControl;
 class QQuickTextNode;
 class QQuickTextNodeEngine;
 
-class Q_QUICK_PRIVATE_EXPORT QQuickTextEditPrivate : public QQuickImplicitSizeItemPrivate
+class Q_QUICK_PRIVATE_EXPORT QQuickTextEditPrivate : public QQuickImplicitSizeItemPrivate, public QQuickItemChangeListener
 {
 public:
     Q_DECLARE_PUBLIC(QQuickTextEdit)
@@ -127,7 +129,8 @@ public:
         , focusOnPress(true), persistentSelection(false), requireImplicitWidth(false)
         , selectByMouse(false), canPaste(false), canPasteValid(false), hAlignImplicit(true)
         , textCached(true), inLayout(false), selectByKeyboard(false), selectByKeyboardSet(false)
-        , hadSelection(false)
+        , hadSelection(false), observesViewport(false), restrictedToViewport(false)
+        , renderedTop(0), renderedBottom(0)
     {
     }
 
@@ -151,6 +154,18 @@ public:
     void addCurrentTextNodeToRoot(QQuickTextNodeEngine *, QSGTransformNode *, QQuickTextNode*, TextNodeIterator&, int startPos);
     QQuickTextNode* createTextNode();
 
+    // Large documents only get nodes for the blocks around the visible part
+    void setObservesViewport(bool observe);
+    void addViewportListeners();
+    void clearViewportListeners();
+    QRectF visibleDocumentRect() const;
+    void checkVisibleRect();
+
+    void itemGeometryChanged(QQuickItem *, QQuickGeometryChange, const QRectF &) override;
+    void itemTransformChanged(QQuickItem *) override;
+    void itemParentChanged(QQuickItem *, QQuickItem *) override;
+    void itemDestroyed(QQuickItem *item) override;
+
 #if QT_CONFIG(im)
     Qt::InputMethodHints effectiveInputMethodHints() const;
 #endif
@@ -224,6 +239,15 @@ public:
     bool selectByKeyboard:1;
     bool selectByKeyboardSet:1;
     bool hadSelection : 1;
+    bool observesViewport : 1;
+    bool restrictedToViewport : 1;
+
+    // The item itself and its ancestors, while observing the viewport
+    QVector<QQuickItem *> viewportItems;
+    // The vertical range of the document that has nodes, in document
+    // coordinates, when restricted to the viewport
+    qreal renderedTop;
+    qreal renderedBottom;
 };
 
 QT_END_NAMESPACE
@@ -44,6 +44,8 @@
 #include "qquickitem.h"
 #include "qquickitem_p.h"
 #include "qquickevents_p_p.h"
+#include "qquickframetimings_p.h"
+#include "qquickhittestindex_p.h"
 
 #include <private/qquickdrag_p.h>
 #include <private/qquickhoverhandler_p.h>
@@ -51,6 +53,7 @@
 
 #include <QtQuick/private/qsgrenderer_p.h>
 #include <QtQuick/private/qsgtexture_p.h>
+#include <QtQuick/private/qsgnode_p.h>
 #include <private/qsgrenderloop_p.h>
 #include <private/qquickrendercontrol_p.h>
 #include <private/qquickanimatorcontroller_p.h>
@@ -66,6 +69,8 @@
 #include <QtGui/qmatrix4x4.h>
 #include <QtCore/qvarlengtharray.h>
 #include <QtCore/qabstractanimation.h>
+#include <QtCore/qsemaphore.h>
+#include <QtCore/qthreadpool.h>
 #include <QtCore/QLibraryInfo>
 #include <QtCore/QRunnable>
 #include <QtQml/qqmlincubator.h>
@@ -73,6 +78,7 @@
 #include <QtQuick/private/qquickpixmapcache_p.h>
 
 #include <private/qqmlmemoryprofiler_p.h>
+#include <private/qqmlbindingscheduler_p.h>
 #include <private/qqmldebugserviceinterfaces_p.h>
 #include <private/qqmldebugconnector_p.h>
 #if QT_CONFIG(opengl)
@@ -294,6 +300,10 @@ static bool transformDirtyOnItemOrAncestor(const QQuickItem *item)
 
 void QQuickWindowPrivate::polishItems()
 {
+    // Batched binding updates are evaluated before polishing, and again whenever the
+    // polish list runs empty, as polishing can in turn change the dependencies of bindings.
+    QQmlBindingScheduler::flushCurrentThread();
+
     // An item can trigger polish on another item, or itself for that matter,
     // during its updatePolish() call. Because of this, we cannot simply
     // iterate through the set, we must continue pulling items out until it
@@ -308,6 +318,8 @@ void QQuickWindowPrivate::polishItems()
         itemPrivate->polishScheduled = false;
         itemPrivate->updatePolish();
         item->updatePolish();
+        if (itemsToPolish.isEmpty())
+            QQmlBindingScheduler::flushCurrentThread();
     }
 
     if (recursionSafeguard == 0)
@@ -433,8 +445,16 @@ void QQuickWindowPrivate::syncSceneGraph()
         renderer->setRootNode(rootNode);
     }
 
+    QQuickFrameTimings *recordingTimings = recordingFrameTimings();
+    QElapsedTimer updateTimer;
+    if (recordingTimings)
+        updateTimer.start();
+
     updateDirtyNodes();
 
+    if (recordingTimings)
+        recordingTimings->guiThreadFrame()->updatePaintNode += updateTimer.nsecsElapsed();
+
     animationController->afterNodeSync();
 
     // Copy the current state of clearing from window into renderer.
@@ -501,6 +521,8 @@ QQuickWindowPrivate::QQuickWindowPrivate()
     , touchMouseId(-1)
     , touchMouseDevice(nullptr)
     , touchMousePressTimestamp(0)
+    , hitTestIndex(nullptr)
+    , frameTimings(nullptr)
     , dirtyItemList(nullptr)
     , devicePixelRatio(0)
     , context(nullptr)
@@ -517,6 +539,7 @@ QQuickWindowPrivate::QQuickWindowPrivate()
     , componentCompleted(true)
     , allowChildEventFiltering(true)
     , allowDoubleClick(true)
+    , concurrentPaintNodeUpdates(false)
     , lastFocusReason(Qt::OtherFocusReason)
     , renderTarget(nullptr)
     , renderTargetId(0)
@@ -530,6 +553,7 @@ QQuickWindowPrivate::QQuickWindowPrivate()
 
 QQuickWindowPrivate::~QQuickWindowPrivate()
 {
+    delete hitTestIndex;
     delete customRenderStage;
     if (QQmlInspectorService *service = QQmlDebugConnector::service<QQmlInspectorService>())
         service->removeWindow(q_func());
@@ -551,6 +575,10 @@ void QQuickWindowPrivate::init(QQuickWindow *c, QQuickRenderControl *control)
     contentItem->setSize(q->size());
 
     customRenderMode = qgetenv("QSG_VISUALIZE");
+    setHitTestIndexEnabled(QQuickHitTestIndex::isEnabledByDefault());
+    if (QQuickFrameTimings::isEnabledByDefault())
+        ensureFrameTimings()->setEnabled(true);
+    concurrentPaintNodeUpdates = qEnvironmentVariableIntValue("QSG_CONCURRENT_PAINT_NODE_UPDATES") > 0;
     renderControl = control;
     if (renderControl)
         QQuickRenderControlPrivate::get(renderControl)->window = q;
@@ -1333,6 +1361,8 @@ QQuickWindow::~QQuickWindow()
         d->windowManager->windowDestroyed(this);
     }
 
+    // Writes out the timings if requested, while the window is still intact
+    delete d->frameTimings; d->frameTimings = nullptr;
     delete d->incubationController; d->incubationController = nullptr;
 #if QT_CONFIG(draganddrop)
     delete d->dragGrabber; d->dragGrabber = nullptr;
@@ -1869,7 +1899,9 @@ bool QQuickWindowPrivate::deliverHoverEvent(QQuickItem *item, const QPointF &sce
 
     qCDebug(DBG_HOVER_TRACE) << q << item << scenePos << lastScenePos << "subtreeHoverEnabled" << itemPrivate->subtreeHoverEnabled;
     if (itemPrivate->subtreeHoverEnabled) {
-        QList<QQuickItem *> children = itemPrivate->paintOrderChildItems();
+        QList<QQuickItem *> children = hitTestIndex
+                ? hitTestIndex->childItemsAt(item, item->mapFromScene(scenePos))
+                : itemPrivate->paintOrderChildItems();
         for (int ii = children.count() - 1; ii >= 0; --ii) {
             QQuickItem *child = children.at(ii);
             if (!child->isVisible() || !child->isEnabled() || QQuickItemPrivate::get(child)->culled)
@@ -2379,8 +2411,11 @@ QVector<QQuickItem *> QQuickWindowPrivate::pointerTargets(QQuickItem *item, QQui
             return targets;
     }
 
-    // recurse for children
-    QList<QQuickItem *> children = itemPrivate->paintOrderChildItems();
+    // recurse for children; the hit test index, if any, leaves out the
+    // children whose whole subtree is nowhere near the point
+    QList<QQuickItem *> children = hitTestIndex
+            ? hitTestIndex->childItemsAt(item, itemPos)
+            : itemPrivate->paintOrderChildItems();
     for (int ii = children.count() - 1; ii >= 0; --ii) {
         QQuickItem *child = children.at(ii);
         auto childPrivate = QQuickItemPrivate::get(child);
@@ -2427,6 +2462,47 @@ QVector<QQuickItem *> QQuickWindowPrivate::mergePointerTargets(const QVector<QQu
     return targets;
 }
 
+/*!
+    \internal
+
+    Enables or disables the hit test index for the items of this window. It is
+    enabled by default when the QML_HIT_TEST_INDEX environment variable is set
+    to a positive value.
+
+    \note Items that override QQuickItem::contains() to accept points outside
+    of their bounding rect are only hit correctly with the index enabled if
+    they call QQuickItemPrivate::setCustomContainment(). Applications using
+    such custom items must not enable the index until they do.
+*/
+void QQuickWindowPrivate::setHitTestIndexEnabled(bool enabled)
+{
+    if (enabled == (hitTestIndex != nullptr))
+        return;
+    if (enabled) {
+        hitTestIndex = new QQuickHitTestIndex;
+    } else {
+        delete hitTestIndex;
+        hitTestIndex = nullptr;
+    }
+}
+
+QQuickFrameTimings *QQuickWindowPrivate::ensureFrameTimings()
+{
+    Q_Q(QQuickWindow);
+    if (!frameTimings)
+        frameTimings = new QQuickFrameTimings(q);
+    return frameTimings;
+}
+
+/*
+    The frame timings to record the current frame into, if any. Called on
+    the GUI thread, or on the render thread while the GUI thread is blocked.
+ */
+QQuickFrameTimings *QQuickWindowPrivate::recordingFrameTimings() const
+{
+    return frameTimings && frameTimings->isEnabled() ? frameTimings : nullptr;
+}
+
 void QQuickWindowPrivate::deliverTouchEvent(QQuickPointerTouchEvent *event)
 {
     qCDebug(DBG_TOUCH) << " - delivering" << event->asTouchEvent();
@@ -2842,7 +2918,9 @@ QQuickItem *QQuickWindowPrivate::findCursorItem(QQuickItem *item, const QPointF
     }
 
     if (itemPrivate->subtreeCursorEnabled) {
-        QList<QQuickItem *> children = itemPrivate->paintOrderChildItems();
+        QList<QQuickItem *> children = hitTestIndex
+                ? hitTestIndex->childItemsAt(item, item->mapFromScene(scenePos))
+                : itemPrivate->paintOrderChildItems();
         for (int ii = children.count() - 1; ii >= 0; --ii) {
             QQuickItem *child = children.at(ii);
             if (!child->isVisible() || !child->isEnabled() || QQuickItemPrivate::get(child)->culled)
@@ -3233,6 +3311,21 @@ void QQuickWindowPrivate::cleanupNodesOnShutdown()
     q->cleanupSceneGraph();
 }
 
+static inline QSGNode *qquickitem_before_paintNode(QQuickItemPrivate *d)
+{
+    const QList<QQuickItem *> childItems = d->paintOrderChildItems();
+    QQuickItem *before = nullptr;
+    for (int i=0; i<childItems.size(); ++i) {
+        QQuickItemPrivate *dd = QQuickItemPrivate::get(childItems.at(i));
+        // Perform the same check as the in fetchNextNode below.
+        if (dd->z() < 0 && (dd->explicitVisible || (dd->extra.isAllocated() && dd->extra->effectRefCount)))
+            before = childItems.at(i);
+        else
+            break;
+    }
+    return Q_UNLIKELY(before) ? QQuickItemPrivate::get(before)->itemNode() : nullptr;
+}
+
 void QQuickWindowPrivate::updateDirtyNodes()
 {
     qCDebug(DBG_DIRTY) << "QQuickWindowPrivate::updateDirtyNodes():";
@@ -3243,29 +3336,119 @@ void QQuickWindowPrivate::updateDirtyNodes()
     dirtyItemList = nullptr;
     if (updateList) QQuickItemPrivate::get(updateList)->prevDirtyItem = &updateList;
 
+    // Only the OpenGL nodes are known to be safe to create and update on other threads.
+    // Software nodes may rasterize in update(), and the OpenVG and Direct3D 12 nodes
+    // create and release graphics resources when they are constructed and destroyed.
+    QVector<QQuickItem *> concurrentUpdates;
+    const bool concurrent = concurrentPaintNodeUpdates
+            && q_func()->rendererInterface()->graphicsApi() == QSGRendererInterface::OpenGL;
+
     while (updateList) {
         QQuickItem *item = updateList;
         QQuickItemPrivate *itemPriv = QQuickItemPrivate::get(item);
         itemPriv->removeFromDirtyList();
 
         qCDebug(DBG_DIRTY) << "   QSGNode:" << item << qPrintable(itemPriv->dirtyToString());
-        updateDirtyNode(item);
+        updateDirtyNode(item, concurrent ? &concurrentUpdates : nullptr);
     }
+
+    if (!concurrentUpdates.isEmpty())
+        updatePaintNodesConcurrently(concurrentUpdates);
 }
 
-static inline QSGNode *qquickitem_before_paintNode(QQuickItemPrivate *d)
+namespace {
+class QQuickPaintNodeUpdateJob : public QRunnable
 {
-    const QList<QQuickItem *> childItems = d->paintOrderChildItems();
-    QQuickItem *before = nullptr;
-    for (int i=0; i<childItems.size(); ++i) {
-        QQuickItemPrivate *dd = QQuickItemPrivate::get(childItems.at(i));
-        // Perform the same check as the in fetchNextNode below.
-        if (dd->z() < 0 && (dd->explicitVisible || (dd->extra.isAllocated() && dd->extra->effectRefCount)))
-            before = childItems.at(i);
-        else
-            break;
+public:
+    QQuickPaintNodeUpdateJob(QQuickItem *const *items, QSGNode **paintNodes, int count,
+                             QQuickItem::UpdatePaintNodeData *data, QSemaphore *done)
+        : m_items(items), m_paintNodes(paintNodes), m_count(count), m_data(data), m_done(done)
+    {
+    }
+
+    void run() override
+    {
+        QQuickWindowPrivate::updatePaintNodes(m_items, m_paintNodes, m_count, m_data);
+        m_done->release();
+    }
+
+private:
+    QQuickItem *const *m_items;
+    QSGNode **m_paintNodes;
+    int m_count;
+    QQuickItem::UpdatePaintNodeData *m_data;
+    QSemaphore *m_done;
+};
+}
+
+Q_GLOBAL_STATIC(QThreadPool, qquickwindow_paint_node_update_pool)
+
+// Updates the paint nodes of items whose updatePaintNode() is declared safe
+// to run concurrently (see QQuickItemPrivate::concurrentPaintNodeUpdate).
+// Only the node subtrees owned by each item are modified in parallel; the
+// resulting nodes are attached to the item node tree serially afterwards.
+void QQuickWindowPrivate::updatePaintNodesConcurrently(const QVector<QQuickItem *> &items)
+{
+    // Below this, dispatching costs more than it saves
+    static const int MinItemsPerJob = 16;
+    static const int MaxJobs = 16;
+
+    const int count = items.count();
+    QVector<QSGNode *> paintNodes(count);
+    QThreadPool *pool = qquickwindow_paint_node_update_pool();
+    const int jobCount = qBound(1, qMin(pool->maxThreadCount() + 1, count / MinItemsPerJob), MaxJobs);
+
+    QQuickItem::UpdatePaintNodeData data[MaxJobs];
+    if (jobCount == 1) {
+        updatePaintNodes(items.constData(), paintNodes.data(), count, &data[0]);
+    } else {
+        const int chunk = (count + jobCount - 1) / jobCount;
+        QSemaphore done;
+        int started = 0;
+        QSGNodePrivate::beginConcurrentUpdates();
+        for (int begin = chunk; begin < count; begin += chunk) {
+            const int end = qMin(begin + chunk, count);
+            pool->start(new QQuickPaintNodeUpdateJob(items.constData() + begin, paintNodes.data() + begin,
+                                                     end - begin, &data[++started], &done));
+        }
+        // The calling thread takes the first chunk itself
+        updatePaintNodes(items.constData(), paintNodes.data(), qMin(chunk, count), &data[0]);
+        done.acquire(started);
+        QSGNodePrivate::endConcurrentUpdates();
+    }
+
+    for (int i = 0; i < count; ++i)
+        setPaintNode(items.at(i), paintNodes.at(i));
+}
+
+void QQuickWindowPrivate::updatePaintNodes(QQuickItem *const *items, QSGNode **paintNodes, int count,
+                                           QQuickItem::UpdatePaintNodeData *data)
+{
+    for (int i = 0; i < count; ++i) {
+        QQuickItemPrivate *itemPriv = QQuickItemPrivate::get(items[i]);
+        data->transformNode = itemPriv->itemNodeInstance;
+        paintNodes[i] = items[i]->updatePaintNode(itemPriv->paintNode, data);
+    }
+}
+
+void QQuickWindowPrivate::setPaintNode(QQuickItem *item, QSGNode *paintNode)
+{
+    QQuickItemPrivate *itemPriv = QQuickItemPrivate::get(item);
+    itemPriv->paintNode = paintNode;
+
+    Q_ASSERT(itemPriv->paintNode == nullptr ||
+             itemPriv->paintNode->parent() == nullptr ||
+             itemPriv->paintNode->parent() == itemPriv->childContainerNode());
+
+    if (itemPriv->paintNode && itemPriv->paintNode->parent() == nullptr) {
+        QSGNode *before = qquickitem_before_paintNode(itemPriv);
+        if (before && before->parent()) {
+            Q_ASSERT(before->parent() == itemPriv->childContainerNode());
+            itemPriv->childContainerNode()->insertChildNodeAfter(itemPriv->paintNode, before);
+        } else {
+            itemPriv->childContainerNode()->prependChildNode(itemPriv->paintNode);
+        }
     }
-    return Q_UNLIKELY(before) ? QQuickItemPrivate::get(before)->itemNode() : nullptr;
 }
 
 static QSGNode *fetchNextNode(QQuickItemPrivate *itemPriv, int &ii, bool &returnedPaintNode)
@@ -3300,7 +3483,7 @@ static QSGNode *fetchNextNode(QQuickItemPrivate *itemPriv, int &ii, bool &return
     return nullptr;
 }
 
-void QQuickWindowPrivate::updateDirtyNode(QQuickItem *item)
+void QQuickWindowPrivate::updateDirtyNode(QQuickItem *item, QVector<QQuickItem *> *concurrentUpdates)
 {
     QQuickItemPrivate *itemPriv = QQuickItemPrivate::get(item);
     quint32 dirty = itemPriv->dirtyAttributes;
@@ -3504,21 +3687,10 @@ void QQuickWindowPrivate::updateDirtyNode(QQuickItem *item)
 
         if (itemPriv->flags & QQuickItem::ItemHasContents) {
             updatePaintNodeData.transformNode = itemPriv->itemNode();
-            itemPriv->paintNode = item->updatePaintNode(itemPriv->paintNode, &updatePaintNodeData);
-
-            Q_ASSERT(itemPriv->paintNode == nullptr ||
-                     itemPriv->paintNode->parent() == nullptr ||
-                     itemPriv->paintNode->parent() == itemPriv->childContainerNode());
-
-            if (itemPriv->paintNode && itemPriv->paintNode->parent() == nullptr) {
-                QSGNode *before = qquickitem_before_paintNode(itemPriv);
-                if (before && before->parent()) {
-                    Q_ASSERT(before->parent() == itemPriv->childContainerNode());
-                    itemPriv->childContainerNode()->insertChildNodeAfter(itemPriv->paintNode, before);
-                } else {
-                    itemPriv->childContainerNode()->prependChildNode(itemPriv->paintNode);
-                }
-            }
+            if (concurrentUpdates && itemPriv->concurrentPaintNodeUpdate)
+                concurrentUpdates->append(item);
+            else
+                setPaintNode(item, item->updatePaintNode(itemPriv->paintNode, &updatePaintNodeData));
         } else if (itemPriv->paintNode) {
             delete itemPriv->paintNode;
             itemPriv->paintNode = nullptr;
@@ -4450,6 +4622,14 @@ void QQuickWindow::resetOpenGLState()
     The Window attached property can be attached to any Item.
 */
 
+/*!
+    \qmlattachedproperty FrameTimings Window::frameTimings
+    \since 5.13
+
+    This attached property holds the timings recorded for the item's window.
+    The Window attached property can be attached to any Item.
+*/
+
 /*!
     \qmlattachedproperty int Window::width
     \qmlattachedproperty int Window::height
@@ -74,6 +74,8 @@ QT_BEGIN_NAMESPACE
 class QOpenGLVertexArrayObjectHelper;
 class QQuickAnimatorController;
 class QQuickDragGrabber;
+class QQuickFrameTimings;
+class QQuickHitTestIndex;
 class QQuickItemPrivate;
 class QQuickPointerDevice;
 class QQuickRenderControl;
@@ -179,6 +181,15 @@ public:
     QVector<QQuickItem *> pointerTargets(QQuickItem *, QQuickEventPoint *point, bool checkMouseButtons, bool checkAcceptsTouch) const;
     QVector<QQuickItem *> mergePointerTargets(const QVector<QQuickItem *> &list1, const QVector<QQuickItem *> &list2) const;
 
+    // optional shortlist of the children that can be hit at a point
+    QQuickHitTestIndex *hitTestIndex;
+    void setHitTestIndexEnabled(bool enabled);
+
+    // optional record of the last frames' timings, created on first use
+    QQuickFrameTimings *frameTimings;
+    QQuickFrameTimings *ensureFrameTimings();
+    QQuickFrameTimings *recordingFrameTimings() const;
+
     // hover delivery
     bool deliverHoverEvent(QQuickItem *, const QPointF &scenePos, const QPointF &lastScenePos, Qt::KeyboardModifiers modifiers, ulong timestamp, bool &accepted);
     bool sendHoverEvent(QEvent::Type, QQuickItem *, const QPointF &scenePos, const QPointF &lastScenePos,
@@ -237,7 +248,11 @@ public:
     void cleanupNodesOnShutdown();
     bool updateEffectiveOpacity(QQuickItem *);
     void updateEffectiveOpacityRoot(QQuickItem *, qreal);
-    void updateDirtyNode(QQuickItem *);
+    void updateDirtyNode(QQuickItem *, QVector<QQuickItem *> *concurrentUpdates = nullptr);
+    void updatePaintNodesConcurrently(const QVector<QQuickItem *> &items);
+    static void updatePaintNodes(QQuickItem *const *items, QSGNode **paintNodes, int count,
+                                 QQuickItem::UpdatePaintNodeData *data);
+    void setPaintNode(QQuickItem *, QSGNode *);
 
     void fireFrameSwapped() { Q_EMIT q_func()->frameSwapped(); }
     void fireOpenGLContextCreated(QOpenGLContext *context) { Q_EMIT q_func()->openglContextCreated(context); }
@@ -267,6 +282,7 @@ public:
 
     bool allowChildEventFiltering : 1;
     bool allowDoubleClick : 1;
+    bool concurrentPaintNodeUpdates : 1;
 
     Qt::FocusReason lastFocusReason;
 
@@ -40,6 +40,7 @@
 #include "qquickwindow.h"
 #include "qquickitem.h"
 #include "qquickwindowattached_p.h"
+#include "qquickwindow_p.h"
 
 QT_BEGIN_NAMESPACE
 
@@ -91,6 +92,11 @@ QQuickWindow *QQuickWindowAttached::window() const
     return m_window;
 }
 
+QQuickFrameTimings *QQuickWindowAttached::frameTimings() const
+{
+    return (m_window ? QQuickWindowPrivate::get(m_window)->ensureFrameTimings() : nullptr);
+}
+
 void QQuickWindowAttached::windowChange(QQuickWindow *window)
 {
     if (window != m_window) {
@@ -39,6 +39,7 @@
 
 #include "qquickwindowmodule_p.h"
 #include "qquickwindowattached_p.h"
+#include "qquickframetimings_p.h"
 #include "qquickscreen_p.h"
 #include "qquickview_p.h"
 #include <QtQuick/QQuickWindow>
@@ -210,6 +211,7 @@ void QQuickWindowModule::defineModule()
     qmlRegisterUncreatableType<QQuickScreen,1>(uri, 2, 3, "Screen", QStringLiteral("Screen can only be used via the attached property."));
     qmlRegisterUncreatableType<QQuickScreenInfo,2>(uri, 2, 3, "ScreenInfo", QStringLiteral("ScreenInfo can only be used via the attached property."));
     qmlRegisterUncreatableType<QQuickScreenInfo,10>(uri, 2, 10, "ScreenInfo", QStringLiteral("ScreenInfo can only be used via the attached property."));
+    qmlRegisterUncreatableType<QQuickFrameTimings>(uri, 2, 13, "FrameTimings", QStringLiteral("FrameTimings can only be used via the Window attached property."));
 }
 
 QT_END_NAMESPACE
@@ -45,7 +45,12 @@
 #include "qsgsoftwarerenderablenode_p.h"
 
 #include <QtCore/QLoggingCategory>
+#include <QtCore/QMutex>
+#include <QtCore/QRunnable>
+#include <QtCore/QSemaphore>
+#include <QtCore/QThreadPool>
 #include <QtGui/QWindow>
+#include <QtGui/qpa/qplatformpixmap.h>
 #include <QtQuick/QSGSimpleRectNode>
 
 Q_LOGGING_CATEGORY(lc2DRender, "qt.scenegraph.softwarecontext.abstractrenderer")
@@ -55,6 +60,7 @@ QT_BEGIN_NAMESPACE
 QSGAbstractSoftwareRenderer::QSGAbstractSoftwareRenderer(QSGRenderContext *context)
     : QSGRenderer(context)
     , m_background(new QSGSimpleRectNode)
+    , m_renderThreadCount(qEnvironmentVariableIntValue("QSG_SOFTWARE_RENDER_THREADS"))
     , m_nodeUpdater(new QSGSoftwareRenderableNodeUpdater(this))
 {
     // Setup special background node
@@ -128,6 +134,9 @@ QRegion QSGAbstractSoftwareRenderer::renderNodes(QPainter *painter)
     if (m_renderableNodes.isEmpty())
         return dirtyRegion;
 
+    if (QImage *target = tiledRenderingTarget(painter))
+        return renderNodesTiled(target);
+
     auto iterator = m_renderableNodes.begin();
     // First node is the background and needs to painted without blending
     auto backgroundNode = *iterator;
@@ -142,6 +151,149 @@ QRegion QSGAbstractSoftwareRenderer::renderNodes(QPainter *painter)
     return dirtyRegion;
 }
 
+// Tiles are bands of whole scan lines of the target image, which can be
+// wrapped in QImages of their own and painted by independent QPainters.
+QImage *QSGAbstractSoftwareRenderer::tiledRenderingTarget(QPainter *painter) const
+{
+    if (m_renderThreadCount < 2)
+        return nullptr;
+
+    QImage *image = nullptr;
+    QPaintDevice *device = painter->device();
+    if (device->devType() == QInternal::Image) {
+        image = static_cast<QImage *>(device);
+    } else if (device->devType() == QInternal::Pixmap) {
+        QPlatformPixmap *data = static_cast<QPixmap *>(device)->handle();
+        if (data && data->classId() == QPlatformPixmap::RasterClass)
+            image = data->buffer();
+    }
+    if (!image || image->isNull() || image->depth() < 8)
+        return nullptr;
+
+    // Tiles are offset by whole logical pixels, through the world transform
+    const qreal dpr = image->devicePixelRatio();
+    if (dpr != qRound(dpr))
+        return nullptr;
+    if (painter->window() != painter->viewport() || !painter->worldTransform().isIdentity())
+        return nullptr;
+
+    // Custom render nodes paint through the render context's active painter
+    for (QSGSoftwareRenderableNode *node : m_renderableNodes) {
+        if (node->type() == QSGSoftwareRenderableNode::RenderNode)
+            return nullptr;
+    }
+    return image;
+}
+
+namespace {
+struct QSGSoftwareTile
+{
+    uchar *bits;
+    QRect rect; // logical coordinates
+};
+
+struct QSGSoftwareTileList
+{
+    const QImage *target;
+    QVector<QSGSoftwareRenderableNode *> nodes; // paint order
+    QVector<QRect> nodeRects;
+    QSGSoftwareRenderableNode *background;
+    QMutex glyphLock;
+
+    void render(const QSGSoftwareTile &tile)
+    {
+        const int dpr = qRound(target->devicePixelRatio());
+        QImage image(tile.bits, target->width(), tile.rect.height() * dpr,
+                     target->bytesPerLine(), target->format());
+        image.setDevicePixelRatio(dpr);
+
+        QPainter painter(&image);
+        painter.setRenderHint(QPainter::Antialiasing);
+        painter.translate(0, -tile.rect.top());
+        for (int i = 0; i < nodes.count(); ++i) {
+            if (nodeRects.at(i).intersects(tile.rect))
+                nodes.at(i)->paint(&painter, nodes.at(i) == background, &glyphLock);
+        }
+    }
+};
+
+class QSGSoftwareTileJob : public QRunnable
+{
+public:
+    QSGSoftwareTileJob(QSGSoftwareTileList *list, const QSGSoftwareTile &tile, QSemaphore *done)
+        : m_list(list), m_tile(tile), m_done(done)
+    {
+    }
+
+    void run() override
+    {
+        m_list->render(m_tile);
+        m_done->release();
+    }
+
+private:
+    QSGSoftwareTileList *m_list;
+    QSGSoftwareTile m_tile;
+    QSemaphore *m_done;
+};
+}
+
+Q_GLOBAL_STATIC(QThreadPool, qsg_software_render_pool)
+
+QRegion QSGAbstractSoftwareRenderer::renderNodesTiled(QImage *target)
+{
+    // Tiles smaller than this are not worth a thread
+    static const int MinTileHeight = 32;
+    // More tiles than threads, since some bands are much busier than others
+    static const int TilesPerThread = 2;
+
+    const int dpr = qRound(target->devicePixelRatio());
+    QSGSoftwareTileList list;
+    list.target = target;
+    list.background = *m_renderableNodes.begin();
+
+    QRect area;
+    for (QSGSoftwareRenderableNode *node : qAsConst(m_renderableNodes)) {
+        if (!node->needsPainting())
+            continue;
+        node->prepareForPainting(dpr);
+        const QRect rect = node->dirtyRegion().boundingRect();
+        list.nodes.append(node);
+        list.nodeRects.append(rect);
+        area |= rect;
+    }
+    area &= QRect(0, 0, target->width() / dpr, target->height() / dpr);
+
+    if (!area.isEmpty()) {
+        const int tileCount = qBound(1, area.height() / MinTileHeight, m_renderThreadCount * TilesPerThread);
+        const int tileHeight = (area.height() + tileCount - 1) / tileCount;
+        // Don't detach in the workers
+        uchar *bits = target->bits();
+
+        QSemaphore done;
+        int started = 0;
+        QSGSoftwareTile first;
+        for (int y = area.top(); y <= area.bottom(); y += tileHeight) {
+            QSGSoftwareTile tile;
+            tile.rect = QRect(0, y, target->width() / dpr, qMin(tileHeight, area.bottom() + 1 - y));
+            tile.bits = bits + qsizetype(y) * dpr * target->bytesPerLine();
+            if (y == area.top()) {
+                first = tile;
+            } else {
+                qsg_software_render_pool()->start(new QSGSoftwareTileJob(&list, tile, &done));
+                ++started;
+            }
+        }
+        list.render(first);
+        done.acquire(started);
+    }
+
+    QRegion dirtyRegion;
+    for (QSGSoftwareRenderableNode *node : qAsConst(m_renderableNodes))
+        dirtyRegion += node->finishPainting();
+    return dirtyRegion;
+}
+
 void QSGAbstractSoftwareRenderer::buildRenderList()
 {
     // Clear the previous renderlist
@@ -154,30 +306,41 @@ void QSGAbstractSoftwareRenderer::buildRenderList()
 
 QRegion QSGAbstractSoftwareRenderer::optimizeRenderList()
 {
+    const QRect renderArea = m_background->rect().toRect();
+    m_dirtyTiles.reset(renderArea);
+    m_dirtyTiles.add(m_dirtyRegion);
+    m_obscuredTiles.reset(renderArea);
+
     // Iterate through the renderlist from front to back
     // Objective is to update the dirty status and rects.
     for (auto i = m_renderableNodes.rbegin(); i != m_renderableNodes.rend(); ++i) {
         auto node = *i;
-        if (!m_dirtyRegion.isEmpty()) {
-            // See if the current dirty regions apply to the current node
-            node->addDirtyRegion(m_dirtyRegion, true);
-        }
+        const QRect boundingRect = node->boundingRectMax();
+
+        // See if the current dirty regions apply to the current node
+        if (m_dirtyTiles.intersects(boundingRect))
+            node->addDirtyRegion(m_dirtyTiles.intersected(boundingRect), true);
 
-        if (!m_obscuredRegion.isEmpty()) {
+        if (node->isDirty()) {
             // Don't try to paint things that are covered by opaque objects
-            node->subtractDirtyRegion(m_obscuredRegion);
+            if (m_obscuredTiles.contains(boundingRect)) {
+                node->subtractDirtyRegion(QRegion(boundingRect));
+            } else {
+                const QRegion obscured = m_obscuredTiles.intersected(boundingRect);
+                if (!obscured.isEmpty())
+                    node->subtractDirtyRegion(obscured);
+            }
         }
 
         // Keep up with obscured regions
         if (node->isOpaque()) {
-            m_obscuredRegion += node->boundingRectMin();
+            m_obscuredTiles.add(node->boundingRectMin());
         }
 
         if (node->isDirty()) {
             // Don't paint things outside of the rendering area
-            if (!m_background->rect().toRect().contains(node->boundingRectMax(), /*proper*/ true)) {
+            if (!renderArea.contains(boundingRect, /*proper*/ true)) {
                 // Some part(s) of node is(are) outside of the rendering area
-                QRegion renderArea(m_background->rect().toRect());
                 QRegion outsideRegions = node->dirtyRegion().subtracted(renderArea);
                 if (!outsideRegions.isEmpty())
                     node->subtractDirtyRegion(outsideRegions);
@@ -185,49 +348,45 @@ QRegion QSGAbstractSoftwareRenderer::optimizeRenderList()
 
             // Get the dirty region's to pass to the next nodes
             if (node->isOpaque()) {
-                // if isOpaque, subtract node's dirty rect from m_dirtyRegion
-                m_dirtyRegion -= node->boundingRectMin();
+                // if isOpaque, subtract node's dirty rect from m_dirtyTiles
+                m_dirtyTiles.subtract(node->boundingRectMin());
             } else {
-                // if isAlpha, add node's dirty rect to m_dirtyRegion
-                m_dirtyRegion += node->dirtyRegion();
+                // if isAlpha, add node's dirty rect to m_dirtyTiles
+                m_dirtyTiles.add(node->dirtyRegion());
             }
-            // if previousDirtyRegion has content outside of boundingRect add to m_dirtyRegion
+            // if previousDirtyRegion has content outside of boundingRect add to m_dirtyTiles
             QRegion prevDirty = node->previousDirtyRegion();
             if (!prevDirty.isNull())
-                m_dirtyRegion += prevDirty;
+                m_dirtyTiles.add(prevDirty);
         }
     }
 
-    if (m_obscuredRegion.contains(m_background->rect().toAlignedRect())) {
-        m_isOpaque = true;
-    } else {
-        m_isOpaque = false;
-    }
+    // The QRegion::contains(QRect) call this used to be only tested for overlap,
+    // so a single opaque node anywhere over the background made the frame count
+    // as opaque. QSGSoftwarePixmapRenderer then skipped filling a pixmap target
+    // with transparent pixels, leaving it without an alpha channel and the
+    // uncovered parts with stale content. Only skip that when opaque nodes
+    // cover all of the background.
+    m_isOpaque = m_obscuredTiles.contains(m_background->rect().toAlignedRect());
 
     // Empty dirtyRegion (for second pass)
     m_dirtyRegion = QRegion();
-    m_obscuredRegion = QRegion();
+    m_dirtyTiles.reset(renderArea);
 
     // Iterate through the renderlist from back to front
     // Objective is to make sure all non-opaque items are painted when an item under them is dirty
     for (auto j = m_renderableNodes.begin(); j != m_renderableNodes.end(); ++j) {
         auto node = *j;
 
-        if (!node->isOpaque() && !m_dirtyRegion.isEmpty()) {
+        if (!node->isOpaque() && m_dirtyTiles.intersects(node->boundingRectMax())) {
             // Only blended nodes need to be updated
-            node->addDirtyRegion(m_dirtyRegion, true);
+            node->addDirtyRegion(m_dirtyTiles.intersected(node->boundingRectMax()), true);
         }
 
-        m_dirtyRegion += node->dirtyRegion();
+        m_dirtyTiles.add(node->dirtyRegion());
     }
 
-    QRegion updateRegion = m_dirtyRegion;
-
-    // Empty dirtyRegion
-    m_dirtyRegion = QRegion();
-    m_obscuredRegion = QRegion();
-
-    return updateRegion;
+    return m_dirtyTiles.toRegion();
 }
 
 void QSGAbstractSoftwareRenderer::setBackgroundColor(const QColor &color)
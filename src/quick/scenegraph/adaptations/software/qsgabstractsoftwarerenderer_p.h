@@ -51,6 +51,8 @@
 // We mean it.
 //
 
+#include "qsgsoftwaretiledregion_p.h"
+
 #include <private/qsgrenderer_p.h>
 
 #include <QtCore/QHash>
@@ -58,6 +60,7 @@
 
 QT_BEGIN_NAMESPACE
 
+class QImage;
 class QSGSimpleRectNode;
 
 class QSGSoftwareRenderableNode;
@@ -77,6 +80,11 @@ public:
 
     void markDirty();
 
+    // Number of threads painting the update region in horizontal bands;
+    // 0 and 1 paint everything on the calling thread.
+    int renderThreadCount() const { return m_renderThreadCount; }
+    void setRenderThreadCount(int count) { m_renderThreadCount = count; }
+
 protected:
     QRegion renderNodes(QPainter *painter);
     void buildRenderList();
@@ -91,6 +99,9 @@ protected:
     const QLinkedList<QSGSoftwareRenderableNode*> &renderableNodes() const;
 
 private:
+    QImage *tiledRenderingTarget(QPainter *painter) const;
+    QRegion renderNodesTiled(QImage *target);
+
     void nodeAdded(QSGNode *node);
     void nodeRemoved(QSGNode *node);
     void nodeGeometryUpdated(QSGNode *node);
@@ -104,8 +115,11 @@ private:
     QSGSimpleRectNode *m_background;
 
     QRegion m_dirtyRegion;
-    QRegion m_obscuredRegion;
+    // Only used during optimizeRenderList(), kept to reuse the tiles
+    QSGSoftwareTiledRegion m_dirtyTiles;
+    QSGSoftwareTiledRegion m_obscuredTiles;
     bool m_isOpaque = false;
+    int m_renderThreadCount;
 
     QSGSoftwareRenderableNodeUpdater *m_nodeUpdater;
 };
@@ -138,8 +138,15 @@ void QSGSoftwareRenderContext::initializeIfNeeded()
     emit initialized();
 }
 
+void QSGSoftwareRenderContext::initialize(void *context)
+{
+    Q_UNUSED(context);
+    initializeIfNeeded();
+}
+
 void QSGSoftwareRenderContext::invalidate()
 {
+    m_initialized = false;
     m_sg->renderContextInvalidated(this);
     emit invalidated();
 }
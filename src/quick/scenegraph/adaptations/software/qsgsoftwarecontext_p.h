@@ -65,12 +65,13 @@ Q_DECLARE_LOGGING_CATEGORY(QSG_RASTER_LOG_RENDERLOOP)
 
 QT_BEGIN_NAMESPACE
 
-class QSGSoftwareRenderContext : public QSGRenderContext
+class Q_QUICK_PRIVATE_EXPORT QSGSoftwareRenderContext : public QSGRenderContext
 {
     Q_OBJECT
 public:
     QSGSoftwareRenderContext(QSGContext *ctx);
     void initializeIfNeeded();
+    void initialize(void *context) override;
     void invalidate() override;
     void renderNextFrame(QSGRenderer *renderer, uint fbo) override;
     QSGTexture *createTexture(const QImage &image, uint flags = CreateTexture_Alpha) const override;
@@ -81,7 +82,7 @@ public:
     QPainter *m_activePainter;
 };
 
-class QSGSoftwareContext : public QSGContext, public QSGRendererInterface
+class Q_QUICK_PRIVATE_EXPORT QSGSoftwareContext : public QSGContext, public QSGRendererInterface
 {
     Q_OBJECT
 public:
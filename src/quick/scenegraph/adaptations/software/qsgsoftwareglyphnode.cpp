@@ -83,21 +83,25 @@ void QSGSoftwareGlyphNode::setGlyphs(const QPointF &position, const QGlyphRun &g
     m_position = position;
     m_glyphRun = glyphs;
     m_bounding_rect = calculateBoundingRect(position, glyphs);
+    markDirty(DirtyGeometry);
 }
 
 void QSGSoftwareGlyphNode::setColor(const QColor &color)
 {
     m_color = color;
+    markDirty(DirtyMaterial);
 }
 
 void QSGSoftwareGlyphNode::setStyle(QQuickText::TextStyle style)
 {
     m_style = style;
+    markDirty(DirtyMaterial);
 }
 
 void QSGSoftwareGlyphNode::setStyleColor(const QColor &color)
 {
     m_styleColor = color;
+    markDirty(DirtyMaterial);
 }
 
 QPointF QSGSoftwareGlyphNode::baseLine() const
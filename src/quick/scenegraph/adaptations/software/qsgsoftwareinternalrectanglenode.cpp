@@ -237,10 +237,7 @@ void QSGSoftwareInternalRectangleNode::paint(QPainter *painter)
 {
     //We can only check for a device pixel ratio change when we know what
     //paint device is being used.
-    if (!qFuzzyCompare(painter->device()->devicePixelRatioF(), m_devicePixelRatio)) {
-        m_devicePixelRatio = painter->device()->devicePixelRatioF();
-        generateCornerPixmap();
-    }
+    setDevicePixelRatio(painter->device()->devicePixelRatioF());
 
     if (painter->transform().isRotating()) {
         //Rotated rectangles lose the benefits of direct rendering, and have poor rendering
@@ -421,6 +418,14 @@ void QSGSoftwareInternalRectangleNode::paintRectangle(QPainter *painter, const Q
     painter->setRenderHints(previousRenderHints);
 }
 
+void QSGSoftwareInternalRectangleNode::setDevicePixelRatio(qreal ratio)
+{
+    if (qFuzzyCompare(ratio, m_devicePixelRatio))
+        return;
+    m_devicePixelRatio = ratio;
+    generateCornerPixmap();
+}
+
 void QSGSoftwareInternalRectangleNode::generateCornerPixmap()
 {
     //Generate new corner Pixmap
@@ -55,7 +55,7 @@
 
 QT_BEGIN_NAMESPACE
 
-class QSGSoftwarePixmapRenderer : public QSGAbstractSoftwareRenderer
+class Q_QUICK_PRIVATE_EXPORT QSGSoftwarePixmapRenderer : public QSGAbstractSoftwareRenderer
 {
 public:
     QSGSoftwarePixmapRenderer(QSGRenderContext *context);
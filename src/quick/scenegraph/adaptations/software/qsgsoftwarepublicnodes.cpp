@@ -95,8 +95,7 @@ void QSGSoftwareImageNode::setTextureCoordinatesTransform(QSGImageNode::TextureC
 
 void QSGSoftwareImageNode::paint(QPainter *painter)
 {
-    if (m_cachedMirroredPixmapIsDirty)
-        updateCachedMirroredPixmap();
+    ensureCachedMirroredPixmap();
 
     painter->setRenderHint(QPainter::SmoothPixmapTransform, (m_filtering == QSGTexture::Linear));
     // Disable antialiased clipping. It causes transformed tiles to have gaps.
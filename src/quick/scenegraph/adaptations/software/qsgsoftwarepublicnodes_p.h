@@ -104,6 +104,11 @@ public:
     bool ownsTexture() const override { return m_owns; }
 
     void paint(QPainter *painter);
+    void ensureCachedMirroredPixmap()
+    {
+        if (m_cachedMirroredPixmapIsDirty)
+            updateCachedMirroredPixmap();
+    }
 
 private:
     void updateCachedMirroredPixmap();
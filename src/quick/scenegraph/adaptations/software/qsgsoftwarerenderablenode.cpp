@@ -55,6 +55,7 @@
 #include <private/qsgtexture_p.h>
 
 #include <qmath.h>
+#include <QtCore/qmutex.h>
 
 Q_LOGGING_CATEGORY(lcRenderable, "qt.scenegraph.softwarecontext.renderable")
 
@@ -76,12 +77,44 @@ inline QRect toRectMax(const QRectF & r)
     return r.toAlignedRect();
 }
 
+// Nodes painted this many times in a row without changing get their
+// rasterization cached, if the budget allows
+static const int UnchangedPaintsBeforeCaching = 2;
+
+// Budget for the cached rasterizations of all nodes, in kilobytes. Set with
+// QSG_SOFTWARE_NODE_CACHE_SIZE, caching is disabled by default.
+static int cachedImageBudget()
+{
+    static const int budget = qMax(0, qEnvironmentVariableIntValue("QSG_SOFTWARE_NODE_CACHE_SIZE"));
+    return budget;
+}
+
+static QBasicAtomicInt cachedImageUsage = Q_BASIC_ATOMIC_INITIALIZER(0);
+
+static int cachedImageCost(const QImage &image)
+{
+    return int((image.sizeInBytes() + 1023) / 1024);
+}
+
+// Whether content painted with from can be moved by whole pixels to match to
+static bool isIntegralTranslation(const QTransform &from, const QTransform &to)
+{
+    if (from.type() > QTransform::TxScale || to.type() > QTransform::TxScale)
+        return false;
+    if (from.m11() != to.m11() || from.m22() != to.m22())
+        return false;
+    const qreal dx = to.dx() - from.dx();
+    const qreal dy = to.dy() - from.dy();
+    return qAbs(dx - qRound(dx)) < 0.001 && qAbs(dy - qRound(dy)) < 0.001;
+}
+
 QSGSoftwareRenderableNode::QSGSoftwareRenderableNode(NodeType type, QSGNode *node)
     : m_nodeType(type)
     , m_isOpaque(true)
     , m_isDirty(true)
     , m_hasClipRegion(false)
     , m_opacity(1.0f)
+    , m_unchangedPaintCount(0)
 {
     switch (m_nodeType) {
     case QSGSoftwareRenderableNode::SimpleRect:
@@ -127,7 +160,7 @@ QSGSoftwareRenderableNode::QSGSoftwareRenderableNode(NodeType type, QSGNode *nod
 
 QSGSoftwareRenderableNode::~QSGSoftwareRenderableNode()
 {
-
+    releaseCachedImage();
 }
 
 void QSGSoftwareRenderableNode::update()
@@ -208,6 +241,7 @@ void QSGSoftwareRenderableNode::update()
     if (m_transform.isRotating())
         m_isOpaque = false;
 
+    m_localBoundingRect = boundingRect;
     const QRectF transformedRect = m_transform.mapRect(boundingRect);
     m_boundingRectMin = toRectMin(transformedRect);
     m_boundingRectMax = toRectMax(transformedRect);
@@ -249,43 +283,143 @@ QRegion QSGSoftwareRenderableNode::renderNode(QPainter *painter, bool forceOpaqu
 
     // Check for don't paint conditions
     if (m_nodeType != RenderNode) {
-        if (!m_isDirty || qFuzzyIsNull(m_opacity) || m_dirtyRegion.isEmpty()) {
-            m_isDirty = false;
-            m_dirtyRegion = QRegion();
-            return QRegion();
-        }
-    } else {
-        if (!m_isDirty || qFuzzyIsNull(m_opacity)) {
-            m_isDirty = false;
-            m_dirtyRegion = QRegion();
-            return QRegion();
-        } else {
-            QSGRenderNodePrivate *rd = QSGRenderNodePrivate::get(m_handle.renderNode);
-            QMatrix4x4 m = m_transform;
-            rd->m_matrix = &m;
-            rd->m_opacity = m_opacity;
-
-            // all the clip region below is in world coordinates, taking m_transform into account already
-            QRegion cr = m_dirtyRegion;
-            if (m_clipRegion.rectCount() > 1)
-                cr &= m_clipRegion;
-
-            painter->save();
-            RenderNodeState rs;
-            rs.cr = cr;
-            m_handle.renderNode->render(&rs);
-            painter->restore();
-
-            const QRect br = m_handle.renderNode->flags().testFlag(QSGRenderNode::BoundedRectRendering)
-                ? m_boundingRectMax // already mapped to world
-                : QRect(0, 0, painter->device()->width(), painter->device()->height());
-            m_previousDirtyRegion = QRegion(br);
-            m_isDirty = false;
-            m_dirtyRegion = QRegion();
-            return br;
+        if (needsPainting()) {
+            prepareForPainting(painter->device()->devicePixelRatioF());
+            paint(painter, forceOpaquePainting);
         }
+        return finishPainting();
     }
 
+    if (!m_isDirty || qFuzzyIsNull(m_opacity)) {
+        m_isDirty = false;
+        m_dirtyRegion = QRegion();
+        return QRegion();
+    }
+
+    QSGRenderNodePrivate *rd = QSGRenderNodePrivate::get(m_handle.renderNode);
+    QMatrix4x4 m = m_transform;
+    rd->m_matrix = &m;
+    rd->m_opacity = m_opacity;
+
+    // all the clip region below is in world coordinates, taking m_transform into account already
+    QRegion cr = m_dirtyRegion;
+    if (m_clipRegion.rectCount() > 1)
+        cr &= m_clipRegion;
+
+    painter->save();
+    RenderNodeState rs;
+    rs.cr = cr;
+    m_handle.renderNode->render(&rs);
+    painter->restore();
+
+    const QRect br = m_handle.renderNode->flags().testFlag(QSGRenderNode::BoundedRectRendering)
+        ? m_boundingRectMax // already mapped to world
+        : QRect(0, 0, painter->device()->width(), painter->device()->height());
+    m_previousDirtyRegion = QRegion(br);
+    m_isDirty = false;
+    m_dirtyRegion = QRegion();
+    return br;
+}
+
+bool QSGSoftwareRenderableNode::needsPainting() const
+{
+    return m_isDirty && !qFuzzyIsNull(m_opacity) && !m_dirtyRegion.isEmpty();
+}
+
+// Does the lazy, state changing parts of painting up front
+void QSGSoftwareRenderableNode::prepareForPainting(qreal devicePixelRatio)
+{
+    switch (m_nodeType) {
+    case QSGSoftwareRenderableNode::Rectangle:
+        m_handle.rectangleNode->setDevicePixelRatio(devicePixelRatio);
+        break;
+    case QSGSoftwareRenderableNode::SimpleImage:
+        static_cast<QSGSoftwareImageNode *>(m_handle.simpleImageNode)->ensureCachedMirroredPixmap();
+        break;
+    default:
+        break;
+    }
+
+    if (cachedImageBudget() > 0 && isCacheable())
+        updateCachedImage(devicePixelRatio);
+}
+
+// Nodes that are expensive to paint compared to blitting an image of them
+bool QSGSoftwareRenderableNode::isCacheable() const
+{
+    switch (m_nodeType) {
+    case QSGSoftwareRenderableNode::Rectangle:
+    case QSGSoftwareRenderableNode::Glyph:
+    case QSGSoftwareRenderableNode::NinePatch:
+        return true;
+    default:
+        return false;
+    }
+}
+
+bool QSGSoftwareRenderableNode::canUseCachedImage(qreal devicePixelRatio) const
+{
+    return !m_cachedImage.isNull()
+            && m_cachedImage.devicePixelRatio() == devicePixelRatio
+            && isIntegralTranslation(m_cachedImageTransform, m_transform);
+}
+
+void QSGSoftwareRenderableNode::updateCachedImage(qreal devicePixelRatio)
+{
+    if (canUseCachedImage(devicePixelRatio))
+        return;
+    if (!m_cachedImage.isNull()) {
+        // Scaled, or moved by a fraction of a pixel: wait for it to settle
+        releaseCachedImage();
+        m_unchangedPaintCount = 0;
+        return;
+    }
+    if (m_unchangedPaintCount < UnchangedPaintsBeforeCaching)
+        return;
+
+    // Unclipped, so that the image stays valid when the clip changes
+    const QRect rect = toRectMax(m_transform.mapRect(m_localBoundingRect));
+    if (rect.isEmpty())
+        return;
+
+    QImage image(rect.size() * devicePixelRatio, QImage::Format_ARGB32_Premultiplied);
+    if (image.isNull())
+        return;
+    // Leave room for other nodes, a single big one would fill the budget
+    const int cost = cachedImageCost(image);
+    if (cost > cachedImageBudget() / 4)
+        return;
+    if (cachedImageUsage.fetchAndAddRelaxed(cost) + cost > cachedImageBudget()) {
+        cachedImageUsage.fetchAndSubRelaxed(cost);
+        return;
+    }
+
+    image.setDevicePixelRatio(devicePixelRatio);
+    image.fill(Qt::transparent);
+    QPainter painter(&image);
+    painter.setRenderHint(QPainter::Antialiasing);
+    painter.translate(-rect.topLeft());
+    painter.setTransform(m_transform, true);
+    paintContent(&painter, nullptr);
+    painter.end();
+
+    m_cachedImage = image;
+    m_cachedImageRect = rect;
+    m_cachedImageTransform = m_transform;
+}
+
+void QSGSoftwareRenderableNode::releaseCachedImage()
+{
+    if (m_cachedImage.isNull())
+        return;
+    cachedImageUsage.fetchAndSubRelaxed(cachedImageCost(m_cachedImage));
+    m_cachedImage = QImage();
+}
+
+void QSGSoftwareRenderableNode::paint(QPainter *painter, bool forceOpaquePainting, QMutex *glyphLock)
+{
+    Q_ASSERT(m_nodeType != RenderNode);
+
     painter->save();
     painter->setOpacity(m_opacity);
 
@@ -295,10 +429,27 @@ QRegion QSGSoftwareRenderableNode::renderNode(QPainter *painter, bool forceOpaqu
     if (m_clipRegion.rectCount() > 1)
         painter->setClipRegion(m_clipRegion, Qt::IntersectClip);
 
-    painter->setTransform(m_transform, false); //precalculated worldTransform
     if (forceOpaquePainting || m_isOpaque)
         painter->setCompositionMode(QPainter::CompositionMode_Source);
 
+    if (canUseCachedImage(painter->device()->devicePixelRatioF())) {
+        const QPointF offset(m_transform.dx() - m_cachedImageTransform.dx(),
+                             m_transform.dy() - m_cachedImageTransform.dy());
+        // The image covers whole pixels, at a fractional position its edges are
+        // partially transparent and must not replace what is underneath
+        painter->setCompositionMode(QPainter::CompositionMode_SourceOver);
+        painter->drawImage(QPointF(m_cachedImageRect.topLeft()) + offset, m_cachedImage);
+    } else {
+        // precalculated worldTransform, combined with the offset of the tile being painted, if any
+        painter->setTransform(m_transform, true);
+        paintContent(painter, glyphLock);
+    }
+
+    painter->restore();
+}
+
+void QSGSoftwareRenderableNode::paintContent(QPainter *painter, QMutex *glyphLock)
+{
     switch (m_nodeType) {
     case QSGSoftwareRenderableNode::SimpleRect:
         painter->fillRect(m_handle.simpleRectNode->rect(), m_handle.simpleRectNode->color());
@@ -325,7 +476,11 @@ QRegion QSGSoftwareRenderableNode::renderNode(QPainter *painter, bool forceOpaqu
         m_handle.rectangleNode->paint(painter);
         break;
     case QSGSoftwareRenderableNode::Glyph:
+    {
+        // Font engines and their glyph caches are shared between the tiles
+        QMutexLocker locker(glyphLock);
         m_handle.glpyhNode->paint(painter);
+    }
         break;
     case QSGSoftwareRenderableNode::NinePatch:
         m_handle.ninePatchNode->paint(painter);
@@ -344,11 +499,17 @@ QRegion QSGSoftwareRenderableNode::renderNode(QPainter *painter, bool forceOpaqu
     default:
         break;
     }
+}
 
-    painter->restore();
-
-    QRegion areaToBeFlushed = m_dirtyRegion;
-    m_previousDirtyRegion = QRegion(m_boundingRectMax);
+QRegion QSGSoftwareRenderableNode::finishPainting()
+{
+    QRegion areaToBeFlushed;
+    if (needsPainting()) {
+        areaToBeFlushed = m_dirtyRegion;
+        m_previousDirtyRegion = QRegion(m_boundingRectMax);
+        if (m_unchangedPaintCount < UnchangedPaintsBeforeCaching)
+            ++m_unchangedPaintCount;
+    }
     m_isDirty = false;
     m_dirtyRegion = QRegion();
 
@@ -364,6 +525,8 @@ void QSGSoftwareRenderableNode::setTransform(const QTransform &transform)
 {
     if (m_transform == transform)
         return;
+    if (!isIntegralTranslation(m_transform, transform))
+        m_unchangedPaintCount = 0;
     m_transform = transform;
     update();
 }
@@ -389,11 +552,15 @@ void QSGSoftwareRenderableNode::setOpacity(float opacity)
 
 void QSGSoftwareRenderableNode::markGeometryDirty()
 {
+    releaseCachedImage();
+    m_unchangedPaintCount = 0;
     update();
 }
 
 void QSGSoftwareRenderableNode::markMaterialDirty()
 {
+    releaseCachedImage();
+    m_unchangedPaintCount = 0;
     update();
 }
 
@@ -53,6 +53,7 @@
 
 #include <QtQuick/private/qtquickglobal_p.h>
 
+#include <QtGui/QImage>
 #include <QtGui/QRegion>
 #include <QtCore/QRect>
 #include <QtGui/QTransform>
@@ -71,6 +72,7 @@ class QSGSoftwareGlyphNode;
 class QSGSoftwareNinePatchNode;
 class QSGSoftwareSpriteNode;
 class QSGRenderNode;
+class QMutex;
 
 class Q_QUICK_PRIVATE_EXPORT QSGSoftwareRenderableNode
 {
@@ -98,12 +100,21 @@ public:
     void update();
 
     QRegion renderNode(QPainter *painter, bool forceOpaquePainting = false);
+
+    // renderNode() split up, for painting a node into several tiles at once:
+    // prepareForPainting() and finishPainting() must be called from one
+    // thread, paint() may run concurrently for different target tiles.
+    bool needsPainting() const;
+    void prepareForPainting(qreal devicePixelRatio);
+    void paint(QPainter *painter, bool forceOpaquePainting = false, QMutex *glyphLock = nullptr);
+    QRegion finishPainting();
     QRect boundingRectMin() const { return m_boundingRectMin; }
     QRect boundingRectMax() const { return m_boundingRectMax; }
     NodeType type() const { return m_nodeType; }
     bool isOpaque() const { return m_isOpaque; }
     bool isDirty() const { return m_isDirty; }
     bool isDirtyRegionEmpty() const;
+    bool hasCachedImage() const { return !m_cachedImage.isNull(); }
     QSGNode *handle() const { return m_handle.node; }
 
     void setTransform(const QTransform &transform);
@@ -123,6 +134,12 @@ public:
     QRegion dirtyRegion() const;
 
 private:
+    void paintContent(QPainter *painter, QMutex *glyphLock);
+    bool isCacheable() const;
+    bool canUseCachedImage(qreal devicePixelRatio) const;
+    void updateCachedImage(qreal devicePixelRatio);
+    void releaseCachedImage();
+
     union RenderableNodeHandle {
         QSGNode *node;
         QSGSimpleRectNode *simpleRectNode;
@@ -154,6 +171,14 @@ private:
 
     QRect m_boundingRectMin;
     QRect m_boundingRectMax;
+    QRectF m_localBoundingRect;
+
+    // Rasterization of a node that keeps being repainted without changing,
+    // blitted instead of painting the node again
+    QImage m_cachedImage;
+    QRect m_cachedImageRect;
+    QTransform m_cachedImageTransform;
+    int m_unchangedPaintCount;
 };
 
 QT_END_NAMESPACE
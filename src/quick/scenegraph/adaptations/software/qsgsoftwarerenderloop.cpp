@@ -43,6 +43,7 @@
 
 #include <QtCore/QCoreApplication>
 
+#include <private/qquickframetimings_p.h>
 #include <private/qquickwindow_p.h>
 #include <QElapsedTimer>
 #include <private/qquickanimatorcontroller_p.h>
@@ -133,9 +134,10 @@ void QSGSoftwareRenderLoop::renderWindow(QQuickWindow *window, bool isNewExpose)
         if (!m_windows.contains(window))
             return;
     }
+    QQuickFrameTimings *frameTimings = data.grabOnly ? nullptr : cd->recordingFrameTimings();
     QElapsedTimer renderTimer;
     qint64 renderTime = 0, syncTime = 0, polishTime = 0;
-    bool profileFrames = QSG_RASTER_LOG_TIME_RENDERLOOP().isDebugEnabled();
+    bool profileFrames = QSG_RASTER_LOG_TIME_RENDERLOOP().isDebugEnabled() || frameTimings;
     if (profileFrames)
         renderTimer.start();
     Q_QUICK_SG_PROFILE_START(QQuickProfiler::SceneGraphPolishFrame);
@@ -190,6 +192,15 @@ void QSGSoftwareRenderLoop::renderWindow(QQuickWindow *window, bool isNewExpose)
     Q_QUICK_SG_PROFILE_END(QQuickProfiler::SceneGraphRenderLoopFrame,
                            QQuickProfiler::SceneGraphRenderLoopSwap);
 
+    if (frameTimings) {
+        QQuickFrameTiming frame = frameTimings->takeGuiThreadFrame();
+        frame.polish = polishTime;
+        frame.sync = syncTime - polishTime;
+        frame.render = renderTime - syncTime;
+        frame.swap = swapTime - renderTime;
+        frameTimings->addFrame(frame);
+    }
+
     if (QSG_RASTER_LOG_TIME_RENDERLOOP().isDebugEnabled()) {
         static QTime lastFrameTime = QTime::currentTime();
         qCDebug(QSG_RASTER_LOG_TIME_RENDERLOOP,
@@ -42,6 +42,7 @@
 #include "qsgsoftwarerenderer_p.h"
 
 #include <private/qsgrenderer_p.h>
+#include <private/qquickframetimings_p.h>
 #include <private/qquickwindow_p.h>
 #include <private/qquickprofiler_p.h>
 #include <private/qquickanimatorcontroller_p.h>
@@ -227,6 +228,8 @@ public:
     bool stopEventProcessing = false;
     QSGSoftwareEventQueue eventQueue;
     QElapsedTimer renderThrottleTimer;
+    QQuickFrameTimings *frameTimings = nullptr; // taken during the sync
+    QQuickFrameTiming syncedFrame;
     qint64 syncTime;
     qint64 renderTime;
     qint64 sinceLastTime;
@@ -249,6 +252,7 @@ bool QSGSoftwareRenderThread::event(QEvent *e)
             QQuickWindowPrivate::get(exposedWindow)->fireAboutToStop();
             qCDebug(QSG_RASTER_LOG_RENDERLOOP, "RT - WM_Obscure - window removed");
             exposedWindow = nullptr;
+            frameTimings = nullptr;
             delete backingStore;
             backingStore = nullptr;
         }
@@ -457,6 +461,11 @@ void QSGSoftwareRenderThread::sync(bool inExpose)
         // on the GUI must now also have resulted in SG changes and the delete
         // is a safe operation.
         QCoreApplication::sendPostedEvents(nullptr, QEvent::DeferredDelete);
+
+        // The gui is still blocked, pick up its part of the frame timings
+        frameTimings = wd->recordingFrameTimings();
+        if (frameTimings)
+            syncedFrame = frameTimings->takeGuiThreadFrame();
     }
 
     if (!inExpose) {
@@ -485,6 +494,7 @@ void QSGSoftwareRenderThread::syncAndRender()
 
     if (syncRequested)
         sync(exposeRequested);
+    const qint64 frameSyncTime = frameTimings ? waitTimer.nsecsElapsed() : 0;
 
     Q_QUICK_SG_PROFILE_RECORD(QQuickProfiler::SceneGraphRenderLoopFrame,
                               QQuickProfiler::SceneGraphRenderLoopSync);
@@ -515,10 +525,21 @@ void QSGSoftwareRenderThread::syncAndRender()
 
         Q_QUICK_SG_PROFILE_RECORD(QQuickProfiler::SceneGraphRenderLoopFrame,
                                   QQuickProfiler::SceneGraphRenderLoopRender);
+        const qint64 frameRenderTime = frameTimings ? waitTimer.nsecsElapsed() : 0;
 
         if (softwareRenderer && (!wd->customRenderStage || !wd->customRenderStage->swap()))
             backingStore->flush(softwareRenderer->flushRegion());
 
+        if (frameTimings) {
+            // Frames rendered without a sync only advanced the animators. The
+            // throttling below is not part of the frame.
+            QQuickFrameTiming frame = syncRequested ? syncedFrame : QQuickFrameTiming();
+            frame.sync = frameSyncTime;
+            frame.render = frameRenderTime - frameSyncTime;
+            frame.swap = waitTimer.nsecsElapsed() - frameRenderTime;
+            frameTimings->addFrame(frame);
+        }
+
         // Since there is no V-Sync with QBackingStore, throttle rendering the refresh
         // rate of the current screen the window is on.
         int blockTime = vsyncDelta - (int) renderThrottleTimer.elapsed();
@@ -960,10 +981,17 @@ void QSGSoftwareThreadedRenderLoop::polishAndSync(QSGSoftwareThreadedRenderLoop:
     Q_QUICK_SG_PROFILE_START(QQuickProfiler::SceneGraphPolishAndSync);
 
     QQuickWindowPrivate *wd = QQuickWindowPrivate::get(window);
+    QQuickFrameTimings *frameTimings = wd->recordingFrameTimings();
+    QElapsedTimer frameTimer;
+    if (frameTimings)
+        frameTimer.start();
+
     wd->polishItems();
 
     Q_QUICK_SG_PROFILE_RECORD(QQuickProfiler::SceneGraphPolishAndSync,
                               QQuickProfiler::SceneGraphPolishAndSyncPolish);
+    if (frameTimings)
+        frameTimings->guiThreadFrame()->polish = frameTimer.nsecsElapsed();
 
     w->updateDuringSync = false;
 
@@ -989,7 +1017,12 @@ void QSGSoftwareThreadedRenderLoop::polishAndSync(QSGSoftwareThreadedRenderLoop:
 
     if (!animationTimer && m_anim->isRunning()) {
         qCDebug(QSG_RASTER_LOG_RENDERLOOP, "polishAndSync - advancing animations");
+        if (frameTimings)
+            frameTimer.restart();
         m_anim->advance();
+        // The new values are shown in the next frame
+        if (frameTimings)
+            frameTimings->guiThreadFrame()->animations = frameTimer.nsecsElapsed();
         // We need to trigger another sync to keep animations running...
         w->window->requestUpdate();
         emit timeToIncubate();
@@ -0,0 +1,183 @@
+/****************************************************************************
+**
+** Copyright (C) 2019 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtQuick module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include "qsgsoftwaretiledregion_p.h"
+
+QT_BEGIN_NAMESPACE
+
+void QSGSoftwareTiledRegion::reset(const QRect &area)
+{
+    m_area = area;
+    m_columns = area.isEmpty() ? 0 : (area.width() + TileSize - 1) / TileSize;
+    m_rows = area.isEmpty() ? 0 : (area.height() + TileSize - 1) / TileSize;
+    // Keeps the allocation from the previous frame when the size is unchanged
+    m_tiles.fill(QRegion(), m_columns * m_rows);
+    m_outside = QRegion();
+}
+
+// Returns the columns and rows of the tiles overlapping rect
+QRect QSGSoftwareTiledRegion::tileSpan(const QRect &rect) const
+{
+    const QRect r = rect & m_area;
+    if (r.isEmpty())
+        return QRect();
+    const QPoint topLeft = r.topLeft() - m_area.topLeft();
+    const QPoint bottomRight = r.bottomRight() - m_area.topLeft();
+    return QRect(QPoint(topLeft.x() / TileSize, topLeft.y() / TileSize),
+                 QPoint(bottomRight.x() / TileSize, bottomRight.y() / TileSize));
+}
+
+QRect QSGSoftwareTiledRegion::tileRect(int column, int row) const
+{
+    return QRect(m_area.x() + column * TileSize, m_area.y() + row * TileSize, TileSize, TileSize) & m_area;
+}
+
+void QSGSoftwareTiledRegion::add(const QRect &rect)
+{
+    if (rect.isEmpty())
+        return;
+    if (!m_area.contains(rect))
+        m_outside += QRegion(rect).subtracted(m_area);
+
+    const QRect span = tileSpan(rect);
+    for (int row = span.top(); row <= span.bottom(); ++row) {
+        for (int column = span.left(); column <= span.right(); ++column) {
+            QRegion &tile = m_tiles[row * m_columns + column];
+            const QRect r = rect & tileRect(column, row);
+            if (tile.isEmpty() || r == tileRect(column, row))
+                tile = r;
+            else if (!(tile.rectCount() == 1 && tile.boundingRect().contains(r)))
+                tile += r;
+        }
+    }
+}
+
+void QSGSoftwareTiledRegion::add(const QRegion &region)
+{
+    for (const QRect &rect : region)
+        add(rect);
+}
+
+void QSGSoftwareTiledRegion::subtract(const QRect &rect)
+{
+    if (rect.isEmpty())
+        return;
+    if (!m_outside.isEmpty())
+        m_outside -= rect;
+
+    const QRect span = tileSpan(rect);
+    for (int row = span.top(); row <= span.bottom(); ++row) {
+        for (int column = span.left(); column <= span.right(); ++column) {
+            QRegion &tile = m_tiles[row * m_columns + column];
+            if (!tile.isEmpty())
+                tile -= rect;
+        }
+    }
+}
+
+bool QSGSoftwareTiledRegion::intersects(const QRect &rect) const
+{
+    if (rect.isEmpty())
+        return false;
+    if (!m_outside.isEmpty() && m_outside.intersects(rect))
+        return true;
+
+    const QRect span = tileSpan(rect);
+    for (int row = span.top(); row <= span.bottom(); ++row) {
+        for (int column = span.left(); column <= span.right(); ++column) {
+            const QRegion &tile = m_tiles.at(row * m_columns + column);
+            if (!tile.isEmpty() && tile.intersects(rect))
+                return true;
+        }
+    }
+    return false;
+}
+
+// Returns whether every pixel of rect is in the region
+bool QSGSoftwareTiledRegion::contains(const QRect &rect) const
+{
+    if (rect.isEmpty())
+        return false;
+    if (!m_area.contains(rect) && !QRegion(rect).subtracted(m_area).subtracted(m_outside).isEmpty())
+        return false;
+
+    const QRect span = tileSpan(rect);
+    for (int row = span.top(); row <= span.bottom(); ++row) {
+        for (int column = span.left(); column <= span.right(); ++column) {
+            const QRegion &tile = m_tiles.at(row * m_columns + column);
+            const QRect r = rect & tileRect(column, row);
+            if (tile.isEmpty())
+                return false;
+            if (tile.rectCount() == 1 ? !tile.boundingRect().contains(r) : !QRegion(r).subtracted(tile).isEmpty())
+                return false;
+        }
+    }
+    return true;
+}
+
+QRegion QSGSoftwareTiledRegion::intersected(const QRect &rect) const
+{
+    QRegion result;
+    if (rect.isEmpty())
+        return result;
+    if (!m_outside.isEmpty())
+        result = m_outside.intersected(rect);
+
+    const QRect span = tileSpan(rect);
+    for (int row = span.top(); row <= span.bottom(); ++row) {
+        for (int column = span.left(); column <= span.right(); ++column) {
+            const QRegion &tile = m_tiles.at(row * m_columns + column);
+            if (!tile.isEmpty())
+                result += tile.intersected(rect);
+        }
+    }
+    return result;
+}
+
+QRegion QSGSoftwareTiledRegion::toRegion() const
+{
+    QRegion result = m_outside;
+    for (const QRegion &tile : m_tiles) {
+        if (!tile.isEmpty())
+            result += tile;
+    }
+    return result;
+}
+
+QT_END_NAMESPACE
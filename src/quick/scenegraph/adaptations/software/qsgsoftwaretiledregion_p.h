@@ -0,0 +1,96 @@
+/****************************************************************************
+**
+** Copyright (C) 2019 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtQuick module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#ifndef QSGSOFTWARETILEDREGION_H
+#define QSGSOFTWARETILEDREGION_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists purely as an
+// implementation detail.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <QtQuick/qtquickglobal.h>
+#include <QtCore/QRect>
+#include <QtCore/QVector>
+#include <QtGui/QRegion>
+
+QT_BEGIN_NAMESPACE
+
+// A region split into a grid of fixed size tiles, so that adding, subtracting
+// and querying rectangles only touches the few tiles they overlap instead of
+// one QRegion holding every rectangle of the scene. Used for the dirty and
+// obscured areas while optimizing the software renderer's render list.
+class Q_QUICK_PRIVATE_EXPORT QSGSoftwareTiledRegion
+{
+public:
+    enum { TileSize = 64 };
+
+    // Starts over with an empty region, with tiles covering area.
+    // Parts of the region outside of area are kept in a single QRegion.
+    void reset(const QRect &area);
+
+    void add(const QRect &rect);
+    void add(const QRegion &region);
+    void subtract(const QRect &rect);
+
+    bool intersects(const QRect &rect) const;
+    bool contains(const QRect &rect) const;
+    QRegion intersected(const QRect &rect) const;
+    QRegion toRegion() const;
+
+private:
+    QRect tileSpan(const QRect &rect) const;
+    QRect tileRect(int column, int row) const;
+
+    QRect m_area;
+    int m_columns = 0;
+    int m_rows = 0;
+    QVector<QRegion> m_tiles;
+    QRegion m_outside;
+};
+
+QT_END_NAMESPACE
+
+#endif // QSGSOFTWARETILEDREGION_H
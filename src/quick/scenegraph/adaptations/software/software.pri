@@ -18,7 +18,8 @@ SOURCES += \
     $$PWD/qsgsoftwarerenderlistbuilder.cpp \
     $$PWD/qsgsoftwarerenderloop.cpp \
     $$PWD/qsgsoftwarelayer.cpp \
-    $$PWD/qsgsoftwareadaptation.cpp
+    $$PWD/qsgsoftwareadaptation.cpp \
+    $$PWD/qsgsoftwaretiledregion.cpp
 
 HEADERS += \
     $$PWD/qsgsoftwarecontext_p.h \
@@ -36,7 +37,8 @@ HEADERS += \
     $$PWD/qsgsoftwarerenderlistbuilder_p.h \
     $$PWD/qsgsoftwarerenderloop_p.h \
     $$PWD/qsgsoftwarelayer_p.h \
-    $$PWD/qsgsoftwareadaptation_p.h
+    $$PWD/qsgsoftwareadaptation_p.h \
+    $$PWD/qsgsoftwaretiledregion_p.h
 
 qtConfig(quick-sprite) {
     SOURCES += \
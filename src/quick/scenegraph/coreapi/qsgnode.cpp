@@ -45,8 +45,14 @@
 
 #include "limits.h"
 
+#include <QtCore/qatomic.h>
+#include <QtCore/qmutex.h>
+
 QT_BEGIN_NAMESPACE
 
+static QBasicAtomicInt qsg_concurrent_updates = Q_BASIC_ATOMIC_INITIALIZER(0);
+Q_GLOBAL_STATIC_WITH_ARGS(QMutex, qsg_mark_dirty_mutex, (QMutex::Recursive))
+
 #ifndef QT_NO_DEBUG
 static const bool qsg_leak_check = !qEnvironmentVariableIsEmpty("QML_LEAK_CHECK");
 static int qt_node_count = 0;
@@ -659,8 +665,20 @@ void QSGNode::setFlags(Flags f, bool enabled)
     Notifies all connected renderers that the node has dirty \a bits.
  */
 
+void QSGNodePrivate::beginConcurrentUpdates()
+{
+    qsg_concurrent_updates.ref();
+}
+
+void QSGNodePrivate::endConcurrentUpdates()
+{
+    qsg_concurrent_updates.deref();
+}
+
 void QSGNode::markDirty(DirtyState bits)
 {
+    QMutexLocker locker(Q_UNLIKELY(qsg_concurrent_updates.loadAcquire()) ? qsg_mark_dirty_mutex() : nullptr);
+
     int renderableCountDiff = 0;
     if (bits & DirtyNodeAdded)
         renderableCountDiff += m_subtreeRenderableCount;
@@ -63,6 +63,12 @@ public:
     QSGNodePrivate() {}
     virtual ~QSGNodePrivate() {}
 
+    // Between these calls, nodes in disjoint subtrees of the same scene may
+    // be modified from several threads. markDirty() then serializes the
+    // bookkeeping it does on shared ancestors and root node notifications.
+    static void beginConcurrentUpdates();
+    static void endConcurrentUpdates();
+
 #ifdef QSG_RUNTIME_DESCRIPTION
     static void setDescription(QSGNode *node, const QString &description) {
         node->d_ptr->descr= description;
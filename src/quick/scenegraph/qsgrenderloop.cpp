@@ -54,6 +54,7 @@
 #include <QtQml/private/qqmlglobal_p.h>
 
 #include <QtQuick/QQuickWindow>
+#include <QtQuick/private/qquickframetimings_p.h>
 #include <QtQuick/private/qquickwindow_p.h>
 #include <QtQuick/private/qsgcontext_p.h>
 #include <QtQuick/private/qsgrenderer_p.h>
@@ -407,9 +408,10 @@ void QSGGuiThreadRenderLoop::renderWindow(QQuickWindow *window)
         if (!m_windows.contains(window))
             return;
     }
+    QQuickFrameTimings *frameTimings = data.grabOnly ? nullptr : cd->recordingFrameTimings();
     QElapsedTimer renderTimer;
     qint64 renderTime = 0, syncTime = 0, polishTime = 0;
-    bool profileFrames = QSG_LOG_TIME_RENDERLOOP().isDebugEnabled();
+    bool profileFrames = QSG_LOG_TIME_RENDERLOOP().isDebugEnabled() || frameTimings;
     if (profileFrames)
         renderTimer.start();
     Q_QUICK_SG_PROFILE_START(QQuickProfiler::SceneGraphPolishFrame);
@@ -459,6 +461,15 @@ void QSGGuiThreadRenderLoop::renderWindow(QQuickWindow *window)
     Q_QUICK_SG_PROFILE_END(QQuickProfiler::SceneGraphRenderLoopFrame,
                            QQuickProfiler::SceneGraphRenderLoopSwap);
 
+    if (frameTimings) {
+        QQuickFrameTiming frame = frameTimings->takeGuiThreadFrame();
+        frame.polish = polishTime;
+        frame.sync = syncTime - polishTime;
+        frame.render = renderTime - syncTime;
+        frame.swap = swapTime - renderTime;
+        frameTimings->addFrame(frame);
+    }
+
     if (QSG_LOG_TIME_RENDERLOOP().isDebugEnabled()) {
         static QTime lastFrameTime = QTime::currentTime();
         qCDebug(QSG_LOG_TIME_RENDERLOOP,
@@ -52,6 +52,7 @@
 #include <qpa/qwindowsysteminterface.h>
 
 #include <QtQuick/QQuickWindow>
+#include <private/qquickframetimings_p.h>
 #include <private/qquickwindow_p.h>
 
 #include <QtQuick/private/qsgrenderer_p.h>
@@ -277,6 +278,7 @@ public:
         , syncResultedInChanges(false)
         , active(false)
         , window(nullptr)
+        , frameTimings(nullptr)
         , stopEventProcessing(false)
     {
         sgrc = static_cast<QSGDefaultRenderContext *>(renderContext);
@@ -348,6 +350,10 @@ public:
     QQuickWindow *window; // Will be 0 when window is not exposed
     QSize windowSize;
 
+    // Taken from the window during the sync, when recording frame timings
+    QQuickFrameTimings *frameTimings;
+    QQuickFrameTiming syncedFrame;
+
     // Local event queue stuff...
     bool stopEventProcessing;
     QSGRenderThreadEventQueue eventQueue;
@@ -367,6 +373,7 @@ bool QSGRenderThread::event(QEvent *e)
             QQuickWindowPrivate::get(window)->fireAboutToStop();
             qCDebug(QSG_LOG_RENDERLOOP, QSG_RT_PAD, "- window removed");
             window = nullptr;
+            frameTimings = nullptr;
         }
         waitCondition.wakeOne();
         mutex.unlock();
@@ -576,6 +583,11 @@ void QSGRenderThread::sync(bool inExpose)
         qCDebug(QSG_LOG_RENDERLOOP, QSG_RT_PAD, "- window has bad size, sync aborted");
     }
 
+    // The GUI thread is still blocked, pick up its part of the frame timings
+    frameTimings = QQuickWindowPrivate::get(window)->recordingFrameTimings();
+    if (frameTimings)
+        syncedFrame = frameTimings->takeGuiThreadFrame();
+
     if (!inExpose) {
         qCDebug(QSG_LOG_RENDERLOOP, QSG_RT_PAD, "- sync complete, waking Gui");
         waitCondition.wakeOne();
@@ -609,6 +621,7 @@ void QSGRenderThread::syncAndRender()
         qCDebug(QSG_LOG_RENDERLOOP, QSG_RT_PAD, "- updatePending, doing sync");
         sync(exposeRequested);
     }
+    const qint64 frameSyncTime = frameTimings ? waitTimer.nsecsElapsed() : 0;
 #ifndef QSG_NO_RENDER_TIMING
     if (profileFrames)
         syncTime = threadTimer.nsecsElapsed();
@@ -648,9 +661,19 @@ void QSGRenderThread::syncAndRender()
             renderTime = threadTimer.nsecsElapsed();
         Q_QUICK_SG_PROFILE_RECORD(QQuickProfiler::SceneGraphRenderLoopFrame,
                                   QQuickProfiler::SceneGraphRenderLoopRender);
+        const qint64 frameRenderTime = frameTimings ? waitTimer.nsecsElapsed() : 0;
         if (!d->customRenderStage || !d->customRenderStage->swap())
             gl->swapBuffers(window);
         d->fireFrameSwapped();
+
+        if (frameTimings) {
+            // Frames rendered without a sync only advanced the animators
+            QQuickFrameTiming frame = syncRequested ? syncedFrame : QQuickFrameTiming();
+            frame.sync = frameSyncTime;
+            frame.render = frameRenderTime - frameSyncTime;
+            frame.swap = waitTimer.nsecsElapsed() - frameRenderTime;
+            frameTimings->addFrame(frame);
+        }
     } else {
         Q_QUICK_SG_PROFILE_SKIP(QQuickProfiler::SceneGraphRenderLoopFrame,
                                 QQuickProfiler::SceneGraphRenderLoopSync, 1);
@@ -1176,22 +1199,26 @@ void QSGThreadedRenderLoop::polishAndSync(Window *w, bool inExpose)
     }
 
 
+    QQuickWindowPrivate *d = QQuickWindowPrivate::get(window);
+    QQuickFrameTimings *frameTimings = d->recordingFrameTimings();
+
     QElapsedTimer timer;
     qint64 polishTime = 0;
     qint64 waitTime = 0;
     qint64 syncTime = 0;
-    bool profileFrames = QSG_LOG_TIME_RENDERLOOP().isDebugEnabled();
+    bool profileFrames = QSG_LOG_TIME_RENDERLOOP().isDebugEnabled() || frameTimings;
     if (profileFrames)
         timer.start();
     Q_QUICK_SG_PROFILE_START(QQuickProfiler::SceneGraphPolishAndSync);
 
-    QQuickWindowPrivate *d = QQuickWindowPrivate::get(window);
     d->polishItems();
 
     if (profileFrames)
         polishTime = timer.nsecsElapsed();
     Q_QUICK_SG_PROFILE_RECORD(QQuickProfiler::SceneGraphPolishAndSync,
                               QQuickProfiler::SceneGraphPolishAndSyncPolish);
+    if (frameTimings)
+        frameTimings->guiThreadFrame()->polish = polishTime;
 
     w->updateDuringSync = false;
 
@@ -1222,6 +1249,9 @@ void QSGThreadedRenderLoop::polishAndSync(Window *w, bool inExpose)
         qCDebug(QSG_LOG_RENDERLOOP, "- advancing animations");
         m_animation_driver->advance();
         qCDebug(QSG_LOG_RENDERLOOP, "- animations done..");
+        // The new values are shown in the next frame
+        if (frameTimings)
+            frameTimings->guiThreadFrame()->animations = timer.nsecsElapsed() - syncTime;
         // We need to trigger another sync to keep animations running...
         maybePostPolishRequest(w);
         emit timeToIncubate();
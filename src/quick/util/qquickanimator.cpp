@@ -41,6 +41,9 @@
 #include "qquickanimatorjob_p.h"
 
 #include <private/qquickitem_p.h>
+#if QT_CONFIG(quick_path)
+#include <private/qquickpath_p.h>
+#endif
 
 QT_BEGIN_NAMESPACE
 
@@ -232,18 +235,18 @@ void QQuickAnimatorPrivate::apply(QQuickAnimatorJob *job,
             job->setTarget(qobject_cast<QQuickItem *>(action.property.object()));
 
             if (isFromDefined)
-                job->setFrom(from);
+                job->setFromValue(fromValue());
             else if (action.fromValue.isValid())
-                job->setFrom(action.fromValue.toReal());
+                job->setFromValue(action.fromValue);
             else
-                job->setFrom(action.property.read().toReal());
+                job->setFromValue(action.property.read());
 
             if (isToDefined)
-                job->setTo(to);
+                job->setToValue(toValue());
             else if (action.toValue.isValid())
-                job->setTo(action.toValue.toReal());
+                job->setToValue(action.toValue);
             else
-                job->setTo(action.property.read().toReal());
+                job->setToValue(action.property.read());
 
             // This magic line is in sync with what PropertyAnimation does
             // and prevents the animation to end up in the "completeList"
@@ -255,8 +258,8 @@ void QQuickAnimatorPrivate::apply(QQuickAnimatorJob *job,
 
     if (modified.isEmpty()) {
         job->setTarget(target);
-        job->setFrom(from);
-        job->setTo(to);
+        job->setFromValue(fromValue());
+        job->setToValue(toValue());
     }
 
     if (!job->target()) {
@@ -504,6 +507,210 @@ QQuickRotationAnimator::RotationDirection QQuickRotationAnimator::direction() co
     return d->direction;
 }
 
+/*!
+    \qmltype WidthAnimator
+    \instantiates QQuickWidthAnimator
+    \inqmlmodule QtQuick
+    \since 5.13
+    \ingroup qtquick-transitions-animations
+    \inherits Animator
+    \brief The WidthAnimator type animates the width of an Item.
+
+    \l{Animator} types are different from normal Animation types. When
+    using an Animator, the animation can be run in the render thread
+    and the property value will jump to the end when the animation is
+    complete.
+
+    The value of Item::width is updated after the animation has finished.
+    While the animation is running, only the scene graph nodes of
+    \l Rectangle items, \l Image items with the \c Image.Stretch fill mode
+    and the clip of items that \l {Item::clip}{clip} to their bounds are
+    resized. Children, anchors and layouts depending on the width follow
+    when the final value is written back.
+
+    \sa HeightAnimator
+ */
+
+QQuickWidthAnimator::QQuickWidthAnimator(QObject *parent) : QQuickAnimator(parent) {}
+
+QQuickAnimatorJob *QQuickWidthAnimator::createJob() const { return new QQuickWidthAnimatorJob(); }
+
+/*!
+    \qmltype HeightAnimator
+    \instantiates QQuickHeightAnimator
+    \inqmlmodule QtQuick
+    \since 5.13
+    \ingroup qtquick-transitions-animations
+    \inherits Animator
+    \brief The HeightAnimator type animates the height of an Item.
+
+    \l{Animator} types are different from normal Animation types. When
+    using an Animator, the animation can be run in the render thread
+    and the property value will jump to the end when the animation is
+    complete.
+
+    The value of Item::height is updated after the animation has finished.
+    The same limitations as for \l WidthAnimator apply while the animation
+    is running.
+
+    \sa WidthAnimator
+ */
+
+QQuickHeightAnimator::QQuickHeightAnimator(QObject *parent) : QQuickAnimator(parent) {}
+
+QQuickAnimatorJob *QQuickHeightAnimator::createJob() const { return new QQuickHeightAnimatorJob(); }
+
+/*!
+    \qmltype ColorAnimator
+    \instantiates QQuickColorAnimator
+    \inqmlmodule QtQuick
+    \since 5.13
+    \ingroup qtquick-transitions-animations
+    \inherits Animator
+    \brief The ColorAnimator type animates the color of a Rectangle.
+
+    \l{Animator} types are different from normal Animation types. When
+    using an Animator, the animation can be run in the render thread
+    and the property value will jump to the end when the animation is
+    complete.
+
+    The value of Rectangle::color is updated after the animation has
+    finished. The target must be a \l Rectangle. A rectangle that is fully
+    transparent and has no border when the animation starts has nothing
+    to show, so it stays invisible until the animation has finished.
+
+    \sa ColorAnimation
+ */
+
+QQuickColorAnimator::QQuickColorAnimator(QObject *parent)
+    : QQuickAnimator(*new QQuickColorAnimatorPrivate, parent)
+{
+}
+
+/*!
+    \qmlproperty color QtQuick::ColorAnimator::from
+    This property holds the color value at which the animation should begin.
+
+    Like ColorAnimation does for PropertyAnimation, ColorAnimator replaces
+    the numeric \l{Animator::from}{from} and \l{Animator::to}{to} of
+    Animator with color properties.
+ */
+QColor QQuickColorAnimator::from() const
+{
+    Q_D(const QQuickColorAnimator);
+    return d->fromColor;
+}
+
+void QQuickColorAnimator::setFrom(const QColor &from)
+{
+    Q_D(QQuickColorAnimator);
+    d->isFromDefined = true;
+    d->fromColor = from;
+}
+
+/*!
+    \qmlproperty color QtQuick::ColorAnimator::to
+    This property holds the color value at which the animation should end.
+ */
+QColor QQuickColorAnimator::to() const
+{
+    Q_D(const QQuickColorAnimator);
+    return d->toColor;
+}
+
+void QQuickColorAnimator::setTo(const QColor &to)
+{
+    Q_D(QQuickColorAnimator);
+    d->isToDefined = true;
+    d->toColor = to;
+}
+
+QQuickAnimatorJob *QQuickColorAnimator::createJob() const { return new QQuickColorAnimatorJob(); }
+
+#if QT_CONFIG(quick_path)
+/*!
+    \qmltype PathAnimator
+    \instantiates QQuickPathAnimator
+    \inqmlmodule QtQuick
+    \since 5.13
+    \ingroup qtquick-transitions-animations
+    \inherits Animator
+    \brief The PathAnimator type moves an Item along a path.
+
+    \l{Animator} types are different from normal Animation types. When
+    using an Animator, the animation can be run in the render thread
+    and the property value will jump to the end when the animation is
+    complete.
+
+    The \l {Animator::from}{from} and \l {Animator::to}{to} properties hold
+    the progress along the path, from 0 to 1, and default to 0 and 1. The
+    position of the item is updated after the animation has finished.
+
+    The path is read when the animation starts. Unlike \l PathAnimation,
+    PathAnimator does not rotate the item along the path, and
+    \l {PathPercent} elements are not taken into account.
+
+    \sa PathAnimation
+ */
+
+QQuickPathAnimator::QQuickPathAnimator(QObject *parent)
+    : QQuickAnimator(*new QQuickPathAnimatorPrivate, parent)
+{
+}
+
+/*!
+    \qmlproperty Path QtQuick::PathAnimator::path
+    This property holds the path to animate along.
+ */
+QQuickPath *QQuickPathAnimator::path() const
+{
+    Q_D(const QQuickPathAnimator);
+    return d->path;
+}
+
+void QQuickPathAnimator::setPath(QQuickPath *path)
+{
+    Q_D(QQuickPathAnimator);
+    if (d->path == path)
+        return;
+    d->path = path;
+    Q_EMIT pathChanged();
+}
+
+/*!
+    \qmlproperty point QtQuick::PathAnimator::anchorPoint
+    This property holds the point of the item that follows the path.
+
+    By default, the top left corner of the item follows the path.
+ */
+QPointF QQuickPathAnimator::anchorPoint() const
+{
+    Q_D(const QQuickPathAnimator);
+    return d->anchorPoint;
+}
+
+void QQuickPathAnimator::setAnchorPoint(const QPointF &point)
+{
+    Q_D(QQuickPathAnimator);
+    if (d->anchorPoint == point)
+        return;
+    d->anchorPoint = point;
+    Q_EMIT anchorPointChanged(point);
+}
+
+QQuickAnimatorJob *QQuickPathAnimator::createJob() const
+{
+    Q_D(const QQuickPathAnimator);
+    if (!d->path)
+        return nullptr;
+
+    QQuickPathAnimatorJob *job = new QQuickPathAnimatorJob();
+    job->setPath(d->path->path());
+    job->setAnchorPoint(d->anchorPoint);
+    return job;
+}
+#endif
+
 #if QT_CONFIG(quick_shadereffect) && QT_CONFIG(opengl)
 /*!
     \qmltype UniformAnimator
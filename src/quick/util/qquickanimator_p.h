@@ -170,6 +170,80 @@ protected:
     QString propertyName() const override { return QStringLiteral("rotation"); }
 };
 
+class Q_QUICK_PRIVATE_EXPORT QQuickWidthAnimator : public QQuickAnimator
+{
+    Q_OBJECT
+public:
+    QQuickWidthAnimator(QObject *parent = nullptr);
+protected:
+    QQuickAnimatorJob *createJob() const override;
+    QString propertyName() const override { return QStringLiteral("width"); }
+};
+
+class Q_QUICK_PRIVATE_EXPORT QQuickHeightAnimator : public QQuickAnimator
+{
+    Q_OBJECT
+public:
+    QQuickHeightAnimator(QObject *parent = nullptr);
+protected:
+    QQuickAnimatorJob *createJob() const override;
+    QString propertyName() const override { return QStringLiteral("height"); }
+};
+
+class QQuickColorAnimatorPrivate;
+class Q_QUICK_PRIVATE_EXPORT QQuickColorAnimator : public QQuickAnimator
+{
+    Q_OBJECT
+    Q_DECLARE_PRIVATE(QQuickColorAnimator)
+    // Shadow the qreal properties of QQuickAnimator, as QQuickColorAnimation
+    // does with the ones of QQuickPropertyAnimation. The job is initialized
+    // from the colors, the inherited values are ignored.
+    Q_PROPERTY(QColor from READ from WRITE setFrom)
+    Q_PROPERTY(QColor to READ to WRITE setTo)
+
+public:
+    QQuickColorAnimator(QObject *parent = nullptr);
+
+    QColor from() const;
+    void setFrom(const QColor &from);
+
+    QColor to() const;
+    void setTo(const QColor &to);
+
+protected:
+    QQuickAnimatorJob *createJob() const override;
+    QString propertyName() const override { return QStringLiteral("color"); }
+};
+
+#if QT_CONFIG(quick_path)
+class QQuickPath;
+class QQuickPathAnimatorPrivate;
+class Q_QUICK_PRIVATE_EXPORT QQuickPathAnimator : public QQuickAnimator
+{
+    Q_OBJECT
+    Q_DECLARE_PRIVATE(QQuickPathAnimator)
+    Q_PROPERTY(QQuickPath *path READ path WRITE setPath NOTIFY pathChanged)
+    Q_PROPERTY(QPointF anchorPoint READ anchorPoint WRITE setAnchorPoint NOTIFY anchorPointChanged)
+
+public:
+    QQuickPathAnimator(QObject *parent = nullptr);
+
+    QQuickPath *path() const;
+    void setPath(QQuickPath *path);
+
+    QPointF anchorPoint() const;
+    void setAnchorPoint(const QPointF &point);
+
+Q_SIGNALS:
+    void pathChanged();
+    void anchorPointChanged(const QPointF &point);
+
+protected:
+    QQuickAnimatorJob *createJob() const override;
+    QString propertyName() const override { return QStringLiteral("progress"); }
+};
+#endif
+
 #if QT_CONFIG(quick_shadereffect) && QT_CONFIG(opengl)
 class QQuickUniformAnimatorPrivate;
 class Q_QUICK_PRIVATE_EXPORT QQuickUniformAnimator : public QQuickAnimator
@@ -198,6 +272,12 @@ QT_END_NAMESPACE
 QML_DECLARE_TYPE(QQuickAnimator)
 QML_DECLARE_TYPE(QQuickXAnimator)
 QML_DECLARE_TYPE(QQuickYAnimator)
+QML_DECLARE_TYPE(QQuickWidthAnimator)
+QML_DECLARE_TYPE(QQuickHeightAnimator)
+QML_DECLARE_TYPE(QQuickColorAnimator)
+#if QT_CONFIG(quick_path)
+QML_DECLARE_TYPE(QQuickPathAnimator)
+#endif
 QML_DECLARE_TYPE(QQuickScaleAnimator)
 QML_DECLARE_TYPE(QQuickRotationAnimator)
 QML_DECLARE_TYPE(QQuickOpacityAnimator)
@@ -82,6 +82,9 @@ public:
     uint isFromDefined : 1;
     uint isToDefined : 1;
 
+    virtual QVariant fromValue() const { return from; }
+    virtual QVariant toValue() const { return to; }
+
     void apply(QQuickAnimatorJob *job, const QString &propertyName, QQuickStateActions &actions, QQmlProperties &modified, QObject *defaultTarget);
 };
 
@@ -95,6 +98,31 @@ public:
     QQuickRotationAnimator::RotationDirection direction;
 };
 
+class QQuickColorAnimatorPrivate : public QQuickAnimatorPrivate
+{
+public:
+    QVariant fromValue() const override { return fromColor; }
+    QVariant toValue() const override { return toColor; }
+
+    QColor fromColor;
+    QColor toColor;
+};
+
+#if QT_CONFIG(quick_path)
+class QQuickPathAnimatorPrivate : public QQuickAnimatorPrivate
+{
+public:
+    QQuickPathAnimatorPrivate()
+        : path(nullptr)
+    {
+        to = 1;
+    }
+
+    QQuickPath *path;
+    QPointF anchorPoint;
+};
+#endif
+
 class QQuickUniformAnimatorPrivate : public QQuickAnimatorPrivate
 {
 public:
@@ -44,6 +44,10 @@
 #include "qquickanimator_p_p.h"
 #include <private/qquickwindow_p.h>
 #include <private/qquickitem_p.h>
+#include <private/qquickclipnode_p.h>
+#include <private/qquickimage_p.h>
+#include <private/qquickrectangle_p.h>
+#include <private/qsgadaptationlayer_p.h>
 #if QT_CONFIG(quick_shadereffect) && QT_CONFIG(opengl)
 # include <private/qquickopenglshadereffectnode_p.h>
 # include <private/qquickopenglshadereffect_p.h>
@@ -352,8 +356,11 @@ void QQuickTransformAnimatorJob::preSync()
 
 void QQuickTransformAnimatorJob::invalidate()
 {
-    if (m_helper)
+    if (m_helper) {
         m_helper->node = nullptr;
+        m_helper->paintNode = nullptr;
+        m_helper->clipNode = nullptr;
+    }
 }
 
 void QQuickTransformAnimatorJob::Helper::sync()
@@ -399,10 +406,61 @@ void QQuickTransformAnimatorJob::Helper::sync()
         ox = o.x();
         oy = o.y();
     }
+
+    if (dirty & QQuickItemPrivate::Size) {
+        width = item->width();
+        height = item->height();
+    }
+}
+
+/*
+    Picks up the nodes showing the item's size after they have been
+    (re)created and updated from the item in the sync. Only nodes whose
+    contents only depend on the size are resized on the render thread, the
+    rest of the item catches up when the animation writes back its result.
+ */
+void QQuickTransformAnimatorJob::Helper::syncPaintNode()
+{
+    QQuickItemPrivate *d = QQuickItemPrivate::get(item);
+
+    paintNode = d->paintNode;
+    paintNodeType = UnknownPaintNode;
+    if (qobject_cast<QQuickRectangle *>(item)) {
+        paintNodeType = RectanglePaintNode;
+    } else if (QQuickImage *image = qobject_cast<QQuickImage *>(item)) {
+        if (image->fillMode() == QQuickImage::Stretch)
+            paintNodeType = StretchedImagePaintNode;
+    }
+
+    clipNode = d->clipNode();
+    if (clipNode && clipNode->rect() != item->boundingRect())
+        clipNode = nullptr;
+
+    // The sync has written the item's own size to the nodes
+    sizeChanged = true;
 }
 
 void QQuickTransformAnimatorJob::Helper::commit()
 {
+    if (sizeChanged) {
+        const QRectF rect(0, 0, width, height);
+        if (paintNode && paintNodeType == RectanglePaintNode) {
+            QSGInternalRectangleNode *rectangleNode = static_cast<QSGInternalRectangleNode *>(paintNode);
+            rectangleNode->setRect(rect);
+            rectangleNode->update();
+        } else if (paintNode && paintNodeType == StretchedImagePaintNode) {
+            QSGInternalImageNode *imageNode = static_cast<QSGInternalImageNode *>(paintNode);
+            imageNode->setTargetRect(rect);
+            imageNode->setInnerTargetRect(rect);
+            imageNode->update();
+        }
+        if (clipNode) {
+            clipNode->setRect(rect);
+            clipNode->update();
+        }
+        sizeChanged = false;
+    }
+
     if (!wasChanged || !node)
         return;
 
@@ -481,6 +539,67 @@ void QQuickScaleAnimatorJob::updateCurrentTime(int time)
 }
 
 
+void QQuickSizeAnimatorJob::postSync()
+{
+    if (m_helper && m_target)
+        m_helper->syncPaintNode();
+}
+
+void QQuickWidthAnimatorJob::writeBack()
+{
+    if (m_target)
+        m_target->setWidth(value());
+}
+
+void QQuickWidthAnimatorJob::updateCurrentTime(int time)
+{
+    if (!m_helper)
+        return;
+
+    m_value = m_from + (m_to - m_from) * progress(time);
+    m_helper->width = m_value;
+    m_helper->sizeChanged = true;
+}
+
+void QQuickHeightAnimatorJob::writeBack()
+{
+    if (m_target)
+        m_target->setHeight(value());
+}
+
+void QQuickHeightAnimatorJob::updateCurrentTime(int time)
+{
+    if (!m_helper)
+        return;
+
+    m_value = m_from + (m_to - m_from) * progress(time);
+    m_helper->height = m_value;
+    m_helper->sizeChanged = true;
+}
+
+QPointF QQuickPathAnimatorJob::positionAt(qreal progress) const
+{
+    return m_path.pointAtPercent(qBound<qreal>(0, progress, 1)) - m_anchorPoint;
+}
+
+void QQuickPathAnimatorJob::writeBack()
+{
+    if (m_target && !m_path.isEmpty())
+        m_target->setPosition(positionAt(value()));
+}
+
+void QQuickPathAnimatorJob::updateCurrentTime(int time)
+{
+    if (!m_helper || m_path.isEmpty())
+        return;
+
+    m_value = m_from + (m_to - m_from) * progress(time);
+    const QPointF position = positionAt(m_value);
+    m_helper->dx = position.x();
+    m_helper->dy = position.y();
+    m_helper->wasChanged = true;
+}
+
 QQuickRotationAnimatorJob::QQuickRotationAnimatorJob()
     : m_direction(QQuickRotationAnimator::Numerical)
 {
@@ -611,6 +730,66 @@ void QQuickOpacityAnimatorJob::updateCurrentTime(int time)
 }
 
 
+QQuickColorAnimatorJob::QQuickColorAnimatorJob()
+    : m_node(nullptr)
+{
+    // The color is interpolated from the progress kept in m_value
+    m_from = 0;
+    m_to = 1;
+}
+
+void QQuickColorAnimatorJob::setFromValue(const QVariant &from)
+{
+    m_fromColor = from.value<QColor>();
+}
+
+void QQuickColorAnimatorJob::setToValue(const QVariant &to)
+{
+    m_toColor = to.value<QColor>();
+}
+
+QColor QQuickColorAnimatorJob::colorAt(qreal progress) const
+{
+    const QColor from = m_fromColor.toRgb();
+    const QColor to = m_toColor.toRgb();
+    return QColor::fromRgbF(from.redF() + (to.redF() - from.redF()) * progress,
+                            from.greenF() + (to.greenF() - from.greenF()) * progress,
+                            from.blueF() + (to.blueF() - from.blueF()) * progress,
+                            from.alphaF() + (to.alphaF() - from.alphaF()) * progress);
+}
+
+void QQuickColorAnimatorJob::postSync()
+{
+    if (!m_target || !qobject_cast<QQuickRectangle *>(m_target)) {
+        invalidate();
+        return;
+    }
+
+    // Null when the rectangle is fully transparent or has no size
+    m_node = static_cast<QSGInternalRectangleNode *>(QQuickItemPrivate::get(m_target)->paintNode);
+}
+
+void QQuickColorAnimatorJob::invalidate()
+{
+    m_node = nullptr;
+}
+
+void QQuickColorAnimatorJob::writeBack()
+{
+    if (QQuickRectangle *rectangle = qobject_cast<QQuickRectangle *>(m_target))
+        rectangle->setColor(colorAt(value()));
+}
+
+void QQuickColorAnimatorJob::updateCurrentTime(int time)
+{
+    m_value = progress(time);
+    if (!m_node)
+        return;
+
+    m_node->setColor(colorAt(m_value));
+    m_node->update();
+}
+
 #if QT_CONFIG(quick_shadereffect) && QT_CONFIG(opengl)
 QQuickUniformAnimatorJob::QQuickUniformAnimatorJob()
     : m_node(nullptr)
@@ -58,6 +58,9 @@
 
 #include <QtQuick/qquickitem.h>
 
+#include <QtGui/qcolor.h>
+#include <QtGui/qpainterpath.h>
+
 #include <QtCore/qeasingcurve.h>
 
 QT_BEGIN_NAMESPACE
@@ -70,8 +73,10 @@ class QQuickAbstractAnimation;
 class QQuickAnimatorController;
 class QQuickAnimatorProxyJobPrivate;
 class QQuickOpenGLShaderEffectNode;
+class QQuickDefaultClipNode;
 
 class QSGOpacityNode;
+class QSGInternalRectangleNode;
 
 class Q_QUICK_PRIVATE_EXPORT QQuickAnimatorProxyJob : public QObject, public QAbstractAnimationJob
 {
@@ -127,6 +132,11 @@ public:
     void setTo(qreal to) { m_to = to; }
     qreal to() const { return m_to; }
 
+    // Called with the start and end values of the animated property, for
+    // animators of non-numeric properties to convert them.
+    virtual void setFromValue(const QVariant &from) { setFrom(from.toReal()); }
+    virtual void setToValue(const QVariant &to) { setTo(to.toReal()); }
+
     void setDuration(int duration) { m_duration = duration; }
     int duration() const override { return m_duration; }
 
@@ -192,27 +202,45 @@ public:
 
     struct Helper
     {
+        enum PaintNodeType {
+            UnknownPaintNode,
+            RectanglePaintNode,
+            StretchedImagePaintNode
+        };
+
         Helper()
             : ref(1)
             , node(nullptr)
+            , paintNode(nullptr)
+            , clipNode(nullptr)
+            , paintNodeType(UnknownPaintNode)
             , ox(0)
             , oy(0)
             , dx(0)
             , dy(0)
             , scale(1)
             , rotation(0)
+            , width(0)
+            , height(0)
             , wasSynced(false)
             , wasChanged(false)
+            , sizeChanged(false)
         {
         }
 
         void sync();
+        void syncPaintNode();
         void commit();
 
         int ref;
         QQuickItem *item;
         QSGTransformNode *node;
 
+        // Only known while the size is being animated
+        QSGNode *paintNode;
+        QQuickDefaultClipNode *clipNode;
+        PaintNodeType paintNodeType;
+
         // Origin
         float ox;
         float oy;
@@ -222,8 +250,12 @@ public:
         float scale;
         float rotation;
 
+        float width;
+        float height;
+
         uint wasSynced : 1;
         uint wasChanged : 1;
+        uint sizeChanged : 1;
     };
 
     ~QQuickTransformAnimatorJob();
@@ -276,6 +308,69 @@ private:
     QQuickRotationAnimator::RotationDirection m_direction;
 };
 
+class Q_QUICK_PRIVATE_EXPORT QQuickSizeAnimatorJob : public QQuickTransformAnimatorJob
+{
+public:
+    void postSync() override;
+
+protected:
+    QQuickSizeAnimatorJob() { }
+};
+
+class Q_QUICK_PRIVATE_EXPORT QQuickWidthAnimatorJob : public QQuickSizeAnimatorJob
+{
+public:
+    void updateCurrentTime(int time) override;
+    void writeBack() override;
+};
+
+class Q_QUICK_PRIVATE_EXPORT QQuickHeightAnimatorJob : public QQuickSizeAnimatorJob
+{
+public:
+    void updateCurrentTime(int time) override;
+    void writeBack() override;
+};
+
+class Q_QUICK_PRIVATE_EXPORT QQuickPathAnimatorJob : public QQuickTransformAnimatorJob
+{
+public:
+    void setPath(const QPainterPath &path) { m_path = path; }
+    QPainterPath path() const { return m_path; }
+
+    void setAnchorPoint(const QPointF &anchorPoint) { m_anchorPoint = anchorPoint; }
+    QPointF anchorPoint() const { return m_anchorPoint; }
+
+    void updateCurrentTime(int time) override;
+    void writeBack() override;
+
+private:
+    QPointF positionAt(qreal progress) const;
+
+    QPainterPath m_path;
+    QPointF m_anchorPoint;
+};
+
+class Q_QUICK_PRIVATE_EXPORT QQuickColorAnimatorJob : public QQuickAnimatorJob
+{
+public:
+    QQuickColorAnimatorJob();
+
+    void setFromValue(const QVariant &from) override;
+    void setToValue(const QVariant &to) override;
+
+    void invalidate() override;
+    void updateCurrentTime(int time) override;
+    void writeBack() override;
+    void postSync() override;
+
+private:
+    QColor colorAt(qreal progress) const;
+
+    QColor m_fromColor;
+    QColor m_toColor;
+    QSGInternalRectangleNode *m_node;
+};
+
 class Q_QUICK_PRIVATE_EXPORT QQuickOpacityAnimatorJob : public QQuickAnimatorJob
 {
 public:
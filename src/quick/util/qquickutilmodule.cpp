@@ -135,4 +135,11 @@ void QQuickUtilModule::defineModule()
 
     qmlRegisterUncreatableType<QQuickAbstractAnimation, 12>("QtQuick", 2, 12, "Animation",
         QQuickAbstractAnimation::tr("Animation is an abstract class"));
+
+    qmlRegisterType<QQuickWidthAnimator>("QtQuick", 2, 13, "WidthAnimator");
+    qmlRegisterType<QQuickHeightAnimator>("QtQuick", 2, 13, "HeightAnimator");
+    qmlRegisterType<QQuickColorAnimator>("QtQuick", 2, 13, "ColorAnimator");
+#if QT_CONFIG(quick_path)
+    qmlRegisterType<QQuickPathAnimator>("QtQuick", 2, 13, "PathAnimator");
+#endif
 }
@@ -839,6 +839,7 @@ void QQuickShape::setContainsMode(QQuickShape::ContainsMode containsMode)
         return;
 
     d->containsMode = containsMode;
+    d->setCustomContainment(containsMode != BoundingRectContains);
     emit containsModeChanged();
 }
 
@@ -40,6 +40,9 @@
 #include <stdlib.h>
 #include <private/qv4alloca_p.h>
 #include <private/qjsvalue_p.h>
+#include <private/qv4estable_p.h>
+#include <private/qv4mapobject_p.h>
+#include <private/qv4setobject_p.h>
 #include <QScopeGuard>
 
 #ifdef Q_CC_MSVC
@@ -128,7 +131,14 @@ private slots:
     void reentrancy_objectCreation();
     void jsIncDecNonObjectProperty();
     void JSONparse();
+    void JSONparseRepeatedKeys();
+    void toJson();
+    void JSONstringifyReplacerArray();
     void arraySort();
+    void arraySortStable();
+    void simpleArrayFastPaths();
+    void mapSetReinsertDuringIteration();
+    void mapSetAbandonedIteration();
     void lookupOnDisappearingProperty();
     void arrayConcat();
     void recursiveBoundFunctions();
@@ -147,6 +157,8 @@ private slots:
     void arrayPop_QTBUG_35979();
     void array_unshift_QTBUG_52065();
     void array_join_QTBUG_53672();
+    void arrayJoin();
+    void substringSlices();
 
     void regexpLastMatch();
     void regexpLastIndex();
@@ -3033,6 +3045,363 @@ void tst_QJSEngine::JSONparse()
     QVERIFY(ret.isObject());
 }
 
+void tst_QJSEngine::JSONparseRepeatedKeys()
+{
+    // Objects following each other at the same nesting level share their
+    // internal class as long as the keys match.
+    QJSEngine eng;
+    QJSValue ret = eng.evaluate(
+            "var list = JSON.parse('[{\"a\": 1, \"b\": {\"c\": 2}}, {\"a\": 3, \"b\": {\"d\": 4}},'\n"
+            "                     + '{\"a\": 5, \"a\": 6}, {\"b\": 7, \"a\": 8}, {\"a\\\\u0062\": 9, \"a\": 10},'\n"
+            "                     + '{\"a\": -0, \"b\": 1.5e3, \"0\": 12345678901}]');\n"
+            "JSON.stringify(list) + ' ' + (1 / list[5].a)");
+    QCOMPARE(ret.toString(), QString::fromLatin1(
+            "[{\"a\":1,\"b\":{\"c\":2}},{\"a\":3,\"b\":{\"d\":4}},{\"a\":6},{\"b\":7,\"a\":8},"
+            "{\"ab\":9,\"a\":10},{\"0\":12345678901,\"a\":0,\"b\":1500}] -Infinity"));
+
+    QVERIFY(eng.evaluate("JSON.parse('1.')").isError());
+    QVERIFY(eng.evaluate("JSON.parse('-')").isError());
+    QVERIFY(eng.evaluate("JSON.parse('[1e]')").isError());
+}
+
+void tst_QJSEngine::toJson()
+{
+    QJSEngine eng;
+    QJSValue value = eng.evaluate("({ name: 'caf\\u00e9 \\\"\\ud83d\\ude00\\\"', list: [1, undefined, function() {}, { x: null }],"
+                                  "   skipped: undefined, empty: {}, none: [] })");
+    QVERIFY(value.isObject());
+
+    QBuffer buffer;
+    QVERIFY(buffer.open(QIODevice::WriteOnly));
+    QVERIFY(eng.toJson(value, &buffer));
+    QCOMPARE(QString::fromUtf8(buffer.data()),
+             eng.evaluate("JSON.stringify").call(QJSValueList() << value).toString());
+
+    QBuffer indented;
+    QVERIFY(indented.open(QIODevice::WriteOnly));
+    QVERIFY(eng.toJson(value, &indented, 2));
+    QCOMPARE(QString::fromUtf8(indented.data()),
+             eng.evaluate("JSON.stringify").call(QJSValueList() << value << QJSValue::NullValue << 2).toString());
+
+    // Large enough to be written in several chunks.
+    QJSValue big = eng.evaluate("var big = []; for (var i = 0; i < 50000; ++i) big.push({ id: i, text: '\\u00fc' + i }); big");
+    QBuffer chunked;
+    QVERIFY(chunked.open(QIODevice::WriteOnly));
+    QVERIFY(eng.toJson(big, &chunked));
+    QCOMPARE(QString::fromUtf8(chunked.data()),
+             eng.evaluate("JSON.stringify").call(QJSValueList() << big).toString());
+
+    QBuffer failing;
+    QVERIFY(failing.open(QIODevice::WriteOnly));
+    QVERIFY(!eng.toJson(QJSValue(), &failing));
+    QVERIFY(!eng.toJson(eng.evaluate("var cyclic = {}; cyclic.self = cyclic; cyclic"), &failing));
+    // The exception does not stay pending.
+    QCOMPARE(eng.evaluate("1 + 1").toInt(), 2);
+
+    QBuffer closed;
+    QTest::ignoreMessage(QtWarningMsg, QRegularExpression("device not open"));
+    QVERIFY(!eng.toJson(value, &closed));
+}
+
+void tst_QJSEngine::JSONstringifyReplacerArray()
+{
+    // Keys listed more than once in a replacer array are only written once, also
+    // when they were converted from numbers or String objects.
+    QJSEngine eng;
+    QJSValue ret = eng.evaluate(
+            "JSON.stringify({ a: 1, b: 2, 1: 3, c: 4 }, ['b', 'a', 'b', 1, '1', new String('a'), new Number(1), {}, null])");
+    QCOMPARE(ret.toString(), QStringLiteral("{\"b\":2,\"a\":1,\"1\":3}"));
+
+    ret = eng.evaluate("JSON.stringify({ a: { a: 1, c: 2 }, c: 3 }, ['a', 'a'], 1)");
+    QCOMPARE(ret.toString(), QStringLiteral("{\n \"a\": {\n  \"a\": 1\n }\n}"));
+
+    ret = eng.evaluate("var keys = []; for (var i = 0; i < 3; ++i) keys.push('k' + (i % 2)); "
+                       "JSON.stringify({ k0: 0, k1: 1 }, keys)");
+    QCOMPARE(ret.toString(), QStringLiteral("{\"k0\":0,\"k1\":1}"));
+}
+
+void tst_QJSEngine::mapSetReinsertDuringIteration()
+{
+    // Re-inserting a key moves it to the end, so the iteration would go on forever.
+    // Removed entries have to be dropped meanwhile, without the iteration skipping
+    // or repeating entries.
+    QJSEngine eng;
+    QJSValue result = eng.evaluate(
+            "(function() {\n"
+            "    var expected = [];\n"
+            "    for (var i = 0; i < 1000; ++i)\n"
+            "        expected.push(i % 100);\n"
+            "    expected = expected.join();\n"
+            "    var m = new Map();\n"
+            "    var s = new Set();\n"
+            "    for (var i = 0; i < 100; ++i) {\n"
+            "        m.set(i, 'v' + i);\n"
+            "        s.add(i);\n"
+            "    }\n"
+            "\n"
+            "    var seen = [];\n"
+            "    for (const [k, v] of m) {\n"
+            "        if (v !== 'v' + k)\n"
+            "            return 'wrong value ' + v + ' for ' + k;\n"
+            "        seen.push(k);\n"
+            "        m.delete(k);\n"
+            "        m.set(k, v);\n"
+            "        if (seen.length === 1000)\n"
+            "            break;\n"
+            "    }\n"
+            "    if (seen.join() !== expected)\n"
+            "        return 'Map iterator: ' + seen.join();\n"
+            "    if (m.size !== 100)\n"
+            "        return 'Map size: ' + m.size;\n"
+            "\n"
+            "    seen = [];\n"
+            "    m.forEach(function(v, k) {\n"
+            "        if (seen.length < 1000) {\n"
+            "            seen.push(k);\n"
+            "            m.delete(k);\n"
+            "            m.set(k, v);\n"
+            "        }\n"
+            "    });\n"
+            "    if (seen.join() !== expected)\n"
+            "        return 'Map forEach: ' + seen.join();\n"
+            "\n"
+            "    seen = [];\n"
+            "    for (const k of s) {\n"
+            "        seen.push(k);\n"
+            "        s.delete(k);\n"
+            "        s.add(k);\n"
+            "        if (seen.length === 1000)\n"
+            "            break;\n"
+            "    }\n"
+            "    if (seen.join() !== expected)\n"
+            "        return 'Set iterator: ' + seen.join();\n"
+            "\n"
+            "    seen = [];\n"
+            "    s.forEach(function(k) {\n"
+            "        if (seen.length < 1000) {\n"
+            "            seen.push(k);\n"
+            "            s.delete(k);\n"
+            "            s.add(k);\n"
+            "        }\n"
+            "    });\n"
+            "    if (seen.join() !== expected)\n"
+            "        return 'Set forEach: ' + seen.join();\n"
+            "    if (s.size !== 100)\n"
+            "        return 'Set size: ' + s.size;\n"
+            "\n"
+            "    // An iteration sees entries added after a clear().\n"
+            "    seen = [];\n"
+            "    for (const k of s) {\n"
+            "        seen.push(k);\n"
+            "        if (k === 0) {\n"
+            "            s.clear();\n"
+            "            s.add('a');\n"
+            "        }\n"
+            "    }\n"
+            "    if (seen.join() !== '0,a')\n"
+            "        return 'Set clear: ' + seen.join();\n"
+            "    return 'ok';\n"
+            "})()");
+    QCOMPARE(result.toString(), QStringLiteral("ok"));
+}
+
+void tst_QJSEngine::mapSetAbandonedIteration()
+{
+    // Iterations that are never finished must not keep the tables from dropping
+    // removed entries, and must be able to continue after they were dropped.
+    QJSEngine eng;
+    QJSValue result = eng.evaluate(
+            "var m = new Map();\n"
+            "var s = new Set();\n"
+            "(function() {\n"
+            "    for (var i = 0; i < 100; ++i) {\n"
+            "        m.set(i, 'v' + i);\n"
+            "        s.add(i);\n"
+            "    }\n"
+            "    for (const [k, v] of m) {\n"
+            "        if (k === 10)\n"
+            "            break;\n"
+            "    }\n"
+            "    for (const k of s)\n"
+            "        break;\n"
+            "    const [a, b] = m;\n"
+            "    const [c] = s;\n"
+            "    var mapIterator = m.keys();\n"
+            "    mapIterator.next();\n"
+            "    var setIterator = s.values();\n"
+            "    setIterator.next();\n"
+            "\n"
+            "    for (var round = 0; round < 1000; ++round) {\n"
+            "        for (var i = 0; i < 100; ++i) {\n"
+            "            m.delete(round * 100 + i);\n"
+            "            m.set((round + 1) * 100 + i, i);\n"
+            "            s.delete(round * 100 + i);\n"
+            "            s.add((round + 1) * 100 + i);\n"
+            "        }\n"
+            "    }\n"
+            "\n"
+            "    var expected = [];\n"
+            "    for (var i = 0; i < 100; ++i)\n"
+            "        expected.push(100000 + i);\n"
+            "    expected = expected.join();\n"
+            "    var rest = [];\n"
+            "    for (var r = mapIterator.next(); !r.done; r = mapIterator.next())\n"
+            "        rest.push(r.value);\n"
+            "    if (rest.join() !== expected)\n"
+            "        return 'Map iterator: ' + rest.join();\n"
+            "    rest = [];\n"
+            "    for (var r = setIterator.next(); !r.done; r = setIterator.next())\n"
+            "        rest.push(r.value);\n"
+            "    if (rest.join() !== expected)\n"
+            "        return 'Set iterator: ' + rest.join();\n"
+            "    return 'ok';\n"
+            "})()");
+    QCOMPARE(result.toString(), QStringLiteral("ok"));
+
+    QJSValue map = eng.globalObject().property("m");
+    QV4::MapObject *mapObject = QJSValuePrivate::getValue(&map)->as<QV4::MapObject>();
+    QVERIFY(mapObject);
+    QCOMPARE(map.property("size").toInt(), 100);
+    QVERIFY(mapObject->d()->esTable->capacity() <= 256);
+
+    QJSValue set = eng.globalObject().property("s");
+    QV4::SetObject *setObject = QJSValuePrivate::getValue(&set)->as<QV4::SetObject>();
+    QVERIFY(setObject);
+    QCOMPARE(set.property("size").toInt(), 100);
+    QVERIFY(setObject->d()->esTable->capacity() <= 256);
+}
+
+void tst_QJSEngine::simpleArrayFastPaths()
+{
+    // includes(), lastIndexOf(), fill() and appending elements read and write densely
+    // stored arrays directly. Compare them with the same operations on array-like
+    // objects, which always take the generic path.
+    QJSEngine eng;
+    QJSValue result = eng.evaluate(
+            "(function() {\n"
+            "    function arrayLike(a) {\n"
+            "        var o = { length: a.length };\n"
+            "        for (var i = 0; i < a.length; ++i) {\n"
+            "            if (i in a)\n"
+            "                o[i] = a[i];\n"
+            "        }\n"
+            "        return o;\n"
+            "    }\n"
+            "    function check(name, a, args, expected) {\n"
+            "        var fast = Array.prototype[name].apply(a, args);\n"
+            "        var slow = Array.prototype[name].apply(arrayLike(a), args);\n"
+            "        if (!Object.is(fast, expected) || !Object.is(slow, expected))\n"
+            "            throw name + '(' + args + ') on [' + a + ']: ' + fast + ', ' + slow + ', expected ' + expected;\n"
+            "    }\n"
+            "\n"
+            "    var holes = [1, , 3];\n"
+            "    check('includes', holes, [undefined], true);\n"
+            "    check('lastIndexOf', holes, [undefined], -1);\n"
+            "    check('includes', holes, [undefined, 2], false);\n"
+            "    var longer = [1, 2];\n"
+            "    longer.length = 5;\n"
+            "    check('includes', longer, [undefined], true);\n"
+            "    check('includes', longer, [undefined, 4], true);\n"
+            "    check('includes', longer, [2, 2], false);\n"
+            "\n"
+            "    var nan = [1, NaN, -0];\n"
+            "    check('includes', nan, [NaN], true);\n"
+            "    check('lastIndexOf', nan, [NaN], -1);\n"
+            "    check('includes', nan, [0], true);\n"
+            "    check('lastIndexOf', nan, [0], 2);\n"
+            "\n"
+            "    var values = [1, 2, 3, 1];\n"
+            "    check('includes', values, [1, -1], true);\n"
+            "    check('includes', values, [2, -2], false);\n"
+            "    check('includes', values, [2, -10], true);\n"
+            "    check('includes', values, [1, 10], false);\n"
+            "    check('lastIndexOf', values, [1, -2], 0);\n"
+            "    check('lastIndexOf', values, [1, -10], -1);\n"
+            "    check('lastIndexOf', values, [3, 10], 2);\n"
+            "\n"
+            "    var accessor = [0, 1, 2];\n"
+            "    Object.defineProperty(accessor, 1, { get: function() { return 'g'; } });\n"
+            "    if (!accessor.includes('g') || accessor.lastIndexOf('g') !== 1)\n"
+            "        return 'accessor elements not found';\n"
+            "\n"
+            "    function fill(a, args) {\n"
+            "        var fast = a.slice();\n"
+            "        fast.length = a.length;\n"
+            "        Array.prototype.fill.apply(fast, args);\n"
+            "        var slow = arrayLike(a);\n"
+            "        Array.prototype.fill.apply(slow, args);\n"
+            "        var result = [];\n"
+            "        for (var i = 0; i < a.length; ++i) {\n"
+            "            if ((i in fast) !== (i in slow) || fast[i] !== slow[i])\n"
+            "                throw 'fill(' + args + ') on [' + a + ']: ' + fast + ' differs at ' + i;\n"
+            "            result.push(i in fast ? String(fast[i]) : 'hole');\n"
+            "        }\n"
+            "        if (fast.length !== a.length)\n"
+            "            throw 'fill(' + args + ') changed the length to ' + fast.length;\n"
+            "        return result.join();\n"
+            "    }\n"
+            "    if (fill([1, 2, 3, 4, 5], [0, -3, -1]) !== '1,2,0,0,5')\n"
+            "        return 'fill with negative start and end';\n"
+            "    if (fill([1, 2], [9, -10]) !== '9,9')\n"
+            "        return 'fill with a start before the array';\n"
+            "    if (fill([1, 2, 3], [9, 2, 1]) !== '1,2,3')\n"
+            "        return 'fill with an empty range';\n"
+            "    if (fill([1, 2], [undefined]) !== 'undefined,undefined')\n"
+            "        return 'fill with undefined';\n"
+            "    var unset = [1, 2].fill();\n"
+            "    if (unset.length !== 2 || !(1 in unset) || unset[1] !== undefined)\n"
+            "        return 'fill without a value';\n"
+            "    var sparse = [];\n"
+            "    sparse.length = 5;\n"
+            "    if (fill(sparse, [1, 2]) !== 'hole,hole,1,1,1')\n"
+            "        return 'fill behind the stored elements';\n"
+            "    if (new Array(3).fill(7).join() !== '7,7,7')\n"
+            "        return 'fill of a preallocated array';\n"
+            "    var frozen = Object.freeze([1, 2]);\n"
+            "    try {\n"
+            "        frozen.fill(0);\n"
+            "        return 'fill of a frozen array';\n"
+            "    } catch (e) {\n"
+            "        if (!(e instanceof TypeError) || frozen.join() !== '1,2')\n"
+            "            return 'fill of a frozen array: ' + e;\n"
+            "    }\n"
+            "\n"
+            "    var appended = [];\n"
+            "    for (var i = 0; i < 1000; ++i)\n"
+            "        appended[i] = i;\n"
+            "    if (appended.length !== 1000 || appended[999] !== 999 || appended.indexOf(500) !== 500)\n"
+            "        return 'append: ' + appended.length;\n"
+            "    var fixed = [0, 1];\n"
+            "    Object.preventExtensions(fixed);\n"
+            "    fixed[2] = 2;\n"
+            "    if (fixed.length !== 2 || (2 in fixed))\n"
+            "        return 'append to a non-extensible array';\n"
+            "    var named = [0];\n"
+            "    named.extra = true;\n"
+            "    named[1] = 1;\n"
+            "    if (named.length !== 2 || named[1] !== 1)\n"
+            "        return 'append to an array with named properties';\n"
+            "\n"
+            "    // Elements in the prototype chain disable the fast paths, so check them last.\n"
+            "    Array.prototype[1] = 'p';\n"
+            "    var shadowed = [0, , 2];\n"
+            "    var found = shadowed.includes('p') && shadowed.lastIndexOf('p') === 1;\n"
+            "    delete Array.prototype[1];\n"
+            "    if (!found)\n"
+            "        return 'prototype elements not found';\n"
+            "    var setterCalls = 0;\n"
+            "    Object.defineProperty(Array.prototype, 3, { set: function(v) { ++setterCalls; }, configurable: true });\n"
+            "    var intercepted = [];\n"
+            "    for (var i = 0; i < 4; ++i)\n"
+            "        intercepted[i] = i;\n"
+            "    delete Array.prototype[3];\n"
+            "    if (setterCalls !== 1 || intercepted.length !== 3 || (3 in intercepted))\n"
+            "        return 'append through a prototype setter: ' + setterCalls + ' ' + intercepted.length;\n"
+            "    return 'ok';\n"
+            "})()");
+    QCOMPARE(result.toString(), QStringLiteral("ok"));
+}
+
 void tst_QJSEngine::arraySort()
 {
     // tests that calling Array.sort with a bad sort function doesn't cause issues
@@ -3051,6 +3420,126 @@ void tst_QJSEngine::arraySort()
                  "crashMe();");
 }
 
+void tst_QJSEngine::arraySortStable()
+{
+    QJSEngine eng;
+    QJSValue result = eng.evaluate(
+            "(function() {\n"
+            "    var seed = 1;\n"
+            "    function random(n) {\n"
+            "        seed = (seed * 16807) % 2147483647;\n"
+            "        return seed % n;\n"
+            "    }\n"
+            "    // Reference: a stable insertion sort.\n"
+            "    function reference(a, compare) {\n"
+            "        var r = a.slice();\n"
+            "        for (var i = 1; i < r.length; ++i) {\n"
+            "            var v = r[i];\n"
+            "            var j = i;\n"
+            "            for (; j > 0 && compare(r[j - 1], v) > 0; --j)\n"
+            "                r[j] = r[j - 1];\n"
+            "            r[j] = v;\n"
+            "        }\n"
+            "        return r;\n"
+            "    }\n"
+            "    function ids(a) {\n"
+            "        return a.map(function(e) { return e.id; }).join();\n"
+            "    }\n"
+            "    function byKey(a, b) { return a.key - b.key; }\n"
+            "\n"
+            "    // Equal keys keep their order, for random data, natural runs and descending runs.\n"
+            "    var inputs = [];\n"
+            "    for (var n = 0; n < 3; ++n)\n"
+            "        inputs.push([]);\n"
+            "    for (var i = 0; i < 1000; ++i) {\n"
+            "        inputs[0].push({ key: random(10), id: i });\n"
+            "        inputs[1].push({ key: Math.floor(i / 7) % 50, id: i });\n"
+            "        inputs[2].push({ key: 100 - Math.floor(i / 3), id: i });\n"
+            "    }\n"
+            "    for (var n = 0; n < inputs.length; ++n) {\n"
+            "        var sorted = inputs[n].slice().sort(byKey);\n"
+            "        if (ids(sorted) !== ids(reference(inputs[n], byKey)))\n"
+            "            return 'comparefn ' + n + ': ' + ids(sorted);\n"
+            "    }\n"
+            "\n"
+            "    // The default comparator sorts by string value, and is stable as well.\n"
+            "    var named = [];\n"
+            "    for (var i = 0; i < 200; ++i)\n"
+            "        named.push({ id: i, toString: function() { return 'k' + (this.id % 4 === 0 ? 10 : this.id % 3); } });\n"
+            "    var sorted = named.slice().sort();\n"
+            "    var expected = reference(named, function(a, b) { return String(a) < String(b) ? -1 : String(a) > String(b) ? 1 : 0; });\n"
+            "    if (ids(sorted) !== ids(expected))\n"
+            "        return 'default comparator: ' + ids(sorted);\n"
+            "    if ([10, 9, 1, 100, -1].sort().join() !== '-1,1,10,100,9')\n"
+            "        return 'default comparator on numbers';\n"
+            "\n"
+            "    // Undefined values and holes go to the end without being compared.\n"
+            "    var compared = [];\n"
+            "    var holes = [3, undefined, , 1, undefined, 2, , ];\n"
+            "    holes.sort(function(a, b) { compared.push(a, b); return a - b; });\n"
+            "    if (compared.indexOf(undefined) !== -1)\n"
+            "        return 'undefined passed to the comparefn';\n"
+            "    if (holes.length !== 7 || holes.slice(0, 5).join() !== '1,2,3,,' || holes[3] !== undefined\n"
+            "            || !(4 in holes) || (5 in holes) || (6 in holes))\n"
+            "        return 'holes with comparefn: ' + holes.length + ' ' + holes.join();\n"
+            "    holes = [undefined, 'b', , 'a'];\n"
+            "    holes.sort();\n"
+            "    if (holes.length !== 4 || holes[0] !== 'a' || holes[1] !== 'b' || !(2 in holes) || (3 in holes))\n"
+            "        return 'holes with default comparator: ' + holes.join();\n"
+            "\n"
+            "    // Shifted and sparse arrays.\n"
+            "    var shifted = [9, 5, 4, 3];\n"
+            "    shifted.shift();\n"
+            "    shifted.sort();\n"
+            "    if (shifted.join() !== '3,4,5')\n"
+            "        return 'shifted: ' + shifted.join();\n"
+            "    var sparse = [];\n"
+            "    sparse[100] = 3;\n"
+            "    sparse[5] = 1;\n"
+            "    sparse[50] = undefined;\n"
+            "    sparse[1000] = 2;\n"
+            "    sparse.sort();\n"
+            "    if (sparse.length !== 1001 || sparse.slice(0, 4).join() !== '1,2,3,' || !(3 in sparse)\n"
+            "            || (4 in sparse) || (1000 in sparse))\n"
+            "        return 'sparse: ' + sparse.length + ' ' + sparse.slice(0, 5).join();\n"
+            "    sparse = [];\n"
+            "    for (var i = 0; i < 300; ++i)\n"
+            "        sparse[i * 1000] = { key: i % 5, id: i };\n"
+            "    var dense = sparse.filter(function() { return true; });\n"
+            "    sparse.sort(byKey);\n"
+            "    if (ids(sparse.slice(0, 300)) !== ids(reference(dense, byKey)) || (300 in sparse))\n"
+            "        return 'sparse with comparefn: ' + ids(sparse.slice(0, 300));\n"
+            "\n"
+            "    // Throwing or inconsistent comparators leave a permutation of the elements.\n"
+            "    var values = [];\n"
+            "    for (var i = 0; i < 500; ++i)\n"
+            "        values.push(i);\n"
+            "    var calls = 0;\n"
+            "    try {\n"
+            "        values.sort(function(a, b) { if (++calls === 300) throw 'stop'; return b - a; });\n"
+            "        return 'comparefn exception lost';\n"
+            "    } catch (e) {\n"
+            "        if (e !== 'stop' || calls !== 300)\n"
+            "            return 'comparefn exception: ' + e + ' ' + calls;\n"
+            "    }\n"
+            "    function isPermutation(a) {\n"
+            "        var check = a.slice().sort(function(a, b) { return a - b; });\n"
+            "        for (var i = 0; i < 500; ++i) {\n"
+            "            if (check[i] !== i)\n"
+            "                return false;\n"
+            "        }\n"
+            "        return a.length === 500;\n"
+            "    }\n"
+            "    if (!isPermutation(values))\n"
+            "        return 'elements lost after an exception';\n"
+            "    values.sort(function() { return random(3) - 1; });\n"
+            "    if (!isPermutation(values))\n"
+            "        return 'elements lost with an inconsistent comparefn';\n"
+            "    return 'ok';\n"
+            "})()");
+    QCOMPARE(result.toString(), QStringLiteral("ok"));
+}
+
 void tst_QJSEngine::lookupOnDisappearingProperty()
 {
     QJSEngine eng;
@@ -3305,6 +3794,131 @@ void tst_QJSEngine::array_join_QTBUG_53672()
     QCOMPARE(result.toString(), QString(""));
 }
 
+void tst_QJSEngine::arrayJoin()
+{
+    QJSEngine eng;
+    QJSValue result = eng.evaluate(
+            "(function() {\n"
+            "    function expect(actual, expected, what) {\n"
+            "        if (actual !== expected)\n"
+            "            throw what + ': \"' + actual + '\" instead of \"' + expected + '\"';\n"
+            "    }\n"
+            "    var o = { toString: function() { return 'o'; } };\n"
+            "    expect([1, null, undefined, 'a', , o].join('-'), '1---a--o', 'separator');\n"
+            "    expect([1, 2].join(), '1,2', 'default separator');\n"
+            "    expect([1, 2, 3].join(''), '123', 'empty separator');\n"
+            "    expect(['a', 'b'].join('\\u00e4\\u00f6'), 'a\\u00e4\\u00f6b', 'long separator');\n"
+            "    expect([].join(), '', 'empty array');\n"
+            "    expect([[1, 2], [3]].join(';'), '1,2;3', 'nested arrays');\n"
+            "\n"
+            "    var longer = [1, 2];\n"
+            "    longer.length = 5;\n"
+            "    expect(longer.join(), '1,2,,,', 'length past the stored elements');\n"
+            "    var shifted = [0, 1, 2, 3];\n"
+            "    shifted.shift();\n"
+            "    expect(shifted.join(), '1,2,3', 'shifted array');\n"
+            "\n"
+            "    // Sparse arrays are joined without storage for every index.\n"
+            "    var sparse = [];\n"
+            "    sparse[1000000] = 1;\n"
+            "    sparse[10] = 'x';\n"
+            "    expect(sparse.join(''), 'x1', 'sparse array');\n"
+            "    var joined = sparse.join(',');\n"
+            "    expect(joined.length, 1000002, 'length of a sparse array joined');\n"
+            "    expect(joined.substring(8, 14), ',,x,,,', 'sparse array with separator');\n"
+            "\n"
+            "    // The length is read once, elements are read when they are converted.\n"
+            "    var growing = [1, { toString: function() { growing.push(9); return 'x'; } }, 3];\n"
+            "    expect(growing.join(), '1,x,3', 'array growing while joined');\n"
+            "    var shrinking = [1, { toString: function() { shrinking.length = 1; return 'x'; } }, 3];\n"
+            "    expect(shrinking.join(), '1,x,', 'array shrinking while joined');\n"
+            "\n"
+            "    expect(Array.prototype.join.call({ length: 3, 0: 'a', 2: 'c' }, '+'), 'a++c', 'array-like object');\n"
+            "    expect(Array.prototype.join.call('abc', '.'), 'a.b.c', 'string');\n"
+            "    var accessor = [1, 2, 3];\n"
+            "    Object.defineProperty(accessor, 1, { get: function() { return 'g'; } });\n"
+            "    expect(accessor.join(), '1,g,3', 'accessor element');\n"
+            "\n"
+            "    try {\n"
+            "        [1, { toString: function() { throw 'thrown'; } }].join();\n"
+            "        return 'exception lost';\n"
+            "    } catch (e) {\n"
+            "        expect(e, 'thrown', 'exception');\n"
+            "    }\n"
+            "    var huge = [];\n"
+            "    huge.length = 4294967295;\n"
+            "    try {\n"
+            "        huge.join('ab');\n"
+            "        return 'too long result accepted';\n"
+            "    } catch (e) {\n"
+            "        if (!(e instanceof RangeError))\n"
+            "            return 'too long result: ' + e;\n"
+            "    }\n"
+            "\n"
+            "    // Elements in the prototype chain show through holes, so check them last.\n"
+            "    Array.prototype[1] = 'p';\n"
+            "    var holes = [0, , 2].join();\n"
+            "    delete Array.prototype[1];\n"
+            "    expect(holes, '0,p,2', 'prototype elements');\n"
+            "    return 'ok';\n"
+            "})()");
+    QCOMPARE(result.toString(), QStringLiteral("ok"));
+}
+
+void tst_QJSEngine::substringSlices()
+{
+    // substring(), substr() and slice() share the storage of their source string.
+    QJSEngine eng;
+    QJSValue result = eng.evaluate(
+            "(function() {\n"
+            "    function expect(actual, expected, what) {\n"
+            "        if (actual !== expected)\n"
+            "            throw what + ': \"' + actual + '\" instead of \"' + expected + '\"';\n"
+            "    }\n"
+            "    var s = '';\n"
+            "    for (var i = 0; i < 10; ++i)\n"
+            "        s += 'abcdefghij';\n"
+            "    // s is a rope here, built from the additions above.\n"
+            "    var chars = s.split('');\n"
+            "    function reference(from, to) {\n"
+            "        return chars.slice(from, to).join('');\n"
+            "    }\n"
+            "\n"
+            "    var sub = s.substring(12, 47);\n"
+            "    expect(sub, reference(12, 47), 'substring of a rope');\n"
+            "    expect(s.substr(12, 35), sub, 'substr');\n"
+            "    expect(s.slice(12, 47), sub, 'slice');\n"
+            "    expect(s.substring(47, 12), sub, 'swapped substring');\n"
+            "    expect(s.substr(-5, 3), 'fgh', 'substr from the end');\n"
+            "    expect(s.substr(98, 10), 'ij', 'substr past the end');\n"
+            "    expect(s.substring(5, 5), '', 'empty substring');\n"
+            "    expect(s.substring(-10, 3), 'abc', 'negative substring start');\n"
+            "\n"
+            "    // Slices of slices.\n"
+            "    var nested = sub.substring(3, 30).slice(2, -2).substr(1, 10);\n"
+            "    expect(nested, reference(18, 28), 'nested slices');\n"
+            "    expect(nested.length, 10, 'length of nested slices');\n"
+            "    expect(nested.charAt(0), 'i', 'first character of nested slices');\n"
+            "    expect(nested.indexOf('j'), 1, 'search in nested slices');\n"
+            "    expect(sub.substring(0, 0).length, 0, 'empty slice');\n"
+            "\n"
+            "    // Slices in ropes, as property names and modified sources.\n"
+            "    var combined = sub.substring(0, 5) + '-' + nested + s.substr(0, 3);\n"
+            "    expect(combined, reference(12, 17) + '-' + reference(18, 28) + 'abc', 'rope of slices');\n"
+            "    expect(combined.substring(4, 8), reference(16, 17) + '-' + reference(18, 20), 'slice of a rope of slices');\n"
+            "    var object = {};\n"
+            "    object[s.substring(10, 13)] = 1;\n"
+            "    expect(object.abc, 1, 'slice as a property name');\n"
+            "    var source = 'Uppercase';\n"
+            "    var tail = (source + source).substring(9, 14);\n"
+            "    source += 'changed';\n"
+            "    expect(tail, 'Upper', 'slice of a changed source');\n"
+            "    expect(tail.toLowerCase(), 'upper', 'converted slice');\n"
+            "    return 'ok';\n"
+            "})()");
+    QCOMPARE(result.toString(), QStringLiteral("ok"));
+}
+
 void tst_QJSEngine::regexpLastMatch()
 {
     QJSEngine eng;
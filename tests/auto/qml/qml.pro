@@ -54,6 +54,7 @@ PRIVATETESTS += \
     qqmlvaluetypes \
     qqmlvaluetypeproviders \
     qqmlbinding \
+    qqmlbindingscheduler \
     qqmlchangeset \
     qqmlconnections \
     qqmllistcompositor \
@@ -74,6 +75,7 @@ PRIVATETESTS += \
     qv4mm \
     qv4identifiertable \
     qv4regexp \
+    qv4sparsearray \
     ecmascripttests \
     bindingdependencyapi \
     v4misc
@@ -34,6 +34,7 @@
 #include <private/qv4engine_p.h>
 #include <private/qv4codegen_p.h>
 #include <private/qqmlcomponent_p.h>
+#include <private/qv4jitcodecache_p.h>
 #include <QQmlComponent>
 #include <QQmlEngine>
 #include <QQmlFileSelector>
@@ -41,6 +42,7 @@
 #include <QCryptographicHash>
 #include <QStandardPaths>
 #include <QDirIterator>
+#include <QScopeGuard>
 
 class tst_qmldiskcache: public QObject
 {
@@ -63,6 +65,7 @@ private slots:
     void singletonDependency();
     void cppRegisteredSingletonDependency();
     void cacheModuleScripts();
+    void jitCodeCache();
 
 private:
     QDir m_qmlCacheDirectory;
@@ -941,6 +944,80 @@ void tst_qmldiskcache::cacheModuleScripts()
     }
 }
 
+void tst_qmldiskcache::jitCodeCache()
+{
+#ifndef V4_ENABLE_JIT_CODE_CACHE
+    QSKIP("Storing JIT code is not supported on this platform");
+#else
+    qputenv("QV4_JIT_DISK_CACHE", "1");
+    auto resetEnvironment = qScopeGuard([]() { qunsetenv("QV4_JIT_DISK_CACHE"); });
+
+    QTemporaryDir tempDir;
+    QVERIFY(tempDir.isValid());
+    const QString testFilePath = tempDir.path() + QStringLiteral("/test.qml");
+    {
+        QFile f(testFilePath);
+        QVERIFY(f.open(QIODevice::WriteOnly));
+        f.write("import QtQml 2.0\n"
+                "QtObject {\n"
+                "    function fib(n) { return n < 2 ? n : fib(n - 1) + fib(n - 2); }\n"
+                "    function guarded(n) { try { if (n < 0) throw n; return n; } catch (e) { return -e; } }\n"
+                "    property int result: fib(15) + guarded(-5)\n"
+                "}");
+    }
+    const QUrl url = QUrl::fromLocalFile(testFilePath);
+    const QString jitCacheFilePath = QV4::JIT::CodeCache::filePathForUnitCache(
+                QV4::CompiledData::CompilationUnit::localCacheFilePath(url));
+    QFile::remove(jitCacheFilePath);
+
+    auto callFunctions = [](QObject *obj) {
+        for (int i = 0; i < 5; ++i) {
+            QVariant result;
+            QVERIFY(QMetaObject::invokeMethod(obj, "guarded", Q_RETURN_ARG(QVariant, result), Q_ARG(QVariant, -i)));
+            QCOMPARE(result.toInt(), i);
+            QVERIFY(QMetaObject::invokeMethod(obj, "fib", Q_RETURN_ARG(QVariant, result), Q_ARG(QVariant, 10)));
+            QCOMPARE(result.toInt(), 55);
+        }
+    };
+
+    {
+        QQmlEngine engine;
+        CleanlyLoadingComponent component(&engine, url);
+        QScopedPointer<QObject> obj(component.create());
+        QVERIFY(!obj.isNull());
+        QCOMPARE(obj->property("result").toInt(), 615);
+        callFunctions(obj.data());
+        if (QTest::currentTestFailed())
+            return;
+    }
+
+    // the code is written when the compilation unit goes away with the engine
+    QVERIFY(QFile::exists(jitCacheFilePath));
+
+    {
+        QQmlEngine engine;
+        CleanlyLoadingComponent component(&engine, url);
+        QScopedPointer<QObject> obj(component.create());
+        QVERIFY(!obj.isNull());
+
+        auto compilationUnit = QQmlComponentPrivate::get(&component)->compilationUnit;
+        QVERIFY(compilationUnit);
+        QVERIFY(!compilationUnit->jitCodeCache.isNull());
+        int precompiled = 0;
+        for (QV4::Function *f : compilationUnit->runtimeFunctions) {
+            if (f->jittedCode)
+                ++precompiled;
+        }
+        QVERIFY(precompiled >= 2);
+
+        QCOMPARE(obj->property("result").toInt(), 615);
+        callFunctions(obj.data());
+        if (QTest::currentTestFailed())
+            return;
+    }
+#endif
+}
+
 QTEST_MAIN(tst_qmldiskcache)
 
 #include "tst_qmldiskcache.moc"
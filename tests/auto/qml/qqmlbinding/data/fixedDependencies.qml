@@ -0,0 +1,18 @@
+import QtQml 2.0
+
+QtObject {
+    id: root
+
+    property int input: 1
+    property int margin: 4
+    property bool flag: true
+
+    property QtObject source: QtObject {
+        id: source
+        property int width: 10
+        property int height: 20
+    }
+
+    property int fixed: source.width * 2 + source.height + margin + input
+    property int conditional: flag ? source.width : source.height
+}
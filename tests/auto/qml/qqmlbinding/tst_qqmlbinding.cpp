@@ -29,6 +29,9 @@
 #include <QtQml/qqmlengine.h>
 #include <QtQml/qqmlcomponent.h>
 #include <private/qqmlbind_p.h>
+#include <private/qqmlbinding_p.h>
+#include <private/qqmlproperty_p.h>
+#include <private/qv4function_p.h>
 #include <QtQuick/private/qquickrectangle_p.h>
 #include "../../shared/util.h"
 
@@ -51,6 +54,9 @@ private slots:
     void disabledOnReadonlyProperty();
     void delayed();
     void bindingOverwriting();
+    void fixedDependencies();
+    void fixedDependenciesRecapture();
+    void conditionalDependencies();
 
 private:
     QQmlEngine engine;
@@ -319,6 +325,101 @@ void tst_qqmlbinding::bindingOverwriting()
     QCOMPARE(messageHandler.messages().count(), 2);
 }
 
+static QQmlBinding *bindingOf(QObject *object, const char *name)
+{
+    return static_cast<QQmlBinding *>(QQmlPropertyPrivate::binding(QQmlProperty(object, QLatin1String(name))));
+}
+
+void tst_qqmlbinding::fixedDependencies()
+{
+    QQmlEngine engine;
+    QQmlComponent c(&engine, testFileUrl("fixedDependencies.qml"));
+    QScopedPointer<QObject> root(c.create());
+    QVERIFY2(root, qPrintable(c.errorString()));
+    QObject *source = root->property("source").value<QObject *>();
+    QVERIFY(source);
+
+    QQmlBinding *binding = bindingOf(root.data(), "fixed");
+    QVERIFY(binding && binding->function());
+    QVERIFY(binding->function()->hasFixedQmlDependencies());
+    QCOMPARE(root->property("fixed").toInt(), 45);
+
+    // The guards captured on the first evaluation have to cover every dependency
+    source->setProperty("width", 11);
+    QCOMPARE(root->property("fixed").toInt(), 47);
+    source->setProperty("height", 25);
+    QCOMPARE(root->property("fixed").toInt(), 52);
+    root->setProperty("margin", 5);
+    QCOMPARE(root->property("fixed").toInt(), 53);
+    root->setProperty("input", 2);
+    QCOMPARE(root->property("fixed").toInt(), 54);
+
+    // ... also after several re-evaluations that skipped the capture
+    source->setProperty("width", 1);
+    source->setProperty("width", 2);
+    QCOMPARE(root->property("fixed").toInt(), 36);
+}
+
+void tst_qqmlbinding::fixedDependenciesRecapture()
+{
+    QQmlEngine engine;
+    QQmlComponent c(&engine, testFileUrl("fixedDependencies.qml"));
+    QScopedPointer<QObject> root(c.create());
+    QVERIFY2(root, qPrintable(c.errorString()));
+    QObject *source = root->property("source").value<QObject *>();
+    QVERIFY(source);
+
+    QQmlBinding *binding = bindingOf(root.data(), "fixed");
+    QVERIFY(binding);
+    QCOMPARE(root->property("fixed").toInt(), 45);
+
+    // Without guards the binding is not notified, but the next evaluation captures again
+    binding->clearActiveGuards();
+    source->setProperty("width", 11);
+    QCOMPARE(root->property("fixed").toInt(), 45);
+    binding->update();
+    QCOMPARE(root->property("fixed").toInt(), 47);
+    source->setProperty("width", 12);
+    QCOMPARE(root->property("fixed").toInt(), 49);
+    root->setProperty("margin", 5);
+    QCOMPARE(root->property("fixed").toInt(), 50);
+
+    // Disabling the binding drops its guards, enabling it has to capture them again
+    binding->setEnabled(false);
+    source->setProperty("height", 25);
+    QCOMPARE(root->property("fixed").toInt(), 50);
+    binding->setEnabled(true);
+    QCOMPARE(root->property("fixed").toInt(), 55);
+    source->setProperty("height", 30);
+    QCOMPARE(root->property("fixed").toInt(), 60);
+    root->setProperty("input", 2);
+    QCOMPARE(root->property("fixed").toInt(), 61);
+}
+
+void tst_qqmlbinding::conditionalDependencies()
+{
+    QQmlEngine engine;
+    QQmlComponent c(&engine, testFileUrl("fixedDependencies.qml"));
+    QScopedPointer<QObject> root(c.create());
+    QVERIFY2(root, qPrintable(c.errorString()));
+    QObject *source = root->property("source").value<QObject *>();
+    QVERIFY(source);
+
+    QQmlBinding *binding = bindingOf(root.data(), "conditional");
+    QVERIFY(binding && binding->function());
+    QVERIFY(!binding->function()->hasFixedQmlDependencies());
+
+    QCOMPARE(root->property("conditional").toInt(), 10);
+    root->setProperty("flag", false);
+    QCOMPARE(root->property("conditional").toInt(), 20);
+    // height was only read after the branch switched, so it must have been captured then
+    source->setProperty("height", 25);
+    QCOMPARE(root->property("conditional").toInt(), 25);
+    root->setProperty("flag", true);
+    source->setProperty("width", 11);
+    QCOMPARE(root->property("conditional").toInt(), 11);
+}
+
 QTEST_MAIN(tst_qqmlbinding)
 
 #include "tst_qqmlbinding.moc"
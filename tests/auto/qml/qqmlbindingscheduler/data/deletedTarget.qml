@@ -0,0 +1,9 @@
+import QtQml 2.0
+
+QtObject {
+    id: root
+    property int source: 0
+    property QtObject target: QtObject {
+        property int value: root.source
+    }
+}
@@ -0,0 +1,7 @@
+import QtQml 2.0
+
+QtObject {
+    property bool loop: false
+    property int a: loop ? b + 1 : 0
+    property int b: a + 1
+}
@@ -0,0 +1,11 @@
+CONFIG += testcase
+TARGET = tst_qqmlbindingscheduler
+macx:CONFIG -= app_bundle
+
+SOURCES += tst_qqmlbindingscheduler.cpp
+
+include (../../shared/util.pri)
+
+TESTDATA = data/*
+
+QT += core-private qml-private testlib
@@ -0,0 +1,117 @@
+/****************************************************************************
+**
+** Copyright (C) 2019 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+#include <qtest.h>
+#include <QtTest/QSignalSpy>
+#include <QtQml/qqmlengine.h>
+#include <QtQml/qqmlcomponent.h>
+#include <private/qqmlbindingscheduler_p.h>
+#include "../../shared/util.h"
+
+class tst_qqmlbindingscheduler : public QQmlDataTest
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase() override;
+
+    void topologicalOrder();
+    void bindingLoop();
+    void deletedTarget();
+};
+
+void tst_qqmlbindingscheduler::initTestCase()
+{
+    // Must be set before the first binding is notified, the option is read only once.
+    qputenv("QML_BATCHED_BINDING_UPDATES", "1");
+    QQmlDataTest::initTestCase();
+    QVERIFY(QQmlBindingScheduler::isEnabled());
+}
+
+void tst_qqmlbindingscheduler::topologicalOrder()
+{
+    QQmlEngine engine;
+    QQmlComponent component(&engine, testFileUrl("fanIn.qml"));
+    QScopedPointer<QObject> object(component.create());
+    QVERIFY2(object, qPrintable(component.errorString()));
+    QQmlBindingScheduler::flushCurrentThread();
+    QCOMPARE(object->property("sum").toInt(), 3);
+
+    QSignalSpy sumSpy(object.data(), SIGNAL(sumChanged()));
+    object->setProperty("source", 10);
+    // Nothing is evaluated before the flush.
+    QCOMPARE(object->property("a").toInt(), 1);
+    QCOMPARE(sumSpy.count(), 0);
+
+    QQmlBindingScheduler::flushCurrentThread();
+    QCOMPARE(object->property("a").toInt(), 11);
+    QCOMPARE(object->property("b").toInt(), 12);
+    QCOMPARE(object->property("sum").toInt(), 23);
+    // sum depends on both a and b, and is evaluated once, after both of them.
+    QCOMPARE(sumSpy.count(), 1);
+}
+
+void tst_qqmlbindingscheduler::bindingLoop()
+{
+    QQmlEngine engine;
+    QQmlComponent component(&engine, testFileUrl("loop.qml"));
+    QScopedPointer<QObject> object(component.create());
+    QVERIFY2(object, qPrintable(component.errorString()));
+    QQmlBindingScheduler::flushCurrentThread();
+
+    object->setProperty("loop", true);
+    QTest::ignoreMessage(QtWarningMsg, QRegularExpression(
+            QLatin1String("loop\\.qml:\\d+:\\d+: QML QtObject: Binding loop detected: .+ -> .+")));
+    QQmlBindingScheduler::flushCurrentThread();
+
+    // The loop is cut off instead of evaluating the bindings over and over.
+    const int a = object->property("a").toInt();
+    const int b = object->property("b").toInt();
+    QVERIFY(a > 0);
+    QVERIFY(qAbs(a - b) == 1);
+}
+
+void tst_qqmlbindingscheduler::deletedTarget()
+{
+    QQmlEngine engine;
+    QQmlComponent component(&engine, testFileUrl("deletedTarget.qml"));
+    QScopedPointer<QObject> object(component.create());
+    QVERIFY2(object, qPrintable(component.errorString()));
+    QQmlBindingScheduler::flushCurrentThread();
+    QObject *target = object->property("target").value<QObject *>();
+    QVERIFY(target);
+
+    object->setProperty("source", 5);
+    delete target;
+    // The binding on the deleted object must be dropped from the queue.
+    QQmlBindingScheduler::flushCurrentThread();
+    QCOMPARE(object->property("source").toInt(), 5);
+}
+
+QTEST_MAIN(tst_qqmlbindingscheduler)
+
+#include "tst_qqmlbindingscheduler.moc"
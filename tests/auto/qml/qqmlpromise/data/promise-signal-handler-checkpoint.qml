@@ -0,0 +1,11 @@
+import QtQml 2.0
+
+QtObject {
+    property string log: ""
+    signal trigger()
+
+    onTrigger: {
+        Promise.resolve().then(function() { log += "then;" }).then(function() { log += "chained;" })
+        log += "handler;"
+    }
+}
@@ -43,4 +43,5 @@ DISTFILES += \
     data/promise-resolve-with-empty.qml \
     data/promise-executor-throw-exception.qml \
     data/promise-executor-function-extensible.qml \
-    data/promise-all-noniterable-input.qml
+    data/promise-all-noniterable-input.qml \
+    data/promise-signal-handler-checkpoint.qml
@@ -82,6 +82,9 @@ private slots:
     void then_fulfilled_non_callable();
     void then_reject_non_callable();
     void then_resolve_multiple_then();
+    void evaluate_checkpoint();
+    void signal_handler_checkpoint();
+    void reaction_throw_rejects();
 
 private:
     void execute_test(QString testName);
@@ -259,6 +262,44 @@ void tst_qqmlpromise::then_resolve_multiple_then()
     execute_test("then-resolve-multiple-then.qml");
 }
 
+void tst_qqmlpromise::evaluate_checkpoint()
+{
+    // Reactions run after the script, but before evaluate() returns.
+    QJSEngine engine;
+    engine.evaluate("var log = [];"
+                    "Promise.resolve(1).then(function(v) { log.push(v); return v + 1; })"
+                    "                  .then(function(v) { log.push(v); });"
+                    "log.push(0);");
+    QCOMPARE(engine.globalObject().property("log").toVariant().toStringList().join(','),
+             QStringLiteral("0,1,2"));
+}
+
+void tst_qqmlpromise::signal_handler_checkpoint()
+{
+    QQmlEngine engine;
+    QQmlComponent component(&engine, testFileUrl("promise-signal-handler-checkpoint.qml"));
+    QScopedPointer<QObject> object(component.create());
+    QVERIFY2(!object.isNull(), qPrintable(component.errorString()));
+
+    // Reactions queued by a signal handler run when the handler returns, without
+    // going back to the event loop.
+    QVERIFY(QMetaObject::invokeMethod(object.data(), "trigger"));
+    QCOMPARE(object->property("log").toString(), QStringLiteral("handler;then;chained;"));
+}
+
+void tst_qqmlpromise::reaction_throw_rejects()
+{
+    QJSEngine engine;
+    engine.evaluate("var result = 0; var nextReactionRan = false;"
+                    "Promise.resolve().then(function() { throw 42; })"
+                    "                 .catch(function(e) { result = e; });"
+                    "Promise.resolve().then(function() { nextReactionRan = true; });");
+    // The exception rejects the derived promise and does not leak into other reactions.
+    QCOMPARE(engine.globalObject().property("result").toInt(), 42);
+    QCOMPARE(engine.globalObject().property("nextReactionRan").toBool(), true);
+    QVERIFY(!engine.evaluate("1").isError());
+}
+
 void tst_qqmlpromise::execute_test(QString testName)
 {
     QQmlEngine engine;
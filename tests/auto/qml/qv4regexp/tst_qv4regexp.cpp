@@ -28,6 +28,10 @@
 
 #include <qtest.h>
 #include <QtQml/qjsengine.h>
+#include <private/qv4engine_p.h>
+#include <private/qv4regexp_p.h>
+#include <private/qv4regexpobject_p.h>
+#include <private/qv4scopedvalue_p.h>
 
 class tst_qv4regexp : public QObject
 {
@@ -35,6 +39,7 @@ class tst_qv4regexp : public QObject
 
 private slots:
     void catchJitFail();
+    void sharedByteCode();
 };
 
 void tst_qv4regexp::catchJitFail()
@@ -48,6 +53,41 @@ void tst_qv4regexp::catchJitFail()
     QVERIFY(result.toBool());
 }
 
+static QV4::RegExpByteCode *byteCode(QV4::Value *regExpObject)
+{
+    return regExpObject->as<QV4::RegExpObject>()->d()->value.get()->byteCode;
+}
+
+void tst_qv4regexp::sharedByteCode()
+{
+    // Patterns with backreferences are always interpreted, so they get bytecode.
+    const QString pattern = QStringLiteral("(a+)\\1");
+    QV4::RegExpByteCode *shared = nullptr;
+    {
+        QV4::ExecutionEngine engine1;
+        QV4::ExecutionEngine engine2;
+        QV4::Scope scope1(&engine1);
+        QV4::ScopedValue regExp1(scope1, engine1.newRegExpObject(pattern, 0));
+        QV4::Scope scope2(&engine2);
+        QV4::ScopedValue regExp2(scope2, engine2.newRegExpObject(pattern, 0));
+
+        shared = byteCode(regExp1);
+        QVERIFY(shared);
+        QCOMPARE(byteCode(regExp2), shared);
+        // One reference for each RegExp, and one for the cache.
+        QCOMPARE(shared->ref.load(), 3);
+    }
+
+    // The cache keeps the bytecode alive after the engines are gone.
+    QCOMPARE(shared->ref.load(), 1);
+
+    QV4::ExecutionEngine engine;
+    QV4::Scope scope(&engine);
+    QV4::ScopedValue regExp(scope, engine.newRegExpObject(pattern, 0));
+    QCOMPARE(byteCode(regExp), shared);
+    QCOMPARE(shared->ref.load(), 2);
+}
+
 QTEST_MAIN(tst_qv4regexp)
 
 #include "tst_qv4regexp.moc"
@@ -0,0 +1,7 @@
+CONFIG += testcase
+TARGET = tst_qv4sparsearray
+macos:CONFIG -= app_bundle
+
+SOURCES += tst_qv4sparsearray.cpp
+
+QT += qml qml-private testlib
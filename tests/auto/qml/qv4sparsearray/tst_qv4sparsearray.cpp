@@ -0,0 +1,486 @@
+/****************************************************************************
+**
+** Copyright (C) 2019 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#include <qtest.h>
+#include <QtCore/qrandom.h>
+#include <QtQml/qjsengine.h>
+#include <private/qv4sparsearray_p.h>
+
+#include <map>
+
+using QV4::SparseArray;
+
+typedef std::map<uint, uint> Reference;
+
+class tst_qv4sparsearray : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void appendInOrder();
+    void insertSplitsLeaves();
+    void eraseMergesLeaves();
+    void eraseFrom_data();
+    void eraseFrom();
+    void popFront();
+    void pushFront();
+    void randomOperations();
+    void copy();
+    void arrayOperations();
+};
+
+// Compares everything that can be observed from outside with the reference.
+static void verify(const SparseArray &array, const Reference &reference)
+{
+    QCOMPARE(array.nEntries(), uint(reference.size()));
+
+    Reference::const_iterator expected = reference.begin();
+    for (SparseArray::ConstIterator it = array.begin(); it != array.end(); ++it, ++expected) {
+        QVERIFY(expected != reference.end());
+        QCOMPARE(it.key(), expected->first);
+        QCOMPARE(it.value(), expected->second);
+    }
+    QVERIFY(expected == reference.end());
+
+    if (!reference.empty()) {
+        QCOMPARE(array.lastKey(), reference.rbegin()->first);
+        SparseArray::ConstIterator last = array.end();
+        --last;
+        QCOMPARE(last.key(), reference.rbegin()->first);
+    }
+
+    for (const auto &entry : reference) {
+        const uint *value = array.find(entry.first);
+        QVERIFY(value);
+        QCOMPARE(*value, entry.second);
+        if (entry.first && !reference.count(entry.first - 1))
+            QVERIFY(!array.find(entry.first - 1));
+        if (!reference.count(entry.first + 1))
+            QVERIFY(!array.find(entry.first + 1));
+
+        // lowerBound() of a key in a gap returns the next entry
+        SparseArray::ConstIterator lower = array.lowerBound(entry.first);
+        QVERIFY(lower != array.end());
+        QCOMPARE(lower.key(), entry.first);
+        if (entry.first && !reference.count(entry.first - 1)) {
+            lower = array.lowerBound(entry.first - 1);
+            QVERIFY(lower != array.end());
+            QCOMPARE(lower.key(), entry.first);
+        }
+    }
+    if (!reference.empty() && reference.rbegin()->first < UINT_MAX)
+        QVERIFY(array.lowerBound(reference.rbegin()->first + 1) == array.end());
+}
+
+static void insert(SparseArray &array, Reference &reference, uint key, uint value)
+{
+    *array.insert(key) = value;
+    reference[key] = value;
+}
+
+void tst_qv4sparsearray::appendInOrder()
+{
+    SparseArray array;
+    Reference reference;
+    QVERIFY(array.begin() == array.end());
+    QVERIFY(!array.find(0));
+
+    for (uint i = 0; i < 1000; ++i)
+        insert(array, reference, i * 3, i);
+    verify(array, reference);
+
+    // Existing entries are found again, not inserted twice
+    QCOMPARE(*array.insert(SparseArray::LeafCapacity * 3), uint(SparseArray::LeafCapacity));
+    QCOMPARE(array.nEntries(), 1000u);
+    QCOMPARE(*array.insert(1), UINT_MAX);
+    *array.find(1) = 1;
+    reference[1] = 1;
+    verify(array, reference);
+}
+
+void tst_qv4sparsearray::insertSplitsLeaves()
+{
+    // Filling in the gaps of full leaves splits them, at the start, in the
+    // middle and at the end of each leaf.
+    SparseArray array;
+    Reference reference;
+    const uint count = 4 * SparseArray::LeafCapacity;
+    for (uint i = 0; i < count; ++i)
+        insert(array, reference, i * 4 + 2, i);
+    verify(array, reference);
+
+    for (uint i = 0; i < count; i += SparseArray::LeafCapacity / 2) {
+        insert(array, reference, i * 4 + 1, 10000 + i);
+        insert(array, reference, i * 4 + 3, 20000 + i);
+        if (i)
+            insert(array, reference, i * 4 - 1, 30000 + i);
+    }
+    verify(array, reference);
+
+    insert(array, reference, 0, 40000);
+    for (uint i = 0; i < count * 4; ++i) {
+        if (!reference.count(i))
+            insert(array, reference, i, 50000 + i);
+    }
+    verify(array, reference);
+    QCOMPARE(array.nEntries(), count * 4);
+}
+
+void tst_qv4sparsearray::eraseMergesLeaves()
+{
+    SparseArray array;
+    Reference reference;
+    const uint count = 6 * SparseArray::LeafCapacity;
+    for (uint i = 0; i < count; ++i)
+        insert(array, reference, i, i);
+
+    QVERIFY(!array.erase(count));
+    QCOMPARE(array.nEntries(), count);
+
+    // Erase most of every leaf, so that neighbours are merged, starting at the
+    // leaf boundaries.
+    for (uint i = 0; i < count; ++i) {
+        if (i % 7 == 3)
+            continue;
+        QVERIFY(array.erase(i));
+        reference.erase(i);
+        if (i % SparseArray::LeafCapacity == 0 || i % SparseArray::LeafCapacity == SparseArray::LeafCapacity - 1)
+            verify(array, reference);
+    }
+    verify(array, reference);
+    QVERIFY(!array.erase(0));
+
+    for (uint i = 0; i < count; i += 7) {
+        insert(array, reference, i, i + 1);
+        verify(array, reference);
+    }
+
+    while (!reference.empty()) {
+        const uint key = reference.rbegin()->first;
+        QVERIFY(array.erase(key));
+        reference.erase(key);
+    }
+    verify(array, reference);
+    QVERIFY(array.begin() == array.end());
+    insert(array, reference, 5, 5);
+    verify(array, reference);
+}
+
+void tst_qv4sparsearray::eraseFrom_data()
+{
+    QTest::addColumn<uint>("key");
+
+    const uint leaf = SparseArray::LeafCapacity;
+    QTest::newRow("first entry") << 0u;
+    QTest::newRow("second entry") << 1u;
+    QTest::newRow("inside the first leaf") << 101u;
+    QTest::newRow("last entry of the first leaf") << (leaf - 1) * 2 + 1;
+    QTest::newRow("between leaves") << (leaf - 1) * 2 + 2;
+    QTest::newRow("first entry of the second leaf") << leaf * 2 + 1;
+    QTest::newRow("second entry of the second leaf") << leaf * 2 + 3;
+    QTest::newRow("inside a later leaf") << leaf * 10 + 7;
+    QTest::newRow("last entry") << 1999u;
+    QTest::newRow("after all") << 2000u;
+}
+
+void tst_qv4sparsearray::eraseFrom()
+{
+    QFETCH(uint, key);
+
+    SparseArray array;
+    Reference reference;
+    for (uint i = 0; i < 1000; ++i)
+        insert(array, reference, i * 2 + 1, i);
+    // Not all leaves are full, after filling in some gaps
+    for (uint i = 0; i < 1000; i += 50)
+        insert(array, reference, i * 2, 5000 + i);
+
+    array.eraseFrom(key);
+    reference.erase(reference.lower_bound(key), reference.end());
+    verify(array, reference);
+
+    // The array is still usable afterwards
+    insert(array, reference, key + 5, 1);
+    insert(array, reference, key / 2, 2);
+    verify(array, reference);
+}
+
+void tst_qv4sparsearray::popFront()
+{
+    SparseArray array;
+    Reference reference;
+    QCOMPARE(array.pop_front(), UINT_MAX);
+
+    const uint count = 3 * SparseArray::LeafCapacity;
+    for (uint i = 0; i < count; ++i)
+        insert(array, reference, i < SparseArray::LeafCapacity ? i : i * 2, i);
+
+    // Removes the entry at 0 and moves all others down by one, across leaves
+    for (uint i = 0; i < SparseArray::LeafCapacity + 2; ++i) {
+        const uint expected = reference.count(0) ? reference[0] : UINT_MAX;
+        QCOMPARE(array.pop_front(), expected);
+        Reference shifted;
+        for (const auto &entry : reference) {
+            if (entry.first)
+                shifted[entry.first - 1] = entry.second;
+        }
+        reference.swap(shifted);
+        if (i % 16 == 0 || i >= SparseArray::LeafCapacity - 2)
+            verify(array, reference);
+    }
+    verify(array, reference);
+}
+
+void tst_qv4sparsearray::pushFront()
+{
+    SparseArray array;
+    Reference reference;
+    array.push_front(7);
+    reference[0] = 7;
+    verify(array, reference);
+
+    for (uint i = 0; i < 2 * SparseArray::LeafCapacity; ++i)
+        insert(array, reference, 10 + i * 3, i);
+
+    for (uint i = 0; i < SparseArray::LeafCapacity + 2; ++i) {
+        array.push_front(1000 + i);
+        Reference shifted;
+        shifted[0] = 1000 + i;
+        for (const auto &entry : reference)
+            shifted[entry.first + 1] = entry.second;
+        reference.swap(shifted);
+        if (i % 16 == 0 || i >= SparseArray::LeafCapacity - 2)
+            verify(array, reference);
+    }
+    verify(array, reference);
+}
+
+void tst_qv4sparsearray::randomOperations()
+{
+    QRandomGenerator random(42);
+    SparseArray array;
+    Reference reference;
+
+    for (int round = 0; round < 20; ++round) {
+        // Keys from a range small enough to collide and to make leaves split and merge
+        for (int i = 0; i < 2000; ++i) {
+            const uint key = random.bounded(4000);
+            if (random.bounded(3)) {
+                insert(array, reference, key, uint(i));
+            } else {
+                QCOMPARE(array.erase(key), reference.erase(key) == 1);
+            }
+        }
+        verify(array, reference);
+        if (QTest::currentTestFailed())
+            return;
+
+        const uint cut = random.bounded(5000);
+        array.eraseFrom(cut);
+        reference.erase(reference.lower_bound(cut), reference.end());
+        verify(array, reference);
+        if (QTest::currentTestFailed())
+            return;
+    }
+}
+
+void tst_qv4sparsearray::copy()
+{
+    SparseArray array;
+    Reference reference;
+    for (uint i = 0; i < 5 * SparseArray::LeafCapacity; ++i)
+        insert(array, reference, i * 5, i);
+    for (uint i = 0; i < 5 * SparseArray::LeafCapacity; i += 3) {
+        array.erase(i * 5);
+        reference.erase(i * 5);
+    }
+
+    SparseArray copy(array);
+    verify(copy, reference);
+
+    // The copy is independent of the original
+    Reference copyReference = reference;
+    insert(copy, copyReference, 1, 1);
+    copy.eraseFrom(SparseArray::LeafCapacity * 10);
+    copyReference.erase(copyReference.lower_bound(SparseArray::LeafCapacity * 10), copyReference.end());
+    verify(copy, copyReference);
+    verify(array, reference);
+}
+
+void tst_qv4sparsearray::arrayOperations()
+{
+    // Array operations on sparse arrays spanning several leaves, compared with a
+    // model of their effect on the indexes.
+    QJSEngine engine;
+    QJSValue result = engine.evaluate(
+            "(function() {\n"
+            "    function create() {\n"
+            "        var a = [];\n"
+            "        var model = { length: 2000000, entries: new Map() };\n"
+            "        a.length = model.length;\n"
+            "        for (var i = 0; i < 600; ++i) {\n"
+            "            var index = i * 3 + (i % 2) * 1000000;\n"
+            "            a[index] = 'v' + i;\n"
+            "            model.entries.set(index, 'v' + i);\n"
+            "        }\n"
+            "        return [a, model];\n"
+            "    }\n"
+            "    function describeArray(a) {\n"
+            "        return [a.length].concat(Object.keys(a).map(function(k) { return k + ':' + a[k]; })).join();\n"
+            "    }\n"
+            "    function describeModel(model) {\n"
+            "        var keys = Array.from(model.entries.keys()).sort(function(x, y) { return x - y; });\n"
+            "        return [model.length].concat(keys.map(function(k) { return k + ':' + model.entries.get(k); })).join();\n"
+            "    }\n"
+            "    // Moves all entries at or after from by delta.\n"
+            "    function move(model, from, delta) {\n"
+            "        var entries = new Map();\n"
+            "        model.entries.forEach(function(v, k) { entries.set(k >= from ? k + delta : k, v); });\n"
+            "        model.entries = entries;\n"
+            "        model.length += delta;\n"
+            "    }\n"
+            "    function truncate(model, length) {\n"
+            "        model.entries.forEach(function(v, k) { if (k >= length) model.entries.delete(k); });\n"
+            "        model.length = length;\n"
+            "    }\n"
+            "    function check(name, onArray, onModel) {\n"
+            "        var created = create();\n"
+            "        var a = onArray(created[0]);\n"
+            "        var b = onModel(created[1]);\n"
+            "        if (String(a) !== String(b))\n"
+            "            throw name + ' returned ' + a + ' instead of ' + b;\n"
+            "        a = describeArray(created[0]);\n"
+            "        b = describeModel(created[1]);\n"
+            "        if (a !== b)\n"
+            "            throw name + ': ' + a.substring(0, 300) + ' instead of ' + b.substring(0, 300);\n"
+            "    }\n"
+            "\n"
+            "    check('shift', function(a) {\n"
+            "        var r = [];\n"
+            "        for (var i = 0; i < 200; ++i)\n"
+            "            r.push(a.shift());\n"
+            "        return r;\n"
+            "    }, function(model) {\n"
+            "        var r = [];\n"
+            "        for (var i = 0; i < 200; ++i) {\n"
+            "            r.push(model.entries.get(0));\n"
+            "            model.entries.delete(0);\n"
+            "            move(model, 1, -1);\n"
+            "        }\n"
+            "        return r;\n"
+            "    });\n"
+            "    check('unshift', function(a) {\n"
+            "        for (var i = 0; i < 200; ++i)\n"
+            "            a.unshift('u' + i, i);\n"
+            "        return a.length;\n"
+            "    }, function(model) {\n"
+            "        for (var i = 0; i < 200; ++i) {\n"
+            "            move(model, 0, 2);\n"
+            "            model.entries.set(0, 'u' + i);\n"
+            "            model.entries.set(1, i);\n"
+            "        }\n"
+            "        return model.length;\n"
+            "    });\n"
+            "    check('truncate', function(a) {\n"
+            "        a.length = 1000100;\n"
+            "        a.length = 200;\n"
+            "        return a.length;\n"
+            "    }, function(model) {\n"
+            "        truncate(model, 1000100);\n"
+            "        truncate(model, 200);\n"
+            "        return model.length;\n"
+            "    });\n"
+            "    check('delete', function(a) {\n"
+            "        for (var i = 0; i < 1800; i += 2)\n"
+            "            delete a[i];\n"
+            "        return a.indexOf('v1') + ' ' + a.indexOf('v3');\n"
+            "    }, function(model) {\n"
+            "        for (var i = 0; i < 1800; i += 2)\n"
+            "            model.entries.delete(i);\n"
+            "        return '1000003 1000009';\n"
+            "    });\n"
+            "    check('pop', function(a) {\n"
+            "        a.length = 1000600;\n"
+            "        return [a.pop(), a.pop(), a.pop()];\n"
+            "    }, function(model) {\n"
+            "        truncate(model, 1000600);\n"
+            "        var r = [];\n"
+            "        for (var i = 0; i < 3; ++i) {\n"
+            "            r.push(model.entries.get(model.length - 1));\n"
+            "            truncate(model, model.length - 1);\n"
+            "        }\n"
+            "        return r;\n"
+            "    });\n"
+            "    check('splice', function(a) {\n"
+            "        a.length = 1800;\n"
+            "        return describeArray(a.splice(100, 300, 'x', 'y'));\n"
+            "    }, function(model) {\n"
+            "        truncate(model, 1800);\n"
+            "        var removed = { length: 300, entries: new Map() };\n"
+            "        model.entries.forEach(function(v, k) {\n"
+            "            if (k >= 100 && k < 400) {\n"
+            "                removed.entries.set(k - 100, v);\n"
+            "                model.entries.delete(k);\n"
+            "            }\n"
+            "        });\n"
+            "        move(model, 400, -298);\n"
+            "        model.entries.set(100, 'x');\n"
+            "        model.entries.set(101, 'y');\n"
+            "        return describeModel(removed);\n"
+            "    });\n"
+            "    check('sort', function(a) {\n"
+            "        a.length = 1800;\n"
+            "        a.sort();\n"
+            "        return a.length;\n"
+            "    }, function(model) {\n"
+            "        truncate(model, 1800);\n"
+            "        var values = Array.from(model.entries.values()).sort();\n"
+            "        model.entries = new Map();\n"
+            "        values.forEach(function(v, i) { model.entries.set(i, v); });\n"
+            "        return model.length;\n"
+            "    });\n"
+            "    check('reverse', function(a) {\n"
+            "        a.length = 1800;\n"
+            "        a.reverse();\n"
+            "        return a[1799];\n"
+            "    }, function(model) {\n"
+            "        truncate(model, 1800);\n"
+            "        var entries = new Map();\n"
+            "        model.entries.forEach(function(v, k) { entries.set(1799 - k, v); });\n"
+            "        model.entries = entries;\n"
+            "        return 'v0';\n"
+            "    });\n"
+            "    return 'ok';\n"
+            "})()");
+    QCOMPARE(result.toString(), QStringLiteral("ok"));
+}
+
+QTEST_MAIN(tst_qv4sparsearray)
+
+#include "tst_qv4sparsearray.moc"
@@ -0,0 +1,61 @@
+/****************************************************************************
+**
+** Copyright (C) 2016 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+import QtQuick 2.13
+
+Item {
+    width: 200
+    height: 200
+
+    property alias rect: rect
+    property alias running: group.running
+
+    Rectangle {
+        id: rect
+        width: 20
+        height: 20
+        color: "red"
+
+        ParallelAnimation {
+            id: group
+            running: true
+
+            WidthAnimator { target: rect; to: 100; duration: 200 }
+            HeightAnimator { target: rect; to: 50; duration: 200 }
+            ColorAnimator { target: rect; to: "blue"; duration: 200 }
+            PathAnimator {
+                target: rect
+                duration: 200
+                path: Path {
+                    startX: 0; startY: 0
+                    PathLine { x: 60; y: 40 }
+                }
+            }
+        }
+    }
+}
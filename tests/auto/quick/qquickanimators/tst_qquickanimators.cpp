@@ -27,9 +27,11 @@
 ****************************************************************************/
 
 #include <qtest.h>
+#include <QtTest/QSignalSpy>
 
 #include <QtQuick>
 #include <private/qquickanimator_p.h>
+#include <private/qquickrectangle_p.h>
 #include <private/qquickrepeater_p.h>
 #include <private/qquicktransition_p.h>
 
@@ -43,6 +45,8 @@ private slots:
     void testMultiWinAnimator_data();
     void testMultiWinAnimator();
     void testTransitions();
+    void testNewAnimators();
+    void testNewAnimatorsWhileRunning();
 };
 
 void tst_Animators::testMultiWinAnimator_data()
@@ -119,6 +123,65 @@ void tst_Animators::testTransitions()
     QCOMPARE(child->scale(), qreal(1.0));
 }
 
+void tst_Animators::testNewAnimators()
+{
+    QQuickView view(QUrl::fromLocalFile("data/newAnimators.qml"));
+    view.show();
+    QVERIFY(QTest::qWaitForWindowExposed(&view));
+    QVERIFY(view.rootObject());
+
+    QQuickRectangle *rect = view.rootObject()->property("rect").value<QQuickRectangle *>();
+    QVERIFY(rect);
+
+    QTRY_VERIFY(!view.rootObject()->property("running").toBool());
+    QCOMPARE(rect->width(), qreal(100));
+    QCOMPARE(rect->height(), qreal(50));
+    QCOMPARE(rect->color(), QColor(Qt::blue));
+    QCOMPARE(rect->position(), QPointF(60, 40));
+}
+
+void tst_Animators::testNewAnimatorsWhileRunning()
+{
+    QQuickView view(QUrl::fromLocalFile("data/newAnimatorsRunning.qml"));
+    view.show();
+    QVERIFY(QTest::qWaitForWindowExposed(&view));
+    QVERIFY(view.rootObject());
+
+    QQuickRectangle *rect = view.rootObject()->property("rect").value<QQuickRectangle *>();
+    QVERIFY(rect);
+
+    QSignalSpy widthSpy(rect, SIGNAL(widthChanged()));
+    QSignalSpy heightSpy(rect, SIGNAL(heightChanged()));
+    QSignalSpy colorSpy(rect, SIGNAL(colorChanged()));
+    QSignalSpy xSpy(rect, SIGNAL(xChanged()));
+    QSignalSpy frameSpy(&view, SIGNAL(frameSwapped()));
+
+    view.rootObject()->setProperty("running", true);
+
+    // Only the scene graph nodes are animated, the item keeps its values until the end
+    QTRY_VERIFY(frameSpy.count() >= 3);
+    QVERIFY(view.rootObject()->property("running").toBool());
+    QCOMPARE(rect->width(), qreal(20));
+    QCOMPARE(rect->height(), qreal(20));
+    QCOMPARE(rect->color(), QColor(Qt::red));
+    QCOMPARE(rect->position(), QPointF(0, 0));
+    QCOMPARE(widthSpy.count(), 0);
+    QCOMPARE(heightSpy.count(), 0);
+    QCOMPARE(colorSpy.count(), 0);
+    QCOMPARE(xSpy.count(), 0);
+
+    // and jumps to the final values when the animation has finished
+    QTRY_VERIFY(!view.rootObject()->property("running").toBool());
+    QCOMPARE(rect->width(), qreal(100));
+    QCOMPARE(rect->height(), qreal(50));
+    QCOMPARE(rect->color(), QColor(Qt::blue));
+    QCOMPARE(rect->position(), QPointF(60, 40));
+    QCOMPARE(widthSpy.count(), 1);
+    QCOMPARE(heightSpy.count(), 1);
+    QCOMPARE(colorSpy.count(), 1);
+    QCOMPARE(xSpy.count(), 1);
+}
+
 #include "tst_qquickanimators.moc"
 
 QTEST_MAIN(tst_Animators)
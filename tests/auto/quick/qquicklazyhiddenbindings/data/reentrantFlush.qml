@@ -0,0 +1,24 @@
+import QtQuick 2.0
+
+Item {
+    id: root
+    property int value: 0
+
+    Item {
+        id: container
+        objectName: "container"
+
+        Item {
+            id: child
+            objectName: "child"
+            // Reading grandChild.value flushes its pending binding from within this one.
+            property bool sawVisible: grandChild.value === root.value && grandChild.visible
+
+            Item {
+                id: grandChild
+                objectName: "grandChild"
+                property int value: root.value
+            }
+        }
+    }
+}
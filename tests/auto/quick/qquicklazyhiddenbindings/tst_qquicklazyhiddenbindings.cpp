@@ -0,0 +1,89 @@
+/****************************************************************************
+**
+** Copyright (C) 2019 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+#include <qtest.h>
+#include <QtTest/QSignalSpy>
+#include <QtQml/qqmlengine.h>
+#include <QtQml/qqmlcomponent.h>
+#include <QtQuick/qquickitem.h>
+#include <private/qqmldata_p.h>
+#include "../../shared/util.h"
+
+class tst_qquicklazyhiddenbindings : public QQmlDataTest
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase() override;
+
+    void reentrantFlush();
+};
+
+void tst_qquicklazyhiddenbindings::initTestCase()
+{
+    // Must be set before the first item changes its visibility, the option is read only once.
+    qputenv("QML_LAZY_HIDDEN_BINDINGS", "1");
+    QQmlDataTest::initTestCase();
+}
+
+void tst_qquicklazyhiddenbindings::reentrantFlush()
+{
+    QQmlEngine engine;
+    QQmlComponent component(&engine, testFileUrl("reentrantFlush.qml"));
+    QScopedPointer<QObject> root(component.create());
+    QVERIFY2(root, qPrintable(component.errorString()));
+
+    QQuickItem *container = root->findChild<QQuickItem *>("container");
+    QQuickItem *child = root->findChild<QQuickItem *>("child");
+    QQuickItem *grandChild = root->findChild<QQuickItem *>("grandChild");
+    QVERIFY(container && child && grandChild);
+    QCOMPARE(child->property("sawVisible").toBool(), true);
+
+    container->setVisible(false);
+    QVERIFY(QQmlData::get(child)->bindingUpdatesSuspended);
+    QVERIFY(QQmlData::get(grandChild)->bindingUpdatesSuspended);
+    QVERIFY(!QQmlData::get(container)->bindingUpdatesSuspended);
+
+    root->setProperty("value", 42);
+    // Reading the property from C++ does not flush, so the old values are still there.
+    QCOMPARE(grandChild->property("value").toInt(), 0);
+
+    QSignalSpy sawVisibleSpy(child, SIGNAL(sawVisibleChanged()));
+    container->setVisible(true);
+    QVERIFY(!QQmlData::get(child)->bindingUpdatesSuspended);
+    QVERIFY(!QQmlData::get(grandChild)->bindingUpdatesSuspended);
+
+    // The pending bindings are only evaluated once the whole subtree is visible again,
+    // so sawVisible never observes the hidden grandChild.
+    QCOMPARE(grandChild->property("value").toInt(), 42);
+    QCOMPARE(child->property("sawVisible").toBool(), true);
+    QCOMPARE(sawVisibleSpy.count(), 0);
+}
+
+QTEST_MAIN(tst_qquicklazyhiddenbindings)
+
+#include "tst_qquicklazyhiddenbindings.moc"
@@ -0,0 +1,22 @@
+import QtQuick 2.9
+import tst_qquickpathitem 1.0
+
+Item {
+    width: 200
+    height: 150
+
+    // The path reaches far outside of the shape's bounding rect.
+    Shape {
+        objectName: "pathItem"
+        width: 10
+        height: 10
+
+        ShapePath {
+            fillColor: "red"
+            startX: 0; startY: 0
+            PathLine { x: 150; y: 0 }
+            PathLine { x: 150; y: 100 }
+            PathLine { x: 0; y: 0 }
+        }
+    }
+}
@@ -34,6 +34,8 @@
 #include <QtQml/qqmlexpression.h>
 #include <QtQml/qqmlincubator.h>
 #include <QtQuickShapes/private/qquickshape_p.h>
+#include <QtQuick/private/qquickhittestindex_p.h>
+#include <QtQuick/private/qquickwindow_p.h>
 
 #include "../../shared/util.h"
 #include "../shared/viewtestutil.h"
@@ -57,6 +59,7 @@ private slots:
     void renderWithMultipleSp();
     void radialGrad();
     void conicalGrad();
+    void containsModeHitTestIndex();
 };
 
 tst_QQuickShape::tst_QQuickShape()
@@ -311,6 +314,32 @@ void tst_QQuickShape::conicalGrad()
              qPrintable(errorMessage));
 }
 
+void tst_QQuickShape::containsModeHitTestIndex()
+{
+    QScopedPointer<QQuickView> window(createView());
+    QQuickWindowPrivate *windowPrivate = QQuickWindowPrivate::get(window.data());
+    windowPrivate->setHitTestIndexEnabled(true);
+
+    window->setSource(testFileUrl("hittest.qml"));
+    qApp->processEvents();
+
+    QQuickItem *root = window->rootObject();
+    QQuickShape *shape = findItem<QQuickShape>(root, "pathItem");
+    QVERIFY(shape);
+
+    const QPointF insidePath(100, 60);
+    QVERIFY(!shape->contains(insidePath));
+    QVERIFY(!windowPrivate->hitTestIndex->childItemsAt(root, insidePath).contains(shape));
+
+    // With FillContains, the shape is hit outside of its bounding rect.
+    shape->setContainsMode(QQuickShape::FillContains);
+    QVERIFY(shape->contains(insidePath));
+    QVERIFY(windowPrivate->hitTestIndex->childItemsAt(root, insidePath).contains(shape));
+
+    shape->setContainsMode(QQuickShape::BoundingRectContains);
+    QVERIFY(!windowPrivate->hitTestIndex->childItemsAt(root, insidePath).contains(shape));
+}
+
 QTEST_MAIN(tst_QQuickShape)
 
 #include "tst_qquickshape.moc"
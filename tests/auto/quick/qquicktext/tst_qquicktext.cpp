@@ -42,6 +42,7 @@
 #include <private/qguiapplication_p.h>
 #include <limits.h>
 #include <QtGui/QMouseEvent>
+#include <QtCore/QThread>
 #include "../../shared/util.h"
 #include "testhttpserver.h"
 
@@ -161,6 +162,10 @@ private slots:
 
     void initialContentHeight();
 
+    void sharedLayout();
+    void asynchronousLayout();
+    void asynchronousShortText();
+
 private:
     QStringList standard;
     QStringList richText;
@@ -778,16 +783,16 @@ void tst_qquicktext::textFormat()
         QVERIFY(textPrivate);
 
         QCOMPARE(text->textFormat(), QQuickText::AutoText);
-        QVERIFY(!textPrivate->layout.formats().isEmpty());
+        QVERIFY(!textPrivate->layout->formats().isEmpty());
 
         text->setTextFormat(QQuickText::StyledText);
-        QVERIFY(!textPrivate->layout.formats().isEmpty());
+        QVERIFY(!textPrivate->layout->formats().isEmpty());
 
         text->setTextFormat(QQuickText::PlainText);
-        QVERIFY(textPrivate->layout.formats().isEmpty());
+        QVERIFY(textPrivate->layout->formats().isEmpty());
 
         text->setTextFormat(QQuickText::AutoText);
-        QVERIFY(!textPrivate->layout.formats().isEmpty());
+        QVERIFY(!textPrivate->layout->formats().isEmpty());
     }
 
     {
@@ -808,9 +813,9 @@ void tst_qquicktext::textFormat()
         formats << range;
 
         // the mnemonic format should be retained
-        textPrivate->layout.setFormats(formats);
+        textPrivate->layout->setFormats(formats);
         text->forceLayout();
-        QCOMPARE(textPrivate->layout.formats(), formats);
+        QCOMPARE(textPrivate->layout->formats(), formats);
 
         // and carried over to the elide layout
         text->setWidth(text->implicitWidth() - 1);
@@ -820,7 +825,7 @@ void tst_qquicktext::textFormat()
         // but cleared when the text changes
         text->setText("Changed");
         QVERIFY(textPrivate->elideLayout);
-        QVERIFY(textPrivate->layout.formats().isEmpty());
+        QVERIFY(textPrivate->layout->formats().isEmpty());
     }
 }
 
@@ -871,24 +876,24 @@ void tst_qquicktext::horizontalAlignment_RightToLeft()
     QQuickTextPrivate *textPrivate = QQuickTextPrivate::get(text);
     QVERIFY(textPrivate != nullptr);
 
-    QTRY_VERIFY(textPrivate->layout.lineCount());
+    QTRY_VERIFY(textPrivate->layout->lineCount());
 
     // implicit alignment should follow the reading direction of RTL text
     QCOMPARE(text->hAlign(), QQuickText::AlignRight);
     QCOMPARE(text->effectiveHAlign(), text->hAlign());
-    QVERIFY(textPrivate->layout.lineAt(0).naturalTextRect().left() > window->width()/2);
+    QVERIFY(textPrivate->layout->lineAt(0).naturalTextRect().left() > window->width()/2);
 
     // explicitly left aligned text
     text->setHAlign(QQuickText::AlignLeft);
     QCOMPARE(text->hAlign(), QQuickText::AlignLeft);
     QCOMPARE(text->effectiveHAlign(), text->hAlign());
-    QVERIFY(textPrivate->layout.lineAt(0).naturalTextRect().left() < window->width()/2);
+    QVERIFY(textPrivate->layout->lineAt(0).naturalTextRect().left() < window->width()/2);
 
     // explicitly right aligned text
     text->setHAlign(QQuickText::AlignRight);
     QCOMPARE(text->hAlign(), QQuickText::AlignRight);
     QCOMPARE(text->effectiveHAlign(), text->hAlign());
-    QVERIFY(textPrivate->layout.lineAt(0).naturalTextRect().left() > window->width()/2);
+    QVERIFY(textPrivate->layout->lineAt(0).naturalTextRect().left() > window->width()/2);
 
     // change to rich text
     QString textString = text->text();
@@ -921,13 +926,13 @@ void tst_qquicktext::horizontalAlignment_RightToLeft()
     text->setHAlign(QQuickText::AlignHCenter);
     QCOMPARE(text->hAlign(), QQuickText::AlignHCenter);
     QCOMPARE(text->effectiveHAlign(), text->hAlign());
-    QVERIFY(textPrivate->layout.lineAt(0).naturalTextRect().left() < window->width()/2);
-    QVERIFY(textPrivate->layout.lineAt(0).naturalTextRect().right() > window->width()/2);
+    QVERIFY(textPrivate->layout->lineAt(0).naturalTextRect().left() < window->width()/2);
+    QVERIFY(textPrivate->layout->lineAt(0).naturalTextRect().right() > window->width()/2);
 
     // reseted alignment should go back to following the text reading direction
     text->resetHAlign();
     QCOMPARE(text->hAlign(), QQuickText::AlignRight);
-    QVERIFY(textPrivate->layout.lineAt(0).naturalTextRect().left() > window->width()/2);
+    QVERIFY(textPrivate->layout->lineAt(0).naturalTextRect().left() > window->width()/2);
 
     // mirror the text item
     QQuickItemPrivate::get(text)->setLayoutMirror(true);
@@ -935,19 +940,19 @@ void tst_qquicktext::horizontalAlignment_RightToLeft()
     // mirrored implicit alignment should continue to follow the reading direction of the text
     QCOMPARE(text->hAlign(), QQuickText::AlignRight);
     QCOMPARE(text->effectiveHAlign(), QQuickText::AlignRight);
-    QVERIFY(textPrivate->layout.lineAt(0).naturalTextRect().left() > window->width()/2);
+    QVERIFY(textPrivate->layout->lineAt(0).naturalTextRect().left() > window->width()/2);
 
     // mirrored explicitly right aligned behaves as left aligned
     text->setHAlign(QQuickText::AlignRight);
     QCOMPARE(text->hAlign(), QQuickText::AlignRight);
     QCOMPARE(text->effectiveHAlign(), QQuickText::AlignLeft);
-    QVERIFY(textPrivate->layout.lineAt(0).naturalTextRect().left() < window->width()/2);
+    QVERIFY(textPrivate->layout->lineAt(0).naturalTextRect().left() < window->width()/2);
 
     // mirrored explicitly left aligned behaves as right aligned
     text->setHAlign(QQuickText::AlignLeft);
     QCOMPARE(text->hAlign(), QQuickText::AlignLeft);
     QCOMPARE(text->effectiveHAlign(), QQuickText::AlignRight);
-    QVERIFY(textPrivate->layout.lineAt(0).naturalTextRect().left() > window->width()/2);
+    QVERIFY(textPrivate->layout->lineAt(0).naturalTextRect().left() > window->width()/2);
 
     // disable mirroring
     QQuickItemPrivate::get(text)->setLayoutMirror(false);
@@ -956,7 +961,7 @@ void tst_qquicktext::horizontalAlignment_RightToLeft()
     // English text should be implicitly left aligned
     text->setText("Hello world!");
     QCOMPARE(text->hAlign(), QQuickText::AlignLeft);
-    QVERIFY(textPrivate->layout.lineAt(0).naturalTextRect().left() < window->width()/2);
+    QVERIFY(textPrivate->layout->lineAt(0).naturalTextRect().left() < window->width()/2);
 
     // empty text with implicit alignment follows the system locale-based
     // keyboard input direction from QInputMethod::inputDirection()
@@ -2856,8 +2861,8 @@ void tst_qquicktext::lineLaidOut()
 
     QVERIFY(!textPrivate->extra.isAllocated());
 
-    for (int i = 0; i < textPrivate->layout.lineCount(); ++i) {
-        QRectF r = textPrivate->layout.lineAt(i).rect();
+    for (int i = 0; i < textPrivate->layout->lineCount(); ++i) {
+        QRectF r = textPrivate->layout->lineAt(i).rect();
         QVERIFY(r.width() == i * 15);
         if (i >= 30)
             QVERIFY(r.x() == r.width() + 30);
@@ -2885,8 +2890,8 @@ void tst_qquicktext::lineLaidOutRelayout()
     QVERIFY(!textPrivate->extra.isAllocated());
 
     qreal y = 0.0;
-    for (int i = 0; i < textPrivate->layout.lineCount(); ++i) {
-        QTextLine line = textPrivate->layout.lineAt(i);
+    for (int i = 0; i < textPrivate->layout->lineCount(); ++i) {
+        QTextLine line = textPrivate->layout->lineAt(i);
         const QRectF r = line.rect();
         if (r.x() == 0) {
             QCOMPARE(r.y(), y);
@@ -2910,9 +2915,9 @@ void tst_qquicktext::lineLaidOutHAlign()
     QQuickTextPrivate *textPrivate = QQuickTextPrivate::get(myText);
     QVERIFY(textPrivate != nullptr);
 
-    QCOMPARE(textPrivate->layout.lineCount(), 1);
+    QCOMPARE(textPrivate->layout->lineCount(), 1);
 
-    QVERIFY(textPrivate->layout.lineAt(0).naturalTextRect().x() < 0.0);
+    QVERIFY(textPrivate->layout->lineAt(0).naturalTextRect().x() < 0.0);
 }
 
 void tst_qquicktext::imgTagsBaseUrl_data()
@@ -3041,7 +3046,7 @@ void tst_qquicktext::imgTagsAlign()
     QQuickTextPrivate *textPrivate = QQuickTextPrivate::get(textObject);
     QVERIFY(textPrivate != nullptr);
 
-    QRectF br = textPrivate->layout.boundingRect();
+    QRectF br = textPrivate->layout->boundingRect();
     if (align == "bottom")
         QVERIFY(br.y() == imgHeight - br.height());
     else if (align == "middle")
@@ -4414,6 +4419,136 @@ void tst_qquicktext::implicitSizeChangeRewrap()
     QVERIFY(text->contentWidth() < window->width());
 }
 
+void tst_qquicktext::sharedLayout()
+{
+    QQmlComponent component(&engine);
+    component.setData("import QtQuick 2.0\n"
+                      "Column { Repeater { model: 3; Text { width: 100; wrapMode: Text.Wrap; text: \"Shared label\" } } }",
+                      QUrl());
+    QScopedPointer<QObject> object(component.create());
+    QQuickItem *root = qobject_cast<QQuickItem *>(object.data());
+    QVERIFY(root);
+    const QList<QQuickText *> texts = root->findChildren<QQuickText *>();
+    QCOMPARE(texts.count(), 3);
+
+    // Identical labels share the laid out text
+    QQuickTextPrivate *first = QQuickTextPrivate::get(texts.at(0));
+    QQuickTextPrivate *second = QQuickTextPrivate::get(texts.at(1));
+    QVERIFY(first->layoutShared);
+    QCOMPARE(second->layout.data(), first->layout.data());
+    QCOMPARE(texts.at(1)->implicitWidth(), texts.at(0)->implicitWidth());
+    QCOMPARE(texts.at(1)->contentHeight(), texts.at(0)->contentHeight());
+    QCOMPARE(texts.at(1)->lineCount(), texts.at(0)->lineCount());
+
+    // but not with other threads, which have caches of their own. Items
+    // can only be created on the GUI thread, so only look at the cache.
+    QVERIFY(QQuickTextPrivate::textLayoutCacheCount() > 0);
+    int threadCacheCount = -1;
+    QScopedPointer<QThread> thread(QThread::create([&]() {
+        threadCacheCount = QQuickTextPrivate::textLayoutCacheCount();
+    }));
+    thread->start();
+    QVERIFY(thread->wait());
+    QCOMPARE(threadCacheCount, 0);
+
+    // Changing one of them leaves the others alone
+    texts.at(1)->setWidth(30);
+    QVERIFY(second->layout != first->layout);
+    QVERIFY(texts.at(1)->lineCount() > texts.at(0)->lineCount());
+    QCOMPARE(first->layout->text(), QStringLiteral("Shared label"));
+    QCOMPARE(first->layout->lineCount(), texts.at(0)->lineCount());
+
+    texts.at(2)->setText(QStringLiteral("<b>Styled</b>"));
+    QVERIFY(!QQuickTextPrivate::get(texts.at(2))->layoutShared);
+    QCOMPARE(first->layout->text(), QStringLiteral("Shared label"));
+}
+
+void tst_qquicktext::asynchronousLayout()
+{
+    // Longer than the texts that are shared, so that both items lay it out
+    QString longText;
+    for (int i = 0; i < 40; ++i)
+        longText += QStringLiteral("Asynchronous %1 ").arg(i);
+
+    QQmlComponent component(&engine);
+    component.setData("import QtQuick 2.13\n"
+                      "Row {\n"
+                      "    property string longText\n"
+                      "    Text { objectName: \"async\"; asynchronous: true; width: 200; wrapMode: Text.Wrap; text: longText }\n"
+                      "    Text { objectName: \"sync\"; width: 200; wrapMode: Text.Wrap; text: longText }\n"
+                      "}", QUrl());
+    QScopedPointer<QObject> object(component.beginCreate(engine.rootContext()));
+    QVERIFY(object);
+    object->setProperty("longText", longText);
+    component.completeCreate();
+
+    QQuickText *asyncText = object->findChild<QQuickText *>("async");
+    QQuickText *syncText = object->findChild<QQuickText *>("sync");
+    QVERIFY(asyncText);
+    QVERIFY(syncText);
+    QVERIFY(syncText->lineCount() > 1);
+
+    QSignalSpy pendingSpy(asyncText, SIGNAL(layoutPendingChanged()));
+    QTRY_VERIFY(!asyncText->isLayoutPending());
+    QCOMPARE(asyncText->lineCount(), syncText->lineCount());
+    QCOMPARE(asyncText->implicitWidth(), syncText->implicitWidth());
+    QCOMPARE(asyncText->implicitHeight(), syncText->implicitHeight());
+    QCOMPARE(asyncText->contentHeight(), syncText->contentHeight());
+    QCOMPARE(asyncText->baselineOffset(), syncText->baselineOffset());
+
+    // Changing the text lays it out again
+    asyncText->setText(longText + longText);
+    QVERIFY(asyncText->isLayoutPending());
+    QCOMPARE(asyncText->lineCount(), 0);
+    QTRY_VERIFY(!asyncText->isLayoutPending());
+    QVERIFY(asyncText->lineCount() > syncText->lineCount());
+    QVERIFY(pendingSpy.count() >= 2);
+
+    // Styled text is always laid out synchronously
+    asyncText->setText(QStringLiteral("<b>Styled</b>"));
+    QVERIFY(!asyncText->isLayoutPending());
+    QCOMPARE(asyncText->lineCount(), 1);
+
+    // Turning it off finishes the layout right away
+    asyncText->setText(longText);
+    QVERIFY(asyncText->isLayoutPending());
+    asyncText->setAsynchronous(false);
+    QVERIFY(!asyncText->isLayoutPending());
+    QCOMPARE(asyncText->lineCount(), syncText->lineCount());
+}
+
+void tst_qquicktext::asynchronousShortText()
+{
+    QQmlComponent asyncComponent(&engine);
+    asyncComponent.setData("import QtQuick 2.13\n"
+                           "Text { asynchronous: true; width: 100; wrapMode: Text.Wrap; text: \"Short asynchronous label\" }",
+                           QUrl());
+    QScopedPointer<QObject> asyncObject(asyncComponent.create());
+    QQuickText *asyncText = qobject_cast<QQuickText *>(asyncObject.data());
+    QVERIFY(asyncText);
+    QTRY_VERIFY(!asyncText->isLayoutPending());
+    QQuickTextPrivate *asyncPrivate = QQuickTextPrivate::get(asyncText);
+    QVERIFY(!asyncPrivate->layoutShared);
+
+    // The result of the job doesn't go into the layout cache
+    QQmlComponent syncComponent(&engine);
+    syncComponent.setData("import QtQuick 2.13\n"
+                          "Text { width: 100; wrapMode: Text.Wrap; text: \"Short asynchronous label\" }",
+                          QUrl());
+    QScopedPointer<QObject> syncObject(syncComponent.create());
+    QQuickText *syncText = qobject_cast<QQuickText *>(syncObject.data());
+    QVERIFY(syncText);
+    QQuickTextPrivate *syncPrivate = QQuickTextPrivate::get(syncText);
+    QVERIFY(syncPrivate->layoutShared);
+    QVERIFY(syncPrivate->layout != asyncPrivate->layout);
+
+    QCOMPARE(asyncText->lineCount(), syncText->lineCount());
+    QCOMPARE(asyncText->implicitWidth(), syncText->implicitWidth());
+    QCOMPARE(asyncText->implicitHeight(), syncText->implicitHeight());
+    QCOMPARE(asyncText->contentHeight(), syncText->contentHeight());
+    QCOMPARE(asyncText->baselineOffset(), syncText->baselineOffset());
+}
+
 QTEST_MAIN(tst_qquicktext)
 
 #include "tst_qquicktext.moc"
@@ -0,0 +1,14 @@
+import QtQuick 2.0
+
+Flickable {
+    width: 200
+    height: 200
+    clip: true
+    contentWidth: textEdit.width
+    contentHeight: textEdit.height
+
+    TextEdit {
+        id: textEdit
+        width: 200
+    }
+}
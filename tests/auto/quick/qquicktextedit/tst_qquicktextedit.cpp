@@ -40,6 +40,7 @@
 #include <private/qquicktextedit_p_p.h>
 #include <private/qquicktext_p.h>
 #include <private/qquicktextdocument_p.h>
+#include <private/qquickflickable_p.h>
 #include <QFontMetrics>
 #include <QtQuick/QQuickView>
 #include <QDir>
@@ -205,6 +206,7 @@ private slots:
 
     void padding();
     void QTBUG_51115_readOnlyResetsSelection();
+    void largeDocumentNodes();
 
 private:
     void simulateKeys(QWindow *window, const QList<Key> &keys);
@@ -5671,6 +5673,57 @@ void tst_qquicktextedit::QTBUG_51115_readOnlyResetsSelection()
     QCOMPARE(obj->selectedText(), QString());
 }
 
+void tst_qquicktextedit::largeDocumentNodes()
+{
+    QQuickView view;
+    view.setSource(testFileUrl("largeDocument.qml"));
+    view.show();
+    QVERIFY(QTest::qWaitForWindowExposed(&view));
+    QQuickFlickable *flickable = qobject_cast<QQuickFlickable *>(view.rootObject());
+    QVERIFY(flickable);
+    QQuickTextEdit *edit = flickable->findChild<QQuickTextEdit *>();
+    QVERIFY(edit);
+    QQuickTextEditPrivate *editPrivate = QQuickTextEditPrivate::get(edit);
+
+    QStringList lines;
+    for (int i = 0; i < 2000; ++i)
+        lines.append(QStringLiteral("Line %1").arg(i));
+    edit->setText(lines.join(QLatin1Char('\n')));
+    QTRY_VERIFY(editPrivate->restrictedToViewport);
+
+    // Only the blocks around the visible part get nodes
+    QVERIFY(!editPrivate->textNodeMap.isEmpty());
+    QVERIFY(editPrivate->textNodeMap.size() < editPrivate->document->blockCount());
+    QCOMPARE(editPrivate->textNodeMap.first().startPos(), 0);
+
+    // Scrolling to the end moves the nodes along
+    flickable->setContentY(flickable->contentHeight() - flickable->height());
+    const int lastBlockPos = editPrivate->document->lastBlock().position();
+    QTRY_COMPARE(editPrivate->textNodeMap.last().startPos(), lastBlockPos);
+    QVERIFY(editPrivate->textNodeMap.first().startPos() > 0);
+
+    // Editing keeps the nodes in order
+    edit->insert(lastBlockPos, QStringLiteral("Edited "));
+    QTRY_COMPARE(editPrivate->updateType, QQuickTextEditPrivate::UpdateNone);
+    QVERIFY(std::is_sorted(editPrivate->textNodeMap.cbegin(), editPrivate->textNodeMap.cend(),
+                           [](const QQuickTextEditPrivate::Node &n1, const QQuickTextEditPrivate::Node &n2) {
+                               return n1.startPos() < n2.startPos();
+                           }));
+
+    // Scaling the item down shows more of the document
+    flickable->setContentY(0);
+    QTRY_COMPARE(editPrivate->textNodeMap.first().startPos(), 0);
+    const int lastRenderedPos = editPrivate->textNodeMap.last().startPos();
+    edit->setTransformOrigin(QQuickItem::TopLeft);
+    edit->setScale(0.25);
+    QTRY_VERIFY(editPrivate->textNodeMap.last().startPos() > lastRenderedPos);
+
+    // Small documents get nodes for the whole text again
+    edit->setText(QStringLiteral("Short\ntext"));
+    QTRY_VERIFY(!editPrivate->restrictedToViewport);
+    QCOMPARE(editPrivate->textNodeMap.size(), editPrivate->document->blockCount());
+}
+
 QTEST_MAIN(tst_qquicktextedit)
 
 #include "tst_qquicktextedit.moc"
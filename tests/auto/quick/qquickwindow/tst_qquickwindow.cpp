@@ -35,6 +35,9 @@
 #include <QtQuick/QQuickWindow>
 #include <QtQml/QQmlEngine>
 #include <QtQml/QQmlComponent>
+#include <QtQuick/private/qquickanimator_p.h>
+#include <QtQuick/private/qquickframetimings_p.h>
+#include <QtQuick/private/qquickitem_p.h>
 #include <QtQuick/private/qquickrectangle_p.h>
 #include <QtQuick/private/qquickloader_p.h>
 #include <QtQuick/private/qquickmousearea_p.h>
@@ -45,6 +48,7 @@
 #include <private/qquickwindow_p.h>
 #include <private/qguiapplication_p.h>
 #include <QRunnable>
+#include <QTemporaryDir>
 #include <QOpenGLFunctions>
 #include <QSGRendererInterface>
 
@@ -466,11 +470,15 @@ private slots:
     void pointerEventTypeAndPointCount();
 
     void grabContentItemToImage();
+    void concurrentPaintNodeUpdates();
 
     void testDragEventPropertyPropagation();
 
     void findChild();
 
+    void hitTestIndex();
+    void frameTimings();
+
     void testChildMouseEventFilter();
     void testChildMouseEventFilter_data();
     void cleanupGrabsOnRelease();
@@ -2852,6 +2860,75 @@ void tst_qquickwindow::grabContentItemToImage()
     QTRY_COMPARE(created->property("success").toInt(), 1);
 }
 
+class PaintNodeRectangle : public QQuickRectangle
+{
+    Q_OBJECT
+public:
+    PaintNodeRectangle(QQuickItem *parent = nullptr) : QQuickRectangle(parent) {}
+
+protected:
+    QSGNode *updatePaintNode(QSGNode *node, UpdatePaintNodeData *data) override
+    {
+        return QQuickRectangle::updatePaintNode(node, data);
+    }
+};
+
+void tst_qquickwindow::concurrentPaintNodeUpdates()
+{
+    QQuickWindow window;
+    window.setTitle(QTest::currentTestFunction());
+    window.resize(200, 200);
+    QQuickWindowPrivate::get(&window)->concurrentPaintNodeUpdates = true;
+
+    // Only plain Rectangles opt in, including ones that declare QML properties
+    PaintNodeRectangle subclass;
+    QVERIFY(!QQuickItemPrivate::get(&subclass)->concurrentPaintNodeUpdate);
+    subclass.setParentItem(window.contentItem());
+    QVERIFY(!QQuickItemPrivate::get(&subclass)->concurrentPaintNodeUpdate);
+
+    QQmlEngine engine;
+    QQmlComponent component(&engine);
+    component.setData("import QtQuick 2.0\nRectangle { property int extra; function f() {} }", QUrl());
+    QScopedPointer<QQuickItem> declared(qobject_cast<QQuickItem *>(component.create()));
+    QVERIFY(declared);
+    declared->setParentItem(window.contentItem());
+    QVERIFY(QQuickItemPrivate::get(declared.data())->concurrentPaintNodeUpdate);
+
+    // enough rectangles for the updates to be spread over several jobs
+    QVector<QQuickRectangle *> rects;
+    for (int i = 0; i < 400; ++i) {
+        QQuickRectangle *rect = new QQuickRectangle(window.contentItem());
+        rect->setPosition(QPointF((i % 20) * 10, (i / 20) * 10));
+        rect->setSize(QSizeF(10, 10));
+        rect->setColor(i % 2 ? Qt::red : Qt::blue);
+        rects << rect;
+    }
+
+    QVERIFY(QQuickItemPrivate::get(rects.first())->concurrentPaintNodeUpdate);
+
+    window.show();
+    QVERIFY(QTest::qWaitForWindowExposed(&window));
+
+    // The other backends always update paint nodes serially
+    if (window.rendererInterface()->graphicsApi() != QSGRendererInterface::OpenGL)
+        QSKIP("Skipping concurrent paint node update test due to not running with OpenGL");
+
+    const qreal dpr = window.effectiveDevicePixelRatio();
+    QImage content = window.grabWindow();
+    QCOMPARE(QColor(content.pixel(QPoint(5, 5) * dpr)), QColor(Qt::blue));
+    QCOMPARE(QColor(content.pixel(QPoint(15, 5) * dpr)), QColor(Qt::red));
+
+    // update existing nodes, and drop one
+    for (QQuickRectangle *rect : qAsConst(rects))
+        rect->setColor(Qt::green);
+    rects.at(1)->setSize(QSizeF());
+
+    content = window.grabWindow();
+    QCOMPARE(QColor(content.pixel(QPoint(5, 5) * dpr)), QColor(Qt::green));
+    QCOMPARE(QColor(content.pixel(QPoint(15, 5) * dpr)), QColor(Qt::white));
+    QVERIFY(!QQuickItemPrivate::get(rects.at(1))->paintNode);
+}
+
 class TestDropTarget : public QQuickItem
 {
     Q_OBJECT
@@ -3419,6 +3496,118 @@ void tst_qquickwindow::testChildMouseEventFilter_data()
 
 }
 
+void tst_qquickwindow::frameTimings()
+{
+    QQuickWindow window;
+    window.setTitle(QTest::currentTestFunction());
+    window.resize(100, 100);
+    QQuickFrameTimings *timings = QQuickWindowPrivate::get(&window)->ensureFrameTimings();
+    timings->setEnabled(true);
+    timings->setCapacity(3);
+
+    QQuickRectangle *rect = new QQuickRectangle(window.contentItem());
+    rect->setSize(QSizeF(50, 50));
+    rect->setColor(Qt::red);
+
+    window.show();
+    QVERIFY(QTest::qWaitForWindowExposed(&window));
+
+    for (int i = 0; i < 5; ++i) {
+        QSignalSpy swapped(&window, SIGNAL(frameSwapped()));
+        rect->setX(i);
+        QTRY_VERIFY(swapped.count() > 0);
+    }
+
+    // only the last frames are kept
+    QTRY_COMPARE(timings->frameCount(), 3);
+    const QVector<QQuickFrameTiming> frames = timings->frames();
+    QCOMPARE(frames.size(), 3);
+    for (int i = 0; i < frames.size(); ++i) {
+        QVERIFY(frames.at(i).render >= 0);
+        QVERIFY(frames.at(i).total() >= frames.at(i).render);
+        if (i > 0)
+            QVERIFY(frames.at(i).timestamp >= frames.at(i - 1).timestamp);
+    }
+    QVERIFY(timings->percentile(QQuickFrameTimings::Total, 50)
+            <= timings->percentile(QQuickFrameTimings::Total, 100));
+    QCOMPARE(timings->frameList().size(), 3);
+
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    const QString fileName = dir.filePath(QStringLiteral("timings.txt"));
+    QVERIFY(timings->dump(fileName));
+    QFile file(fileName);
+    QVERIFY(file.open(QIODevice::ReadOnly | QIODevice::Text));
+    const QByteArray contents = file.readAll();
+    QVERIFY(contents.contains("3 frames"));
+    QVERIFY(contents.contains("updatePaintNode"));
+
+    timings->clear();
+    QCOMPARE(timings->frameCount(), 0);
+
+    // The threaded render loop keeps the timings from the last sync while
+    // animators run, those frames must not be recorded once disabled either
+    timings->setEnabled(false);
+    QQuickXAnimator animator;
+    animator.setTargetItem(rect);
+    animator.setFrom(0);
+    animator.setTo(50);
+    animator.setDuration(200);
+    animator.setRunning(true);
+    QTRY_VERIFY(!animator.isRunning());
+    QCOMPARE(timings->frameCount(), 0);
+}
+
+void tst_qquickwindow::hitTestIndex()
+{
+    QQuickWindow window;
+    window.setTitle(QTest::currentTestFunction());
+    window.resize(320, 240);
+    QQuickWindowPrivate::get(&window)->setHitTestIndexEnabled(true);
+
+    // enough siblings for the index to put a grid over them
+    QVector<QQuickMouseArea *> areas;
+    for (int i = 0; i < 20; ++i) {
+        QQuickMouseArea *area = new QQuickMouseArea(window.contentItem());
+        area->setPosition(QPointF((i % 10) * 30, (i / 10) * 30));
+        area->setSize(QSizeF(20, 20));
+        areas << area;
+    }
+    // a child outside of its (unclipped) parent's bounds
+    QQuickMouseArea *outside = new QQuickMouseArea(areas.at(0));
+    outside->setPosition(QPointF(60, 60));
+    outside->setSize(QSizeF(10, 10));
+
+    window.show();
+    QVERIFY(QTest::qWaitForWindowExposed(&window));
+
+    auto pressed = [&window](QQuickMouseArea *area, const QPoint &p) {
+        QTest::mousePress(&window, Qt::LeftButton, Qt::NoModifier, p);
+        const bool result = area->pressed();
+        QTest::mouseRelease(&window, Qt::LeftButton, Qt::NoModifier, p);
+        return result;
+    };
+
+    QVERIFY(pressed(areas.at(3), QPoint(95, 5)));
+    QVERIFY(pressed(areas.at(14), QPoint(125, 35)));
+    QVERIFY(pressed(outside, QPoint(65, 65)));
+
+    // geometry changes must be picked up
+    areas.at(3)->setX(200);
+    QVERIFY(!pressed(areas.at(3), QPoint(95, 5)));
+    QVERIFY(pressed(areas.at(3), QPoint(205, 5)));
+
+    areas.at(0)->setScale(2);
+    QVERIFY(!pressed(outside, QPoint(65, 65)));
+    QVERIFY(pressed(outside, QPoint(120, 120)));
+
+    outside->setParentItem(areas.at(14));
+    QVERIFY(pressed(outside, QPoint(185, 95)));
+
+    areas.at(14)->setClip(true);
+    QVERIFY(!pressed(outside, QPoint(185, 95)));
+}
+
 void tst_qquickwindow::testChildMouseEventFilter()
 {
     QFETCH(QPoint, mousePos);
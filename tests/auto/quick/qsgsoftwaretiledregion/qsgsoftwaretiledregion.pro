@@ -0,0 +1,7 @@
+CONFIG += testcase
+TARGET = tst_qsgsoftwaretiledregion
+macx:CONFIG -= app_bundle
+
+SOURCES += tst_qsgsoftwaretiledregion.cpp
+
+QT += quick-private testlib
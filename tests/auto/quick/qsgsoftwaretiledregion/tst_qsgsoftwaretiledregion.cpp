@@ -0,0 +1,232 @@
+/****************************************************************************
+**
+** Copyright (C) 2019 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include <qtest.h>
+#include <QtCore/QRandomGenerator>
+#include <QtQuick/private/qsgsoftwaretiledregion_p.h>
+
+class tst_qsgsoftwaretiledregion : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void empty();
+    void tileBoundaries();
+    void outsideArea();
+    void reset();
+    void randomOperations();
+};
+
+enum { Tile = QSGSoftwareTiledRegion::TileSize };
+
+static bool sameRegion(const QRegion &a, const QRegion &b)
+{
+    return a.xored(b).isEmpty();
+}
+
+// Checks every query of region against the plain QRegion model for rect
+static void verifyQueries(const QSGSoftwareTiledRegion &region, const QRegion &model, const QRect &rect)
+{
+    QCOMPARE(region.intersects(rect), model.intersects(rect));
+    QCOMPARE(region.contains(rect), !rect.isEmpty() && QRegion(rect).subtracted(model).isEmpty());
+    QVERIFY2(sameRegion(region.intersected(rect), model.intersected(rect)),
+             qPrintable(QString::fromLatin1("intersected(%1, %2, %3x%4)")
+                        .arg(rect.x()).arg(rect.y()).arg(rect.width()).arg(rect.height())));
+}
+
+void tst_qsgsoftwaretiledregion::empty()
+{
+    QSGSoftwareTiledRegion region;
+    region.reset(QRect(0, 0, 200, 100));
+    QVERIFY(region.toRegion().isEmpty());
+    QVERIFY(!region.intersects(QRect(0, 0, 200, 100)));
+    QVERIFY(!region.contains(QRect(10, 10, 1, 1)));
+    QVERIFY(region.intersected(QRect(0, 0, 200, 100)).isEmpty());
+
+    // An empty rect is never contained, not even in a full region
+    region.add(QRect(0, 0, 200, 100));
+    QVERIFY(!region.contains(QRect()));
+    QVERIFY(!region.intersects(QRect()));
+
+    // Nor is there anything to index without an area
+    QSGSoftwareTiledRegion unindexed;
+    unindexed.reset(QRect());
+    unindexed.add(QRect(5, 5, 10, 10));
+    QVERIFY(sameRegion(unindexed.toRegion(), QRect(5, 5, 10, 10)));
+    QVERIFY(unindexed.contains(QRect(5, 5, 10, 10)));
+}
+
+void tst_qsgsoftwaretiledregion::tileBoundaries()
+{
+    QSGSoftwareTiledRegion region;
+    const QRect area(0, 0, 4 * Tile, 3 * Tile);
+    region.reset(area);
+
+    // exactly one tile, then the tile to its right
+    region.add(QRect(Tile, Tile, Tile, Tile));
+    QVERIFY(region.contains(QRect(Tile, Tile, Tile, Tile)));
+    QVERIFY(!region.contains(QRect(Tile, Tile, Tile + 1, Tile)));
+    QVERIFY(!region.intersects(QRect(0, 0, Tile, Tile)));
+    QVERIFY(!region.intersects(QRect(2 * Tile, Tile, Tile, Tile)));
+    region.add(QRect(2 * Tile, Tile, Tile, Tile));
+    QVERIFY(region.contains(QRect(Tile + 10, Tile + 10, Tile, Tile - 20)));
+
+    // a rect spanning the corner of four tiles
+    const QRect corner(Tile - 5, 2 * Tile - 5, 10, 10);
+    region.add(corner);
+    QVERIFY(region.contains(corner));
+    QVERIFY(region.intersects(QRect(Tile - 5, 2 * Tile + 4, 1, 1)));
+    QVERIFY(!region.intersects(QRect(Tile - 6, 2 * Tile + 4, 1, 1)));
+
+    // a hole in the middle of a tile, and one across a tile edge
+    region.subtract(QRect(Tile + 20, Tile + 20, 4, 4));
+    QVERIFY(!region.contains(QRect(Tile, Tile, Tile, Tile)));
+    QVERIFY(!region.intersects(QRect(Tile + 21, Tile + 21, 2, 2)));
+    QVERIFY(region.contains(QRect(Tile, Tile, 20, Tile)));
+    region.subtract(QRect(2 * Tile - 1, Tile + 40, 2, 2));
+    QVERIFY(!region.intersects(QRect(2 * Tile - 1, Tile + 40, 2, 2)));
+    QVERIFY(region.intersects(QRect(2 * Tile - 2, Tile + 40, 2, 2)));
+
+    QRegion model;
+    model += QRect(Tile, Tile, 2 * Tile, Tile);
+    model += corner;
+    model -= QRect(Tile + 20, Tile + 20, 4, 4);
+    model -= QRect(2 * Tile - 1, Tile + 40, 2, 2);
+    QVERIFY(sameRegion(region.toRegion(), model));
+    verifyQueries(region, model, area);
+    verifyQueries(region, model, QRect(Tile - 3, Tile - 3, Tile + 6, Tile + 6));
+
+    // covering the whole area again
+    region.add(area);
+    QVERIFY(region.contains(area));
+    region.subtract(QRect(area.right(), area.bottom(), 1, 1));
+    QVERIFY(!region.contains(area));
+    QVERIFY(region.contains(area.adjusted(0, 0, 0, -1)));
+}
+
+void tst_qsgsoftwaretiledregion::outsideArea()
+{
+    QSGSoftwareTiledRegion region;
+    // not aligned to the tile size, and not at the origin
+    const QRect area(-10, 5, 2 * Tile + 3, Tile + 7);
+    region.reset(area);
+
+    QRegion model;
+    const QRect straddling(-30, 0, 50, 40);
+    region.add(straddling);
+    model += straddling;
+    const QRect outside(500, 500, 10, 10);
+    region.add(outside);
+    model += outside;
+
+    QVERIFY(sameRegion(region.toRegion(), model));
+    QVERIFY(region.contains(straddling));
+    QVERIFY(region.contains(outside));
+    QVERIFY(!region.contains(straddling.adjusted(-1, 0, 0, 0)));
+    verifyQueries(region, model, QRect(-40, -5, 100, 100));
+    verifyQueries(region, model, QRect(505, 490, 20, 20));
+
+    region.subtract(QRect(-20, 10, 20, 10));
+    model -= QRect(-20, 10, 20, 10);
+    QVERIFY(sameRegion(region.toRegion(), model));
+    QVERIFY(!region.contains(straddling));
+    verifyQueries(region, model, QRect(-25, 5, 30, 20));
+}
+
+void tst_qsgsoftwaretiledregion::reset()
+{
+    QSGSoftwareTiledRegion region;
+    region.reset(QRect(0, 0, 300, 300));
+    region.add(QRect(10, 10, 100, 100));
+    region.add(QRect(-50, -50, 10, 10));
+
+    region.reset(QRect(0, 0, 300, 300));
+    QVERIFY(region.toRegion().isEmpty());
+    QVERIFY(!region.intersects(QRect(-100, -100, 500, 500)));
+
+    // a different size gets a different grid
+    region.reset(QRect(0, 0, 3 * Tile, Tile));
+    region.add(QRect(2 * Tile + 10, 10, 10, 10));
+    QVERIFY(region.contains(QRect(2 * Tile + 10, 10, 10, 10)));
+    QVERIFY(sameRegion(region.toRegion(), QRect(2 * Tile + 10, 10, 10, 10)));
+}
+
+// Compares against a plain QRegion after every operation
+void tst_qsgsoftwaretiledregion::randomOperations()
+{
+    QRandomGenerator random(7);
+    const QRect area(-20, 10, 5 * Tile + 17, 4 * Tile + 9);
+    auto randomRect = [&]() {
+        const int x = random.bounded(area.left() - 40, area.right() + 40);
+        const int y = random.bounded(area.top() - 40, area.bottom() + 40);
+        // mostly small rects, some of them whole tiles or larger
+        const int extent = random.bounded(4) == 0 ? 3 * Tile : Tile / 2;
+        return QRect(x, y, random.bounded(extent) + 1, random.bounded(extent) + 1);
+    };
+
+    QSGSoftwareTiledRegion region;
+    for (int round = 0; round < 5; ++round) {
+        region.reset(area);
+        QRegion model;
+        for (int i = 0; i < 200; ++i) {
+            const QRect rect = randomRect();
+            switch (random.bounded(3)) {
+            case 0:
+            case 1:
+                region.add(rect);
+                model += rect;
+                break;
+            case 2:
+                region.subtract(rect);
+                model -= rect;
+                break;
+            }
+
+            QVERIFY2(sameRegion(region.toRegion(), model), qPrintable(QString::number(i)));
+            verifyQueries(region, model, randomRect());
+            if (!model.isEmpty()) {
+                // A rect from the region itself is contained
+                const QVector<QRect> rects = model.rects();
+                verifyQueries(region, model, rects.at(random.bounded(rects.count())));
+            }
+            if (QTest::currentTestFailed())
+                return;
+        }
+
+        QRegion added;
+        for (int i = 0; i < 10; ++i)
+            added += randomRect();
+        region.add(added);
+        model += added;
+        QVERIFY(sameRegion(region.toRegion(), model));
+    }
+}
+
+QTEST_APPLESS_MAIN(tst_qsgsoftwaretiledregion)
+
+#include "tst_qsgsoftwaretiledregion.moc"
@@ -51,6 +51,7 @@ QUICKTESTS += \
     qquickdynamicpropertyanimation \
     qquickborderimage \
     qquickwindow \
+    qsgsoftwaretiledregion \
     qquickdrag \
     qquickdroparea \
     qquickflickable \
@@ -62,6 +63,7 @@ QUICKTESTS += \
     qquickitem \
     qquickitem2 \
     qquickitemlayer \
+    qquicklazyhiddenbindings \
     qquicklistview \
     qquicktableview \
     qquickloader \
@@ -86,7 +88,9 @@ QUICKTESTS += \
     qquickscreen \
     touchmouse \
     scenegraph \
-    sharedimage
+    sharedimage \
+    softwarenodecache \
+    softwarerenderer
 
 SUBDIRS += $$PUBLICTESTS
 
@@ -0,0 +1,25 @@
+import QtQuick 2.0
+
+Rectangle {
+    width: 100
+    height: 100
+    color: "blue"
+
+    // Opaque, so it is painted with CompositionMode_Source
+    Rectangle {
+        objectName: "cached"
+        x: 10.5
+        y: 10.5
+        width: 40
+        height: 40
+        color: "red"
+    }
+
+    // Invisible, changing its color repaints everything underneath
+    Rectangle {
+        objectName: "trigger"
+        width: 60
+        height: 60
+        color: "#00000000"
+    }
+}
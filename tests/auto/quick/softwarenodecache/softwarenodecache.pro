@@ -0,0 +1,11 @@
+CONFIG += testcase
+TARGET = tst_softwarenodecache
+macx:CONFIG -= app_bundle
+
+SOURCES += tst_softwarenodecache.cpp
+
+include (../../shared/util.pri)
+
+TESTDATA = data/*
+
+QT += qml quick quick-private testlib
@@ -0,0 +1,86 @@
+/****************************************************************************
+**
+** Copyright (C) 2019 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+#include <qtest.h>
+#include <QtQuick/qquickitem.h>
+#include <QtQuick/qquickview.h>
+#include <QtQuick/private/qquickitem_p.h>
+#include <QtQuick/private/qquickwindow_p.h>
+#include <QtQuick/private/qsgabstractsoftwarerenderer_p.h>
+#include <QtQuick/private/qsgsoftwarerenderablenode_p.h>
+#include "../../shared/util.h"
+
+class tst_softwarenodecache : public QQmlDataTest
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase() override;
+
+    void fractionalPosition();
+};
+
+void tst_softwarenodecache::initTestCase()
+{
+    // Must be set before the first node is painted, the budget is read only once.
+    qputenv("QSG_SOFTWARE_NODE_CACHE_SIZE", "1024");
+    QQuickWindow::setSceneGraphBackend(QSGRendererInterface::Software);
+    QQmlDataTest::initTestCase();
+}
+
+void tst_softwarenodecache::fractionalPosition()
+{
+    QQuickView view;
+    view.setSource(testFileUrl("fractionalPosition.qml"));
+    QVERIFY(view.rootObject());
+    QQuickItem *trigger = view.rootObject()->findChild<QQuickItem *>("trigger");
+    QVERIFY(trigger);
+    QQuickItem *cached = view.rootObject()->findChild<QQuickItem *>("cached");
+    QVERIFY(cached);
+    view.show();
+    QVERIFY(QTest::qWaitForWindowExposed(&view));
+
+    // Painted directly
+    const QImage expected = view.grabWindow();
+    auto renderer = static_cast<QSGAbstractSoftwareRenderer *>(QQuickWindowPrivate::get(&view)->renderer);
+    QVERIFY(renderer);
+    QSGSoftwareRenderableNode *node = renderer->renderableNode(QQuickItemPrivate::get(cached)->paintNode);
+    QVERIFY(node);
+    QVERIFY(!node->hasCachedImage());
+
+    // Repaint the unchanged nodes until they are blitted from their cached images
+    for (int i = 0; i < 5; ++i) {
+        trigger->setProperty("color", QColor(i % 2 ? "#00000000" : "#00ffffff"));
+        const QImage actual = view.grabWindow();
+        QCOMPARE(actual.convertToFormat(expected.format()), expected);
+    }
+    QVERIFY(node->hasCachedImage());
+}
+
+QTEST_MAIN(tst_softwarenodecache)
+
+#include "tst_softwarenodecache.moc"
@@ -0,0 +1,7 @@
+CONFIG += testcase
+TARGET = tst_softwarerenderer
+macx:CONFIG -= app_bundle
+
+SOURCES += tst_softwarerenderer.cpp
+
+QT += quick quick-private testlib
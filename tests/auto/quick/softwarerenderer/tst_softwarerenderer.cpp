@@ -0,0 +1,277 @@
+/****************************************************************************
+**
+** Copyright (C) 2019 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include <qtest.h>
+#include <QtGui/QImage>
+#include <QtGui/QPixmap>
+#include <QtQuick/QSGClipNode>
+#include <QtQuick/QSGImageNode>
+#include <QtQuick/QSGOpacityNode>
+#include <QtQuick/QSGSimpleRectNode>
+#include <QtQuick/QSGTransformNode>
+#include <QtQuick/private/qsgadaptationlayer_p.h>
+#include <QtQuick/private/qsgsoftwarecontext_p.h>
+#include <QtQuick/private/qsgsoftwarepixmaprenderer_p.h>
+
+// Renders scenes with QSGSoftwarePixmapRenderer. Rendering serially and in
+// parallel bands must produce identical images, also for partial updates and
+// across band boundaries.
+class tst_softwarerenderer : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+    void cleanupTestCase();
+
+    void bandedFrame_data();
+    void bandedFrame();
+    void bandedPartialUpdates();
+    void partiallyObscuredPixmap_data();
+    void partiallyObscuredPixmap();
+
+private:
+    struct Scene
+    {
+        QSGRootNode root;
+        QVector<QSGSimpleRectNode *> movingNodes;
+        QSGOpacityNode *opacityNode = nullptr;
+    };
+
+    void populate(Scene *scene);
+    void setupRenderer(QSGSoftwarePixmapRenderer *renderer, Scene *scene, int threads, const QSize &size);
+
+    QSGSoftwareContext *m_context = nullptr;
+    QSGSoftwareRenderContext *m_renderContext = nullptr;
+};
+
+static const QSize sceneSize(400, 300);
+
+void tst_softwarerenderer::initTestCase()
+{
+    m_context = new QSGSoftwareContext;
+    m_renderContext = static_cast<QSGSoftwareRenderContext *>(m_context->createRenderContext());
+}
+
+void tst_softwarerenderer::cleanupTestCase()
+{
+    delete m_renderContext;
+    delete m_context;
+}
+
+// Antialiased rounded rectangles, images, opacity, clipping and transforms.
+// Most of the nodes straddle the boundaries of several bands.
+void tst_softwarerenderer::populate(Scene *scene)
+{
+    const int cell = 37;
+    for (int y = 0; y + cell <= sceneSize.height(); y += cell) {
+        for (int x = 0; x + cell <= sceneSize.width(); x += cell) {
+            QSGInternalRectangleNode *node = m_context->createInternalRectangleNode();
+            node->setRect(QRectF(x + 1.5, y + 1.5, cell - 3, cell - 3));
+            node->setColor(QColor::fromHsv((x + 3 * y) % 360, 200, 220, 200));
+            node->setPenColor(Qt::black);
+            node->setPenWidth(1.5);
+            node->setRadius(9);
+            node->setAntialiasing(true);
+            node->update();
+            scene->root.appendChildNode(node);
+        }
+    }
+
+    QImage pattern(16, 16, QImage::Format_ARGB32_Premultiplied);
+    for (int y = 0; y < pattern.height(); ++y) {
+        for (int x = 0; x < pattern.width(); ++x)
+            pattern.setPixel(x, y, (x + y) % 2 ? 0xff00ff00 : 0x80000080);
+    }
+    QSGImageNode *image = m_context->createImageNode();
+    image->setTexture(m_renderContext->createTexture(pattern));
+    image->setOwnsTexture(true);
+    image->setRect(QRectF(30.5, 20, 150, 210));
+    image->setFiltering(QSGTexture::Linear);
+    scene->root.appendChildNode(image);
+
+    scene->opacityNode = new QSGOpacityNode;
+    scene->opacityNode->setOpacity(0.6);
+    scene->root.appendChildNode(scene->opacityNode);
+
+    QSGTransformNode *transform = new QSGTransformNode;
+    QMatrix4x4 matrix;
+    matrix.translate(250, 150);
+    matrix.rotate(30, 0, 0, 1);
+    transform->setMatrix(matrix);
+    scene->opacityNode->appendChildNode(transform);
+
+    QSGClipNode *clip = new QSGClipNode;
+    clip->setIsRectangular(true);
+    clip->setClipRect(QRectF(-80, -60, 160, 120));
+    transform->appendChildNode(clip);
+    clip->appendChildNode(new QSGSimpleRectNode(QRectF(-100, -40, 200, 80), Qt::red));
+
+    for (int i = 0; i < 6; ++i) {
+        QSGSimpleRectNode *node = new QSGSimpleRectNode(QRectF(i * 55, i * 45, 63, 41), QColor(0, 0, 255, 128));
+        scene->root.appendChildNode(node);
+        scene->movingNodes.append(node);
+    }
+}
+
+void tst_softwarerenderer::setupRenderer(QSGSoftwarePixmapRenderer *renderer, Scene *scene, int threads, const QSize &size)
+{
+    renderer->setRenderThreadCount(threads);
+    renderer->setRootNode(&scene->root);
+    renderer->setDeviceRect(size);
+    renderer->setViewportRect(size);
+    renderer->setProjectionRect(QRect(QPoint(), sceneSize));
+    renderer->setClearColor(Qt::white);
+}
+
+void tst_softwarerenderer::bandedFrame_data()
+{
+    QTest::addColumn<int>("threads");
+    QTest::addColumn<int>("devicePixelRatio");
+
+    QTest::newRow("2 threads") << 2 << 1;
+    QTest::newRow("4 threads") << 4 << 1;
+    QTest::newRow("7 threads") << 7 << 1;
+    QTest::newRow("4 threads, dpr 2") << 4 << 2;
+}
+
+void tst_softwarerenderer::bandedFrame()
+{
+    QFETCH(int, threads);
+    QFETCH(int, devicePixelRatio);
+
+    Scene serialScene;
+    populate(&serialScene);
+    Scene bandedScene;
+    populate(&bandedScene);
+
+    const QSize size = sceneSize * devicePixelRatio;
+    QSGSoftwarePixmapRenderer serialRenderer(m_renderContext);
+    setupRenderer(&serialRenderer, &serialScene, 0, size);
+    QSGSoftwarePixmapRenderer bandedRenderer(m_renderContext);
+    setupRenderer(&bandedRenderer, &bandedScene, threads, size);
+
+    QImage serial(size, QImage::Format_ARGB32_Premultiplied);
+    serial.setDevicePixelRatio(devicePixelRatio);
+    serial.fill(Qt::transparent);
+    QImage banded(size, QImage::Format_ARGB32_Premultiplied);
+    banded.setDevicePixelRatio(devicePixelRatio);
+    banded.fill(Qt::transparent);
+
+    serialRenderer.renderScene();
+    serialRenderer.render(&serial);
+    bandedRenderer.renderScene();
+    bandedRenderer.render(&banded);
+
+    // Make sure that something was painted at all
+    QVERIFY(serial.pixel(0, 0) != 0);
+    QCOMPARE(banded, serial);
+}
+
+void tst_softwarerenderer::bandedPartialUpdates()
+{
+    Scene serialScene;
+    populate(&serialScene);
+    Scene bandedScene;
+    populate(&bandedScene);
+
+    QSGSoftwarePixmapRenderer serialRenderer(m_renderContext);
+    setupRenderer(&serialRenderer, &serialScene, 0, sceneSize);
+    QSGSoftwarePixmapRenderer bandedRenderer(m_renderContext);
+    setupRenderer(&bandedRenderer, &bandedScene, 4, sceneSize);
+
+    QImage serial(sceneSize, QImage::Format_ARGB32_Premultiplied);
+    QImage banded(sceneSize, QImage::Format_ARGB32_Premultiplied);
+
+    for (int frame = 0; frame < 10; ++frame) {
+        for (Scene *scene : {&serialScene, &bandedScene}) {
+            for (QSGSimpleRectNode *node : qAsConst(scene->movingNodes)) {
+                QRectF rect = node->rect();
+                rect.translate(13, 7);
+                if (rect.right() > sceneSize.width())
+                    rect.moveLeft(rect.left() - sceneSize.width() + 63);
+                if (rect.bottom() > sceneSize.height())
+                    rect.moveTop(rect.top() - sceneSize.height() + 41);
+                node->setRect(rect);
+            }
+            if (frame % 3 == 1)
+                scene->opacityNode->setOpacity(0.2 + frame * 0.05);
+        }
+
+        serialRenderer.renderScene();
+        serialRenderer.render(&serial);
+        bandedRenderer.renderScene();
+        bandedRenderer.render(&banded);
+        QCOMPARE(banded, serial);
+    }
+}
+
+// The pixmap is only cleared to transparent when opaque nodes don't cover
+// all of it, which also gives it an alpha channel.
+void tst_softwarerenderer::partiallyObscuredPixmap_data()
+{
+    QTest::addColumn<bool>("covered");
+
+    QTest::newRow("partially covered") << false;
+    QTest::newRow("covered") << true;
+}
+
+void tst_softwarerenderer::partiallyObscuredPixmap()
+{
+    QFETCH(bool, covered);
+
+    QSGRootNode root;
+    root.appendChildNode(new QSGSimpleRectNode(QRectF(0, 0, 100, 50), Qt::red));
+    if (covered)
+        root.appendChildNode(new QSGSimpleRectNode(QRectF(0, 50, 100, 50), Qt::blue));
+
+    const QSize size(100, 100);
+    QSGSoftwarePixmapRenderer renderer(m_renderContext);
+    renderer.setRootNode(&root);
+    renderer.setDeviceRect(size);
+    renderer.setViewportRect(size);
+    renderer.setProjectionRect(QRect(QPoint(), size));
+    renderer.setClearColor(Qt::transparent);
+
+    QPixmap pixmap(size);
+    pixmap.fill(Qt::green);
+    renderer.renderScene();
+    renderer.render(&pixmap);
+
+    const QImage image = pixmap.toImage();
+    QCOMPARE(QColor::fromRgba(image.pixel(50, 25)), QColor(Qt::red));
+    QCOMPARE(pixmap.hasAlphaChannel(), !covered);
+    if (covered)
+        QCOMPARE(QColor::fromRgba(image.pixel(50, 75)), QColor(Qt::blue));
+    else
+        QCOMPARE(qAlpha(image.pixel(50, 75)), 0);
+}
+
+QTEST_MAIN(tst_softwarerenderer)
+
+#include "tst_softwarerenderer.moc"
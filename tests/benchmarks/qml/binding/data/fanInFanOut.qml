@@ -0,0 +1,30 @@
+import QtQml 2.0
+
+QtObject {
+    property int a: 0
+    property int b: 0
+    property int c: 0
+    property int d: 0
+
+    property int sum: a + b + c + d
+
+    property int o1: sum + 1
+    property int o2: sum + 2
+    property int o3: sum + 3
+    property int o4: sum + 4
+    property int o5: sum + 5
+    property int o6: sum + 6
+    property int o7: sum + 7
+    property int o8: sum + 8
+    property int o9: sum + 9
+    property int o10: sum + 10
+    property int o11: sum + 11
+    property int o12: sum + 12
+    property int o13: sum + 13
+    property int o14: sum + 14
+    property int o15: sum + 15
+    property int o16: sum + 16
+
+    property int total: o1 + o2 + o3 + o4 + o5 + o6 + o7 + o8
+                        + o9 + o10 + o11 + o12 + o13 + o14 + o15 + o16
+}
@@ -0,0 +1,25 @@
+import QtQml 2.0
+
+QtObject {
+    id: root
+
+    property int input: 0
+    property int margin: 4
+    property bool always: true
+
+    property QtObject source: QtObject {
+        id: source
+        property int width: root.input
+        property int height: root.input * 2
+    }
+
+    // Dependencies known at compile time
+    property int fixed1: source.width * 2 + margin
+    property int fixed2: source.height - source.width
+    property int fixed3: (input + margin) * 3
+
+    // Dependencies captured on every evaluation
+    property int dynamic1: always ? source.width * 2 + margin : 0
+    property int dynamic2: always ? source.height - source.width : 0
+    property int dynamic3: always ? (input + margin) * 3 : 0
+}
@@ -32,6 +32,7 @@
 #include <QQmlComponent>
 #include <QFile>
 #include <QDebug>
+#include <private/qqmlbindingscheduler_p.h>
 #include "testtypes.h"
 
 class tst_binding : public QObject
@@ -53,6 +54,9 @@ private slots:
     void basicproperty();
     void creation_data();
     void creation();
+    void fanInFanOut();
+    void fixedDependencies_data();
+    void fixedDependencies();
 
 private:
     QQmlEngine engine;
@@ -171,5 +175,56 @@ void tst_binding::creation()
     }
 }
 
+void tst_binding::fanInFanOut()
+{
+    // Four inputs feed one sum, which feeds 16 bindings that are summed up again.
+    // Run with QML_BATCHED_BINDING_UPDATES=1 to evaluate each binding once per round.
+    QQmlComponent c(&engine, QUrl::fromLocalFile(SRCDIR "/data/fanInFanOut.qml"));
+    QScopedPointer<QObject> object(c.create());
+    QVERIFY(object);
+
+    int value = 0;
+    QBENCHMARK {
+        ++value;
+        object->setProperty("a", value);
+        object->setProperty("b", value);
+        object->setProperty("c", value);
+        object->setProperty("d", value);
+        QQmlBindingScheduler::flushCurrentThread();
+    }
+
+    QCOMPARE(object->property("total").toInt(), 16 * 4 * value + 136);
+}
+
+void tst_binding::fixedDependencies_data()
+{
+    QTest::addColumn<QByteArray>("prefix");
+
+    QTest::newRow("fixed") << QByteArray("fixed");
+    QTest::newRow("dynamic") << QByteArray("dynamic");
+}
+
+void tst_binding::fixedDependencies()
+{
+    // The "fixed" bindings only read ids and scope properties, so their guards are
+    // captured once; the "dynamic" ones contain a conditional and re-capture each time.
+    QFETCH(QByteArray, prefix);
+
+    QQmlComponent c(&engine, QUrl::fromLocalFile(SRCDIR "/data/fixedDependencies.qml"));
+    QScopedPointer<QObject> object(c.create());
+    QVERIFY(object);
+
+    int value = 0;
+    QBENCHMARK {
+        object->setProperty("input", ++value);
+        for (int i = 1; i <= 3; ++i)
+            object->property((prefix + QByteArray::number(i)).constData());
+    }
+
+    QCOMPARE(object->property((prefix + "1").constData()).toInt(), value * 2 + 4);
+    QCOMPARE(object->property((prefix + "2").constData()).toInt(), value);
+    QCOMPARE(object->property((prefix + "3").constData()).toInt(), (value + 4) * 3);
+}
+
 QTEST_MAIN(tst_binding)
 #include "tst_binding.moc"
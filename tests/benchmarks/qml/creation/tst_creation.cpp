@@ -34,6 +34,7 @@
 #include <QQuickItem>
 #include <QQmlContext>
 #include <private/qobject_p.h>
+#include <private/qqmlengine_p.h>
 
 class tst_creation : public QObject
 {
@@ -68,6 +69,11 @@ private slots:
 
     void bindings_parent_qml();
 
+    void literals_qml();
+
+    void delegate_qml();
+    void delegate_qml_pooled_bindings();
+
     void anchors_creation();
     void anchors_heightChange();
 
@@ -412,6 +418,90 @@ void tst_creation::bindings_parent_qml()
     delete obj;
 }
 
+void tst_creation::literals_qml()
+{
+    // Literal values that need to be converted from strings are restored from
+    // the compilation unit after the first instantiation.
+    QQmlComponent component(&engine);
+    component.setData("import QtQuick 2.0\n"
+                      "Rectangle {\n"
+                      "    property point p: \"10,20\"\n"
+                      "    property size s: \"100x200\"\n"
+                      "    property rect r: \"10,20,100x200\"\n"
+                      "    property date d: \"2019-01-01\"\n"
+                      "    property url u: \"images/background.png\"\n"
+                      "    property variant v: \"#ff00ff\"\n"
+                      "    color: \"steelblue\"\n"
+                      "    border.color: \"#80ffffff\"\n"
+                      "    Rectangle { color: \"red\"; border.color: \"green\" }\n"
+                      "    Rectangle { color: \"#123456\"; border.color: \"transparent\" }\n"
+                      "}", QUrl());
+
+    QObject *obj = component.create();
+    QVERIFY(obj != nullptr);
+    delete obj;
+
+    QBENCHMARK {
+        QObject *obj = component.create();
+        delete obj;
+    }
+}
+
+static const char delegateQml[] =
+        "import QtQuick 2.0\n"
+        "Item {\n"
+        "    id: root\n"
+        "    width: 200; height: 40\n"
+        "    property int index: 0\n"
+        "    Repeater {\n"
+        "        model: 30\n"
+        "        delegate: Rectangle {\n"
+        "            x: index * 4\n"
+        "            width: root.width / 30; height: root.height\n"
+        "            opacity: root.index % 2 ? 0.5 : 1.0\n"
+        "            visible: width > 0\n"
+        "            color: index % 2 ? \"red\" : \"blue\"\n"
+        "            onWidthChanged: opacity = opacity\n"
+        "        }\n"
+        "    }\n"
+        "}";
+
+void tst_creation::delegate_qml()
+{
+    QQmlComponent component(&engine);
+    component.setData(delegateQml, QUrl());
+
+    QObject *obj = component.create();
+    QVERIFY(obj != nullptr);
+    delete obj;
+
+    QBENCHMARK {
+        QObject *obj = component.create();
+        delete obj;
+    }
+}
+
+void tst_creation::delegate_qml_pooled_bindings()
+{
+    QQmlComponent component(&engine);
+    component.setData(delegateQml, QUrl());
+
+    QObject *obj = component.create();
+    QVERIFY(obj != nullptr);
+    delete obj;
+
+    // The bindings of an instance come from the engine's slabs, count them there
+    const QQmlBindingPool &pool = QQmlEnginePrivate::get(&engine)->bindingPool;
+    const int outstanding = pool.outstandingItems();
+    obj = component.create();
+    QVERIFY(obj != nullptr);
+    const int pooledBindings = pool.outstandingItems() - outstanding;
+    delete obj;
+
+    QVERIFY(pooledBindings > 0);
+    QTest::setBenchmarkResult(pooledBindings, QTest::Events);
+}
+
 void tst_creation::anchors_creation()
 {
     QQmlComponent component(&engine);
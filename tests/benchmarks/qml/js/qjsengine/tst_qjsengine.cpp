@@ -29,6 +29,7 @@
 #include <qtest.h>
 #include <QtQml/qjsvalue.h>
 #include <QtQml/qjsengine.h>
+#include <QtCore/qbuffer.h>
 
 class tst_QJSEngine : public QObject
 {
@@ -50,6 +51,11 @@ private slots:
 #endif
     void evaluate_data();
     void evaluate();
+    void promiseChain();
+    void jsonParse_data();
+    void jsonParse();
+    void jsonStringify_data();
+    void jsonStringify();
 #if 0 // No program
     void evaluateProgram_data();
     void evaluateProgram();
@@ -206,6 +212,21 @@ void tst_QJSEngine::evaluate_data()
     QTest::newRow("while loop (100000 iterations)") << QString::fromLatin1("i = 0; while (i < 100000) { ++i; }; i");
     QTest::newRow("while loop (1000000 iterations)") << QString::fromLatin1("i = 0; while (i < 1000000) { ++i; }; i");
     QTest::newRow("function expression") << QString::fromLatin1("(function(a, b, c){ return a + b + c; })(1, 2, 3)");
+    QTest::newRow("array append (1000000 elements)") << QString::fromLatin1("a = []; for (i = 0; i < 1000000; ++i) { a[i] = i * 0.5; }; a.length");
+    QTest::newRow("array sort (100000 numbers)") << QString::fromLatin1("a = []; for (i = 0; i < 100000; ++i) { a[i] = (i * 7919) % 100003; }; a.sort(); a[0]");
+    QTest::newRow("array sort (100000 rows, comparator)") << QString::fromLatin1("a = []; for (i = 0; i < 100000; ++i) { a[i] = { key: (i * 7919) % 1000, index: i }; }; a.sort(function(x, y) { return x.key - y.key; }); a[0].index");
+    QTest::newRow("array sort (100000 rows, presorted)") << QString::fromLatin1("a = []; for (i = 0; i < 100000; ++i) { a[i] = { key: i >> 4, index: i }; }; a.sort(function(x, y) { return x.key - y.key; }); a[0].index");
+    QTest::newRow("array fill and search (1000000 elements)") << QString::fromLatin1("a = new Array(1000000); a.fill(0.5); a[999999] = 1; a.includes(2) || a.lastIndexOf(1)");
+    QTest::newRow("csv join (100000 rows)") << QString::fromLatin1("rows = []; for (i = 0; i < 100000; ++i) { rows[i] = [i, i * 0.5, 'name' + i, true].join(','); }; rows.join('\\n').length");
+    QTest::newRow("log template concat (100000 lines)") << QString::fromLatin1("s = ''; for (i = 0; i < 100000; ++i) { s += `${i}: message ${i * 2}\\n`; }; s.substring(10, 20).length + s.slice(-10).length");
+    QTest::newRow("map set/get (100000 number keys)") << QString::fromLatin1("m = new Map(); for (i = 0; i < 100000; ++i) { m.set(i, i); }; j = 0; for (i = 0; i < 100000; ++i) { j += m.get(i); }; j");
+    QTest::newRow("map set/get (100000 string keys)") << QString::fromLatin1("m = new Map(); for (i = 0; i < 100000; ++i) { m.set('id' + i, i); }; j = 0; for (i = 0; i < 100000; ++i) { j += m.get('id' + i); }; j");
+    QTest::newRow("map delete and iterate (100000 keys)") << QString::fromLatin1("m = new Map(); for (i = 0; i < 100000; ++i) { m.set(i, i); }; for (i = 0; i < 100000; i += 2) { m.delete(i); }; j = 0; m.forEach(function(v) { j += v; }); j");
+    QTest::newRow("set add/has (100000 objects)") << QString::fromLatin1("s = new Set(); o = []; for (i = 0; i < 100000; ++i) { o[i] = {}; s.add(o[i]); }; j = 0; for (i = 0; i < 100000; ++i) { if (s.has(o[i])) ++j; }; j");
+    QTest::newRow("sparse array insert (100000 elements)") << QString::fromLatin1("a = []; a[1000000000] = 0; for (i = 0; i < 100000; ++i) { a[((i * 7919) % 100003) * 16] = i; }; a.length");
+    QTest::newRow("sparse array lookup (100000 elements)") << QString::fromLatin1("a = []; a[1000000000] = 0; for (i = 0; i < 100000; ++i) { a[i * 16] = i; }; j = 0; for (i = 0; i < 1600000; i += 4) { if (a[i] !== undefined) ++j; }; j");
+    QTest::newRow("sparse array iterate (100000 elements)") << QString::fromLatin1("a = []; a[1000000000] = 0; for (i = 0; i < 100000; ++i) { a[i * 16] = i; }; j = 0; for (k in a) { ++j; }; j + Object.keys(a).length");
+    QTest::newRow("sparse array delete and truncate (100000 elements)") << QString::fromLatin1("a = []; a[1000000000] = 0; for (i = 0; i < 100000; ++i) { a[i * 16] = i; }; for (i = 0; i < 1600000; i += 32) { delete a[i]; }; a.length = 800000; Object.keys(a).length");
 }
 
 void tst_QJSEngine::evaluate()
@@ -246,6 +267,91 @@ void tst_QJSEngine::evaluateProgram()
 }
 #endif
 
+void tst_QJSEngine::promiseChain()
+{
+    // One million chained resolutions, all run from the promise reaction queue
+    // before evaluate() returns.
+    newEngine();
+    QJSValue chain = m_engine->evaluate(
+            "(function() {\n"
+            "    var p = Promise.resolve(0);\n"
+            "    for (var i = 0; i < 1000000; ++i)\n"
+            "        p = p.then(function(v) { return v + 1; });\n"
+            "    p.then(function(v) { result = v; });\n"
+            "})");
+    QVERIFY(chain.isCallable());
+
+    QBENCHMARK {
+        m_engine->globalObject().setProperty("result", 0);
+        chain.call();
+    }
+
+    QCOMPARE(m_engine->globalObject().property("result").toInt(), 1000000);
+}
+
+void tst_QJSEngine::jsonParse_data()
+{
+    QTest::addColumn<bool>("indented");
+    QTest::newRow("compact") << false;
+    QTest::newRow("indented") << true;
+}
+
+void tst_QJSEngine::jsonParse()
+{
+    QFETCH(bool, indented);
+
+    // A REST style payload of a few MB: an array of records with the same keys.
+    newEngine();
+    m_engine->evaluate(QString::fromLatin1(
+            "var records = [];\n"
+            "for (var i = 0; i < 20000; ++i) {\n"
+            "    records.push({ id: i, name: 'item ' + i, price: i * 0.25, active: (i % 3) == 0,\n"
+            "                   tags: ['a', 'b\\n' + i], owner: { id: i % 97, email: 'user' + i + '@example.com' } });\n"
+            "}\n"
+            "payload = JSON.stringify(records, null, %1);").arg(indented ? 4 : 0));
+    QJSValue parse = m_engine->evaluate("(function() { return JSON.parse(payload).length; })");
+    QVERIFY(parse.isCallable());
+
+    QJSValue result;
+    QBENCHMARK {
+        result = parse.call();
+    }
+    QCOMPARE(result.toInt(), 20000);
+}
+
+void tst_QJSEngine::jsonStringify_data()
+{
+    QTest::addColumn<bool>("toDevice");
+    QTest::newRow("JSON.stringify") << false;
+    QTest::newRow("QJSEngine::toJson") << true;
+}
+
+void tst_QJSEngine::jsonStringify()
+{
+    QFETCH(bool, toDevice);
+
+    newEngine();
+    QJSValue model = m_engine->evaluate(
+            "var model = [];\n"
+            "for (var i = 0; i < 20000; ++i) {\n"
+            "    model.push({ id: i, name: 'item \"' + i + '\"', price: i * 0.25,\n"
+            "                 children: [{ id: i * 2, tags: ['a', 'b'] }, { id: i * 2 + 1, tags: [] }] });\n"
+            "}\n"
+            "model");
+    QJSValue stringify = m_engine->evaluate("(function(value) { return JSON.stringify(value, null, 2); })");
+    QVERIFY(stringify.isCallable());
+
+    QBENCHMARK {
+        if (toDevice) {
+            QBuffer buffer;
+            buffer.open(QIODevice::WriteOnly);
+            m_engine->toJson(model, &buffer, 2);
+        } else {
+            stringify.call(QJSValueList() << model);
+        }
+    }
+}
+
 void tst_QJSEngine::globalObject()
 {
     newEngine();
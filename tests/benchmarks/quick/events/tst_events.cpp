@@ -29,6 +29,7 @@
 #include <qtest.h>
 #include <QtQuick>
 #include <QtQuick/private/qquickmousearea_p.h>
+#include <QtQuick/private/qquickwindow_p.h>
 #include <QDebug>
 #include "../../../auto/shared/util.h"
 #include "../../../auto/quick/shared/viewtestutil.h"
@@ -50,6 +51,8 @@ private slots:
     void mouseMove();
     void touchToMousePressRelease();
     void touchToMousePressMove();
+    void hitTest_data();
+    void hitTest();
 
 public slots:
     void initTestCase() {
@@ -139,5 +142,44 @@ void tst_events::touchToMousePressMove()
     QCOMPARE(mouseArea->pressed(), false);
 }
 
+void tst_events::hitTest_data()
+{
+    QTest::addColumn<bool>("hitTestIndex");
+
+    QTest::newRow("tree walk") << false;
+    QTest::newRow("hit test index") << true;
+}
+
+void tst_events::hitTest()
+{
+    QFETCH(bool, hitTestIndex);
+
+    TestView view;
+    QQuickWindowPrivate::get(&view)->setHitTestIndexEnabled(hitTestIndex);
+    view.setSource(testFileUrl("hittest.qml"));
+    view.show();
+    QVERIFY(QTest::qWaitForWindowExposed(&view));
+
+    QQuickMouseArea *mouseArea = view.rootObject()->findChild<QQuickMouseArea *>("target");
+    QVERIFY(mouseArea);
+    const QPoint p = mouseArea->mapToScene(QPointF(1, 1)).toPoint();
+    const QPoint p2 = p + QPoint(1, 0);
+
+    QMouseEvent hoverEvent1(QEvent::MouseMove, p, Qt::NoButton, Qt::NoButton, 0);
+    QMouseEvent hoverEvent2(QEvent::MouseMove, p2, Qt::NoButton, Qt::NoButton, 0);
+    QMouseEvent pressEvent(QEvent::MouseButtonPress, p, Qt::LeftButton, Qt::LeftButton, 0);
+    QMouseEvent releaseEvent(QEvent::MouseButtonRelease, p, Qt::LeftButton, Qt::LeftButton, 0);
+
+    QBENCHMARK {
+        view.handleEvent(&hoverEvent1);
+        view.handleEvent(&hoverEvent2);
+        QCOMPARE(mouseArea->hovered(), true);
+        view.handleEvent(&pressEvent);
+        QCOMPARE(mouseArea->pressed(), true);
+        view.handleEvent(&releaseEvent);
+    }
+    QCOMPARE(mouseArea->pressed(), false);
+}
+
 QTEST_MAIN(tst_events)
 #include "tst_events.moc"
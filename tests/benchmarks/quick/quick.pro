@@ -1,4 +1,6 @@
 TEMPLATE = subdirs
 
 SUBDIRS += \
-           events
+           events \
+           softwarerenderer \
+           text
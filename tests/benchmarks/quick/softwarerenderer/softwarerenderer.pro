@@ -0,0 +1,7 @@
+CONFIG += benchmark
+TEMPLATE = app
+TARGET = tst_softwarerenderer
+QT += quick quick-private testlib
+macos:CONFIG -= app_bundle
+
+SOURCES += tst_softwarerenderer.cpp
@@ -0,0 +1,216 @@
+/****************************************************************************
+**
+** Copyright (C) 2019 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#include <qtest.h>
+#include <QtCore/QThread>
+#include <QtGui/QImage>
+#include <QtQuick/QSGSimpleRectNode>
+#include <QtQuick/private/qsgadaptationlayer_p.h>
+#include <QtQuick/private/qsgsoftwarecontext_p.h>
+#include <QtQuick/private/qsgsoftwarepixmaprenderer_p.h>
+
+class tst_SoftwareRenderer : public QObject
+{
+    Q_OBJECT
+public:
+    tst_SoftwareRenderer() {}
+
+private slots:
+    void initTestCase();
+    void cleanupTestCase();
+    void renderFullScene_data();
+    void renderFullScene();
+    void renderPartialUpdate_data();
+    void renderPartialUpdate();
+    void renderOccludedScene();
+
+private:
+    void populate(QSGRootNode *root);
+    void threadCountData();
+
+    QSGSoftwareContext *m_context = nullptr;
+    QSGSoftwareRenderContext *m_renderContext = nullptr;
+    QVector<QSGSimpleRectNode *> m_animatedNodes;
+};
+
+static const QSize sceneSize(1920, 1080);
+
+void tst_SoftwareRenderer::initTestCase()
+{
+    m_context = new QSGSoftwareContext;
+    m_renderContext = static_cast<QSGSoftwareRenderContext *>(m_context->createRenderContext());
+}
+
+void tst_SoftwareRenderer::cleanupTestCase()
+{
+    delete m_renderContext;
+    delete m_context;
+}
+
+// A grid of rounded, bordered rectangles with a few plain ones moving on top
+void tst_SoftwareRenderer::populate(QSGRootNode *root)
+{
+    m_animatedNodes.clear();
+    const int cell = 40;
+    for (int y = 0; y + cell <= sceneSize.height(); y += cell) {
+        for (int x = 0; x + cell <= sceneSize.width(); x += cell) {
+            QSGInternalRectangleNode *node = m_context->createInternalRectangleNode();
+            node->setRect(QRectF(x + 2, y + 2, cell - 4, cell - 4));
+            node->setColor(QColor::fromHsv((x + y) % 360, 200, 220));
+            node->setPenColor(Qt::black);
+            node->setPenWidth(2);
+            node->setRadius(8);
+            node->setAntialiasing(true);
+            node->update();
+            root->appendChildNode(node);
+        }
+    }
+    for (int i = 0; i < 16; ++i) {
+        QSGSimpleRectNode *node = new QSGSimpleRectNode(QRectF(i * 100, i * 50, 120, 120), QColor(0, 0, 255, 128));
+        root->appendChildNode(node);
+        m_animatedNodes.append(node);
+    }
+}
+
+void tst_SoftwareRenderer::threadCountData()
+{
+    QTest::addColumn<int>("threads");
+
+    QTest::newRow("serial") << 0;
+    for (int threads = 2; threads <= qMax(2, QThread::idealThreadCount()); threads *= 2)
+        QTest::newRow(qPrintable(QString::fromLatin1("%1 threads").arg(threads))) << threads;
+}
+
+void tst_SoftwareRenderer::renderFullScene_data()
+{
+    threadCountData();
+}
+
+void tst_SoftwareRenderer::renderFullScene()
+{
+    QFETCH(int, threads);
+
+    QSGRootNode root;
+    populate(&root);
+
+    QSGSoftwarePixmapRenderer renderer(m_renderContext);
+    renderer.setRenderThreadCount(threads);
+    renderer.setRootNode(&root);
+    renderer.setDeviceRect(sceneSize);
+    renderer.setViewportRect(sceneSize);
+    renderer.setProjectionRect(QRect(QPoint(), sceneSize));
+    renderer.setClearColor(Qt::white);
+
+    QImage image(sceneSize, QImage::Format_ARGB32_Premultiplied);
+    QBENCHMARK {
+        root.markDirty(QSGNode::DirtyForceUpdate);
+        renderer.renderScene();
+        renderer.render(&image);
+    }
+}
+
+void tst_SoftwareRenderer::renderPartialUpdate_data()
+{
+    threadCountData();
+}
+
+void tst_SoftwareRenderer::renderPartialUpdate()
+{
+    QFETCH(int, threads);
+
+    QSGRootNode root;
+    populate(&root);
+
+    QSGSoftwarePixmapRenderer renderer(m_renderContext);
+    renderer.setRenderThreadCount(threads);
+    renderer.setRootNode(&root);
+    renderer.setDeviceRect(sceneSize);
+    renderer.setViewportRect(sceneSize);
+    renderer.setProjectionRect(QRect(QPoint(), sceneSize));
+    renderer.setClearColor(Qt::white);
+
+    QImage image(sceneSize, QImage::Format_ARGB32_Premultiplied);
+    renderer.renderScene();
+    renderer.render(&image);
+
+    int frame = 0;
+    QBENCHMARK {
+        ++frame;
+        for (QSGSimpleRectNode *node : qAsConst(m_animatedNodes)) {
+            QRectF rect = node->rect();
+            rect.moveLeft((int(rect.left()) + 7) % (sceneSize.width() - 120));
+            node->setRect(rect);
+        }
+        renderer.renderScene();
+        renderer.render(&image);
+    }
+}
+
+// Stacks of opaque cards, as in a StackView or a list of pages, where most
+// of the scene is hidden and only the top of each stack changes
+void tst_SoftwareRenderer::renderOccludedScene()
+{
+    QSGRootNode root;
+    QVector<QSGSimpleRectNode *> topCards;
+    const QSize cardSize(200, 150);
+    for (int y = 0; y + cardSize.height() <= sceneSize.height(); y += cardSize.height()) {
+        for (int x = 0; x + cardSize.width() <= sceneSize.width(); x += cardSize.width()) {
+            QSGSimpleRectNode *node = nullptr;
+            for (int i = 0; i < 20; ++i) {
+                node = new QSGSimpleRectNode(QRectF(QPointF(x, y), cardSize), QColor::fromHsv(i * 18, 200, 200));
+                root.appendChildNode(node);
+            }
+            topCards.append(node);
+        }
+    }
+
+    QSGSoftwarePixmapRenderer renderer(m_renderContext);
+    renderer.setRootNode(&root);
+    renderer.setDeviceRect(sceneSize);
+    renderer.setViewportRect(sceneSize);
+    renderer.setProjectionRect(QRect(QPoint(), sceneSize));
+    renderer.setClearColor(Qt::white);
+
+    QImage image(sceneSize, QImage::Format_ARGB32_Premultiplied);
+    renderer.renderScene();
+    renderer.render(&image);
+
+    int frame = 0;
+    QBENCHMARK {
+        ++frame;
+        for (QSGSimpleRectNode *node : qAsConst(topCards))
+            node->setColor(QColor::fromHsv(frame % 360, 200, 200));
+        renderer.renderScene();
+        renderer.render(&image);
+    }
+}
+
+QTEST_MAIN(tst_SoftwareRenderer)
+
+#include "tst_softwarerenderer.moc"
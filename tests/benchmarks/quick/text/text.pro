@@ -0,0 +1,7 @@
+CONFIG += benchmark
+TEMPLATE = app
+TARGET = tst_text
+QT += quick qml testlib
+macos:CONFIG -= app_bundle
+
+SOURCES += tst_text.cpp
@@ -0,0 +1,89 @@
+/****************************************************************************
+**
+** Copyright (C) 2019 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#include <qtest.h>
+#include <QtQml/QQmlEngine>
+#include <QtQml/QQmlComponent>
+#include <QtQuick/QQuickItem>
+
+class tst_Text : public QObject
+{
+    Q_OBJECT
+public:
+    tst_Text() {}
+
+private slots:
+    void createLabels_data();
+    void createLabels();
+
+private:
+    QQmlEngine m_engine;
+};
+
+void tst_Text::createLabels_data()
+{
+    QTest::addColumn<QString>("text");
+    QTest::addColumn<int>("width");
+
+    // Every label shows the same string, like the status texts of a large list
+    QTest::newRow("identical") << QStringLiteral("\"OK\"") << 0;
+    QTest::newRow("identical, wrapped") << QStringLiteral("\"Waiting for the server\"") << 60;
+    // Every label shows a string of its own, so nothing can be shared
+    QTest::newRow("distinct") << QStringLiteral("\"Item \" + index") << 0;
+}
+
+void tst_Text::createLabels()
+{
+    QFETCH(QString, text);
+    QFETCH(int, width);
+
+    QQmlComponent component(&m_engine);
+    component.setData(QStringLiteral(
+            "import QtQuick 2.0\n"
+            "Item {\n"
+            "    Repeater {\n"
+            "        model: 10000\n"
+            "        Text {\n"
+            "            text: %1\n"
+            "            width: %2 > 0 ? %2 : implicitWidth\n"
+            "            wrapMode: Text.Wrap\n"
+            "        }\n"
+            "    }\n"
+            "}\n").arg(text).arg(width).toUtf8(), QUrl());
+    QVERIFY2(component.isReady(), qPrintable(component.errorString()));
+
+    QBENCHMARK {
+        QScopedPointer<QObject> root(component.create());
+        QVERIFY(root);
+    }
+}
+
+QTEST_MAIN(tst_Text)
+
+#include "tst_text.moc"